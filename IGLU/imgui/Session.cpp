@@ -11,6 +11,7 @@
 
 #include <IGLU/simple_renderer/Drawable.h>
 #include <IGLU/simple_renderer/Material.h>
+#include <IGLU/simple_renderer/TransientGeometryArena.h>
 #include <igl/Macros.h>
 #include <igl/ShaderCreator.h>
 
@@ -236,52 +237,31 @@ std::unique_ptr<igl::IShaderStages> getShaderStagesForBackend(igl::IDevice& devi
 } // namespace
 
 namespace {
+// initial sizes of the per-frame geometry buffers shared by all ImGui command lists
+constexpr size_t kInitialVertexBufferSize = (1l << 16) * sizeof(ImDrawVert);
+constexpr size_t kInitialIndexBufferSize = (1l << 16) * sizeof(ImDrawIdx);
+
 struct DrawableData {
   std::shared_ptr<iglu::vertexdata::VertexData> vertexData;
   std::shared_ptr<iglu::drawable::Drawable> drawable;
 
-  DrawableData(igl::IDevice& device,
+  // Checks whether this drawable still refers to the current buffers of `geometry`
+  [[nodiscard]] bool usesBuffersOf(const iglu::vertexdata::TransientGeometryArena& geometry) const {
+    return vertexData && &vertexData->vertexBuffer() == geometry.vertexBuffer().get() &&
+           &vertexData->indexBuffer() == geometry.indexBuffer().get();
+  }
+
+  DrawableData() = default;
+  DrawableData(const iglu::vertexdata::TransientGeometryArena& geometry,
                const std::shared_ptr<igl::IVertexInputState>& inputState,
                const std::shared_ptr<iglu::material::Material>& material) {
     IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
-    IGL_DEBUG_ASSERT(sizeof(ImDrawIdx) == 2,
-                     "The constants below may not work with the ImGui data.");
-    const size_t kMaxVertices = (1l << 16);
-    const size_t kMaxVertexBufferSize = kMaxVertices * sizeof(ImDrawVert);
-    const size_t kMaxIndexBufferSize = kMaxVertices * sizeof(ImDrawIdx);
-
-    const igl::BufferDesc vbDesc{.type = igl::BufferDesc::BufferTypeBits::Vertex,
-                                 .data = nullptr,
-                                 .length = kMaxVertexBufferSize,
-                                 .storage = igl::ResourceStorage::Shared,
-                                 .hint = 0,
-                                 .debugName = "vertex (" + material->name + ")"};
-    const igl::BufferDesc ibDesc{.type = igl::BufferDesc::BufferTypeBits::Index,
-                                 .data = nullptr,
-                                 .length = kMaxIndexBufferSize,
-                                 .storage = igl::ResourceStorage::Shared,
-                                 .hint = 0,
-                                 .debugName = "index (" + material->name + ")"};
-
-    iglu::vertexdata::PrimitiveDesc primitiveDesc;
-    primitiveDesc.numEntries = 0;
-
-    // Per IGL Error Handling rule #24, every resource creation call must pass
-    // a Result* and check it; passing nullptr silently swallows errors.
-    igl::Result result;
-    auto vb = device.createBuffer(vbDesc, &result);
-    IGL_DEBUG_ASSERT(result.isOk(), "createBuffer(vertex) failed: %s", result.message.c_str());
-    IGL_DEBUG_ASSERT(vb != nullptr);
-    auto ib = device.createBuffer(ibDesc, &result);
-    IGL_DEBUG_ASSERT(result.isOk(), "createBuffer(index) failed: %s", result.message.c_str());
-    IGL_DEBUG_ASSERT(ib != nullptr);
-
     vertexData = std::make_shared<iglu::vertexdata::VertexData>(
         inputState,
-        std::move(vb),
-        std::move(ib),
+        geometry.vertexBuffer(),
+        geometry.indexBuffer(),
         sizeof(ImDrawIdx) == sizeof(uint16_t) ? igl::IndexFormat::UInt16 : igl::IndexFormat::UInt32,
-        primitiveDesc);
+        iglu::vertexdata::PrimitiveDesc{});
 
     drawable = std::make_shared<iglu::drawable::Drawable>(vertexData, material);
   }
@@ -307,8 +287,12 @@ class Session::Renderer {
  private:
   std::shared_ptr<igl::IVertexInputState> vertexInputState_;
   std::shared_ptr<iglu::material::Material> material_;
-  std::vector<DrawableData> drawables_[3]; // list of drawables to be reused every 3 frames
-  size_t nextBufferingIndex_ = 0;
+  // all command lists of a frame share the buffers of this arena
+  iglu::vertexdata::TransientGeometryArena geometry_{
+      kInitialVertexBufferSize, kInitialIndexBufferSize, "imgui"};
+  std::vector<iglu::vertexdata::TransientGeometryArena::Allocation> allocations_;
+  // one drawable per frame of the arena, recreated when the arena grows its buffers
+  DrawableData drawables_[iglu::vertexdata::TransientGeometryArena::kNumFrames];
 
   igl::RenderPipelineDesc renderPipelineDesc_;
   std::shared_ptr<igl::ITexture> fontTexture_;
@@ -319,6 +303,8 @@ Session::Renderer::Renderer(igl::IDevice& device) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
   ImGuiIO& io = ImGui::GetIO();
   io.BackendRendererName = "imgui_impl_igl";
+  // vertex offsets are applied when binding the vertex buffer, so 16-bit indices are enough
+  io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
 
   // Per IGL Error Handling rule #24, every resource creation call must pass a
   // Result* and check it; passing nullptr silently swallows errors.
@@ -450,6 +436,29 @@ void Session::Renderer::renderDrawData(igl::IDevice& device,
     return;
   }
 
+  // Gather the geometry of all command lists and upload it at once. The arena cycles through
+  // three sets of buffers, since the buffers of previous frames may still be in use by the GPU.
+  geometry_.begin();
+  allocations_.clear();
+  for (int n = 0; n < drawData->CmdListsCount; n++) {
+    const ImDrawList* cmdList = drawData->CmdLists[n];
+    allocations_.push_back(geometry_.allocate(cmdList->VtxBuffer.Data,
+                                              cmdList->VtxBuffer.Size * sizeof(ImDrawVert),
+                                              cmdList->IdxBuffer.Data,
+                                              cmdList->IdxBuffer.Size * sizeof(ImDrawIdx)));
+  }
+  const igl::Result result = geometry_.commit(device);
+  if (!result.isOk()) {
+    IGL_LOG_ERROR("ImGui renderDrawData: Cannot upload geometry: %s\n", result.message.c_str());
+    return;
+  }
+
+  DrawableData& drawableData = drawables_[geometry_.currentFrame()];
+  if (!drawableData.usesBuffersOf(geometry_)) {
+    drawableData = DrawableData(geometry_, vertexInputState_, material_);
+  }
+  iglu::vertexdata::PrimitiveDesc& primitiveDesc = drawableData.vertexData->primitiveDesc();
+
   cmdEncoder.pushDebugGroupLabel("ImGui Rendering", igl::Color(0, 1, 0));
 
   const igl::Viewport viewport = {
@@ -485,10 +494,6 @@ void Session::Renderer::renderDrawData(igl::IDevice& device,
   const ImVec2 clipScale =
       drawData->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
-  // Since vertex buffers are updated every frame, we must use triple buffering for Metal to work
-  std::vector<DrawableData>& curFrameDrawables = drawables_[nextBufferingIndex_];
-  nextBufferingIndex_ = (nextBufferingIndex_ + 1) % 3;
-
   const bool isOpenGL = device.getBackendType() == igl::BackendType::OpenGL;
   const bool isVulkan = device.getBackendType() == igl::BackendType::Vulkan;
   const bool isD3D12 = device.getBackendType() == igl::BackendType::D3D12;
@@ -498,17 +503,7 @@ void Session::Renderer::renderDrawData(igl::IDevice& device,
 
   for (int n = 0; n < drawData->CmdListsCount; n++) {
     const ImDrawList* cmdList = drawData->CmdLists[n];
-
-    if (n >= curFrameDrawables.size()) {
-      curFrameDrawables.emplace_back(device, vertexInputState_, material_);
-    }
-    const DrawableData& drawableData = curFrameDrawables[n];
-
-    // Upload vertex/index buffers
-    drawableData.vertexData->vertexBuffer().upload(
-        cmdList->VtxBuffer.Data, {cmdList->VtxBuffer.Size * sizeof(ImDrawVert), 0});
-    drawableData.vertexData->indexBuffer().upload(cmdList->IdxBuffer.Data,
-                                                  {cmdList->IdxBuffer.Size * sizeof(ImDrawIdx), 0});
+    const auto& allocation = allocations_[n];
 
     for (int cmdI = 0; cmdI < cmdList->CmdBuffer.Size; cmdI++) {
       const ImDrawCmd cmd = cmdList->CmdBuffer[cmdI];
@@ -548,8 +543,10 @@ void Session::Renderer::renderDrawData(igl::IDevice& device,
         }
       }
 
-      drawableData.vertexData->primitiveDesc().numEntries = cmd.ElemCount;
-      drawableData.vertexData->primitiveDesc().offset = cmd.IdxOffset * sizeof(ImDrawIdx);
+      primitiveDesc.numEntries = cmd.ElemCount;
+      primitiveDesc.offset = allocation.indexOffset + cmd.IdxOffset * sizeof(ImDrawIdx);
+      primitiveDesc.vertexBufferOffset =
+          allocation.vertexOffset + cmd.VtxOffset * sizeof(ImDrawVert);
 
       drawableData.drawable->draw(device,
                                   cmdEncoder,
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#include "TransientGeometryArena.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <igl/Macros.h>
+
+namespace iglu::vertexdata {
+
+namespace {
+
+size_t alignUp(size_t value) {
+  return (value + TransientGeometryArena::kAlignment - 1) &
+         ~(TransientGeometryArena::kAlignment - 1);
+}
+
+size_t append(std::vector<uint8_t>& staging, const void* data, size_t size) {
+  const size_t offset = alignUp(staging.size());
+  staging.resize(offset + size);
+  if (size) {
+    memcpy(staging.data() + offset, data, size);
+  }
+  return offset;
+}
+
+} // namespace
+
+TransientGeometryArena::TransientGeometryArena(size_t vertexCapacity,
+                                               size_t indexCapacity,
+                                               std::string debugName) :
+  vertexCapacity_(vertexCapacity), indexCapacity_(indexCapacity), debugName_(std::move(debugName)) {
+  vertexStaging_.reserve(vertexCapacity_);
+  indexStaging_.reserve(indexCapacity_);
+}
+
+void TransientGeometryArena::begin() {
+  currentFrame_ = (currentFrame_ + 1) % kNumFrames;
+  vertexStaging_.clear();
+  indexStaging_.clear();
+}
+
+TransientGeometryArena::Allocation TransientGeometryArena::allocate(const void* vertices,
+                                                                    size_t vertexBytes,
+                                                                    const void* indices,
+                                                                    size_t indexBytes) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(vertices || !vertexBytes);
+  IGL_DEBUG_ASSERT(indices || !indexBytes);
+  return {
+      .vertexOffset = append(vertexStaging_, vertices, vertexBytes),
+      .indexOffset = append(indexStaging_, indices, indexBytes),
+  };
+}
+
+igl::Result TransientGeometryArena::commit(igl::IDevice& device) {
+  IGL_PROFILER_FUNCTION();
+  Frame& frame = frames_[currentFrame_];
+
+  igl::Result result;
+  if (!frame.vertexBuffer || frame.vertexBuffer->getSizeInBytes() < vertexStaging_.size()) {
+    // grow geometrically, so that a frame with slowly increasing geometry does not reallocate
+    const size_t current = frame.vertexBuffer ? frame.vertexBuffer->getSizeInBytes() : 0;
+    vertexCapacity_ = std::max({vertexCapacity_, 2 * current, vertexStaging_.size()});
+    frame.vertexBuffer = createBuffer(
+        device, igl::BufferDesc::BufferTypeBits::Vertex, vertexCapacity_, result);
+    if (!result.isOk()) {
+      return result;
+    }
+  }
+  if (!frame.indexBuffer || frame.indexBuffer->getSizeInBytes() < indexStaging_.size()) {
+    const size_t current = frame.indexBuffer ? frame.indexBuffer->getSizeInBytes() : 0;
+    indexCapacity_ = std::max({indexCapacity_, 2 * current, indexStaging_.size()});
+    frame.indexBuffer =
+        createBuffer(device, igl::BufferDesc::BufferTypeBits::Index, indexCapacity_, result);
+    if (!result.isOk()) {
+      return result;
+    }
+  }
+
+  if (!vertexStaging_.empty()) {
+    result = frame.vertexBuffer->upload(vertexStaging_.data(), {vertexStaging_.size(), 0});
+    if (!result.isOk()) {
+      return result;
+    }
+  }
+  if (!indexStaging_.empty()) {
+    result = frame.indexBuffer->upload(indexStaging_.data(), {indexStaging_.size(), 0});
+  }
+  return result;
+}
+
+std::shared_ptr<igl::IBuffer> TransientGeometryArena::createBuffer(
+    igl::IDevice& device,
+    igl::BufferDesc::BufferType type,
+    size_t length,
+    igl::Result& outResult) const {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+  const bool isVertex = (type & igl::BufferDesc::BufferTypeBits::Vertex) != 0;
+  const igl::BufferDesc desc{
+      .type = type,
+      .data = nullptr,
+      .length = length,
+      .storage = igl::ResourceStorage::Shared,
+      .hint = 0,
+      .debugName = (isVertex ? "vertex (" : "index (") + debugName_ + ")",
+  };
+  auto buffer = device.createBuffer(desc, &outResult);
+  IGL_DEBUG_ASSERT(outResult.isOk(), "createBuffer() failed: %s", outResult.message.c_str());
+  return buffer;
+}
+
+} // namespace iglu::vertexdata
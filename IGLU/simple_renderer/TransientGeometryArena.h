@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// @MARK:COVERAGE_EXCLUDE_FILE
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <igl/IGL.h>
+
+namespace iglu::vertexdata {
+
+/// Per-frame vertex and index storage for geometry that is rebuilt every frame, such as UI.
+///
+/// Callers append their vertices and indices with allocate() between begin() and commit(). The
+/// data is staged on the CPU and written to one vertex and one index buffer with a single upload
+/// per buffer in commit(). Each allocation is addressed by byte offsets into these buffers: bind
+/// the vertex buffer at `vertexOffset` (which acts as the base vertex) and the index buffer at
+/// `indexOffset`.
+///
+/// The arena cycles through kNumFrames sets of buffers, so the GPU can still read the buffers of
+/// previous frames while the current one is written. Buffers grow on demand in commit(), in which
+/// case the buffers returned by vertexBuffer() and indexBuffer() change.
+class TransientGeometryArena final {
+ public:
+  static constexpr uint32_t kNumFrames = 3;
+  /// Alignment of every allocation, in bytes. Satisfies the buffer offset requirements of all
+  /// backends for both vertex and index buffers.
+  static constexpr size_t kAlignment = 16;
+
+  struct Allocation {
+    size_t vertexOffset = 0;
+    size_t indexOffset = 0;
+  };
+
+  /// @param vertexCapacity Initial size of each vertex buffer, in bytes.
+  /// @param indexCapacity Initial size of each index buffer, in bytes.
+  TransientGeometryArena(size_t vertexCapacity, size_t indexCapacity, std::string debugName);
+  ~TransientGeometryArena() = default;
+  TransientGeometryArena(const TransientGeometryArena&) = delete;
+  TransientGeometryArena& operator=(const TransientGeometryArena&) = delete;
+
+  /// Moves to the buffers of the next frame and discards all allocations.
+  void begin();
+
+  /// Copies `vertexBytes` of `vertices` and `indexBytes` of `indices` into the staging memory of
+  /// the current frame. `indices` may be nullptr if `indexBytes` is 0.
+  Allocation allocate(const void* vertices,
+                      size_t vertexBytes,
+                      const void* indices,
+                      size_t indexBytes);
+
+  /// Uploads everything allocated since begin(), growing the buffers of the current frame if
+  /// needed. Must be called before any of the allocations is drawn.
+  igl::Result commit(igl::IDevice& device);
+
+  /// The buffers of the current frame. nullptr until the first commit().
+  [[nodiscard]] const std::shared_ptr<igl::IBuffer>& vertexBuffer() const {
+    return frames_[currentFrame_].vertexBuffer;
+  }
+  [[nodiscard]] const std::shared_ptr<igl::IBuffer>& indexBuffer() const {
+    return frames_[currentFrame_].indexBuffer;
+  }
+  [[nodiscard]] uint32_t currentFrame() const {
+    return currentFrame_;
+  }
+
+ private:
+  struct Frame {
+    std::shared_ptr<igl::IBuffer> vertexBuffer;
+    std::shared_ptr<igl::IBuffer> indexBuffer;
+  };
+
+  std::shared_ptr<igl::IBuffer> createBuffer(igl::IDevice& device,
+                                             igl::BufferDesc::BufferType type,
+                                             size_t length,
+                                             igl::Result& outResult) const;
+
+  std::array<Frame, kNumFrames> frames_;
+  uint32_t currentFrame_ = kNumFrames - 1;
+  std::vector<uint8_t> vertexStaging_;
+  std::vector<uint8_t> indexStaging_;
+  size_t vertexCapacity_ = 0;
+  size_t indexCapacity_ = 0;
+  std::string debugName_;
+};
+
+} // namespace iglu::vertexdata
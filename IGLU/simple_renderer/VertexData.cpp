@@ -80,9 +80,8 @@ void VertexData::draw(igl::IRenderCommandEncoder& commandEncoder) {
   if (primitiveDesc_.numEntries == 0) {
     return;
   }
-  // Assumption: we don't need buffer offset
   if (vb_) {
-    commandEncoder.bindVertexBuffer(0, *vb_);
+    commandEncoder.bindVertexBuffer(0, *vb_, primitiveDesc_.vertexBufferOffset);
   }
 
   if (ib_) {
@@ -20,6 +20,9 @@ struct PrimitiveDesc {
   size_t numEntries = 0;
   size_t offset = 0;
   igl::WindingMode frontFaceWinding = igl::WindingMode::CounterClockwise;
+  /// Byte offset at which the vertex buffer is bound. Acts as the base vertex of the draw, e.g.
+  /// for geometry sub-allocated from a TransientGeometryArena.
+  size_t vertexBufferOffset = 0;
 };
 
 /// Consolidates all vertex data input in a single place. Also handles binding and drawing.
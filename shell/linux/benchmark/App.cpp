@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+// Runs every render session listed in BenchmarkRunnerSessions.h headless on all enabled backends
+// and prints a combined performance table:
+//
+//   IGLShellBenchmarkRunner [--frames N] [--warmup N] [--seed N] [--filter Name1,Name2]
+//                           [--backends vulkan,opengl] [--viewport-size WxH] [--report file.csv]
+
+#include <igl/Macros.h>
+
+#if IGL_BACKEND_OPENGL
+#if IGL_PLATFORM_LINUX_USE_EGL
+#include <igl/opengl/egl/HWDevice.h>
+#else
+#include <igl/opengl/glx/HWDevice.h>
+#endif // IGL_PLATFORM_LINUX_USE_EGL
+#endif // IGL_BACKEND_OPENGL
+
+#include <BenchmarkRunnerSessions.h> // generated by CMake
+#include <cstdio>
+#include <memory>
+#include <shell/shared/platform/win/PlatformWin.h>
+#include <shell/shared/renderSession/BenchmarkRunner.h>
+#include <shell/shared/renderSession/RenderSessionRegistry.hpp>
+#include <shell/shared/renderSession/ShellParams.h>
+#include <igl/Core.h>
+#include <igl/IGL.h>
+
+#if IGL_BACKEND_OPENGL
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#endif // IGL_BACKEND_OPENGL
+
+#if IGL_BACKEND_VULKAN
+#include <igl/vulkan/HWDevice.h>
+#include <igl/vulkan/PlatformDevice.h>
+#include <igl/vulkan/VulkanContext.h>
+#endif // IGL_BACKEND_VULKAN
+
+using namespace igl;
+namespace igl::shell {
+
+// defined in the loader translation units generated for every session
+#define IGL_DECLARE_BENCHMARK_SESSION(name) \
+  std::unique_ptr<RenderSession> createBenchmarkSession_##name(std::shared_ptr<Platform> platform);
+IGL_BENCHMARK_RUNNER_SESSIONS(IGL_DECLARE_BENCHMARK_SESSION)
+#undef IGL_DECLARE_BENCHMARK_SESSION
+
+namespace {
+
+void registerSessions(RenderSessionRegistry& registry) {
+#define IGL_REGISTER_BENCHMARK_SESSION(name) \
+  registry.registerLoader(#name, createBenchmarkSession_##name);
+  IGL_BENCHMARK_RUNNER_SESSIONS(IGL_REGISTER_BENCHMARK_SESSION)
+#undef IGL_REGISTER_BENCHMARK_SESSION
+}
+
+#if IGL_BACKEND_VULKAN
+BenchmarkRunnerBackend createVulkanBackend(const BenchmarkRunnerParams& params) {
+  return {
+      .name = "vulkan",
+      .createPlatform = [width = params.width,
+                         height = params.height]() -> std::shared_ptr<Platform> {
+        // validation layers would dominate the frame times
+        const igl::vulkan::VulkanContextConfig cfg = {
+            .enableValidation = false,
+            .headless = true,
+        };
+        auto ctx = vulkan::HWDevice::createContext(cfg, nullptr);
+        if (!ctx) {
+          return nullptr;
+        }
+
+        // Prioritize discrete GPUs. If not found, use any that is available (lavapipe etc)
+        std::vector<HWDeviceDesc> devices;
+        for (const HWDeviceType type : {HWDeviceType::DiscreteGpu,
+                                        HWDeviceType::IntegratedGpu,
+                                        HWDeviceType::SoftwareGpu}) {
+          if (devices.empty()) {
+            devices = vulkan::HWDevice::queryDevices(*ctx, HWDeviceQueryDesc(type), nullptr);
+          }
+        }
+        if (devices.empty()) {
+          return nullptr;
+        }
+        std::shared_ptr<IDevice> device =
+            vulkan::HWDevice::create(std::move(ctx), devices[0], width, height);
+        return device ? std::make_shared<PlatformWin>(std::move(device)) : nullptr;
+      },
+      .createSurfaceTextures = [width = params.width,
+                                height = params.height](Platform& platform) -> SurfaceTextures {
+        const auto* platformDevice =
+            platform.getDevice().getPlatformDevice<igl::vulkan::PlatformDevice>();
+        Result ret;
+        auto color = platformDevice->createTextureFromNativeDrawable(&ret);
+        IGL_DEBUG_ASSERT(ret.isOk());
+        auto depth = platformDevice->createTextureFromNativeDepth(width, height, &ret);
+        IGL_DEBUG_ASSERT(ret.isOk());
+        return SurfaceTextures{.color = std::move(color), .depth = std::move(depth)};
+      },
+  };
+}
+#endif // IGL_BACKEND_VULKAN
+
+#if IGL_BACKEND_OPENGL
+BenchmarkRunnerBackend createOpenGLBackend(const BenchmarkRunnerParams& params) {
+#if IGL_PLATFORM_LINUX_USE_EGL
+  using HWDevice = igl::opengl::egl::HWDevice;
+#else
+  using HWDevice = igl::opengl::glx::HWDevice;
+#endif // IGL_PLATFORM_LINUX_USE_EGL
+
+  return {
+      .name = "opengl",
+      .createPlatform = [width = params.width,
+                         height = params.height]() -> std::shared_ptr<Platform> {
+        HWDevice hwDevice;
+        auto context = hwDevice.createOffscreenContext(width, height, nullptr);
+        if (!context) {
+          return nullptr;
+        }
+        std::shared_ptr<IDevice> device = hwDevice.createWithContext(std::move(context), nullptr);
+        return device ? std::make_shared<PlatformWin>(std::move(device)) : nullptr;
+      },
+      .createSurfaceTextures = [width = params.width,
+                                height = params.height](Platform& platform) -> SurfaceTextures {
+        auto& device = static_cast<igl::opengl::Device&>(platform.getDevice());
+        device.getContext().setCurrent();
+        TextureDesc desc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                              width,
+                                              height,
+                                              TextureDesc::TextureUsageBits::Attachment |
+                                                  TextureDesc::TextureUsageBits::Sampled);
+        auto color = device.createTexture(desc, nullptr);
+        desc.format = TextureFormat::Z_UNorm24;
+        desc.usage = TextureDesc::TextureUsageBits::Attachment;
+        auto depth = device.createTexture(desc, nullptr);
+        return SurfaceTextures{.color = std::move(color), .depth = std::move(depth)};
+      },
+  };
+}
+#endif // IGL_BACKEND_OPENGL
+
+} // namespace
+} // namespace igl::shell
+
+int main(int argc, char* argv[]) {
+  igl::shell::Platform::initializeCommandLineArgs(argc, argv);
+
+  igl::shell::BenchmarkRunnerParams params;
+  if (!igl::shell::parseBenchmarkRunnerParams(igl::shell::convertArgvToParams(argc, argv),
+                                              params)) {
+    return -1;
+  }
+
+  igl::shell::RenderSessionRegistry registry;
+  igl::shell::registerSessions(registry);
+
+  igl::shell::BenchmarkRunner runner(registry, params);
+  if (runner.getSessionNames().empty()) {
+    IGL_LOG_ERROR("[IGL Benchmark] No session matches the filter '%s'\n", params.filter.c_str());
+    return -1;
+  }
+
+#if IGL_BACKEND_VULKAN
+  runner.run(igl::shell::createVulkanBackend(params));
+#endif // IGL_BACKEND_VULKAN
+#if IGL_BACKEND_OPENGL
+  runner.run(igl::shell::createOpenGLBackend(params));
+#endif // IGL_BACKEND_OPENGL
+
+  const std::string table = igl::shell::formatBenchmarkRunnerTable(runner.getResults());
+  std::printf("%s", table.c_str());
+
+  if (!params.reportPath.empty() &&
+      !igl::shell::writeBenchmarkRunnerReport(runner.getResults(), params.reportPath)) {
+    IGL_LOG_ERROR("[IGL Benchmark] Could not write %s\n", params.reportPath.c_str());
+    return -1;
+  }
+
+  return runner.getResults().empty() ? -1 : 0;
+}
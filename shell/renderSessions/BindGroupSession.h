@@ -18,10 +18,6 @@
 
 namespace igl::shell {
 
-struct VertexFormat {
-  glm::mat4 mvpMatrix;
-};
-
 class BindGroupSession : public RenderSession {
  public:
   explicit BindGroupSession(std::shared_ptr<Platform> platform);
@@ -29,6 +25,10 @@ class BindGroupSession : public RenderSession {
   void update(SurfaceTextures surfaceTextures) noexcept override;
 
  private:
+  struct VertexFormat {
+    glm::mat4 mvpMatrix;
+  };
+
   RenderPassDesc renderPass_;
   FramebufferDesc framebufferDesc_;
   std::shared_ptr<IRenderPipelineState> pipelineState_;
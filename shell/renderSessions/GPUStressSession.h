@@ -21,12 +21,6 @@
 
 namespace igl::shell {
 
-struct VertexFormat {
-  glm::mat4 projectionMatrix;
-  glm::mat4 modelViewMatrix;
-  float scaleZ{};
-};
-
 class GPUStressSession : public RenderSession {
  public:
   explicit GPUStressSession(std::shared_ptr<Platform> platform);
@@ -70,6 +64,12 @@ class GPUStressSession : public RenderSession {
   [[nodiscard]] bool getRotateCubes() const;
 
  private:
+  struct VertexFormat {
+    glm::mat4 projectionMatrix;
+    glm::mat4 modelViewMatrix;
+    float scaleZ{};
+  };
+
   struct VertexPosUvw {
     glm::vec3 position;
     glm::vec4 uvw;
@@ -17,11 +17,6 @@
 
 namespace igl::shell {
 
-struct VertexFormat {
-  glm::mat4 mvpMatrix;
-  float scaleZ{};
-};
-
 class Textured3DCubeSession : public RenderSession {
  public:
   explicit Textured3DCubeSession(std::shared_ptr<Platform> platform) :
@@ -30,6 +25,11 @@ class Textured3DCubeSession : public RenderSession {
   void update(SurfaceTextures surfaceTextures) noexcept override;
 
  private:
+  struct VertexFormat {
+    glm::mat4 mvpMatrix;
+    float scaleZ{};
+  };
+
   RenderPassDesc renderPass_;
   std::shared_ptr<IRenderPipelineState> pipelineState_;
   std::shared_ptr<IVertexInputState> vertexInput0_;
@@ -20,13 +20,13 @@
 
 namespace igl::shell {
 
+namespace {
+
 struct VertexPosUv {
   iglu::simdtypes::float3 position;
   iglu::simdtypes::float2 uv;
 };
 
-namespace {
-
 constexpr VertexPosUv kVertexData[] = {
     {.position = {-1.f, 1.f, 0.0}, .uv = {0.0, 0.0}},
     {.position = {1.f, 1.f, 0.0}, .uv = {1.0, 0.0}},
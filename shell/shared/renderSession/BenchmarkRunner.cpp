@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <shell/shared/renderSession/BenchmarkRunner.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <utility>
+#include <shell/shared/renderSession/AppParams.h>
+#include <shell/shared/renderSession/RenderSession.h>
+#include <igl/Core.h>
+
+namespace igl::shell {
+
+namespace {
+
+bool parseUint(const std::string& value, uint32_t& outValue) {
+  char* end = nullptr;
+  const unsigned long v = std::strtoul(value.c_str(), &end, 10);
+  if (value.empty() || *end != '\0' || v > std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+  outValue = static_cast<uint32_t>(v);
+  return true;
+}
+
+bool endsWith(const std::string& str, const std::string& suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+bool parseBenchmarkRunnerParams(const std::vector<std::string>& args,
+                                BenchmarkRunnerParams& outParams) {
+  // args[0] is the program name
+  for (size_t i = 1; i < args.size(); i++) {
+    const std::string& arg = args[i];
+    if (i + 1 >= args.size()) {
+      IGL_LOG_ERROR("[IGL Benchmark] Missing value for %s\n", arg.c_str());
+      return false;
+    }
+    const std::string& value = args[++i];
+
+    bool ok = true;
+    if (arg == "--frames") {
+      ok = parseUint(value, outParams.numFrames) && outParams.numFrames > 0;
+    } else if (arg == "--warmup") {
+      ok = parseUint(value, outParams.numWarmupFrames);
+    } else if (arg == "--seed") {
+      ok = parseUint(value, outParams.seed);
+    } else if (arg == "--filter") {
+      outParams.filter = value;
+    } else if (arg == "--backends") {
+      outParams.backends = value;
+    } else if (arg == "--report") {
+      outParams.reportPath = value;
+    } else if (arg == "--viewport-size") {
+      unsigned int w = 0;
+      unsigned int h = 0;
+      ok = std::sscanf(value.c_str(), "%ux%u", &w, &h) == 2 && w && h;
+      outParams.width = ok ? w : outParams.width;
+      outParams.height = ok ? h : outParams.height;
+    } else {
+      IGL_LOG_ERROR("[IGL Benchmark] Unknown argument %s\n", arg.c_str());
+      return false;
+    }
+    if (!ok) {
+      IGL_LOG_ERROR("[IGL Benchmark] Invalid value for %s: %s\n", arg.c_str(), value.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+bool matchesBenchmarkFilter(const std::string& name, const std::string& filter) {
+  if (filter.empty()) {
+    return true;
+  }
+  size_t begin = 0;
+  while (begin <= filter.size()) {
+    size_t end = filter.find(',', begin);
+    if (end == std::string::npos) {
+      end = filter.size();
+    }
+    if (end > begin && name.find(filter.substr(begin, end - begin)) != std::string::npos) {
+      return true;
+    }
+    begin = end + 1;
+  }
+  return false;
+}
+
+BenchmarkRunner::BenchmarkRunner(RenderSessionRegistry& registry, BenchmarkRunnerParams params) :
+  registry_(registry), params_(std::move(params)) {
+  shellParams_.isHeadless = true;
+  // headless swapchains discard presented images, but sessions have to present to get new ones
+  shellParams_.shouldPresent = true;
+  shellParams_.viewportSize = glm::vec2(params_.width, params_.height);
+
+  BenchmarkRenderSessionParams benchmarkParams;
+  benchmarkParams.benchmarkDurationMs = 0;
+  benchmarkParams.reportIntervalMs = std::numeric_limits<size_t>::max();
+  // keep every measured frame so that the percentiles are exact
+  benchmarkParams.renderTimeBufferSize = params_.numFrames;
+  shellParams_.benchmarkParams = benchmarkParams;
+}
+
+std::vector<std::string> BenchmarkRunner::getSessionNames() const {
+  std::vector<std::string> names;
+  for (std::string& name : registry_.loaderNames()) {
+    if (matchesBenchmarkFilter(name, params_.filter)) {
+      names.push_back(std::move(name));
+    }
+  }
+  return names;
+}
+
+size_t BenchmarkRunner::run(const BenchmarkRunnerBackend& backend) {
+  if (!matchesBenchmarkFilter(backend.name, params_.backends)) {
+    return 0;
+  }
+
+  size_t numSessions = 0;
+  for (const std::string& name : getSessionNames()) {
+    if (runSession(name, backend)) {
+      numSessions++;
+    }
+  }
+  return numSessions;
+}
+
+bool BenchmarkRunner::runSession(const std::string& sessionName,
+                                 const BenchmarkRunnerBackend& backend) {
+  IGL_LOG_INFO("[IGL Benchmark] Running %s on %s\n", sessionName.c_str(), backend.name.c_str());
+
+  std::shared_ptr<Platform> platform = backend.createPlatform();
+  if (!platform) {
+    IGL_LOG_ERROR("[IGL Benchmark] Could not create the %s platform\n", backend.name.c_str());
+    return false;
+  }
+
+  // NOLINTNEXTLINE(cert-msc51-cpp)
+  std::srand(params_.seed);
+
+  std::unique_ptr<RenderSession> session = registry_.findLoader(sessionName)(platform);
+  if (!session) {
+    IGL_LOG_ERROR("[IGL Benchmark] Could not create %s\n", sessionName.c_str());
+    return false;
+  }
+  session->setShellParams(shellParams_);
+  session->setBenchmarkSessionName(sessionName);
+  session->initialize();
+
+  BenchmarkRunnerResult result = {
+      .sessionName = sessionName,
+      .backendName = backend.name,
+  };
+
+  // runUpdate() records the interval of a frame when the next frame starts: the tracker is reset
+  // when the first measured frame has started, and one more frame ends the last measured one
+  const uint32_t numUpdates = params_.numWarmupFrames + params_.numFrames + 1;
+  for (uint32_t frame = 0; frame != numUpdates; frame++) {
+    if (session->appParams().exitRequested) {
+      IGL_LOG_ERROR("[IGL Benchmark] %s requested exit after %u frames\n",
+                    sessionName.c_str(),
+                    frame);
+      result.completed = false;
+      break;
+    }
+    if (frame == params_.numWarmupFrames + 1) {
+      session->getBenchmarkTracker()->reset();
+    }
+    session->runUpdate(backend.createSurfaceTextures(*platform));
+  }
+
+  if (BenchmarkTracker* tracker = session->getBenchmarkTracker()) {
+    tracker->recordDeviceCounters(platform->getDevice());
+    result.stats = tracker->computeStats();
+  }
+
+  session->teardown();
+  session.reset();
+
+  results_.push_back(std::move(result));
+  return true;
+}
+
+std::string formatBenchmarkRunnerTable(const std::vector<BenchmarkRunnerResult>& results) {
+  char line[256];
+  std::snprintf(line,
+                sizeof(line),
+                "%-32s %-8s %7s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n",
+                "Session",
+                "Backend",
+                "Frames",
+                "Avg ms",
+                "P50 ms",
+                "P90 ms",
+                "P99 ms",
+                "Max ms",
+                "Avg FPS",
+                "GPU ms",
+                "GPU lat",
+                "Draws");
+  std::string table = line;
+  table += std::string(table.size() - 1, '-') + "\n";
+
+  for (const BenchmarkRunnerResult& r : results) {
+    const RenderTimeStats& s = r.stats;
+    std::snprintf(line,
+                  sizeof(line),
+                  "%-32s %-8s %7zu %8.3f %8.3f %8.3f %8.3f %8.3f %8.1f %8.3f %8.3f %8.1f%s\n",
+                  r.sessionName.c_str(),
+                  r.backendName.c_str(),
+                  s.totalSamples,
+                  s.avgRenderTimeMs,
+                  s.p50RenderTimeMs,
+                  s.p90RenderTimeMs,
+                  s.p99RenderTimeMs,
+                  s.maxRenderTimeMs,
+                  s.avgFps,
+                  s.avgGpuTimeMs,
+                  s.avgGpuLatencyMs,
+                  s.avgDrawCallsPerFrame,
+                  r.completed ? "" : " (incomplete)");
+    table += line;
+  }
+  return table;
+}
+
+std::string formatBenchmarkRunnerCsv(const std::vector<BenchmarkRunnerResult>& results) {
+  std::string csv = getBenchmarkStatsCsvHeader() + "\n";
+  for (const BenchmarkRunnerResult& r : results) {
+    csv += formatBenchmarkStatsCsv(r.stats, r.sessionName + "/" + r.backendName) + "\n";
+  }
+  return csv;
+}
+
+bool writeBenchmarkRunnerReport(const std::vector<BenchmarkRunnerResult>& results,
+                                const std::string& path) {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  file << (endsWith(path, ".csv") ? formatBenchmarkRunnerCsv(results)
+                                  : formatBenchmarkRunnerTable(results));
+  return file.good();
+}
+
+} // namespace igl::shell
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <shell/shared/platform/Platform.h>
+#include <shell/shared/renderSession/BenchmarkTracker.h>
+#include <shell/shared/renderSession/RenderSessionRegistry.hpp>
+#include <shell/shared/renderSession/ShellParams.h>
+
+namespace igl::shell {
+
+struct BenchmarkRunnerParams {
+  /// @brief Frames rendered by every session before the measurement starts
+  uint32_t numWarmupFrames = 60;
+
+  /// @brief Frames measured per session and backend
+  uint32_t numFrames = 600;
+
+  /// @brief Passed to std::srand() before every session is created
+  uint32_t seed = 1;
+
+  /// @brief Comma-separated substrings; a session runs if its name contains any of them.
+  /// Empty = all sessions
+  std::string filter;
+
+  /// @brief Comma-separated backend names to run on. Empty = all backends
+  std::string backends;
+
+  /// @brief Path of the combined report; CSV if it ends with ".csv", a text table otherwise.
+  /// Empty = none
+  std::string reportPath;
+
+  uint32_t width = 1024;
+  uint32_t height = 768;
+};
+
+/// @brief Parses "--frames", "--warmup", "--seed", "--filter", "--backends", "--report" and
+/// "--viewport-size WxH". Returns false if an argument is unknown or has no valid value.
+[[nodiscard]] bool parseBenchmarkRunnerParams(const std::vector<std::string>& args,
+                                              BenchmarkRunnerParams& outParams);
+
+/// @brief Returns true if `name` contains any of the comma-separated substrings in `filter`, or
+/// if the filter is empty
+[[nodiscard]] bool matchesBenchmarkFilter(const std::string& name, const std::string& filter);
+
+struct BenchmarkRunnerResult {
+  std::string sessionName;
+  std::string backendName;
+  RenderTimeStats stats;
+  /// @brief False if the session requested exit before all frames were rendered
+  bool completed = true;
+};
+
+/// @brief A backend on which the runner creates a fresh platform for every session
+struct BenchmarkRunnerBackend {
+  std::string name;
+  std::function<std::shared_ptr<Platform>()> createPlatform;
+  std::function<SurfaceTextures(Platform& platform)> createSurfaceTextures;
+};
+
+/**
+ * @brief Runs the render sessions of a registry one after another on headless backends and
+ * collects their frame statistics.
+ *
+ * Every session is created on its own platform after seeding std::rand(), renders
+ * numWarmupFrames frames, then numFrames measured frames through RenderSession::runUpdate().
+ * The statistics come from the session's BenchmarkTracker, which is reset after the warm-up.
+ */
+class BenchmarkRunner final {
+ public:
+  BenchmarkRunner(RenderSessionRegistry& registry, BenchmarkRunnerParams params);
+
+  /// @brief The registered sessions which pass the filter, sorted by name
+  [[nodiscard]] std::vector<std::string> getSessionNames() const;
+
+  /// @brief Runs all sessions returned by getSessionNames() on `backend`, unless the backend is
+  /// filtered out. Returns the number of sessions which ran.
+  size_t run(const BenchmarkRunnerBackend& backend);
+
+  [[nodiscard]] const std::vector<BenchmarkRunnerResult>& getResults() const noexcept {
+    return results_;
+  }
+
+ private:
+  bool runSession(const std::string& sessionName, const BenchmarkRunnerBackend& backend);
+
+  RenderSessionRegistry& registry_;
+  BenchmarkRunnerParams params_;
+  ShellParams shellParams_;
+  std::vector<BenchmarkRunnerResult> results_;
+};
+
+/// @brief Formats the results as a table with one row per session and backend
+[[nodiscard]] std::string formatBenchmarkRunnerTable(
+    const std::vector<BenchmarkRunnerResult>& results);
+
+/// @brief Formats the results as CSV; the session column is "<session>/<backend>"
+[[nodiscard]] std::string formatBenchmarkRunnerCsv(
+    const std::vector<BenchmarkRunnerResult>& results);
+
+/// @brief Writes the results to `path`: CSV if it ends with ".csv", the table otherwise
+bool writeBenchmarkRunnerReport(const std::vector<BenchmarkRunnerResult>& results,
+                                const std::string& path);
+
+} // namespace igl::shell
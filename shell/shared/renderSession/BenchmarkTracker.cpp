@@ -8,16 +8,169 @@
 #include <shell/shared/renderSession/BenchmarkTracker.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <sstream>
 #include <type_traits>
+#include <utility>
+#include <igl/Device.h>
+#include <igl/TimestampQueries.h>
 
 static_assert(std::is_trivially_copyable_v<igl::shell::RenderTimeOverflowRecord>);
 static_assert(std::is_trivially_copyable_v<igl::shell::RenderTimeStats>);
 
 namespace igl::shell {
 
+namespace {
+
+// 1-based nearest rank; the epsilon keeps e.g. 99.9% of 1000 samples at rank 999
+size_t getPercentileRank(double percentile, size_t count) {
+  const auto rank =
+      static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(count) - 1e-9));
+  return std::clamp<size_t>(rank, 1, count);
+}
+
+double getPercentileOfSorted(const std::vector<double>& sorted, double percentile) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  return sorted[getPercentileRank(percentile, sorted.size()) - 1];
+}
+
+void setPercentilesOfSorted(const std::vector<double>& sorted, RenderTimeStats& stats) {
+  stats.p50RenderTimeMs = getPercentileOfSorted(sorted, 50.0);
+  stats.p90RenderTimeMs = getPercentileOfSorted(sorted, 90.0);
+  stats.p99RenderTimeMs = getPercentileOfSorted(sorted, 99.0);
+  stats.p999RenderTimeMs = getPercentileOfSorted(sorted, 99.9);
+}
+
+// metrics written to JSON/CSV reports, in this order
+constexpr std::pair<const char*, double RenderTimeStats::*> kReportMetrics[] = {
+    {"avgRenderTimeMs", &RenderTimeStats::avgRenderTimeMs},
+    {"minRenderTimeMs", &RenderTimeStats::minRenderTimeMs},
+    {"maxRenderTimeMs", &RenderTimeStats::maxRenderTimeMs},
+    {"p50RenderTimeMs", &RenderTimeStats::p50RenderTimeMs},
+    {"p90RenderTimeMs", &RenderTimeStats::p90RenderTimeMs},
+    {"p99RenderTimeMs", &RenderTimeStats::p99RenderTimeMs},
+    {"p999RenderTimeMs", &RenderTimeStats::p999RenderTimeMs},
+    {"avgFps", &RenderTimeStats::avgFps},
+    {"minFps", &RenderTimeStats::minFps},
+    {"maxFps", &RenderTimeStats::maxFps},
+    {"avgGpuTimeMs", &RenderTimeStats::avgGpuTimeMs},
+    {"maxGpuTimeMs", &RenderTimeStats::maxGpuTimeMs},
+    {"p50GpuTimeMs", &RenderTimeStats::p50GpuTimeMs},
+    {"p90GpuTimeMs", &RenderTimeStats::p90GpuTimeMs},
+    {"p99GpuTimeMs", &RenderTimeStats::p99GpuTimeMs},
+    {"p999GpuTimeMs", &RenderTimeStats::p999GpuTimeMs},
+    {"avgGpuLatencyMs", &RenderTimeStats::avgGpuLatencyMs},
+    {"maxGpuLatencyMs", &RenderTimeStats::maxGpuLatencyMs},
+    {"p50GpuLatencyMs", &RenderTimeStats::p50GpuLatencyMs},
+    {"p90GpuLatencyMs", &RenderTimeStats::p90GpuLatencyMs},
+    {"p99GpuLatencyMs", &RenderTimeStats::p99GpuLatencyMs},
+    {"avgDrawCallsPerFrame", &RenderTimeStats::avgDrawCallsPerFrame},
+};
+
+constexpr std::pair<const char*, size_t RenderTimeStats::*> kReportCounters[] = {
+    {"totalSamples", &RenderTimeStats::totalSamples},
+    {"gpuSamples", &RenderTimeStats::gpuSamples},
+    {"gpuLatencySamples", &RenderTimeStats::gpuLatencySamples},
+    {"drawCalls", &RenderTimeStats::drawCalls},
+    {"shaderCompilations", &RenderTimeStats::shaderCompilations},
+};
+
+// lower is better for all of these. The GPU frame latency is left out: it includes idle time
+// which depends on the CPU, not on the GPU work.
+constexpr std::pair<const char*, double RenderTimeStats::*> kRegressionMetrics[] = {
+    {"avgRenderTimeMs", &RenderTimeStats::avgRenderTimeMs},
+    {"p50RenderTimeMs", &RenderTimeStats::p50RenderTimeMs},
+    {"p90RenderTimeMs", &RenderTimeStats::p90RenderTimeMs},
+    {"p99RenderTimeMs", &RenderTimeStats::p99RenderTimeMs},
+    {"avgGpuTimeMs", &RenderTimeStats::avgGpuTimeMs},
+    {"p50GpuTimeMs", &RenderTimeStats::p50GpuTimeMs},
+    {"p90GpuTimeMs", &RenderTimeStats::p90GpuTimeMs},
+    {"p99GpuTimeMs", &RenderTimeStats::p99GpuTimeMs},
+};
+
+std::string formatMetric(double value) {
+  char buffer[64];
+  std::snprintf(buffer, sizeof(buffer), "%.4f", value);
+  return {buffer};
+}
+
+// GPU time spanned by all slots, or 0 if the results are not available
+uint64_t getElapsedNanos(const ITimestampQueries& queries) {
+  if (!queries.isValid() || !queries.resultsAvailable()) {
+    return 0;
+  }
+  uint64_t elapsedNanos = queries.getFrameElapsedNanos();
+  if (elapsedNanos == 0) {
+    // backends without raw timestamps only report the elapsed time of every slot
+    for (uint32_t slot = 0; slot != queries.count(); slot++) {
+      elapsedNanos += queries.getElapsedNanos(slot);
+    }
+  }
+  return elapsedNanos;
+}
+
+std::string escapeJsonString(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buffer[8];
+      std::snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned int>(c));
+      escaped += buffer;
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+} // namespace
+
+void FrameTimeHistogram::record(double timeMs) {
+  const double octaves = timeMs > kMinTimeMs ? std::log2(timeMs / kMinTimeMs) : 0.0;
+  const auto bucket =
+      std::min(static_cast<size_t>(octaves * static_cast<double>(kBucketsPerOctave)),
+               kNumBuckets - 1);
+  buckets_[bucket]++;
+  count_++;
+  minTimeMs_ = std::min(minTimeMs_, timeMs);
+  maxTimeMs_ = std::max(maxTimeMs_, timeMs);
+}
+
+void FrameTimeHistogram::reset() {
+  buckets_.fill(0);
+  count_ = 0;
+  minTimeMs_ = std::numeric_limits<double>::max();
+  maxTimeMs_ = 0.0;
+}
+
+double FrameTimeHistogram::getPercentile(double percentile) const {
+  if (count_ == 0) {
+    return 0.0;
+  }
+  const size_t rank = getPercentileRank(percentile, count_);
+  size_t numSamples = 0;
+  for (size_t i = 0; i != kNumBuckets; i++) {
+    numSamples += buckets_[i];
+    if (numSamples >= rank) {
+      // the geometric center of the bucket
+      const double value =
+          kMinTimeMs * std::exp2((static_cast<double>(i) + 0.5) / kBucketsPerOctave);
+      return std::clamp(value, minTimeMs_, maxTimeMs_);
+    }
+  }
+  return maxTimeMs_;
+}
+
 BenchmarkTracker::BenchmarkTracker(size_t bufferSize) : bufferCapacity_(bufferSize) {
   circularBuffer_.resize(bufferCapacity_, 0.0);
   reset();
@@ -48,6 +201,52 @@ void BenchmarkTracker::recordRenderTime(double renderTimeMs) {
   // Update running statistics
   runningSum_ += renderTimeMs;
   totalSampleCount_++;
+  renderTimeHistogram_.record(renderTimeMs);
+}
+
+void BenchmarkTracker::recordGpuTime(double gpuTimeMs) {
+  gpuTimeHistogram_.record(gpuTimeMs);
+  gpuTimeSum_ += gpuTimeMs;
+  maxGpuTimeMs_ = std::max(maxGpuTimeMs_, gpuTimeMs);
+}
+
+bool BenchmarkTracker::recordGpuTime(const ITimestampQueries& queries) {
+  const uint64_t elapsedNanos = getElapsedNanos(queries);
+  if (elapsedNanos == 0) {
+    return false;
+  }
+  recordGpuTime(static_cast<double>(elapsedNanos) / 1e6);
+  return true;
+}
+
+void BenchmarkTracker::recordGpuLatency(double gpuLatencyMs) {
+  gpuLatencyHistogram_.record(gpuLatencyMs);
+  gpuLatencySum_ += gpuLatencyMs;
+  maxGpuLatencyMs_ = std::max(maxGpuLatencyMs_, gpuLatencyMs);
+}
+
+bool BenchmarkTracker::recordGpuLatency(const ITimestampQueries& queries) {
+  const uint64_t elapsedNanos = getElapsedNanos(queries);
+  if (elapsedNanos == 0) {
+    return false;
+  }
+  recordGpuLatency(static_cast<double>(elapsedNanos) / 1e6);
+  return true;
+}
+
+void BenchmarkTracker::recordDeviceCounters(size_t drawCount, size_t shaderCompilationCount) {
+  if (!hasDeviceCounters_) {
+    hasDeviceCounters_ = true;
+    baseDrawCount_ = drawCount;
+    baseShaderCompilationCount_ = shaderCompilationCount;
+  }
+  drawCount_ = drawCount - std::min(drawCount, baseDrawCount_);
+  shaderCompilationCount_ =
+      shaderCompilationCount - std::min(shaderCompilationCount, baseShaderCompilationCount_);
+}
+
+void BenchmarkTracker::recordDeviceCounters(const IDevice& device) {
+  recordDeviceCounters(device.getCurrentDrawCount(), device.getShaderCompilationCount());
 }
 
 void BenchmarkTracker::flushBufferToOverflow() {
@@ -120,6 +319,43 @@ RenderTimeStats BenchmarkTracker::computeStats() const {
   stats.hiccupThresholdMs = stats.avgRenderTimeMs * hiccupMultiplier_;
   stats.hasHiccup = lastFrameWasHiccup_;
 
+  // Percentiles are exact while all samples fit into the buffer
+  if (overflowRecords_.empty()) {
+    std::vector<double> sorted(circularBuffer_.begin(),
+                               circularBuffer_.begin() + static_cast<ptrdiff_t>(bufferCount_));
+    std::sort(sorted.begin(), sorted.end());
+    setPercentilesOfSorted(sorted, stats);
+  } else {
+    stats.p50RenderTimeMs = renderTimeHistogram_.getPercentile(50.0);
+    stats.p90RenderTimeMs = renderTimeHistogram_.getPercentile(90.0);
+    stats.p99RenderTimeMs = renderTimeHistogram_.getPercentile(99.0);
+    stats.p999RenderTimeMs = renderTimeHistogram_.getPercentile(99.9);
+  }
+
+  stats.gpuSamples = gpuTimeHistogram_.getCount();
+  if (stats.gpuSamples) {
+    stats.avgGpuTimeMs = gpuTimeSum_ / static_cast<double>(stats.gpuSamples);
+    stats.maxGpuTimeMs = maxGpuTimeMs_;
+    stats.p50GpuTimeMs = gpuTimeHistogram_.getPercentile(50.0);
+    stats.p90GpuTimeMs = gpuTimeHistogram_.getPercentile(90.0);
+    stats.p99GpuTimeMs = gpuTimeHistogram_.getPercentile(99.0);
+    stats.p999GpuTimeMs = gpuTimeHistogram_.getPercentile(99.9);
+  }
+
+  stats.gpuLatencySamples = gpuLatencyHistogram_.getCount();
+  if (stats.gpuLatencySamples) {
+    stats.avgGpuLatencyMs = gpuLatencySum_ / static_cast<double>(stats.gpuLatencySamples);
+    stats.maxGpuLatencyMs = maxGpuLatencyMs_;
+    stats.p50GpuLatencyMs = gpuLatencyHistogram_.getPercentile(50.0);
+    stats.p90GpuLatencyMs = gpuLatencyHistogram_.getPercentile(90.0);
+    stats.p99GpuLatencyMs = gpuLatencyHistogram_.getPercentile(99.0);
+  }
+
+  stats.drawCalls = drawCount_;
+  stats.avgDrawCallsPerFrame =
+      static_cast<double>(drawCount_) / static_cast<double>(totalSampleCount_);
+  stats.shaderCompilations = shaderCompilationCount_;
+
   return stats;
 }
 
@@ -155,6 +391,11 @@ RenderTimeStats BenchmarkTracker::computeRecentStats() const {
   stats.hiccupThresholdMs = stats.avgRenderTimeMs * hiccupMultiplier_;
   stats.hasHiccup = lastFrameWasHiccup_;
 
+  std::vector<double> sorted(circularBuffer_.begin(),
+                             circularBuffer_.begin() + static_cast<ptrdiff_t>(bufferCount_));
+  std::sort(sorted.begin(), sorted.end());
+  setPercentilesOfSorted(sorted, stats);
+
   return stats;
 }
 
@@ -195,6 +436,18 @@ void BenchmarkTracker::reset() {
   totalSampleCount_ = 0;
   lastFrameWasHiccup_ = false;
   lastRenderTimeMs_ = 0.0;
+  renderTimeHistogram_.reset();
+  gpuTimeHistogram_.reset();
+  gpuTimeSum_ = 0.0;
+  maxGpuTimeMs_ = 0.0;
+  gpuLatencyHistogram_.reset();
+  gpuLatencySum_ = 0.0;
+  maxGpuLatencyMs_ = 0.0;
+  hasDeviceCounters_ = false;
+  baseDrawCount_ = 0;
+  baseShaderCompilationCount_ = 0;
+  drawCount_ = 0;
+  shaderCompilationCount_ = 0;
   startTime_ = std::chrono::steady_clock::now();
   lastReportTime_ = startTime_;
 }
@@ -313,6 +566,72 @@ std::string generateFinalBenchmarkReport(const BenchmarkTracker& tracker, bool w
                 stats.maxRenderTimeMs);
   oss << line << "║\n";
 
+  auto padLine = [&oss, &line]() {
+    oss << line;
+    for (size_t i = std::strlen(line); i < 80; ++i) {
+      oss << " ";
+    }
+    oss << "║\n";
+  };
+
+  std::snprintf(line,
+                sizeof(line),
+                "║    p50/p90/p99/p99.9: %.2f / %.2f / %.2f / %.2f ms",
+                stats.p50RenderTimeMs,
+                stats.p90RenderTimeMs,
+                stats.p99RenderTimeMs,
+                stats.p999RenderTimeMs);
+  padLine();
+
+  if (stats.gpuSamples) {
+    oss << "╠══════════════════════════════════════════════════════════════════════════════╣\n";
+    oss << "║  GPU Time Statistics:                                                        ║\n";
+    std::snprintf(line,
+                  sizeof(line),
+                  "║    Average: %.2f ms, Maximum: %.2f ms (%zu frames)",
+                  stats.avgGpuTimeMs,
+                  stats.maxGpuTimeMs,
+                  stats.gpuSamples);
+    padLine();
+    std::snprintf(line,
+                  sizeof(line),
+                  "║    p50/p90/p99/p99.9: %.2f / %.2f / %.2f / %.2f ms",
+                  stats.p50GpuTimeMs,
+                  stats.p90GpuTimeMs,
+                  stats.p99GpuTimeMs,
+                  stats.p999GpuTimeMs);
+    padLine();
+  }
+
+  if (stats.gpuLatencySamples) {
+    oss << "╠══════════════════════════════════════════════════════════════════════════════╣\n";
+    oss << "║  GPU Frame Latency Statistics:                                               ║\n";
+    std::snprintf(line,
+                  sizeof(line),
+                  "║    Average: %.2f ms, Maximum: %.2f ms (%zu frames)",
+                  stats.avgGpuLatencyMs,
+                  stats.maxGpuLatencyMs,
+                  stats.gpuLatencySamples);
+    padLine();
+    std::snprintf(line,
+                  sizeof(line),
+                  "║    p50/p90/p99: %.2f / %.2f / %.2f ms",
+                  stats.p50GpuLatencyMs,
+                  stats.p90GpuLatencyMs,
+                  stats.p99GpuLatencyMs);
+    padLine();
+  }
+
+  oss << "╠══════════════════════════════════════════════════════════════════════════════╣\n";
+
+  std::snprintf(line,
+                sizeof(line),
+                "║  Draw Calls: %zu (%.1f per frame), Shader Compilations: %zu",
+                stats.drawCalls,
+                stats.avgDrawCallsPerFrame,
+                stats.shaderCompilations);
+  padLine();
+
   oss << "╠══════════════════════════════════════════════════════════════════════════════╣\n";
 
   std::snprintf(line,
@@ -327,4 +646,106 @@ std::string generateFinalBenchmarkReport(const BenchmarkTracker& tracker, bool w
   return oss.str();
 }
 
+std::string formatBenchmarkStatsJson(const RenderTimeStats& stats, const std::string& sessionName) {
+  std::ostringstream oss;
+  oss << "{\n  \"session\": \"" << escapeJsonString(sessionName) << "\"";
+  for (const auto& [name, member] : kReportCounters) {
+    oss << ",\n  \"" << name << "\": " << stats.*member;
+  }
+  for (const auto& [name, member] : kReportMetrics) {
+    oss << ",\n  \"" << name << "\": " << formatMetric(stats.*member);
+  }
+  oss << ",\n  \"hasHiccup\": " << (stats.hasHiccup ? "true" : "false") << "\n}\n";
+  return oss.str();
+}
+
+std::string getBenchmarkStatsCsvHeader() {
+  std::string header = "session";
+  for (const auto& [name, member] : kReportCounters) {
+    header += ",";
+    header += name;
+  }
+  for (const auto& [name, member] : kReportMetrics) {
+    header += ",";
+    header += name;
+  }
+  return header;
+}
+
+std::string formatBenchmarkStatsCsv(const RenderTimeStats& stats, const std::string& sessionName) {
+  std::string csv = sessionName;
+  for (const auto& [name, member] : kReportCounters) {
+    csv += "," + std::to_string(stats.*member);
+  }
+  for (const auto& [name, member] : kReportMetrics) {
+    csv += "," + formatMetric(stats.*member);
+  }
+  return csv;
+}
+
+bool writeBenchmarkReport(const RenderTimeStats& stats,
+                          const std::string& sessionName,
+                          const std::string& path) {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    return false;
+  }
+  const bool isCsv = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+  if (isCsv) {
+    file << getBenchmarkStatsCsvHeader() << "\n" << formatBenchmarkStatsCsv(stats, sessionName)
+         << "\n";
+  } else {
+    file << formatBenchmarkStatsJson(stats, sessionName);
+  }
+  return file.good();
+}
+
+bool parseBenchmarkStatsJson(const std::string& json, RenderTimeStats& outStats) {
+  // only the flat objects written by formatBenchmarkStatsJson() are supported
+  auto findValue = [&json](const char* name) -> const char* {
+    const std::string key = std::string("\"") + name + "\":";
+    const size_t pos = json.find(key);
+    return pos != std::string::npos ? json.c_str() + pos + key.size() : nullptr;
+  };
+
+  bool found = false;
+  for (const auto& [name, member] : kReportCounters) {
+    if (const char* value = findValue(name)) {
+      outStats.*member = static_cast<size_t>(std::strtoull(value, nullptr, 10));
+      found = true;
+    }
+  }
+  for (const auto& [name, member] : kReportMetrics) {
+    if (const char* value = findValue(name)) {
+      outStats.*member = std::strtod(value, nullptr);
+      found = true;
+    }
+  }
+  return found;
+}
+
+std::vector<BenchmarkRegression> compareBenchmarkStats(const RenderTimeStats& baseline,
+                                                       const RenderTimeStats& current,
+                                                       double thresholdPercent) {
+  std::vector<BenchmarkRegression> regressions;
+  for (const auto& [name, member] : kRegressionMetrics) {
+    const double baselineValue = baseline.*member;
+    const double currentValue = current.*member;
+    // skip metrics missing from either run, e.g. GPU times on backends without timestamps
+    if (baselineValue <= 0.0 || currentValue <= 0.0) {
+      continue;
+    }
+    const double changePercent = (currentValue - baselineValue) / baselineValue * 100.0;
+    if (changePercent > thresholdPercent) {
+      regressions.push_back({
+          .metric = name,
+          .baselineValue = baselineValue,
+          .currentValue = currentValue,
+          .changePercent = changePercent,
+      });
+    }
+  }
+  return regressions;
+}
+
 } // namespace igl::shell
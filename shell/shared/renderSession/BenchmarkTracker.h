@@ -7,11 +7,18 @@
 
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <limits>
 #include <string>
 #include <vector>
 
+namespace igl {
+class IDevice;
+class ITimestampQueries;
+} // namespace igl
+
 namespace igl::shell {
 
 /// @brief Stores min/max render time data when circular buffer overflows
@@ -32,6 +39,71 @@ struct RenderTimeStats {
   size_t totalSamples = 0;
   bool hasHiccup = false;
   double hiccupThresholdMs = 0.0;
+
+  // Frame time percentiles
+  double p50RenderTimeMs = 0.0;
+  double p90RenderTimeMs = 0.0;
+  double p99RenderTimeMs = 0.0;
+  double p999RenderTimeMs = 0.0;
+
+  // GPU frame time (0 if no GPU times were recorded)
+  size_t gpuSamples = 0;
+  double avgGpuTimeMs = 0.0;
+  double maxGpuTimeMs = 0.0;
+  double p50GpuTimeMs = 0.0;
+  double p90GpuTimeMs = 0.0;
+  double p99GpuTimeMs = 0.0;
+  double p999GpuTimeMs = 0.0;
+
+  // GPU frame latency: from the point a frame starts on the GPU timeline until all work submitted
+  // during the frame has completed. It includes GPU idle time while the CPU records commands, so
+  // it is not GPU cost and is not compared against baselines (0 if not measured)
+  size_t gpuLatencySamples = 0;
+  double avgGpuLatencyMs = 0.0;
+  double maxGpuLatencyMs = 0.0;
+  double p50GpuLatencyMs = 0.0;
+  double p90GpuLatencyMs = 0.0;
+  double p99GpuLatencyMs = 0.0;
+
+  // IDevice counters accumulated since the tracker was reset
+  size_t drawCalls = 0;
+  double avgDrawCallsPerFrame = 0.0;
+  size_t shaderCompilations = 0;
+};
+
+/// @brief Histogram of frame times with logarithmic buckets, used for percentiles over the whole
+/// benchmark run in constant memory. Every bucket spans 1/kBucketsPerOctave of an octave, so a
+/// percentile is accurate to about 1.1% (clamped to the exact min/max).
+class FrameTimeHistogram {
+ public:
+  static constexpr double kMinTimeMs = 0.001;
+  static constexpr size_t kBucketsPerOctave = 64;
+  static constexpr size_t kNumOctaves = 24; // up to ~16.7 seconds
+  static constexpr size_t kNumBuckets = kBucketsPerOctave * kNumOctaves;
+
+  void record(double timeMs);
+  void reset();
+
+  /// @brief Returns the frame time below which `percentile` (0..100) percent of samples lie
+  [[nodiscard]] double getPercentile(double percentile) const;
+
+  [[nodiscard]] size_t getCount() const {
+    return count_;
+  }
+
+ private:
+  std::array<uint32_t, kNumBuckets> buckets_ = {};
+  size_t count_ = 0;
+  double minTimeMs_ = std::numeric_limits<double>::max();
+  double maxTimeMs_ = 0.0;
+};
+
+/// @brief A metric of `current` which is slower than `baseline` by more than the threshold
+struct BenchmarkRegression {
+  std::string metric;
+  double baselineValue = 0.0;
+  double currentValue = 0.0;
+  double changePercent = 0.0;
 };
 
 /// @brief Tracks render times and provides benchmark statistics for IGL shell
@@ -53,6 +125,29 @@ class BenchmarkTracker {
   /// @param renderTimeMs The time in milliseconds for the render call
   void recordRenderTime(double renderTimeMs);
 
+  /// @brief Records the GPU time of a frame
+  /// @param gpuTimeMs The GPU time in milliseconds spanned by the frame
+  void recordGpuTime(double gpuTimeMs);
+
+  /// @brief Records the GPU time of a frame from ITimestampQueries::getFrameElapsedNanos(), or the
+  /// sum of the elapsed times of all slots on backends which do not report a frame time
+  /// @return false if the results are not available yet or the backend reports no time
+  bool recordGpuTime(const ITimestampQueries& queries);
+
+  /// @brief Records the GPU frame latency of a frame (see RenderTimeStats::avgGpuLatencyMs)
+  void recordGpuLatency(double gpuLatencyMs);
+
+  /// @brief Records the GPU frame latency measured by ITimestampQueries::beginFrameQuery()
+  /// @return false if the results are not available yet or the backend reports no time
+  bool recordGpuLatency(const ITimestampQueries& queries);
+
+  /// @brief Updates the draw call and shader compilation counts with the running totals of a
+  /// device. The first call after reset() only sets the baseline.
+  void recordDeviceCounters(size_t drawCount, size_t shaderCompilationCount);
+
+  /// @brief Reads IDevice::getCurrentDrawCount() and IDevice::getShaderCompilationCount()
+  void recordDeviceCounters(const IDevice& device);
+
   /// @brief Checks if it's time to generate a periodic report
   /// @return true if a report should be generated
   [[nodiscard]] bool shouldGeneratePeriodicReport() const;
@@ -121,6 +216,21 @@ class BenchmarkTracker {
 
   double runningSum_ = 0.0;
   size_t totalSampleCount_ = 0;
+  FrameTimeHistogram renderTimeHistogram_;
+
+  FrameTimeHistogram gpuTimeHistogram_;
+  double gpuTimeSum_ = 0.0;
+  double maxGpuTimeMs_ = 0.0;
+
+  FrameTimeHistogram gpuLatencyHistogram_;
+  double gpuLatencySum_ = 0.0;
+  double maxGpuLatencyMs_ = 0.0;
+
+  bool hasDeviceCounters_ = false;
+  size_t baseDrawCount_ = 0;
+  size_t baseShaderCompilationCount_ = 0;
+  size_t drawCount_ = 0;
+  size_t shaderCompilationCount_ = 0;
 
   double hiccupMultiplier_ = kDefaultHiccupMultiplier;
   bool lastFrameWasHiccup_ = false;
@@ -144,4 +254,33 @@ std::string formatBenchmarkStats(const RenderTimeStats& stats, const char* prefi
 /// @return Formatted multi-line string for the final report
 std::string generateFinalBenchmarkReport(const BenchmarkTracker& tracker, bool wasTimeout);
 
+/// @brief Formats benchmark statistics as a flat JSON object
+/// @param stats The statistics to format
+/// @param sessionName Stored in the "session" field
+std::string formatBenchmarkStatsJson(const RenderTimeStats& stats, const std::string& sessionName);
+
+/// @brief Returns the header line matching formatBenchmarkStatsCsv()
+std::string getBenchmarkStatsCsvHeader();
+
+/// @brief Formats benchmark statistics as one CSV line (see getBenchmarkStatsCsvHeader())
+std::string formatBenchmarkStatsCsv(const RenderTimeStats& stats, const std::string& sessionName);
+
+/// @brief Writes a benchmark report to `path`: CSV (header and one line) if the path ends with
+/// ".csv", JSON otherwise
+/// @return false if the file cannot be written
+bool writeBenchmarkReport(const RenderTimeStats& stats,
+                          const std::string& sessionName,
+                          const std::string& path);
+
+/// @brief Reads statistics written by formatBenchmarkStatsJson()
+/// @return false if `json` contains no known metric
+bool parseBenchmarkStatsJson(const std::string& json, RenderTimeStats& outStats);
+
+/// @brief Compares the frame time metrics (average, percentiles, GPU time) of two runs
+/// @param thresholdPercent A metric regresses if it is more than this many percent slower
+/// @return The regressed metrics; empty if there are none
+std::vector<BenchmarkRegression> compareBenchmarkStats(const RenderTimeStats& baseline,
+                                                       const RenderTimeStats& current,
+                                                       double thresholdPercent);
+
 } // namespace igl::shell
@@ -9,6 +9,8 @@
 
 #include <chrono>
 #include <cstdlib>
+#include <fstream>
+#include <sstream>
 #include <thread>
 #include <type_traits>
 #include <shell/shared/platform/DisplayContext.h>
@@ -16,6 +18,7 @@
 #include <shell/shared/renderSession/ShellParams.h>
 #include <igl/Common.h>
 #include <igl/Macros.h>
+#include <igl/TimestampQueries.h>
 #ifdef IGL_WITH_PERFETTO
 #include <shell/shared/profiling/IglPerfetto.h>
 #endif
@@ -99,6 +102,18 @@ void RenderSession::initBenchmarkTracker() noexcept {
   benchmarkTracker_->setReportInterval(benchmarkParams.reportIntervalMs);
   benchmarkTracker_->setHiccupMultiplier(benchmarkParams.hiccupMultiplier);
 
+  const IDevice& device = platform_->getDevice();
+  if (device.hasFeature(DeviceFeatures::TimestampQueries)) {
+    for (uint32_t i = 0; i != kNumBenchmarkTimestampQueries; i++) {
+      auto queries = device.createTimestampQueries(1, nullptr);
+      if (!queries) {
+        benchmarkTimestampQueries_.clear();
+        break;
+      }
+      benchmarkTimestampQueries_.push_back(std::move(queries));
+    }
+  }
+
   IGL_LOG_INFO("[IGL Benchmark] Benchmark tracking initialized\n");
   IGL_LOG_INFO("[IGL Benchmark]   Duration: %zu ms (%.1f minutes)\n",
                benchmarkParams.benchmarkDurationMs,
@@ -109,6 +124,8 @@ void RenderSession::initBenchmarkTracker() noexcept {
   IGL_LOG_INFO("[IGL Benchmark]   Hiccup Multiplier: %.1f\n", benchmarkParams.hiccupMultiplier);
   IGL_LOG_INFO("[IGL Benchmark]   Buffer Size: %zu samples\n",
                benchmarkParams.renderTimeBufferSize);
+  IGL_LOG_INFO("[IGL Benchmark]   GPU Frame Latency: %s\n",
+               benchmarkTimestampQueries_.empty() ? "unsupported" : "enabled");
 }
 
 void RenderSession::recordBenchmarkFrame(double renderTimeMs) noexcept {
@@ -126,6 +143,31 @@ void RenderSession::recordBenchmarkFrame(double renderTimeMs) noexcept {
   }
 }
 
+void RenderSession::recordBenchmarkGpuTime(const ITimestampQueries& queries) noexcept {
+  if (!benchmarkTracker_) {
+    return;
+  }
+
+  benchmarkTracker_->recordGpuTime(queries);
+}
+
+ITimestampQueries* RenderSession::beginBenchmarkLatencyQuery() noexcept {
+  if (benchmarkTimestampQueries_.empty()) {
+    return nullptr;
+  }
+
+  ITimestampQueries& queries =
+      *benchmarkTimestampQueries_[frameCount_ % benchmarkTimestampQueries_.size()];
+  if (queries.count()) {
+    // a frame whose results are still pending after all frames in flight is dropped
+    if (queries.resultsAvailable()) {
+      benchmarkTracker_->recordGpuLatency(queries);
+    }
+    queries.reset();
+  }
+  return queries.beginFrameQuery() ? &queries : nullptr;
+}
+
 void RenderSession::checkBenchmarkPeriodicReport() noexcept {
   if (!benchmarkTracker_) {
     return;
@@ -187,10 +229,78 @@ void RenderSession::logFinalBenchmarkReport(bool wasTimeout) noexcept {
   IGL_LOG_INFO("[IGL Benchmark] Average: %.2f ms\n", stats.avgRenderTimeMs);
   IGL_LOG_INFO("[IGL Benchmark] Minimum: %.2f ms\n", stats.minRenderTimeMs);
   IGL_LOG_INFO("[IGL Benchmark] Maximum: %.2f ms\n", stats.maxRenderTimeMs);
+  IGL_LOG_INFO("[IGL Benchmark] p50/p90/p99/p99.9: %.2f / %.2f / %.2f / %.2f ms\n",
+               stats.p50RenderTimeMs,
+               stats.p90RenderTimeMs,
+               stats.p99RenderTimeMs,
+               stats.p999RenderTimeMs);
+  if (stats.gpuSamples) {
+    IGL_LOG_INFO("[IGL Benchmark] ---------- GPU Time Statistics ----------\n");
+    IGL_LOG_INFO("[IGL Benchmark] Average: %.2f ms, Maximum: %.2f ms (%zu frames)\n",
+                 stats.avgGpuTimeMs,
+                 stats.maxGpuTimeMs,
+                 stats.gpuSamples);
+    IGL_LOG_INFO("[IGL Benchmark] p50/p90/p99/p99.9: %.2f / %.2f / %.2f / %.2f ms\n",
+                 stats.p50GpuTimeMs,
+                 stats.p90GpuTimeMs,
+                 stats.p99GpuTimeMs,
+                 stats.p999GpuTimeMs);
+  }
+  if (stats.gpuLatencySamples) {
+    IGL_LOG_INFO("[IGL Benchmark] ---------- GPU Frame Latency Statistics ----------\n");
+    IGL_LOG_INFO("[IGL Benchmark] Average: %.2f ms, Maximum: %.2f ms (%zu frames)\n",
+                 stats.avgGpuLatencyMs,
+                 stats.maxGpuLatencyMs,
+                 stats.gpuLatencySamples);
+    IGL_LOG_INFO("[IGL Benchmark] p50/p90/p99: %.2f / %.2f / %.2f ms\n",
+                 stats.p50GpuLatencyMs,
+                 stats.p90GpuLatencyMs,
+                 stats.p99GpuLatencyMs);
+  }
+  IGL_LOG_INFO("[IGL Benchmark] Draw Calls: %zu (%.1f per frame)\n",
+               stats.drawCalls,
+               stats.avgDrawCallsPerFrame);
+  IGL_LOG_INFO("[IGL Benchmark] Shader Compilations: %zu\n", stats.shaderCompilations);
   IGL_LOG_INFO("[IGL Benchmark] Overflow Records: %zu\n",
                benchmarkTracker_->getOverflowRecordCount());
   IGL_LOG_INFO("[IGL Benchmark] ===============================================\n");
 
+  const auto& benchmarkParams = shellParams_->benchmarkParams.value();
+
+  if (!benchmarkParams.reportPath.empty()) {
+    if (writeBenchmarkReport(stats, benchmarkSessionName_, benchmarkParams.reportPath)) {
+      IGL_LOG_INFO("[IGL Benchmark] Report written to %s\n", benchmarkParams.reportPath.c_str());
+    } else {
+      IGL_LOG_ERROR("[IGL Benchmark] Cannot write report to %s\n",
+                    benchmarkParams.reportPath.c_str());
+    }
+  }
+
+  if (!benchmarkParams.baselinePath.empty()) {
+    std::ifstream file(benchmarkParams.baselinePath);
+    std::stringstream json;
+    json << file.rdbuf();
+    RenderTimeStats baseline;
+    if (!file.is_open() || !parseBenchmarkStatsJson(json.str(), baseline)) {
+      IGL_LOG_ERROR("[IGL Benchmark] Cannot read baseline %s\n",
+                    benchmarkParams.baselinePath.c_str());
+    } else {
+      const auto regressions =
+          compareBenchmarkStats(baseline, stats, benchmarkParams.regressionThresholdPercent);
+      for (const auto& r : regressions) {
+        IGL_LOG_INFO("[IGL Benchmark] *** REGRESSION *** %s: %.2f -> %.2f (+%.1f%%)\n",
+                     r.metric.c_str(),
+                     r.baselineValue,
+                     r.currentValue,
+                     r.changePercent);
+        (void)r;
+      }
+      IGL_LOG_INFO("[IGL Benchmark] Baseline comparison: %zu regression(s) above %.1f%%\n",
+                   regressions.size(),
+                   benchmarkParams.regressionThresholdPercent);
+    }
+  }
+
   // Suppress unused variable warnings when logging is disabled
   (void)stats;
   (void)elapsedSec;
@@ -243,6 +353,7 @@ void RenderSession::runUpdate(SurfaceTextures surfaceTextures) noexcept {
       recordBenchmarkFrame(frameIntervalMs);
     }
     prevFrameStartTime_ = startTime;
+    benchmarkTracker_->recordDeviceCounters(platform_->getDevice());
 
     // Check for periodic benchmark reporting
     checkBenchmarkPeriodicReport();
@@ -265,8 +376,13 @@ void RenderSession::runUpdate(SurfaceTextures surfaceTextures) noexcept {
   {
     // Scoped zone covering the full session update
     IGL_PROFILER_ZONE("IGL::RenderSession::update", IGL_PROFILER_COLOR_UPDATE);
+    ITimestampQueries* latencyQueries =
+        benchmarkTracker_ ? beginBenchmarkLatencyQuery() : nullptr;
     // Call the actual update implementation
     update(std::move(surfaceTextures));
+    if (latencyQueries) {
+      latencyQueries->endFrameQuery();
+    }
     IGL_PROFILER_ZONE_END();
   }
 
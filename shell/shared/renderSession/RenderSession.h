@@ -9,6 +9,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <vector>
 #include <shell/shared/platform/Platform.h>
 #include <shell/shared/renderSession/BenchmarkTracker.h>
 
@@ -92,6 +94,16 @@ class RenderSession {
   /// @param renderTimeMs The time in milliseconds for the update call
   void recordBenchmarkFrame(double renderTimeMs) noexcept;
 
+  /// @brief Records the GPU time of a frame for benchmarking. Sessions call this for queries
+  /// written around their own GPU work; the frame queries which runUpdate() wraps around update()
+  /// are reported separately as GPU frame latency.
+  void recordBenchmarkGpuTime(const ITimestampQueries& queries) noexcept;
+
+  /// @brief Sets the name stored in the benchmark report file (default: "RenderSession")
+  void setBenchmarkSessionName(std::string name) noexcept {
+    benchmarkSessionName_ = std::move(name);
+  }
+
   /// @brief Checks and handles periodic benchmark reporting
   /// Logs stats every minute if benchmark mode is enabled
   void checkBenchmarkPeriodicReport() noexcept;
@@ -131,11 +143,20 @@ class RenderSession {
   double lastTime_ = getSeconds();
 
  private:
+  /// @brief Records the GPU frame latency of the frame which last used the next queries object and
+  /// starts a frame query on it. Returns nullptr if the latency is not measured.
+  ITimestampQueries* beginBenchmarkLatencyQuery() noexcept;
+
+  // GPU results are read a few frames later, so every frame in flight has its own queries
+  static constexpr uint32_t kNumBenchmarkTimestampQueries = 3;
+
   std::shared_ptr<Platform> platform_;
   std::shared_ptr<AppParams> appParams_;
   std::optional<Color> preferredClearColor_;
   const ShellParams* shellParams_ = nullptr;
   std::unique_ptr<BenchmarkTracker> benchmarkTracker_;
+  std::vector<std::shared_ptr<ITimestampQueries>> benchmarkTimestampQueries_;
+  std::string benchmarkSessionName_ = "RenderSession";
   uint32_t frameCount_ = 0;
   bool benchmarkExpiredLogged_ = false;
   bool loggedMissingParams_ = false;
@@ -7,6 +7,7 @@
 
 #include <shell/shared/renderSession/RenderSessionRegistry.hpp>
 
+#include <algorithm>
 #include <unordered_map>
 #include <igl/Core.h>
 
@@ -24,6 +25,16 @@ size_t RenderSessionRegistry::size() const noexcept {
   return loaders_.size();
 }
 
+std::vector<std::string> RenderSessionRegistry::loaderNames() const noexcept {
+  std::vector<std::string> names;
+  names.reserve(loaders_.size());
+  for (const auto& [name, loader] : loaders_) {
+    names.push_back(name);
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
 RenderSessionLoader& RenderSessionRegistry::findLoader(const std::string& loaderName) noexcept {
   if (auto it = loaders_.find(loaderName); IGL_DEBUG_VERIFY(it != loaders_.end())) {
     return it->second;
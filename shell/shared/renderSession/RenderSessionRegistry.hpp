@@ -9,6 +9,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <shell/shared/renderSession/RenderSessionLoader.hpp>
 
 namespace igl::shell {
@@ -19,6 +20,9 @@ class RenderSessionRegistry {
   bool empty() const noexcept;
   size_t size() const noexcept;
 
+  /// @brief Names of all registered loaders, sorted alphabetically
+  std::vector<std::string> loaderNames() const noexcept;
+
   RenderSessionLoader& findLoader(const std::string& loaderName) noexcept;
   void registerLoader(const std::string& loaderName, RenderSessionLoader value) noexcept;
 
@@ -74,6 +74,15 @@ std::optional<BenchmarkRenderSessionParams> parseBenchmarkRenderSessionParams(
     } else if (arg == "--render-buffer-size" && tryConsumeNext(args, i)) {
       p.renderTimeBufferSize = std::stoul(args[i]);
       found = true;
+    } else if (arg == "--benchmark-report" && tryConsumeNext(args, i)) {
+      p.reportPath = args[i];
+      found = true;
+    } else if (arg == "--benchmark-baseline" && tryConsumeNext(args, i)) {
+      p.baselinePath = args[i];
+      found = true;
+    } else if (arg == "--regression-threshold" && tryConsumeNext(args, i)) {
+      p.regressionThresholdPercent = std::stod(args[i]);
+      found = true;
     } else if (arg == "--force-multiview") {
       // handled in parseShellParams; skip here
     } else if (arg.rfind("--", 0) == 0) {
@@ -38,6 +38,15 @@ struct BenchmarkRenderSessionParams {
 
   /// @brief Size of the circular buffer for storing render times
   size_t renderTimeBufferSize = 1000;
+
+  /// @brief Path of the final report; CSV if it ends with ".csv", JSON otherwise. Empty = none
+  std::string reportPath;
+
+  /// @brief Path of a JSON report of a previous run to compare the final statistics against
+  std::string baselinePath;
+
+  /// @brief A frame time metric regresses if it is slower than the baseline by more than this
+  double regressionThresholdPercent = 10.0;
 };
 
 struct ShellParams {
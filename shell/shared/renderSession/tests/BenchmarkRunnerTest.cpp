@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <shell/shared/renderSession/BenchmarkRunner.h>
+
+#include <string>
+#include <vector>
+
+namespace igl::shell::tests {
+
+// ---------------------------------------------------------------------------
+// matchesBenchmarkFilter()
+// ---------------------------------------------------------------------------
+
+TEST(BenchmarkRunnerFilterTest, EmptyFilterMatchesEverything) {
+  EXPECT_TRUE(matchesBenchmarkFilter("FireworksSession", ""));
+}
+
+TEST(BenchmarkRunnerFilterTest, MatchesAnySubstring) {
+  EXPECT_TRUE(matchesBenchmarkFilter("FireworksSession", "Fireworks"));
+  EXPECT_TRUE(matchesBenchmarkFilter("GPUStressSession", "Fireworks,GPUStress"));
+  EXPECT_TRUE(matchesBenchmarkFilter("TinyMeshSession", "TinyMesh"));
+  EXPECT_TRUE(matchesBenchmarkFilter("TinyMeshBindGroupSession", "TinyMesh"));
+  EXPECT_FALSE(matchesBenchmarkFilter("DrawInstancedSession", "Fireworks,GPUStress"));
+}
+
+TEST(BenchmarkRunnerFilterTest, IgnoresEmptyEntries) {
+  EXPECT_FALSE(matchesBenchmarkFilter("FireworksSession", ","));
+  EXPECT_TRUE(matchesBenchmarkFilter("FireworksSession", ",,Fireworks,"));
+}
+
+// ---------------------------------------------------------------------------
+// parseBenchmarkRunnerParams()
+// ---------------------------------------------------------------------------
+
+TEST(BenchmarkRunnerParamsTest, ParsesAllFlags) {
+  BenchmarkRunnerParams params;
+  ASSERT_TRUE(parseBenchmarkRunnerParams({"prog",
+                                          "--frames",
+                                          "100",
+                                          "--warmup",
+                                          "10",
+                                          "--seed",
+                                          "42",
+                                          "--filter",
+                                          "Fireworks",
+                                          "--backends",
+                                          "vulkan",
+                                          "--viewport-size",
+                                          "640x480",
+                                          "--report",
+                                          "out.csv"},
+                                         params));
+  EXPECT_EQ(params.numFrames, 100u);
+  EXPECT_EQ(params.numWarmupFrames, 10u);
+  EXPECT_EQ(params.seed, 42u);
+  EXPECT_EQ(params.filter, "Fireworks");
+  EXPECT_EQ(params.backends, "vulkan");
+  EXPECT_EQ(params.width, 640u);
+  EXPECT_EQ(params.height, 480u);
+  EXPECT_EQ(params.reportPath, "out.csv");
+}
+
+TEST(BenchmarkRunnerParamsTest, RejectsInvalidArguments) {
+  BenchmarkRunnerParams params;
+  EXPECT_FALSE(parseBenchmarkRunnerParams({"prog", "--frames"}, params));
+  EXPECT_FALSE(parseBenchmarkRunnerParams({"prog", "--frames", "0"}, params));
+  EXPECT_FALSE(parseBenchmarkRunnerParams({"prog", "--warmup", "ten"}, params));
+  EXPECT_FALSE(parseBenchmarkRunnerParams({"prog", "--viewport-size", "640"}, params));
+  EXPECT_FALSE(parseBenchmarkRunnerParams({"prog", "--unknown", "1"}, params));
+}
+
+// ---------------------------------------------------------------------------
+// BenchmarkRunner session selection
+// ---------------------------------------------------------------------------
+
+TEST(BenchmarkRunnerTest, SessionNamesAreFilteredAndSorted) {
+  RenderSessionRegistry registry;
+  for (const char* name : {"TinyMeshSession", "FireworksSession", "GPUStressSession"}) {
+    registry.registerLoader(name, [](std::shared_ptr<Platform>) { return nullptr; });
+  }
+  EXPECT_EQ(registry.loaderNames(),
+            (std::vector<std::string>{"FireworksSession", "GPUStressSession", "TinyMeshSession"}));
+
+  BenchmarkRunnerParams params;
+  params.filter = "TinyMesh,Fireworks";
+  const BenchmarkRunner runner(registry, params);
+  EXPECT_EQ(runner.getSessionNames(),
+            (std::vector<std::string>{"FireworksSession", "TinyMeshSession"}));
+  EXPECT_TRUE(runner.getResults().empty());
+}
+
+// ---------------------------------------------------------------------------
+// Combined report
+// ---------------------------------------------------------------------------
+
+TEST(BenchmarkRunnerReportTest, OneRowPerSessionAndBackend) {
+  std::vector<BenchmarkRunnerResult> results(2);
+  results[0].sessionName = "FireworksSession";
+  results[0].backendName = "vulkan";
+  results[0].stats.totalSamples = 600;
+  results[1].sessionName = "FireworksSession";
+  results[1].backendName = "opengl";
+  results[1].completed = false;
+
+  const std::string table = formatBenchmarkRunnerTable(results);
+  EXPECT_NE(table.find("Session"), std::string::npos);
+  EXPECT_NE(table.find("vulkan"), std::string::npos);
+  EXPECT_NE(table.find("opengl"), std::string::npos);
+  EXPECT_NE(table.find("(incomplete)"), std::string::npos);
+
+  const std::string csv = formatBenchmarkRunnerCsv(results);
+  EXPECT_EQ(csv.rfind(getBenchmarkStatsCsvHeader() + "\n", 0), 0u);
+  EXPECT_NE(csv.find("\nFireworksSession/vulkan,"), std::string::npos);
+  EXPECT_NE(csv.find("\nFireworksSession/opengl,"), std::string::npos);
+}
+
+} // namespace igl::shell::tests
@@ -9,9 +9,12 @@
 
 #include <shell/shared/renderSession/BenchmarkTracker.h>
 
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <thread>
+#include <vector>
+#include <igl/TimestampQueries.h>
 
 namespace igl::shell::tests {
 
@@ -439,4 +442,260 @@ TEST(GenerateFinalBenchmarkReportTest, NormalTerminationStatus) {
   EXPECT_NE(report.find("terminated normally"), std::string::npos);
 }
 
+TEST(GenerateFinalBenchmarkReportTest, GpuSectionOnlyWithGpuTimes) {
+  BenchmarkTracker tracker;
+  tracker.recordRenderTime(16.6);
+  EXPECT_EQ(generateFinalBenchmarkReport(tracker, false).find("GPU Time"), std::string::npos);
+
+  tracker.recordGpuTime(4.0);
+  EXPECT_NE(generateFinalBenchmarkReport(tracker, false).find("GPU Time"), std::string::npos);
+}
+
+// ---------------------------------------------------------------------------
+// Percentiles, GPU time and device counters
+// ---------------------------------------------------------------------------
+
+TEST(BenchmarkTrackerTest, PercentilesExactWithinBuffer) {
+  BenchmarkTracker tracker;
+  for (int i = 1; i <= 1000; ++i) {
+    tracker.recordRenderTime(static_cast<double>(i));
+  }
+
+  const RenderTimeStats stats = tracker.computeStats();
+  EXPECT_DOUBLE_EQ(stats.p50RenderTimeMs, 500.0);
+  EXPECT_DOUBLE_EQ(stats.p90RenderTimeMs, 900.0);
+  EXPECT_DOUBLE_EQ(stats.p99RenderTimeMs, 990.0);
+  EXPECT_DOUBLE_EQ(stats.p999RenderTimeMs, 999.0);
+
+  const RenderTimeStats recent = tracker.computeRecentStats();
+  EXPECT_DOUBLE_EQ(recent.p50RenderTimeMs, 500.0);
+  EXPECT_DOUBLE_EQ(recent.p999RenderTimeMs, 999.0);
+}
+
+TEST(BenchmarkTrackerTest, PercentilesAfterOverflow) {
+  BenchmarkTracker tracker(10);
+  // 99 fast frames and one slow frame, repeated
+  for (int i = 0; i < 1000; ++i) {
+    tracker.recordRenderTime(i % 100 == 99 ? 100.0 : 10.0);
+  }
+  ASSERT_GT(tracker.getOverflowRecordCount(), 0u);
+
+  const RenderTimeStats stats = tracker.computeStats();
+  EXPECT_NEAR(stats.p50RenderTimeMs, 10.0, 10.0 * 0.012);
+  EXPECT_NEAR(stats.p99RenderTimeMs, 10.0, 10.0 * 0.012);
+  EXPECT_NEAR(stats.p999RenderTimeMs, 100.0, 100.0 * 0.012);
+}
+
+TEST(FrameTimeHistogramTest, Percentiles) {
+  FrameTimeHistogram histogram;
+  EXPECT_EQ(histogram.getPercentile(50.0), 0.0);
+
+  for (int i = 1; i <= 100; ++i) {
+    histogram.record(static_cast<double>(i) * 0.1);
+  }
+  EXPECT_EQ(histogram.getCount(), 100u);
+  EXPECT_NEAR(histogram.getPercentile(50.0), 5.0, 5.0 * 0.012);
+  EXPECT_NEAR(histogram.getPercentile(90.0), 9.0, 9.0 * 0.012);
+  EXPECT_NEAR(histogram.getPercentile(100.0), 10.0, 10.0 * 0.012);
+  EXPECT_NEAR(histogram.getPercentile(0.0), 0.1, 0.1 * 0.012);
+
+  histogram.reset();
+  EXPECT_EQ(histogram.getCount(), 0u);
+}
+
+TEST(BenchmarkTrackerTest, GpuTime) {
+  BenchmarkTracker tracker;
+  tracker.recordRenderTime(16.0);
+  EXPECT_EQ(tracker.computeStats().gpuSamples, 0u);
+
+  tracker.recordGpuTime(2.0);
+  tracker.recordGpuTime(4.0);
+
+  const RenderTimeStats stats = tracker.computeStats();
+  EXPECT_EQ(stats.gpuSamples, 2u);
+  EXPECT_DOUBLE_EQ(stats.avgGpuTimeMs, 3.0);
+  EXPECT_DOUBLE_EQ(stats.maxGpuTimeMs, 4.0);
+  EXPECT_NEAR(stats.p50GpuTimeMs, 2.0, 2.0 * 0.012);
+
+  tracker.reset();
+  EXPECT_EQ(tracker.computeStats().gpuSamples, 0u);
+}
+
+namespace {
+
+class FakeTimestampQueries final : public ITimestampQueries {
+ public:
+  [[nodiscard]] uint32_t capacity() const override {
+    return 4;
+  }
+  [[nodiscard]] uint32_t count() const override {
+    return static_cast<uint32_t>(elapsedNanos.size());
+  }
+  void reset() override {
+    elapsedNanos.clear();
+  }
+  [[nodiscard]] bool resultsAvailable() const override {
+    return available;
+  }
+  [[nodiscard]] uint64_t getElapsedNanos(uint32_t slotIndex) const override {
+    return elapsedNanos[slotIndex];
+  }
+  [[nodiscard]] uint64_t getFrameElapsedNanos() const override {
+    return frameElapsedNanos;
+  }
+
+  std::vector<uint64_t> elapsedNanos;
+  uint64_t frameElapsedNanos = 0;
+  bool available = true;
+};
+
+} // namespace
+
+TEST(BenchmarkTrackerTest, GpuTimeFromTimestampQueries) {
+  BenchmarkTracker tracker;
+  FakeTimestampQueries queries;
+
+  // nothing recorded yet
+  EXPECT_FALSE(tracker.recordGpuTime(queries));
+
+  // backends without a frame time report the sum of all slots
+  queries.elapsedNanos = {1'000'000, 2'000'000};
+  queries.available = false;
+  EXPECT_FALSE(tracker.recordGpuTime(queries));
+  queries.available = true;
+  EXPECT_TRUE(tracker.recordGpuTime(queries));
+
+  queries.frameElapsedNanos = 5'000'000;
+  EXPECT_TRUE(tracker.recordGpuTime(queries));
+
+  const RenderTimeStats stats = tracker.computeStats();
+  EXPECT_EQ(stats.gpuSamples, 2u);
+  EXPECT_DOUBLE_EQ(stats.avgGpuTimeMs, 4.0);
+  EXPECT_DOUBLE_EQ(stats.maxGpuTimeMs, 5.0);
+}
+
+TEST(BenchmarkTrackerTest, GpuLatencyIsSeparateFromGpuTime) {
+  BenchmarkTracker tracker;
+  FakeTimestampQueries queries;
+  tracker.recordRenderTime(16.0);
+
+  queries.frameElapsedNanos = 12'000'000;
+  queries.elapsedNanos = {12'000'000};
+  EXPECT_TRUE(tracker.recordGpuLatency(queries));
+  tracker.recordGpuLatency(8.0);
+
+  RenderTimeStats stats = tracker.computeStats();
+  EXPECT_EQ(stats.gpuSamples, 0u);
+  EXPECT_EQ(stats.gpuLatencySamples, 2u);
+  EXPECT_DOUBLE_EQ(stats.avgGpuLatencyMs, 10.0);
+  EXPECT_DOUBLE_EQ(stats.maxGpuLatencyMs, 12.0);
+  EXPECT_NEAR(stats.p50GpuLatencyMs, 8.0, 8.0 * 0.012);
+
+  const std::string report = generateFinalBenchmarkReport(tracker, false);
+  EXPECT_NE(report.find("GPU Frame Latency Statistics"), std::string::npos);
+  EXPECT_EQ(report.find("GPU Time Statistics"), std::string::npos);
+
+  tracker.reset();
+  stats = tracker.computeStats();
+  EXPECT_EQ(stats.gpuLatencySamples, 0u);
+  EXPECT_DOUBLE_EQ(stats.avgGpuLatencyMs, 0.0);
+}
+
+TEST(BenchmarkTrackerTest, DeviceCountersAreRelativeToFirstCall) {
+  BenchmarkTracker tracker;
+  tracker.recordDeviceCounters(100, 7);
+  tracker.recordRenderTime(16.0);
+  tracker.recordDeviceCounters(110, 8);
+  tracker.recordRenderTime(16.0);
+  tracker.recordDeviceCounters(130, 8);
+
+  const RenderTimeStats stats = tracker.computeStats();
+  EXPECT_EQ(stats.drawCalls, 30u);
+  EXPECT_DOUBLE_EQ(stats.avgDrawCallsPerFrame, 15.0);
+  EXPECT_EQ(stats.shaderCompilations, 1u);
+}
+
+// ---------------------------------------------------------------------------
+// JSON/CSV reports and baseline comparison
+// ---------------------------------------------------------------------------
+
+TEST(BenchmarkReportTest, JsonRoundTrip) {
+  RenderTimeStats stats;
+  stats.totalSamples = 120;
+  stats.avgRenderTimeMs = 16.5;
+  stats.p99RenderTimeMs = 33.25;
+  stats.avgGpuTimeMs = 4.125;
+  stats.avgGpuLatencyMs = 9.5;
+  stats.gpuLatencySamples = 118;
+  stats.drawCalls = 2400;
+
+  const std::string json = formatBenchmarkStatsJson(stats, "TinyMeshSession");
+  EXPECT_NE(json.find("\"session\": \"TinyMeshSession\""), std::string::npos);
+
+  RenderTimeStats parsed;
+  ASSERT_TRUE(parseBenchmarkStatsJson(json, parsed));
+  EXPECT_EQ(parsed.totalSamples, 120u);
+  EXPECT_DOUBLE_EQ(parsed.avgRenderTimeMs, 16.5);
+  EXPECT_DOUBLE_EQ(parsed.p99RenderTimeMs, 33.25);
+  EXPECT_DOUBLE_EQ(parsed.avgGpuTimeMs, 4.125);
+  EXPECT_DOUBLE_EQ(parsed.avgGpuLatencyMs, 9.5);
+  EXPECT_EQ(parsed.gpuLatencySamples, 118u);
+  EXPECT_EQ(parsed.drawCalls, 2400u);
+
+  EXPECT_FALSE(parseBenchmarkStatsJson("{}", parsed));
+}
+
+TEST(BenchmarkReportTest, JsonEscapesSessionName) {
+  RenderTimeStats stats;
+  stats.totalSamples = 10;
+
+  const std::string json = formatBenchmarkStatsJson(stats, "Session \"A\"\\B\n");
+  EXPECT_NE(json.find("\"session\": \"Session \\\"A\\\"\\\\B\\u000a\""), std::string::npos);
+
+  RenderTimeStats parsed;
+  ASSERT_TRUE(parseBenchmarkStatsJson(json, parsed));
+  EXPECT_EQ(parsed.totalSamples, 10u);
+}
+
+TEST(BenchmarkReportTest, CsvColumnsMatchHeader) {
+  const std::string header = getBenchmarkStatsCsvHeader();
+  const std::string line = formatBenchmarkStatsCsv(RenderTimeStats{}, "Session");
+  EXPECT_EQ(header.rfind("session,", 0), 0u);
+  EXPECT_EQ(line.rfind("Session,", 0), 0u);
+  EXPECT_EQ(std::count(header.begin(), header.end(), ','),
+            std::count(line.begin(), line.end(), ','));
+}
+
+TEST(BenchmarkReportTest, CompareFlagsRegressionsAboveThreshold) {
+  RenderTimeStats baseline;
+  baseline.avgRenderTimeMs = 10.0;
+  baseline.p99RenderTimeMs = 20.0;
+  baseline.avgGpuTimeMs = 5.0;
+
+  RenderTimeStats current = baseline;
+  current.avgRenderTimeMs = 10.5; // +5%
+  current.p99RenderTimeMs = 30.0; // +50%
+  current.avgGpuTimeMs = 0.0; // not measured
+
+  const auto regressions = compareBenchmarkStats(baseline, current, 10.0);
+  ASSERT_EQ(regressions.size(), 1u);
+  EXPECT_EQ(regressions[0].metric, "p99RenderTimeMs");
+  EXPECT_DOUBLE_EQ(regressions[0].changePercent, 50.0);
+
+  EXPECT_TRUE(compareBenchmarkStats(baseline, baseline, 0.0).empty());
+}
+
+TEST(BenchmarkReportTest, CompareIgnoresGpuLatency) {
+  RenderTimeStats baseline;
+  baseline.avgRenderTimeMs = 10.0;
+  baseline.avgGpuLatencyMs = 5.0;
+  baseline.p99GpuLatencyMs = 6.0;
+
+  RenderTimeStats current = baseline;
+  current.avgGpuLatencyMs = 50.0;
+  current.p99GpuLatencyMs = 60.0;
+
+  EXPECT_TRUE(compareBenchmarkStats(baseline, current, 10.0).empty());
+}
+
 } // namespace igl::shell::tests
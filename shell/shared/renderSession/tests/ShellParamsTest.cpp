@@ -260,6 +260,21 @@ TEST(ParseShellParamsTest, BenchmarkRenderBufferSize) {
   EXPECT_EQ(shellParams.benchmarkParams->renderTimeBufferSize, 250u);
 }
 
+TEST(ParseShellParamsTest, BenchmarkReportAndBaseline) {
+  ShellParams shellParams;
+  parseShellParams({"--benchmark-report",
+                    "out.csv",
+                    "--benchmark-baseline",
+                    "base.json",
+                    "--regression-threshold",
+                    "5"},
+                   shellParams);
+  ASSERT_TRUE(shellParams.benchmarkParams.has_value());
+  EXPECT_EQ(shellParams.benchmarkParams->reportPath, "out.csv");
+  EXPECT_EQ(shellParams.benchmarkParams->baselinePath, "base.json");
+  EXPECT_DOUBLE_EQ(shellParams.benchmarkParams->regressionThresholdPercent, 5.0);
+}
+
 TEST(ParseShellParamsTest, BenchmarkCustomParamsCollected) {
   ShellParams shellParams;
   parseShellParams({"--benchmark", "--myFlag", "myValue"}, shellParams);
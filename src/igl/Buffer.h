@@ -49,7 +49,8 @@ struct BufferDesc {
     UniformBlock = 1 << 1, // Enforces UBO for OpenGL
     Query = 1 << 2,
     // @fb-only
-    Ring = 1 << 4, // Metal/Vulkan: Ring buffers with memory for each swapchain image
+    Ring = 1 << 4, // Metal/Vulkan: Ring buffers with memory for each swapchain image. OpenGL:
+                   // Shared buffers cycle through several copies, see opengl::ArrayBuffer
     NoCopy = 1 << 5, // Metal: The buffer should re-use previously allocated memory.
   };
 
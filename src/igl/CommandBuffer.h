@@ -12,6 +12,7 @@
 #include <igl/ComputeCommandEncoder.h>
 #include <igl/ComputePass.h>
 #include <igl/Framebuffer.h>
+#include <igl/Readback.h>
 #include <igl/RenderCommandEncoder.h>
 
 namespace igl {
@@ -159,6 +160,33 @@ class ICommandBuffer {
                                    uint32_t level = 0,
                                    uint32_t layer = 0) = 0;
 
+  /**
+   * @brief Records a copy of `size` bytes at `srcOffset` of the `src` buffer into CPU-visible
+   * memory. Unlike IBuffer::map(), this does not stall the CPU: the returned object can be polled
+   * or given a completion handler, and its data becomes available once this command buffer has
+   * been submitted and retired by the GPU. Must be called outside of any command encoder.
+   * @return nullptr and an error in `outResult` if the backend does not support async readbacks.
+   */
+  virtual std::shared_ptr<IReadback> readBufferAsync(IBuffer& /*src*/,
+                                                     uint64_t /*srcOffset*/,
+                                                     uint64_t /*size*/,
+                                                     Result* IGL_NULLABLE outResult = nullptr) {
+    Result::setResult(outResult, Result::Code::Unimplemented, "Async readback not implemented");
+    return nullptr;
+  }
+
+  /**
+   * @brief Records a copy of the texels in `range` of the `src` texture into CPU-visible memory.
+   * The range must cover a single mip level; rows are tightly packed in the result (see
+   * IReadback::bytesPerRow()). See readBufferAsync() for the synchronization rules.
+   */
+  virtual std::shared_ptr<IReadback> readTextureAsync(ITexture& /*src*/,
+                                                      const TextureRangeDesc& /*range*/,
+                                                      Result* IGL_NULLABLE outResult = nullptr) {
+    Result::setResult(outResult, Result::Code::Unimplemented, "Async readback not implemented");
+    return nullptr;
+  }
+
   /**
    * @returns the number of draw operations tracked by this CommandBuffer. This is tracked manually
    * via calls to incrementCurrentDrawCount().
@@ -65,6 +65,27 @@ enum class InDevelopementFeatures : uint8_t {
   DummyFeatureExample,
 };
 
+/**
+ * @brief GPU memory used by a device, broken down by the kind of resources it backs. All values
+ * are in bytes. Backends do not attribute every allocation to a category (e.g. swapchain images or
+ * driver-internal memory), so the categories might not add up to `total`.
+ */
+struct GPUMemoryUsage {
+  /// Memory backing textures and render targets
+  size_t textures = 0;
+  /// Memory backing buffers created by the application
+  size_t buffers = 0;
+  /// Memory backing staging buffers used internally for uploads and readbacks
+  size_t staging = 0;
+  /// Memory used by descriptor pools and descriptor buffers (estimated where the API does not
+  /// report it)
+  size_t descriptorPools = 0;
+  /// Total memory in use
+  size_t total = 0;
+  /// Memory the device can use without degrading performance, or 0 if it is unknown
+  size_t budget = 0;
+};
+
 /**
  * @brief Interface to a GPU that is used to draw graphics or do parallel computation.
  */
@@ -382,6 +403,17 @@ class IDevice : public ICapabilities, public base::IDeviceBase {
     return 0;
   }
 
+  /**
+   * @brief Returns the GPU memory currently in use broken down by category, along with the memory
+   * budget if the device can report it. Devices which do not track categories report only `total`.
+   * @return Used GPU memory by category
+   */
+  [[nodiscard]] virtual GPUMemoryUsage getGPUMemoryUsageBreakdown() const {
+    GPUMemoryUsage usage;
+    usage.total = getGPUMemoryUsage();
+    return usage;
+  }
+
   /**
    * @brief Creates a shader library with one or more shader modules.
    * @see igl::ShaderCompileDesc
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <igl/Common.h>
+
+namespace igl {
+
+/**
+ * @brief A pending GPU->CPU copy recorded via ICommandBuffer::readBufferAsync() or
+ * ICommandBuffer::readTextureAsync().
+ *
+ * The copy is executed as part of the command buffer it was recorded into, and the data becomes
+ * available once that command buffer has been submitted and retired by the GPU. None of the
+ * methods except wait() block the calling thread.
+ */
+class IReadback {
+ public:
+  using CompletionHandler = std::function<void(const IReadback& readback)>;
+
+  virtual ~IReadback() = default;
+
+  /// True if the GPU has finished the copy and data() can be accessed
+  [[nodiscard]] virtual bool isReady() const = 0;
+
+  /// Blocks until the GPU has finished the copy. The command buffer must have been submitted.
+  virtual void wait() = 0;
+
+  /// The read back bytes, or nullptr if the copy has not finished yet
+  [[nodiscard]] virtual const void* IGL_NULLABLE data() const = 0;
+
+  /// Size of the read back data in bytes
+  [[nodiscard]] virtual size_t size() const = 0;
+
+  /// Size of one row of texels for texture readbacks (rows are tightly packed); 0 for buffers
+  [[nodiscard]] virtual uint32_t bytesPerRow() const = 0;
+
+  /// Sets a handler invoked once when the copy has finished. The handler runs on the thread which
+  /// submits command buffers. If the copy has already finished, the handler is invoked right away.
+  virtual void setCompletionHandler(CompletionHandler handler) = 0;
+};
+
+} // namespace igl
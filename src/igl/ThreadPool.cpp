@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/ThreadPool.h>
+
+#include <algorithm>
+#include <igl/Core.h>
+
+namespace igl {
+
+ThreadPool::ThreadPool(uint32_t numThreads, const char* debugName) :
+  debugName_(debugName ? debugName : "") {
+  if (numThreads == 0) {
+    const uint32_t numCores = std::thread::hardware_concurrency();
+    numThreads = std::max(numCores, 2u) - 1u;
+  }
+
+  workers_.reserve(numThreads);
+
+  for (uint32_t i = 0; i != numThreads; i++) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard lock(mutex_);
+    stopping_ = true;
+  }
+  cvTasks_.notify_all();
+
+  for (std::thread& t : workers_) {
+    t.join();
+  }
+}
+
+void ThreadPool::enqueue(std::function<void()>&& task) {
+  {
+    const std::lock_guard lock(mutex_);
+    IGL_DEBUG_ASSERT(!stopping_, "Cannot submit tasks to a ThreadPool which is being destroyed");
+    tasks_.emplace_back(std::move(task));
+  }
+  cvTasks_.notify_one();
+}
+
+void ThreadPool::waitIdle() {
+  IGL_DEBUG_ASSERT(!isWorkerThread(), "waitIdle() called from a worker thread would deadlock");
+
+  std::unique_lock lock(mutex_);
+  cvIdle_.wait(lock, [this]() { return tasks_.empty() && numBusyWorkers_ == 0; });
+}
+
+bool ThreadPool::isWorkerThread() const noexcept {
+  const std::thread::id id = std::this_thread::get_id();
+  return std::any_of(
+      workers_.begin(), workers_.end(), [id](const std::thread& t) { return t.get_id() == id; });
+}
+
+void ThreadPool::workerLoop() {
+  IGL_PROFILER_THREAD(debugName_.c_str());
+
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock lock(mutex_);
+      cvTasks_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+      // drain the queue before exiting so that no future is left without a value
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+      numBusyWorkers_++;
+    }
+
+    task();
+
+    {
+      const std::lock_guard lock(mutex_);
+      numBusyWorkers_--;
+      if (tasks_.empty() && numBusyWorkers_ == 0) {
+        cvIdle_.notify_all();
+      }
+    }
+  }
+}
+
+} // namespace igl
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace igl {
+
+/// @brief A fixed-size pool of worker threads which execute submitted tasks in FIFO order. Used by
+/// the backends to move expensive, self-contained work (pipeline and shader compilation) off the
+/// render thread. Destroying the pool runs all tasks that are still queued and joins the workers.
+class ThreadPool final {
+ public:
+  /// @param numThreads the number of worker threads. Passing 0 picks
+  /// `std::thread::hardware_concurrency() - 1` threads (at least 1), leaving one core for the
+  /// thread which submits the work.
+  /// @param debugName the name used for the worker threads in profiler captures
+  explicit ThreadPool(uint32_t numThreads = 0, const char* debugName = "IGL Worker");
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool(ThreadPool&&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+  ThreadPool& operator=(ThreadPool&&) = delete;
+
+  /// @brief Schedules `task` for execution on one of the worker threads. The returned future
+  /// becomes ready once the task has finished running.
+  template<typename F>
+  [[nodiscard]] std::future<std::invoke_result_t<std::decay_t<F>>> submit(F&& task) {
+    using ResultType = std::invoke_result_t<std::decay_t<F>>;
+    auto packagedTask = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(task));
+    std::future<ResultType> future = packagedTask->get_future();
+    enqueue([packagedTask]() { (*packagedTask)(); });
+    return future;
+  }
+
+  /// @brief Blocks the calling thread until the queue is empty and no worker is running a task.
+  void waitIdle();
+
+  [[nodiscard]] uint32_t getNumThreads() const noexcept {
+    return static_cast<uint32_t>(workers_.size());
+  }
+
+  /// @brief Returns true if the calling thread is one of the workers of this pool
+  [[nodiscard]] bool isWorkerThread() const noexcept;
+
+ private:
+  void enqueue(std::function<void()>&& task);
+  void workerLoop();
+
+ private:
+  std::vector<std::thread> workers_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable cvTasks_;
+  std::condition_variable cvIdle_;
+  uint32_t numBusyWorkers_ = 0;
+  bool stopping_ = false;
+  std::string debugName_;
+};
+
+} // namespace igl
@@ -66,6 +66,21 @@ class ITimestampQueries : public ITrackedResource<ITimestampQueries> {
     return 0;
   }
 
+  /// Start a timing slot covering all GPU work submitted to the device after this call, until
+  /// endFrameQuery(). Lets callers time whole frames without attaching queries to every pass; the
+  /// result is read with getElapsedNanos(count() - 1). The begin timestamp is written when the
+  /// previously submitted work completes, not when the frame's first command starts, so the result
+  /// is the frame's submit-to-completion latency: it includes GPU idle time spent waiting for the
+  /// CPU to record the frame and is not the GPU cost of the frame. Must not overlap per-pass
+  /// queries on backends whose elapsed queries cannot nest (OpenGL).
+  /// Default returns false; override in backends that can time submissions.
+  [[nodiscard]] virtual bool beginFrameQuery() {
+    return false;
+  }
+
+  /// End the timing slot started by beginFrameQuery()
+  virtual void endFrameQuery() {}
+
   /// Get the label associated with a timing slot, if the backend records one.
   /// Returns a stable C string owned by the queries object (valid until reset()
   /// or destruction); empty string if the backend records no label.
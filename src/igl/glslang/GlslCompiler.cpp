@@ -8,9 +8,12 @@
 #include <igl/glslang/GlslCompiler.h>
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <igl/Macros.h>
+#include <igl/ThreadPool.h>
 #include <igl/glslang/GlslangHelpers.h>
+#include <igl/glslang/SpirvCache.h>
 
 namespace igl::glslang {
 namespace {
@@ -70,6 +73,23 @@ void logShaderSource(const char* text) {
 #endif
 #endif
 }
+
+// Shared by all jobs of a compileShaders() batch: holds a reference to the glslang process until
+// the last job is done
+struct CompileBatch {
+  explicit CompileBatch(const glslang_resource_t& resource) : resource(resource) {
+    glslang_initialize_process();
+  }
+  ~CompileBatch() {
+    glslang_finalize_process();
+  }
+  CompileBatch(const CompileBatch&) = delete;
+  CompileBatch& operator=(const CompileBatch&) = delete;
+  CompileBatch(CompileBatch&&) = delete;
+  CompileBatch& operator=(CompileBatch&&) = delete;
+
+  const glslang_resource_t resource;
+};
 } // namespace
 
 void initializeCompiler() noexcept {
@@ -166,6 +186,46 @@ Result compileShader(ShaderStage stage,
   return Result();
 }
 
+std::vector<std::future<CompileJobResult>> compileShaders(
+    ThreadPool& pool,
+    std::vector<CompileJob> jobs,
+    const glslang_resource_t& glslLangResource,
+    SpirvCache* IGL_NULLABLE cache) {
+  IGL_PROFILER_FUNCTION();
+
+  auto batch = std::make_shared<const CompileBatch>(glslLangResource);
+
+  std::vector<std::future<CompileJobResult>> futures;
+  futures.reserve(jobs.size());
+
+  for (CompileJob& job : jobs) {
+    futures.emplace_back(pool.submit([batch, job = std::move(job), cache]() {
+      IGL_PROFILER_FUNCTION();
+
+      CompileJobResult out;
+
+      const SpirvCache::Key key =
+          cache ? SpirvCache::computeKey(job.stage, job.code.c_str(), job.options, batch->resource)
+                : SpirvCache::Key{};
+
+      if (cache && cache->find(key, out.spirv)) {
+        return out;
+      }
+
+      out.result =
+          compileShader(job.stage, job.code.c_str(), out.spirv, &batch->resource, job.options);
+
+      if (cache && out.result.isOk()) {
+        cache->insert(key, out.spirv);
+      }
+
+      return out;
+    }));
+  }
+
+  return futures;
+}
+
 void finalizeCompiler() noexcept {
   glslang_finalize_process();
 }
@@ -7,13 +7,21 @@
 
 #pragma once
 
+#include <future>
 #include <glslang/Include/glslang_c_interface.h>
+#include <string>
 #include <vector>
 #include <igl/Common.h>
 #include <igl/Shader.h>
 
+namespace igl {
+class ThreadPool;
+} // namespace igl
+
 namespace igl::glslang {
 
+class SpirvCache;
+
 void initializeCompiler() noexcept;
 
 /// Maps an IGL optimization strategy onto glslang's SPIR-V optimizer options. Exposed for testing;
@@ -30,6 +38,27 @@ void initializeCompiler() noexcept;
                                    const glslang_resource_t* glslLangResource,
                                    const ShaderCompilerOptions& options = {}) noexcept;
 
+struct CompileJob {
+  ShaderStage stage = ShaderStage::Fragment;
+  std::string code;
+  ShaderCompilerOptions options;
+};
+
+struct CompileJobResult {
+  Result result;
+  std::vector<uint32_t> spirv;
+};
+
+/// Compiles every job in `jobs` on the worker threads of `pool`. The returned futures are in the
+/// same order as `jobs`. The glslang process is kept initialized until the last job finishes, so
+/// the caller does not need to call initializeCompiler(). If `cache` is not null, it is consulted
+/// before compiling and populated with the results.
+[[nodiscard]] std::vector<std::future<CompileJobResult>> compileShaders(
+    ThreadPool& pool,
+    std::vector<CompileJob> jobs,
+    const glslang_resource_t& glslLangResource,
+    SpirvCache* IGL_NULLABLE cache = nullptr);
+
 void finalizeCompiler() noexcept;
 
 } // namespace igl::glslang
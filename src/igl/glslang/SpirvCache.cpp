@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/glslang/SpirvCache.h>
+
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+namespace igl::glslang {
+
+namespace {
+
+constexpr uint32_t kSpirvMagic = 0x07230203;
+// "IGLS"
+constexpr uint32_t kFileMagic = 0x534C4749;
+
+// every cache file is a FileHeader, the key material padded to 4 bytes and the SPIR-V binary
+struct FileHeader {
+  uint32_t magic = kFileMagic;
+  uint32_t version = SpirvCache::kCacheVersion;
+  uint32_t materialSize = 0;
+  uint32_t spirvSize = 0; // in words
+};
+
+size_t alignUp4(size_t size) {
+  return (size + 3) & ~size_t(3);
+}
+
+// 64-bit FNV-1a
+constexpr uint64_t kHashSeed = 14695981039346656037ull;
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) noexcept {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i != size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+template<typename T>
+void appendValue(std::string& material, const T& value) {
+  material.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+} // namespace
+
+SpirvCache::SpirvCache(size_t capacity, const char* IGL_NULLABLE directory) :
+  capacity_(capacity), directory_(directory ? directory : "") {}
+
+SpirvCache::Key SpirvCache::computeKey(ShaderStage stage,
+                                       const char* IGL_NONNULL source,
+                                       const ShaderCompilerOptions& options,
+                                       const glslang_resource_t& resource) {
+  const size_t sourceLength = strlen(source);
+
+  Key key;
+  key.material.reserve(sizeof(resource) + sourceLength + 16);
+  appendValue(key.material, kCacheVersion);
+  appendValue(key.material, static_cast<uint32_t>(stage));
+  appendValue(key.material, options.fastMathEnabled);
+  appendValue(key.material, static_cast<uint32_t>(options.optimization));
+  // `limits` is a struct of bools at the end of glslang_resource_t; append it separately so that
+  // the tail padding does not leak into the key
+  key.material.append(reinterpret_cast<const char*>(&resource),
+                      offsetof(glslang_resource_t, limits));
+  appendValue(key.material, resource.limits);
+  key.material.append(source, sourceLength);
+  key.hash = hashBytes(kHashSeed, key.material.data(), key.material.size());
+  return key;
+}
+
+std::string SpirvCache::getFilePath(uint64_t hash) const {
+  char name[32] = {};
+  snprintf(name, sizeof(name), "%016llx.spv", static_cast<unsigned long long>(hash));
+  return (std::filesystem::path(directory_) / name).string();
+}
+
+bool SpirvCache::readFile(const Key& key, std::vector<uint32_t>& outSPIRV) const {
+  std::ifstream file(getFilePath(key.hash), std::ios::binary | std::ios::ate);
+  if (!file) {
+    return false;
+  }
+  const auto size = static_cast<size_t>(static_cast<std::streamsize>(file.tellg()));
+  file.seekg(0, std::ios::beg);
+
+  FileHeader header;
+  if (size < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    return false;
+  }
+  const size_t materialSize = alignUp4(header.materialSize);
+  if (header.magic != kFileMagic || header.version != kCacheVersion ||
+      header.materialSize != key.material.size() || header.spirvSize == 0 ||
+      size != sizeof(header) + materialSize + header.spirvSize * sizeof(uint32_t)) {
+    return false;
+  }
+
+  // a different key whose hash collides with this one is a miss
+  std::string material(materialSize, '\0');
+  if (!file.read(material.data(), static_cast<std::streamsize>(materialSize)) ||
+      material.compare(0, key.material.size(), key.material) != 0) {
+    return false;
+  }
+
+  std::vector<uint32_t> spirv(header.spirvSize);
+  if (!file.read(reinterpret_cast<char*>(spirv.data()),
+                 static_cast<std::streamsize>(spirv.size() * sizeof(uint32_t))) ||
+      spirv[0] != kSpirvMagic) {
+    return false;
+  }
+
+  outSPIRV = std::move(spirv);
+  return true;
+}
+
+bool SpirvCache::find(const Key& key, std::vector<uint32_t>& outSPIRV) {
+  IGL_PROFILER_FUNCTION();
+
+  {
+    const std::lock_guard lock(mutex_);
+
+    auto it = entries_.find(key.hash);
+    if (it != entries_.end() && it->second->key.material == key.material) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      outSPIRV = it->second->spirv;
+      stats_.numHits++;
+      return true;
+    }
+  }
+
+  std::vector<uint32_t> spirv;
+  if (!directory_.empty() && readFile(key, spirv)) {
+    const std::lock_guard lock(mutex_);
+    insertIntoMemory(key, spirv);
+    stats_.numDiskHits++;
+    outSPIRV = std::move(spirv);
+    return true;
+  }
+
+  const std::lock_guard lock(mutex_);
+  stats_.numMisses++;
+  return false;
+}
+
+void SpirvCache::insert(const Key& key, const std::vector<uint32_t>& spirv) {
+  IGL_PROFILER_FUNCTION();
+
+  if (spirv.empty()) {
+    return;
+  }
+
+  {
+    const std::lock_guard lock(mutex_);
+    insertIntoMemory(key, spirv);
+  }
+
+  if (directory_.empty()) {
+    return;
+  }
+
+  const FileHeader header = {
+      .materialSize = static_cast<uint32_t>(key.material.size()),
+      .spirvSize = static_cast<uint32_t>(spirv.size()),
+  };
+  const std::string padding(alignUp4(key.material.size()) - key.material.size(), '\0');
+
+  // write to a temporary file first so that concurrent readers never see a partial binary
+  const std::string path = getFilePath(key.hash);
+  const std::string tmpPath =
+      path + "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) +
+      ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(key.material.data(), static_cast<std::streamsize>(key.material.size()));
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    if (!file.write(reinterpret_cast<const char*>(spirv.data()),
+                    static_cast<std::streamsize>(spirv.size() * sizeof(uint32_t)))) {
+      IGL_LOG_ERROR("Cannot write SPIR-V cache file %s\n", tmpPath.c_str());
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+  }
+}
+
+void SpirvCache::insertIntoMemory(const Key& key, const std::vector<uint32_t>& spirv) {
+  if (!capacity_) {
+    return;
+  }
+
+  auto it = entries_.find(key.hash);
+  if (it != entries_.end()) {
+    // replaces the entry of a colliding key
+    it->second->key = key;
+    it->second->spirv = spirv;
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return;
+  }
+
+  if (entries_.size() >= capacity_) {
+    entries_.erase(lru_.back().key.hash);
+    lru_.pop_back();
+  }
+
+  lru_.push_front({.key = key, .spirv = spirv});
+  entries_[key.hash] = lru_.begin();
+}
+
+void SpirvCache::clear() {
+  const std::lock_guard lock(mutex_);
+  lru_.clear();
+  entries_.clear();
+}
+
+size_t SpirvCache::size() const {
+  const std::lock_guard lock(mutex_);
+  return entries_.size();
+}
+
+SpirvCache::Stats SpirvCache::getStats() const {
+  const std::lock_guard lock(mutex_);
+  return stats_;
+}
+
+} // namespace igl::glslang
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <glslang/Include/glslang_c_interface.h>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <igl/Common.h>
+#include <igl/Shader.h>
+
+namespace igl::glslang {
+
+/**
+ * @brief A content-addressed cache of SPIR-V binaries produced by compileShader(). Entries are
+ * keyed on everything which affects the compiler output: the GLSL source, the shader stage, the
+ * compiler options and the glslang resource limits.
+ *
+ * The cache has two tiers: an in-memory LRU tier holding up to `capacity` binaries and an optional
+ * on-disk tier (one file per binary in `directory`) which survives across runs. Entries are looked
+ * up by the hash of the key, and the full key material is stored next to every binary and compared
+ * on lookup, so a hash collision is a miss rather than a wrong binary. All methods are thread-safe.
+ */
+class SpirvCache final {
+ public:
+  /// Bump this whenever the compiler setup changes in a way that makes cached binaries unusable
+  static constexpr uint32_t kCacheVersion = 2;
+
+  struct Key {
+    uint64_t hash = 0;
+    // the bytes `hash` was computed from
+    std::string material;
+  };
+
+  struct Stats {
+    uint32_t numHits = 0; // found in memory
+    uint32_t numDiskHits = 0; // found on disk
+    uint32_t numMisses = 0; // had to be compiled
+  };
+
+  /// @param capacity the maximum number of binaries kept in memory
+  /// @param directory an existing directory for the on-disk tier. Can be null or empty.
+  explicit SpirvCache(size_t capacity, const char* IGL_NULLABLE directory = nullptr);
+
+  [[nodiscard]] static Key computeKey(ShaderStage stage,
+                                      const char* IGL_NONNULL source,
+                                      const ShaderCompilerOptions& options,
+                                      const glslang_resource_t& resource);
+
+  /// @brief Looks up `key` in memory and then on disk. Entries found on disk are promoted to the
+  /// memory tier. Updates the hit/miss counters.
+  [[nodiscard]] bool find(const Key& key, std::vector<uint32_t>& outSPIRV);
+
+  /// @brief Adds a binary to both tiers, evicting the least recently used entry from memory.
+  void insert(const Key& key, const std::vector<uint32_t>& spirv);
+
+  /// @brief Drops the memory tier. Files on disk are kept.
+  void clear();
+
+  [[nodiscard]] size_t size() const;
+  [[nodiscard]] Stats getStats() const;
+
+ private:
+  [[nodiscard]] std::string getFilePath(uint64_t hash) const;
+  [[nodiscard]] bool readFile(const Key& key, std::vector<uint32_t>& outSPIRV) const;
+  void insertIntoMemory(const Key& key, const std::vector<uint32_t>& spirv);
+
+ private:
+  struct Entry {
+    Key key;
+    std::vector<uint32_t> spirv;
+  };
+
+  const size_t capacity_;
+  const std::string directory_;
+
+  mutable std::mutex mutex_;
+  // most recently used entries are at the front
+  std::list<Entry> lru_;
+  std::unordered_map<uint64_t, std::list<Entry>::iterator> entries_;
+  Stats stats_;
+};
+
+} // namespace igl::glslang
@@ -7,12 +7,19 @@
 
 #include <igl/opengl/Buffer.h>
 
+#include <cstring>
 #include <igl/Buffer.h>
 #include <igl/DeviceFeatures.h>
 #include <igl/Macros.h>
 
 namespace igl::opengl {
 
+namespace {
+constexpr GLbitfield kPersistentMapFlags =
+    GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+constexpr GLuint64 kSlotWaitTimeoutNs = 1000000000ull;
+} // namespace
+
 // ********************************
 // ****  ArrayBuffer
 // ********************************
@@ -29,11 +36,20 @@ ArrayBuffer::ArrayBuffer(IContext& context,
 
 ArrayBuffer::~ArrayBuffer() {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_DESTROY);
+  for (GLsync& fence : slotFences_) {
+    if (fence != nullptr) {
+      getContext().deleteSync(fence);
+      fence = nullptr;
+    }
+  }
   if (iD_ != 0) {
+    // deleting the buffer also unmaps it
     getContext().deleteBuffers(1, &iD_);
     getContext().unbindBuffer(target_);
+    getContext().removeBufferMemoryUsage(getAllocatedSize());
     iD_ = 0;
   }
+  mappedPtr_ = nullptr;
   size_ = 0;
   isDynamic_ = false;
 }
@@ -94,8 +110,25 @@ void ArrayBuffer::initialize(const BufferDesc& desc, Result* IGL_NULLABLE outRes
 
   size_ = desc.length;
 
+  if (canStream(desc)) {
+    size_t alignment = 16;
+    getContext().deviceFeatures().getFeatureLimits(DeviceFeatureLimits::BufferAlignment,
+                                                   alignment);
+    slotStride_ = (size_ + alignment - 1) / alignment * alignment;
+    shadow_.resize(size_);
+  }
+
+  bool isMapped = true;
   getContext().bindBuffer(target_, iD_);
-  getContext().bufferData(target_, size_, desc.data, usage);
+  if (!isStreaming()) {
+    getContext().bufferData(target_, size_, desc.data, usage);
+  } else if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::BufferStorage)) {
+    getContext().bufferStorage(target_, getAllocatedSize(), nullptr, kPersistentMapFlags);
+    mappedPtr_ = getContext().mapBufferRange(target_, 0, getAllocatedSize(), kPersistentMapFlags);
+    isMapped = mappedPtr_ != nullptr;
+  } else {
+    getContext().bufferData(target_, getAllocatedSize(), nullptr, GL_STREAM_DRAW);
+  }
 
   // make sure the buffer was fully allocated
   GLint bufferSize = 0;
@@ -113,16 +146,84 @@ void ArrayBuffer::initialize(const BufferDesc& desc, Result* IGL_NULLABLE outRes
 
   getContext().bindBuffer(target_, 0);
 
-  if (bufferSize != size_) {
+  if (bufferSize != getAllocatedSize()) {
     getContext().deleteBuffers(1, &iD_);
     iD_ = 0;
     Result::setResult(outResult, Result::Code::ArgumentOutOfRange, "bufferSize != dataSize");
     return;
   }
+  if (!isMapped) {
+    getContext().deleteBuffers(1, &iD_);
+    iD_ = 0;
+    Result::setResult(outResult, Result::Code::RuntimeError, "Failed to map streaming buffer");
+    return;
+  }
+
+  getContext().addBufferMemoryUsage(getAllocatedSize());
+
+  if (isStreaming() && desc.data != nullptr) {
+    memcpy(shadow_.data(), desc.data, size_);
+    writeSlot(desc.data, 0, size_);
+  }
 
   Result::setOk(outResult);
 }
 
+bool ArrayBuffer::canStream(const BufferDesc& desc) const {
+  const DeviceFeatureSet& features = getContext().deviceFeatures();
+  return (desc.hint & BufferDesc::BufferAPIHintBits::Ring) != 0 && isDynamic_ && desc.length != 0 &&
+         // the GPU must not write to streaming buffers, as uploads only go to the current slot
+         (target_ == GL_ARRAY_BUFFER || target_ == GL_ELEMENT_ARRAY_BUFFER ||
+          target_ == GL_UNIFORM_BUFFER) &&
+         features.hasInternalFeature(InternalFeatures::Sync) &&
+         !features.hasInternalRequirement(InternalRequirement::SyncExtReq) &&
+         features.hasFeature(DeviceFeatures::MapBufferRange);
+}
+
+void ArrayBuffer::advanceSlot() {
+  IGL_PROFILER_FUNCTION();
+  IContext& ctx = getContext();
+
+  // the GPU can read the current slot until all commands issued so far have completed
+  slotFences_[currentSlot_] = ctx.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  currentSlot_ = (currentSlot_ + 1) % kNumStreamingSlots;
+  isCurrentSlotInUse_ = false;
+
+  GLsync& fence = slotFences_[currentSlot_];
+  if (fence != nullptr) {
+    // only blocks if the CPU is kNumStreamingSlots uploads ahead of the GPU
+    GLenum status = GL_TIMEOUT_EXPIRED;
+    while (status == GL_TIMEOUT_EXPIRED) {
+      status = ctx.clientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, kSlotWaitTimeoutNs);
+    }
+    ctx.deleteSync(fence);
+    fence = nullptr;
+  }
+}
+
+void ArrayBuffer::writeSlot(const void* IGL_NONNULL data, size_t offset, size_t size) {
+  const size_t slotOffset = getBindOffset() + offset;
+  if (mappedPtr_ != nullptr) {
+    memcpy(static_cast<uint8_t*>(mappedPtr_) + slotOffset, data, size);
+    return;
+  }
+
+  // the fence in advanceSlot() guarantees the GPU no longer reads this slot
+  getContext().bindBuffer(target_, iD_);
+  void* dst = getContext().mapBufferRange(
+      target_,
+      static_cast<GLintptr>(slotOffset),
+      static_cast<GLsizeiptr>(size),
+      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+  if (dst != nullptr) {
+    memcpy(dst, data, size);
+    getContext().unmapBuffer(target_);
+  } else {
+    getContext().bufferSubData(target_, slotOffset, size, data);
+  }
+  getContext().bindBuffer(target_, 0);
+}
+
 // upload data to the buffer at the given offset with the given size
 Result ArrayBuffer::upload(const void* data, const BufferRange& range) {
   IGL_PROFILER_FUNCTION();
@@ -131,6 +232,26 @@ Result ArrayBuffer::upload(const void* data, const BufferRange& range) {
     return Result(Result::Code::InvalidOperation, "Can't upload to static buffers");
   }
 
+  if (isStreaming()) {
+    if (range.offset + range.size > size_) {
+      return Result(Result::Code::ArgumentOutOfRange, "upload() size + offset must be <= size");
+    }
+    if (range.size == 0) {
+      return Result();
+    }
+    memcpy(shadow_.data() + range.offset, data, range.size);
+    if (isCurrentSlotInUse_) {
+      advanceSlot();
+      if (range.size != size_) {
+        // the new slot holds outdated contents
+        writeSlot(shadow_.data(), 0, size_);
+        return Result();
+      }
+    }
+    writeSlot(data, range.offset, range.size);
+    return Result();
+  }
+
   getContext().bindBuffer(target_, iD_);
 
   getContext().bufferSubData(target_, range.offset, range.size, data);
@@ -148,6 +269,11 @@ void* FOLLY_NULLABLE ArrayBuffer::map(const BufferRange& range, Result* IGL_NULL
     return nullptr;
   }
 
+  if (isStreaming()) {
+    Result::setOk(outResult);
+    return shadow_.data() + range.offset;
+  }
+
   bind();
 
   void* srcData = nullptr;
@@ -164,6 +290,9 @@ void* FOLLY_NULLABLE ArrayBuffer::map(const BufferRange& range, Result* IGL_NULL
 
 void ArrayBuffer::unmap() {
   IGL_PROFILER_FUNCTION();
+  if (isStreaming()) {
+    return;
+  }
   bind();
   getContext().unmapBuffer(target_);
 }
@@ -172,6 +301,7 @@ void ArrayBuffer::unmap() {
 void ArrayBuffer::bind() {
   IGL_PROFILER_FUNCTION();
   getContext().bindBuffer(target_, iD_);
+  markCurrentSlotInUse();
 }
 
 void ArrayBuffer::unbind() {
@@ -189,12 +319,14 @@ void ArrayBuffer::bindBase(IGL_MAYBE_UNUSED size_t index, Result* IGL_NULLABLE o
   }
   getContext().bindBuffer(target_, iD_);
   getContext().bindBufferBase(target_, static_cast<GLuint>(index), iD_);
+  markCurrentSlotInUse();
   Result::setOk(outResult);
 }
 
 void ArrayBuffer::bindForTarget(GLenum target) {
   IGL_PROFILER_FUNCTION();
   getContext().bindBuffer(target, iD_);
+  markCurrentSlotInUse();
 }
 
 void UniformBlockBuffer::setBlockBinding(GLuint pid, GLuint blockIndex, GLuint bindingPoint) {
@@ -211,7 +343,12 @@ void UniformBlockBuffer::bindBase(size_t index, Result* IGL_NULLABLE outResult)
       Result::setResult(outResult, Result::Code::InvalidOperation, kErrorMsg);
       return;
     }
+    if (isStreaming()) {
+      bindRange(index, 0, 0, outResult);
+      return;
+    }
     getContext().bindBufferBase(target_, static_cast<GLuint>(index), iD_);
+    markCurrentSlotInUse();
     Result::setOk(outResult);
   } else {
     static constexpr const char* kErrorMsg = "Uniform Blocks are not supported";
@@ -241,8 +378,9 @@ void UniformBlockBuffer::bindRange(size_t index,
     getContext().bindBufferRange(target_,
                                  static_cast<GLuint>(index),
                                  iD_,
-                                 static_cast<GLintptr>(offset),
+                                 static_cast<GLintptr>(getBindOffset() + offset),
                                  size ? size : getSizeInBytes() - offset);
+    markCurrentSlotInUse();
     Result::setOk(outResult);
   } else {
     static constexpr const char* kErrorMsg = "Uniform Blocks are not supported";
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <array>
+#include <vector>
 #include <igl/Buffer.h>
 #include <igl/opengl/IContext.h>
 #include <igl/opengl/WithContext.h>
@@ -45,8 +47,21 @@ class Buffer : public WithContext, public IBuffer {
   BufferDesc::BufferType bufferType_ = 0;
 };
 
+/**
+ * @brief A GL buffer object for vertex, index, indirect, storage and uniform block data.
+ *
+ * Shared buffers created with BufferDesc::BufferAPIHintBits::Ring are streaming buffers: the GL
+ * buffer holds kNumStreamingSlots copies of the contents. When upload() is called after the current
+ * copy was bound, it continues in the next copy, so it never has to wait for the GPU to finish
+ * reading the previous one. With glBufferStorage, all copies stay persistently mapped and upload()
+ * is a memcpy(); otherwise each upload maps its range with GL_MAP_UNSYNCHRONIZED_BIT. A fence per
+ * copy guards its reuse. Bind offsets have to include getBindOffset(), and a streaming buffer has
+ * to be bound again after an upload for the draw calls to use the new contents.
+ */
 class ArrayBuffer : public Buffer {
  public:
+  static constexpr uint32_t kNumStreamingSlots = 3;
+
   ArrayBuffer(IContext& context,
               BufferDesc::BufferAPIHint requestedApiHints,
               BufferDesc::BufferType bufferType);
@@ -62,13 +77,28 @@ class ArrayBuffer : public Buffer {
   void unmap() override;
 
   [[nodiscard]] BufferDesc::BufferAPIHint acceptedApiHints() const noexcept override {
-    return 0;
+    return isStreaming() ? BufferDesc::BufferAPIHintBits::Ring : 0;
   }
 
   [[nodiscard]] ResourceStorage storage() const noexcept override {
     return ResourceStorage::Managed;
   }
 
+  [[nodiscard]] bool isStreaming() const noexcept {
+    return slotStride_ != 0;
+  }
+
+  /// @brief True if the streaming copies are persistently mapped with glBufferStorage
+  [[nodiscard]] bool isPersistentlyMapped() const noexcept {
+    return mappedPtr_ != nullptr;
+  }
+
+  /// @brief The offset of the current copy of the contents in the GL buffer. This is 0 for
+  /// buffers which are not streaming.
+  [[nodiscard]] size_t getBindOffset() const noexcept {
+    return currentSlot_ * slotStride_;
+  }
+
   [[nodiscard]] size_t getSizeInBytes() const override {
     return size_;
   }
@@ -102,10 +132,32 @@ class ArrayBuffer : public Buffer {
   // this must be set by each derived object during construction
   GLenum target_{};
 
+  // must be called whenever the GPU can read from the buffer
+  void markCurrentSlotInUse() noexcept {
+    isCurrentSlotInUse_ = true;
+  }
+
  private:
+  [[nodiscard]] bool canStream(const BufferDesc& desc) const;
+  [[nodiscard]] size_t getAllocatedSize() const noexcept {
+    return isStreaming() ? slotStride_ * kNumStreamingSlots : size_;
+  }
+  void advanceSlot();
+  void writeSlot(const void* IGL_NONNULL data, size_t offset, size_t size);
+
   size_t size_ = 0;
 
   bool isDynamic_ = false;
+
+  // streaming buffers only
+  size_t slotStride_ = 0;
+  uint32_t currentSlot_ = 0;
+  bool isCurrentSlotInUse_ = false;
+  // persistently mapped with glBufferStorage, null otherwise
+  void* IGL_NULLABLE mappedPtr_ = nullptr;
+  std::array<GLsync IGL_NULLABLE, kNumStreamingSlots> slotFences_ = {};
+  // a CPU copy of the contents which fills the next slot after partial uploads and serves map()
+  std::vector<uint8_t> shadow_;
 };
 
 class UniformBlockBuffer : public ArrayBuffer {
@@ -124,7 +176,7 @@ class UniformBlockBuffer : public ArrayBuffer {
   void bindRange(size_t index, size_t offset, size_t size, Result* IGL_NULLABLE outResult);
 
   [[nodiscard]] BufferDesc::BufferAPIHint acceptedApiHints() const noexcept override {
-    return BufferDesc::BufferAPIHintBits::UniformBlock;
+    return BufferDesc::BufferAPIHintBits::UniformBlock | ArrayBuffer::acceptedApiHints();
   }
 };
 
@@ -84,10 +84,16 @@ void CommandBuffer::copyBuffer(IBuffer& src,
 
   auto& srcBuffer = static_cast<ArrayBuffer&>(src);
   auto& dstBuffer = static_cast<ArrayBuffer&>(dst);
+  // the GPU copy would not reach the CPU copy kept by streaming buffers
+  IGL_DEBUG_ASSERT(!dstBuffer.isStreaming(), "Cannot copy into a streaming buffer");
 
   ctx.bindBuffer(GL_COPY_READ_BUFFER, srcBuffer.getId());
   ctx.bindBuffer(GL_COPY_WRITE_BUFFER, dstBuffer.getId());
-  ctx.copyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, srcOffset, dstOffset, size);
+  ctx.copyBufferSubData(GL_COPY_READ_BUFFER,
+                        GL_COPY_WRITE_BUFFER,
+                        srcBuffer.getBindOffset() + srcOffset,
+                        dstOffset,
+                        size);
   ctx.bindBuffer(GL_COPY_READ_BUFFER, 0);
   ctx.bindBuffer(GL_COPY_WRITE_BUFFER, 0);
 }
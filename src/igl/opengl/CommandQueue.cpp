@@ -36,7 +36,7 @@ std::shared_ptr<ICommandBuffer> CommandQueue::createCommandBuffer(const CommandB
   return commandBuffer;
 }
 
-SubmitHandle CommandQueue::submit(const ICommandBuffer& commandBuffer, bool /* endOfFrame */) {
+SubmitHandle CommandQueue::submit(const ICommandBuffer& commandBuffer, bool endOfFrame) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
   const auto& cb = static_cast<const CommandBuffer&>(commandBuffer);
   incrementDrawCount(cb.getCurrentDrawCount());
@@ -46,6 +46,10 @@ SubmitHandle CommandQueue::submit(const ICommandBuffer& commandBuffer, bool /* e
 
   activeCommandBuffers_--;
 
+  if (endOfFrame) {
+    cb.getContext().endStateCacheFrame();
+  }
+
   return SubmitHandle{};
 }
 
@@ -17,6 +17,7 @@
 #include <igl/opengl/Framebuffer.h>
 #include <igl/opengl/FramebufferWrapper.h>
 #include <igl/opengl/IContext.h>
+#include <igl/opengl/PixelReadbackQueue.h>
 #include <igl/opengl/RenderPipelineState.h>
 #include <igl/opengl/SamplerState.h>
 #include <igl/opengl/Shader.h>
@@ -350,6 +351,7 @@ BackendVersion Device::getBackendVersion() const {
 
 void Device::beginScope() {
   IGL_PROFILER_FUNCTION();
+  const bool isOutermostScope = !IDevice::verifyScope();
   IDevice::beginScope();
 
   IGL_DEBUG_ASSERT(context_);
@@ -357,6 +359,12 @@ void Device::beginScope() {
 
   // UnbindPolicy is fixed for duration of this scope
   cachedUnbindPolicy_ = getContext().getUnbindPolicy();
+
+  if (isOutermostScope) {
+    // External rendering may have changed the GL state since the last scope, whatever the unbind
+    // policy is. This only resets the shadowed state, which costs a few redundant calls per scope.
+    context_->invalidateStateCache();
+  }
 }
 
 void Device::endScope() {
@@ -394,6 +402,14 @@ size_t Device::getShaderCompilationCount() const {
   return context_->getShaderCompilationCount();
 }
 
+size_t Device::getGPUMemoryUsage() const {
+  return context_->getGPUMemoryUsage().total;
+}
+
+GPUMemoryUsage Device::getGPUMemoryUsageBreakdown() const {
+  return context_->getGPUMemoryUsage();
+}
+
 Holder<BindGroupTextureHandle> Device::createBindGroup(
     const BindGroupTextureDesc& desc,
     const IRenderPipelineState* IGL_NULLABLE /*compatiblePipeline*/,
@@ -472,6 +488,24 @@ std::shared_ptr<ITimestampQueries> Device::createTimestampQueries(uint32_t maxTi
   return queries;
 }
 
+std::unique_ptr<PixelReadbackQueue> Device::createPixelReadbackQueue(
+    uint32_t numBuffers,
+    Result* IGL_NULLABLE outResult) const {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+  if (numBuffers == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "numBuffers must not be 0");
+    return nullptr;
+  }
+  if (!PixelReadbackQueue::isSupported(getContext())) {
+    Result::setResult(outResult,
+                      Result::Code::Unsupported,
+                      "Pixel buffer objects or sync objects are not supported");
+    return nullptr;
+  }
+  Result::setOk(outResult);
+  return std::make_unique<PixelReadbackQueue>(getContext(), numBuffers);
+}
+
 void Device::destroy(BindGroupTextureHandle handle) {
   IGL_PROFILER_FUNCTION();
   if (handle.empty()) {
@@ -15,6 +15,7 @@
 
 namespace igl::opengl {
 class CommandQueue;
+class PixelReadbackQueue;
 
 class Device : public IDevice {
   friend class HWDevice;
@@ -102,6 +103,11 @@ class Device : public IDevice {
                                                             Result* IGL_NULLABLE
                                                                 outResult) const noexcept override;
 
+  // Asynchronous readback of framebuffer attachments, see PixelReadbackQueue
+  std::unique_ptr<PixelReadbackQueue> createPixelReadbackQueue(
+      uint32_t numBuffers,
+      Result* IGL_NULLABLE outResult) const;
+
   // debug markers useful in GPU captures
   void pushMarker(int len, const char* IGL_NULLABLE name);
   void popMarker();
@@ -126,6 +132,8 @@ class Device : public IDevice {
   // Device Statistics
   [[nodiscard]] size_t getCurrentDrawCount() const override;
   [[nodiscard]] size_t getShaderCompilationCount() const override;
+  [[nodiscard]] size_t getGPUMemoryUsage() const override;
+  [[nodiscard]] GPUMemoryUsage getGPUMemoryUsageBreakdown() const override;
 
   bool verifyScope() override;
 
@@ -316,6 +316,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasDesktopExtension(*this, "GL_ARB_bindless_texture");
   case Extensions::BindlessTextureNv:
     return hasDesktopOrESExtension(*this, "GL_NV_bindless_texture");
+  case Extensions::BufferStorage:
+    return hasESExtension(*this, "GL_EXT_buffer_storage");
   case Extensions::Debug:
     return hasDesktopOrESExtension(*this, "GL_KHR_debug");
   case Extensions::DebugLabel:
@@ -354,6 +356,8 @@ bool DeviceFeatureSet::isExtensionSupported(Extensions extension) const {
     return hasESExtension(*this, "GL_IMG_multisampled_render_to_texture");
   case Extensions::MultiViewMultiSample:
     return hasESExtension(*this, "GL_OVR_multiview_multisampled_render_to_texture");
+  case Extensions::ParallelShaderCompile:
+    return hasDesktopOrESExtension(*this, "GL_KHR_parallel_shader_compile");
   case Extensions::PolygonOffsetClamp:
     return hasDesktopOrESExtension(*this, "GL_ARB_polygon_offset_clamp");
   case Extensions::RequiredInternalFormat:
@@ -646,6 +650,10 @@ bool DeviceFeatureSet::isFeatureSupported(DeviceFeatures feature) const {
 bool DeviceFeatureSet::isInternalFeatureSupportedBufferGroup(InternalFeatures feature) const {
   // NOLINTNEXTLINE(clang-diagnostic-switch-enum)
   switch (feature) {
+  case InternalFeatures::BufferStorage:
+    return hasDesktopVersionOrExtension(*this, GLVersion::v4_4, "GL_ARB_buffer_storage") ||
+           hasExtension(Extensions::BufferStorage);
+
   case InternalFeatures::DrawArraysIndirect:
     return hasDesktopOrESVersionOrExtension(
         *this, GLVersion::v4_0, GLVersion::v3_1_ES, "GL_ARB_draw_indirect");
@@ -763,6 +771,10 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
   case InternalFeatures::PolygonFillMode:
     return hasDesktopVersion(*this, GLVersion::v2_0);
 
+  case InternalFeatures::ProgramBinary:
+    return hasDesktopOrESVersion(*this, GLVersion::v4_1, GLVersion::v3_0_ES) ||
+           hasDesktopExtension(*this, "GL_ARB_get_program_binary");
+
   case InternalFeatures::ProgramInterfaceQuery:
     return hasDesktopOrESVersion(*this, GLVersion::v4_3, GLVersion::v3_1_ES) ||
            hasDesktopExtension(*this, "GL_ARB_program_interface_query");
@@ -774,6 +786,7 @@ bool DeviceFeatureSet::isInternalFeatureSupported(InternalFeatures feature) cons
     return hasDesktopOrESVersion(*this, GLVersion::v3_2, GLVersion::v3_0_ES) ||
            hasDesktopExtension(*this, "GL_ARB_sync") || hasExtension(Extensions::Sync);
 
+  case InternalFeatures::BufferStorage:
   case InternalFeatures::DrawArraysIndirect:
   case InternalFeatures::MultiDrawIndirect:
   case InternalFeatures::MapBuffer:
@@ -1416,6 +1429,10 @@ bool DeviceFeatureSet::hasInternalRequirementColorGroup(InternalRequirement requ
 bool DeviceFeatureSet::hasInternalRequirementMiscGroup(InternalRequirement requirement) const {
   // NOLINTNEXTLINE(clang-diagnostic-switch-enum)
   switch (requirement) {
+  case InternalRequirement::BufferStorageExtReq:
+    // no version of OpenGL ES includes glBufferStorage
+    return usesOpenGLES();
+
   case InternalRequirement::DrawBuffersExtReq:
     return usesOpenGLES() && !hasESVersion(*this, GLVersion::v3_0_ES);
 
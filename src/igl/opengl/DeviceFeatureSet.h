@@ -23,6 +23,7 @@ enum class Extensions {
   AppleRgb422,                // GL_APPLE_rgb_422 is supported
   BindlessTextureArb,         // GL_ARB_bindless_texture is supported
   BindlessTextureNv,          // GL_NV_bindless_texture is supported
+  BufferStorage,              // GL_EXT_buffer_storage is supported
   Debug,                      // GL_KHR_debug is supported
   DebugLabel,                 // GL_EXT_debug_label is supported
   DebugMarker,                // GL_EXT_debug_marker is supported
@@ -42,6 +43,7 @@ enum class Extensions {
   MultiSampleExt2,            // GL_EXT_multisampled_render_to_texture2 is supported
   MultiSampleImg,             // GL_IMG_multisampled_render_to_texture is supported
   MultiViewMultiSample,       // GL_OVR_multiview_multisampled_render_to_texture is supported
+  ParallelShaderCompile,      // GL_KHR_parallel_shader_compile is supported
   PolygonOffsetClamp,         // GL_ARB_polygon_offset_clamp is supported
   RequiredInternalFormat,     // GL_OES_required_internalformat is supported
   ShaderImageLoadStore,       // GL_EXT_shader_image_load_store is supported
@@ -66,6 +68,7 @@ enum class Extensions {
 
 // clang-format off
 enum class InternalFeatures {
+  BufferStorage,             // glBufferStorage is supported
   ClearBufferfv,             // glClearBufferfv is supported
   ClearDepthf,               // glClearDepthf is supported
   DebugLabel,                // Debug labels on objects are supported
@@ -81,6 +84,7 @@ enum class InternalFeatures {
   PackRowLength,             // GL_PACK_ROW_LENGTH is supported with glPixelStorei
   PixelBufferObject,         // PBOs are available
   PolygonFillMode,           // glPolygonFillMode is supported
+  ProgramBinary,             // glGetProgramBinary and glProgramBinary are supported
   ProgramInterfaceQuery,     // Querying info about shader program interfaces is supported
   SeamlessCubeMap,           // GL_TEXTURE_CUBE_MAP_SEAMLESS is supported
   ShaderImageLoadStore,      // Shader image load/store is supported
@@ -162,6 +166,7 @@ enum class TextureFeatures {
 // clang-format on
 
 enum class InternalRequirement {
+  BufferStorageExtReq,
   ColorTexImageRgb10A2Unsized,
   ColorTexImageRgb5A1Unsized,
   ColorTexImageRgba4Unsized,
@@ -278,6 +278,14 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* unused */,
                                            const TextureRangeDesc& range,
                                            size_t bytesPerRow) const {
   IGL_PROFILER_FUNCTION();
+  readColorAttachment(index, pixelBytes, range, bytesPerRow);
+}
+
+void Framebuffer::readColorAttachment(size_t index,
+                                      void* IGL_NULLABLE pixelBytes,
+                                      const TextureRangeDesc& range,
+                                      size_t bytesPerRow) const {
+  IGL_PROFILER_FUNCTION();
   // Only support attachment 0 because that's what glReadPixels supports
   if (index != 0) {
     IGL_DEBUG_ABORT("Invalid index: %d", index);
@@ -48,6 +48,14 @@ class Framebuffer : public WithContext, public IFramebuffer {
                                 const TextureRangeDesc& range,
                                 size_t bytesPerRow = 0) const override;
 
+  /// @brief Reads a color attachment with glReadPixels(). If a buffer is bound to
+  /// GL_PIXEL_PACK_BUFFER, `pixelBytes` is an offset into that buffer and the call returns without
+  /// waiting for the GPU. See PixelReadbackQueue.
+  void readColorAttachment(size_t index,
+                           void* IGL_NULLABLE pixelBytes,
+                           const TextureRangeDesc& range,
+                           size_t bytesPerRow = 0) const;
+
   void copyBytesDepthAttachment(ICommandQueue& /* unused */,
                                 void* pixelBytes,
                                 const TextureRangeDesc& range,
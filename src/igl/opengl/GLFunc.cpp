@@ -543,6 +543,20 @@ void iglMakeTextureHandleNonResidentARB(GLuint64 handle) {
                           handle);
 }
 
+///--------------------------------------
+/// MARK: - GL_ARB_buffer_storage
+
+#if defined(GL_VERSION_4_4) || defined(GL_ARB_buffer_storage)
+#define CAN_CALL_glBufferStorage CAN_CALL
+#else
+#define CAN_CALL_glBufferStorage 0
+#endif
+
+void iglBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+  GLEXTENSION_METHOD_BODY(
+      CAN_CALL_glBufferStorage, glBufferStorage, PFNIGLBUFFERSTORAGEPROC, target, size, data, flags);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_compute_shader
 
@@ -906,6 +920,53 @@ void iglRenderbufferStorageMultisample(GLenum target,
                             internalformat,
                             width,
                             height)}
+///--------------------------------------
+/// MARK: - GL_ARB_get_program_binary
+
+#if defined(GL_VERSION_4_1) || defined(GL_ES_VERSION_3_0) || defined(GL_ARB_get_program_binary)
+#define CAN_CALL_glGetProgramBinary CAN_CALL
+#define CAN_CALL_glProgramBinary CAN_CALL
+#define CAN_CALL_glProgramParameteri CAN_CALL
+#else
+#define CAN_CALL_glGetProgramBinary 0
+#define CAN_CALL_glProgramBinary 0
+#define CAN_CALL_glProgramParameteri 0
+#endif
+
+void iglGetProgramBinary(GLuint program,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLenum* binaryFormat,
+                         void* binary) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glGetProgramBinary,
+                          glGetProgramBinary,
+                          PFNIGLGETPROGRAMBINARYPROC,
+                          program,
+                          bufSize,
+                          length,
+                          binaryFormat,
+                          binary);
+}
+
+void iglProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramBinary,
+                          glProgramBinary,
+                          PFNIGLPROGRAMBINARYPROC,
+                          program,
+                          binaryFormat,
+                          binary,
+                          length);
+}
+
+void iglProgramParameteri(GLuint program, GLenum pname, GLint value) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glProgramParameteri,
+                          glProgramParameteri,
+                          PFNIGLPROGRAMPARAMETERIPROC,
+                          program,
+                          pname,
+                          value);
+}
+
 ///--------------------------------------
 /// MARK: - GL_ARB_invalidate_subdata
 
@@ -1294,6 +1355,25 @@ void iglPolygonOffsetClamp(float factor, float units, float clamp) {
                           clamp);
 }
 
+///--------------------------------------
+/// MARK: - GL_EXT_buffer_storage
+
+#if defined(GL_EXT_buffer_storage)
+#define CAN_CALL_glBufferStorageEXT CAN_CALL
+#else
+#define CAN_CALL_glBufferStorageEXT 0
+#endif
+
+void iglBufferStorageEXT(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glBufferStorageEXT,
+                          glBufferStorageEXT,
+                          PFNIGLBUFFERSTORAGEPROC,
+                          target,
+                          size,
+                          data,
+                          flags);
+}
+
 ///--------------------------------------
 /// MARK: - GL_EXT_debug_label
 
@@ -1797,6 +1877,22 @@ void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar
                           message);
 }
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+#if defined(GL_KHR_parallel_shader_compile)
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR CAN_CALL
+#else
+#define CAN_CALL_glMaxShaderCompilerThreadsKHR 0
+#endif
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count) {
+  GLEXTENSION_METHOD_BODY(CAN_CALL_glMaxShaderCompilerThreadsKHR,
+                          glMaxShaderCompilerThreadsKHR,
+                          PFNIGLMAXSHADERCOMPILERTHREADSPROC,
+                          count);
+}
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
@@ -55,6 +55,10 @@ using PFNIGLBLITFRAMEBUFFERPROC = void (*)(GLint srcX0,
                                            GLint dstY1,
                                            GLbitfield mask,
                                            GLenum filter);
+using PFNIGLBUFFERSTORAGEPROC = void (*)(GLenum target,
+                                         GLsizeiptr size,
+                                         const void* data,
+                                         GLbitfield flags);
 using PFNIGLCHECKFRAMEBUFFERSTATUSPROC = GLenum (*)(GLenum target);
 using PFNIGLCLEARBUFFERFVPROC = void (*)(GLenum buffer, GLint drawBuffer, const GLfloat* value);
 using PFNIGLCLEARDEPTHPROC = void (*)(GLdouble depth);
@@ -176,6 +180,11 @@ using PFNIGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC = void (*)(GLenum target,
                                                                GLenum attachment,
                                                                GLenum pname,
                                                                GLint* params);
+using PFNIGLGETPROGRAMBINARYPROC = void (*)(GLuint program,
+                                            GLsizei bufSize,
+                                            GLsizei* length,
+                                            GLenum* binaryFormat,
+                                            void* binary);
 using PFNIGLGETPROGRAMINTERFACEIVPROC = void (*)(GLuint program,
                                                  GLenum programInterface,
                                                  GLenum pname,
@@ -222,12 +231,18 @@ using PFNIGLMAPBUFFERRANGEPROC = void* (*)(GLenum target,
                                            GLintptr offset,
                                            GLsizeiptr length,
                                            GLbitfield access);
+using PFNIGLMAXSHADERCOMPILERTHREADSPROC = void (*)(GLuint count);
 using PFNIGLMEMORYBARRIERPROC = void (*)(GLbitfield barriers);
 using PFNIGLOBJECTLABELPROC = void (*)(GLenum identifier,
                                        GLuint name,
                                        GLsizei length,
                                        const char* label);
 using PFNIGLPOPDEBUGGROUPPROC = void (*)();
+using PFNIGLPROGRAMBINARYPROC = void (*)(GLuint program,
+                                         GLenum binaryFormat,
+                                         const void* binary,
+                                         GLsizei length);
+using PFNIGLPROGRAMPARAMETERIPROC = void (*)(GLuint program, GLenum pname, GLint value);
 using PFNIGLPOPGROUPMARKERPROC = void (*)();
 using PFNIGLPUSHDEBUGGROUPPROC = void (*)(GLenum source,
                                           GLuint id,
@@ -403,6 +418,11 @@ GLuint64 iglGetTextureHandleARB(GLuint texture);
 void iglMakeTextureHandleResidentARB(GLuint64 handle);
 void iglMakeTextureHandleNonResidentARB(GLuint64 handle);
 
+///--------------------------------------
+/// MARK: - GL_ARB_buffer_storage
+
+void iglBufferStorage(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_compute_shader
 
@@ -484,6 +504,17 @@ void iglRenderbufferStorageMultisample(GLenum target,
                                        GLsizei width,
                                        GLsizei height);
 
+///--------------------------------------
+/// MARK: - GL_ARB_get_program_binary
+
+void iglGetProgramBinary(GLuint program,
+                         GLsizei bufSize,
+                         GLsizei* length,
+                         GLenum* binaryFormat,
+                         void* binary);
+void iglProgramBinary(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+void iglProgramParameteri(GLuint program, GLenum pname, GLint value);
+
 ///--------------------------------------
 /// MARK: - GL_ARB_invalidate_subdata
 
@@ -585,6 +616,11 @@ void iglGenVertexArrays(GLsizei n, GLuint* vertexArrays);
 
 void iglPolygonOffsetClamp(float factor, float units, float clamp);
 
+///--------------------------------------
+/// MARK: - GL_EXT_buffer_storage
+
+void iglBufferStorageEXT(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
 ///--------------------------------------
 /// MARK: - GL_EXT_debug_label
 
@@ -739,6 +775,11 @@ void iglObjectLabelKHR(GLenum identifier, GLuint name, GLsizei length, const cha
 void iglPopDebugGroupKHR();
 void iglPushDebugGroupKHR(GLenum source, GLuint id, GLsizei length, const GLchar* message);
 
+///--------------------------------------
+/// MARK: - GL_KHR_parallel_shader_compile
+
+void iglMaxShaderCompilerThreadsKHR(GLuint count);
+
 ///--------------------------------------
 /// MARK: - GL_NV_bindless_texture
 
@@ -79,6 +79,9 @@
 #ifndef GL_ALPHA8
 #define GL_ALPHA8 0x803C
 #endif
+#ifndef GL_ALREADY_SIGNALED
+#define GL_ALREADY_SIGNALED 0x911a
+#endif
 #ifndef GL_ATOMIC_COUNTER_BARRIER_BIT
 #define GL_ATOMIC_COUNTER_BARRIER_BIT 0x1000
 #endif
@@ -127,6 +130,9 @@
 #ifndef GL_COMPARE_REF_TO_TEXTURE
 #define GL_COMPARE_REF_TO_TEXTURE 0x884e
 #endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
 #ifndef GL_COMPRESSED_R11_EAC
 #define GL_COMPRESSED_R11_EAC 0x9270
 #endif
@@ -262,6 +268,9 @@
 #ifndef GL_COMPUTE_SHADER
 #define GL_COMPUTE_SHADER 0x91B9
 #endif
+#ifndef GL_CONDITION_SATISFIED
+#define GL_CONDITION_SATISFIED 0x911c
+#endif
 #ifndef GL_COPY_READ_BUFFER
 #define GL_COPY_READ_BUFFER 0x8f36
 #endif
@@ -556,6 +565,9 @@
 #ifndef GL_NUM_EXTENSIONS
 #define GL_NUM_EXTENSIONS 0x821d
 #endif
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87fe
+#endif
 #ifndef GL_PACK_ROW_LENGTH
 #define GL_PACK_ROW_LENGTH 0x0d02
 #endif
@@ -571,6 +583,12 @@
 #ifndef GL_PROGRAM
 #define GL_PROGRAM 0x82e2
 #endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
 #ifndef GL_PROGRAM_OBJECT_EXT
 #define GL_PROGRAM_OBJECT_EXT 0x8B40
 #endif
@@ -754,6 +772,9 @@
 #ifndef GL_STREAM_READ
 #define GL_STREAM_READ 0x88e1
 #endif
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x1
+#endif
 #ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
 #define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
 #endif
@@ -823,6 +844,9 @@
 #ifndef GL_TEXTURE_WRAP_R
 #define GL_TEXTURE_WRAP_R 0x8072
 #endif
+#ifndef GL_TIMEOUT_EXPIRED
+#define GL_TIMEOUT_EXPIRED 0x911b
+#endif
 #ifndef GL_TRANSFORM_FEEDBACK_BARRIER_BIT
 #define GL_TRANSFORM_FEEDBACK_BARRIER_BIT 0x800
 #endif
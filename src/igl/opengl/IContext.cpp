@@ -17,6 +17,7 @@
 #include <igl/Macros.h>
 #include <igl/opengl/GLFunc.h>
 #include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/ProgramBinaryCache.h>
 
 #if defined(IGL_WITH_TRACY_GPU)
 #include "tracy/TracyOpenGL.hpp"
@@ -794,8 +795,120 @@ Result::Code GLerrorToCode(GLenum error) {
 
 #define GL_ERROR_TO_STRING(error) GLerrorToString(error)
 #define GL_ERROR_TO_RESULT(error) Result(GLerrorToCode(error), GLerrorToString(error))
+
+// Targets and capabilities which are not shadowed by IContext::StateCache
+constexpr int kNotCached = -1;
+
+int stateCacheTextureIndex(GLenum target) {
+  switch (target) {
+  case GL_TEXTURE_2D:
+    return 0;
+  case GL_TEXTURE_3D:
+    return 1;
+  case GL_TEXTURE_CUBE_MAP:
+    return 2;
+  case GL_TEXTURE_2D_ARRAY:
+    return 3;
+  case GL_TEXTURE_EXTERNAL_OES:
+    return 4;
+  case GL_TEXTURE_2D_MULTISAMPLE:
+    return 5;
+  default:
+    return kNotCached;
+  }
+}
+
+int stateCacheBufferIndex(GLenum target) {
+  switch (target) {
+  case GL_ARRAY_BUFFER:
+    return 0;
+  case GL_ELEMENT_ARRAY_BUFFER:
+    return 1;
+  case GL_COPY_READ_BUFFER:
+    return 2;
+  case GL_COPY_WRITE_BUFFER:
+    return 3;
+  case GL_DRAW_INDIRECT_BUFFER:
+    return 4;
+  case GL_PIXEL_PACK_BUFFER:
+    return 5;
+  case GL_PIXEL_UNPACK_BUFFER:
+    return 6;
+  case GL_SHADER_STORAGE_BUFFER:
+    return 7;
+  case GL_UNIFORM_BUFFER:
+    return 8;
+  default:
+    return kNotCached;
+  }
+}
+
+int stateCacheCapIndex(GLenum cap) {
+  switch (cap) {
+  case GL_BLEND:
+    return 0;
+  case GL_CULL_FACE:
+    return 1;
+  case GL_DEPTH_TEST:
+    return 2;
+  case GL_DITHER:
+    return 3;
+  case GL_FRAMEBUFFER_SRGB:
+    return 4;
+  case GL_POLYGON_OFFSET_FILL:
+    return 5;
+  case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    return 6;
+  case GL_SCISSOR_TEST:
+    return 7;
+  case GL_STENCIL_TEST:
+    return 8;
+  default:
+    return kNotCached;
+  }
+}
+
+// Stores `value` into the shadow state and returns true if the call setting it is redundant
+template<typename T>
+bool updateStateCache(T& cached, const T& value) {
+  if (cached == value) {
+    return true;
+  }
+  cached = value;
+  return false;
+}
 } // namespace
 
+void IContext::StateCache::invalidate() {
+  activeTextureUnit = kUnknown;
+  for (auto& unit : textures) {
+    unit.fill(kUnknown);
+  }
+  buffers.fill(kUnknown);
+  vao = kUnknown;
+  drawFramebuffer = kUnknown;
+  readFramebuffer = kUnknown;
+  renderbuffer = kUnknown;
+  program = kUnknown;
+  caps.fill(kUnknown);
+  blendFunc.fill(kUnknown);
+  blendEquation.fill(kUnknown);
+  hasBlendColor = false;
+  colorMask.fill(kUnknown);
+  depthMask = kUnknown;
+  depthFunc = kUnknown;
+  cullFace = kUnknown;
+  frontFace = kUnknown;
+  hasViewport = false;
+  hasScissor = false;
+}
+
+void IContext::StateCache::forgetDeleted(GLuint& binding, GLsizei n, const GLuint* names) {
+  if (names && std::find(names, names + n, binding) != names + n) {
+    binding = kUnknown;
+  }
+}
+
 // NOLINTNEXTLINE(modernize-use-equals-default)
 IContext::IContext() : deviceFeatureSet_(*this) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
@@ -1499,6 +1612,16 @@ bool IContext::shouldQueueAPI() const {
 }
 
 void IContext::activeTexture(GLenum texture) {
+  const GLuint unit = texture - GL_TEXTURE0;
+  if (unit < StateCache::kNumTextureUnits) {
+    if (updateStateCache(stateCache_.activeTextureUnit, unit)) {
+      stateCacheStats_.numElidedBindings++;
+      return;
+    }
+  } else {
+    // invalid or rarely used units are not cached
+    stateCache_.activeTextureUnit = StateCache::kUnknown;
+  }
 #if IGL_API_LOG
   activeTextureUnit_ = texture - GL_TEXTURE0;
 #endif
@@ -1514,6 +1637,11 @@ void IContext::attachShader(GLuint program, GLuint shader) {
 }
 
 void IContext::bindBuffer(GLenum target, GLuint buffer) {
+  const int targetIndex = stateCacheBufferIndex(target);
+  if (targetIndex != kNotCached && updateStateCache(stateCache_.buffers[targetIndex], buffer)) {
+    stateCacheStats_.numElidedBindings++;
+    return;
+  }
 #if IGL_API_LOG
   GLuint unboundBuffer = boundBuffer(target);
   setBoundBuffer(target, buffer);
@@ -1541,6 +1669,11 @@ void IContext::bindBufferBase(GLenum target, GLuint index, GLuint buffer) {
          boundBufferName(boundProgram_, target, index).c_str());
   IGLCALL(BindBufferBase)(target, index, buffer);
   GLCHECK_ERRORS();
+  // glBindBufferBase() also binds the buffer to the generic binding point
+  const int targetIndex = stateCacheBufferIndex(target);
+  if (targetIndex != kNotCached) {
+    stateCache_.buffers[targetIndex] = buffer;
+  }
 }
 
 void IContext::bindBufferRange(GLenum target,
@@ -1561,9 +1694,35 @@ void IContext::bindBufferRange(GLenum target,
          boundBufferName(boundProgram_, target, index).c_str());
   IGLCALL(BindBufferRange)(target, index, buffer, offset, size);
   GLCHECK_ERRORS();
+  // glBindBufferRange() also binds the buffer to the generic binding point
+  const int targetIndex = stateCacheBufferIndex(target);
+  if (targetIndex != kNotCached) {
+    stateCache_.buffers[targetIndex] = buffer;
+  }
 }
 
 void IContext::bindFramebuffer(GLenum target, GLuint framebuffer) {
+  bool isRedundant = false;
+  switch (target) {
+  case GL_FRAMEBUFFER:
+    isRedundant = stateCache_.drawFramebuffer == framebuffer &&
+                  stateCache_.readFramebuffer == framebuffer;
+    stateCache_.drawFramebuffer = framebuffer;
+    stateCache_.readFramebuffer = framebuffer;
+    break;
+  case GL_DRAW_FRAMEBUFFER:
+    isRedundant = updateStateCache(stateCache_.drawFramebuffer, framebuffer);
+    break;
+  case GL_READ_FRAMEBUFFER:
+    isRedundant = updateStateCache(stateCache_.readFramebuffer, framebuffer);
+    break;
+  default:
+    break;
+  }
+  if (isRedundant) {
+    stateCacheStats_.numElidedBindings++;
+    return;
+  }
 #if IGL_API_LOG
   GLuint unboundFramebuffer = boundFramebuffer(target);
   setBoundFramebuffer(target, framebuffer);
@@ -1578,6 +1737,10 @@ void IContext::bindFramebuffer(GLenum target, GLuint framebuffer) {
 }
 
 void IContext::bindRenderbuffer(GLenum target, GLuint renderbuffer) {
+  if (target == GL_RENDERBUFFER && updateStateCache(stateCache_.renderbuffer, renderbuffer)) {
+    stateCacheStats_.numElidedBindings++;
+    return;
+  }
 #if IGL_API_LOG
   GLuint unboundRenderbuffer = boundRenderbuffer_;
   boundRenderbuffer_ = renderbuffer;
@@ -1592,6 +1755,12 @@ void IContext::bindRenderbuffer(GLenum target, GLuint renderbuffer) {
 }
 
 void IContext::bindTexture(GLenum target, GLuint texture) {
+  const int targetIndex = stateCacheTextureIndex(target);
+  if (targetIndex != kNotCached && stateCache_.activeTextureUnit != StateCache::kUnknown &&
+      updateStateCache(stateCache_.textures[stateCache_.activeTextureUnit][targetIndex], texture)) {
+    stateCacheStats_.numElidedBindings++;
+    return;
+  }
 #if IGL_API_LOG
   GLuint unboundTexture = boundTexture(target);
   setBoundTexture(target, texture);
@@ -1651,6 +1820,12 @@ void IContext::bindImageTexture(GLuint unit,
 }
 
 void IContext::bindVertexArray(GLuint vao) {
+  if (updateStateCache(stateCache_.vao, vao)) {
+    stateCacheStats_.numElidedBindings++;
+    return;
+  }
+  // the element array buffer binding is part of the VAO state
+  stateCache_.buffers[stateCacheBufferIndex(GL_ELEMENT_ARRAY_BUFFER)] = StateCache::kUnknown;
 #if IGL_API_LOG
   GLuint unboundVao = boundVao_;
   boundVao_ = vao;
@@ -1671,18 +1846,33 @@ void IContext::bindVertexArray(GLuint vao) {
 }
 
 void IContext::blendColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha) {
+  const std::array<GLfloat, 4> color = {red, green, blue, alpha};
+  if (stateCache_.hasBlendColor && stateCache_.blendColor == color) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
+  stateCache_.blendColor = color;
+  stateCache_.hasBlendColor = true;
   APILOG("glBlendColor(%f, %f, %f, %f)\n", red, green, blue, alpha);
   GLCALL(BlendColor)(red, green, blue, alpha);
   GLCHECK_ERRORS();
 }
 
 void IContext::blendEquation(GLenum mode) {
+  if (updateStateCache(stateCache_.blendEquation, {mode, mode})) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glBlendEquation(%s)\n", GL_ENUM_TO_STRING(mode));
   GLCALL(BlendEquation)(mode);
   GLCHECK_ERRORS();
 }
 
 void IContext::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+  if (updateStateCache(stateCache_.blendEquation, {modeRGB, modeAlpha})) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glBlendEquationSeparate(%s, %s)\n",
          GL_ENUM_TO_STRING(modeRGB),
          GL_ENUM_TO_STRING(modeAlpha));
@@ -1691,12 +1881,20 @@ void IContext::blendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
 }
 
 void IContext::blendFunc(GLenum sfactor, GLenum dfactor) {
+  if (updateStateCache(stateCache_.blendFunc, {sfactor, dfactor, sfactor, dfactor})) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glBlendFunc(%s, %s)\n", GL_ENUM_TO_STRING(sfactor), GL_ENUM_TO_STRING(dfactor));
   GLCALL(BlendFunc)(sfactor, dfactor);
   GLCHECK_ERRORS();
 }
 
 void IContext::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+  if (updateStateCache(stateCache_.blendFunc, {srcRGB, dstRGB, srcAlpha, dstAlpha})) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glBlendFuncSeparate(%s, %s, %s, %s)\n",
          GL_ENUM_TO_STRING(srcRGB),
          GL_ENUM_TO_STRING(dstRGB),
@@ -1761,6 +1959,31 @@ void IContext::bufferData(GLenum target,
   GLCHECK_ERRORS();
 }
 
+void IContext::bufferStorage(GLenum target,
+                             GLsizeiptr size,
+                             const GLvoid* IGL_NULLABLE data,
+                             GLbitfield flags) {
+  if (bufferStorageProc_ == nullptr) {
+    if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::BufferStorageExtReq)) {
+      if (deviceFeatureSet_.hasExtension(Extensions::BufferStorage)) {
+        bufferStorageProc_ = iglBufferStorageEXT;
+      }
+    } else if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::BufferStorage)) {
+      bufferStorageProc_ = iglBufferStorage;
+    }
+    IGL_DEBUG_ASSERT(bufferStorageProc_, "No supported function for glBufferStorage\n");
+  }
+  APILOG("glBufferStorage(%s, %zu, %p, 0x%x [%s]) (buffer: %u)\n",
+         GL_ENUM_TO_STRING(target),
+         size,
+         data,
+         flags,
+         GL_MAP_BUFFER_RANGE_BITS_TO_STRING(flags),
+         boundBuffer(target));
+  GLCALL_PROC(bufferStorageProc_, target, size, data, flags);
+  GLCHECK_ERRORS();
+}
+
 void IContext::bufferSubData(GLenum target,
                              GLintptr offset,
                              GLsizeiptr size,
@@ -1863,6 +2086,10 @@ GLenum IContext::clientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeoutN
 }
 
 void IContext::colorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+  if (updateStateCache(stateCache_.colorMask, {red, green, blue, alpha})) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glColorMask(%s, %s, %s, %s) (framebuffer: %u)\n",
          GL_BOOL_TO_STRING(red),
          GL_BOOL_TO_STRING(green),
@@ -2111,6 +2338,10 @@ GLuint IContext::createShader(GLenum shaderType) {
 }
 
 void IContext::cullFace(GLint mode) {
+  if (updateStateCache(stateCache_.cullFace, static_cast<GLenum>(mode))) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glCullFace(%s)\n", GL_ENUM_TO_STRING(mode));
   GLCALL(CullFace)(mode);
   GLCHECK_ERRORS();
@@ -2178,6 +2409,10 @@ void IContext::deleteBuffers(GLsizei n, const GLuint* buffers) {
           "glDeleteBuffers(%u, %p) (buffer: %u)\n", n, buffers, buffers == nullptr ? 0 : *buffers);
       GLCALL(DeleteBuffers)(n, buffers);
       GLCHECK_ERRORS();
+      // deleted buffers are unbound by GL
+      for (GLuint& binding : stateCache_.buffers) {
+        StateCache::forgetDeleted(binding, n, buffers);
+      }
     }
   }
 }
@@ -2210,6 +2445,8 @@ void IContext::deleteFramebuffers(GLsizei n, const GLuint* framebuffers) {
              framebuffers == nullptr ? 0 : *framebuffers);
       IGLCALL(DeleteFramebuffers)(n, framebuffers);
       GLCHECK_ERRORS();
+      StateCache::forgetDeleted(stateCache_.drawFramebuffer, n, framebuffers);
+      StateCache::forgetDeleted(stateCache_.readFramebuffer, n, framebuffers);
     }
   }
 }
@@ -2222,6 +2459,7 @@ void IContext::deleteProgram(GLuint program) {
       APILOG("glDeleteProgram(%u) (program: %u)\n", program, program);
       GLCALL(DeleteProgram)(program);
       GLCHECK_ERRORS();
+      StateCache::forgetDeleted(stateCache_.program, 1, &program);
     }
   }
 }
@@ -2237,6 +2475,7 @@ void IContext::deleteRenderbuffers(GLsizei n, const GLuint* renderbuffers) {
              renderbuffers == nullptr ? 0 : *renderbuffers);
       IGLCALL(DeleteRenderbuffers)(n, renderbuffers);
       GLCHECK_ERRORS();
+      StateCache::forgetDeleted(stateCache_.renderbuffer, n, renderbuffers);
     }
   }
 }
@@ -2262,6 +2501,10 @@ void IContext::deleteVertexArrays(GLsizei n, const GLuint* vertexArrays) {
              vertexArrays == nullptr ? 0 : *vertexArrays);
       GLCALL_PROC(deleteVertexArraysProc_, n, vertexArrays);
       GLCHECK_ERRORS();
+      StateCache::forgetDeleted(stateCache_.vao, n, vertexArrays);
+      if (stateCache_.vao == StateCache::kUnknown) {
+        stateCache_.buffers[stateCacheBufferIndex(GL_ELEMENT_ARRAY_BUFFER)] = StateCache::kUnknown;
+      }
     }
   }
 }
@@ -2306,17 +2549,31 @@ void IContext::deleteTextures(GLsizei n, const GLuint* textures) {
              textures == nullptr ? 0 : *textures);
       GLCALL(DeleteTextures)(n, textures);
       GLCHECK_ERRORS();
+      // deleted textures are unbound from all texture units by GL
+      for (auto& unit : stateCache_.textures) {
+        for (GLuint& binding : unit) {
+          StateCache::forgetDeleted(binding, n, textures);
+        }
+      }
     }
   }
 }
 
 void IContext::depthFunc(GLenum func) {
+  if (updateStateCache(stateCache_.depthFunc, func)) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glDepthFunc(%s)\n", GL_ENUM_TO_STRING(func));
   GLCALL(DepthFunc)(func);
   GLCHECK_ERRORS();
 }
 
 void IContext::depthMask(GLboolean flag) {
+  if (updateStateCache(stateCache_.depthMask, static_cast<GLuint>(flag))) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glDepthMask(%s)\n", GL_BOOL_TO_STRING(flag));
   GLCALL(DepthMask)(flag);
   GLCHECK_ERRORS();
@@ -2335,6 +2592,12 @@ void IContext::detachShader(GLuint program, GLuint shader) {
 }
 
 void IContext::disable(GLenum cap) {
+  const int capIndex = stateCacheCapIndex(cap);
+  if (capIndex != kNotCached &&
+      updateStateCache(stateCache_.caps[capIndex], static_cast<GLuint>(GL_FALSE))) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glDisable(%s)\n", GL_ENUM_TO_STRING(cap));
   GLCALL(Disable)(cap);
   GLCHECK_ERRORS();
@@ -2589,6 +2852,12 @@ void IContext::multiDrawElementsIndirect(GLenum mode,
 }
 
 void IContext::enable(GLenum cap) {
+  const int capIndex = stateCacheCapIndex(cap);
+  if (capIndex != kNotCached &&
+      updateStateCache(stateCache_.caps[capIndex], static_cast<GLuint>(GL_TRUE))) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glEnable(%s)\n", GL_ENUM_TO_STRING(cap));
   GLCALL(Enable)(cap);
   GLCHECK_ERRORS();
@@ -2788,6 +3057,10 @@ void IContext::framebufferTextureLayer(GLenum target,
 }
 
 void IContext::frontFace(GLenum mode) {
+  if (updateStateCache(stateCache_.frontFace, mode)) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   APILOG("glFrontFace(%s)\n", GL_ENUM_TO_STRING(mode));
   GLCALL(FrontFace)(mode);
   GLCHECK_ERRORS();
@@ -3115,6 +3388,24 @@ void IContext::getProgramiv(GLuint program, GLenum pname, GLint* params) const {
   GLCHECK_ERRORS();
 }
 
+void IContext::getProgramBinary(GLuint program,
+                                GLsizei bufSize,
+                                GLsizei* length,
+                                GLenum* binaryFormat,
+                                void* binary) const {
+  IGLCALL(GetProgramBinary)(program, bufSize, length, binaryFormat, binary);
+  // NOTE: Must log after call due to return value
+  APILOG("glGetProgramBinary(%u, %d, %p, %p, %p) = %d (program: %u)\n",
+         program,
+         bufSize,
+         length,
+         binaryFormat,
+         binary,
+         length == nullptr ? 0 : *length,
+         program);
+  GLCHECK_ERRORS();
+}
+
 void IContext::getProgramInterfaceiv(GLuint program,
                                      GLenum programInterface,
                                      GLenum pname,
@@ -3453,6 +3744,14 @@ void* IContext::mapBufferRange(GLenum target,
   return ret;
 }
 
+void IContext::maxShaderCompilerThreads(GLuint count) {
+  if (IGL_DEBUG_VERIFY(deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompile))) {
+    APILOG("glMaxShaderCompilerThreadsKHR(%u)\n", count);
+    IGLCALL(MaxShaderCompilerThreadsKHR)(count);
+    GLCHECK_ERRORS();
+  }
+}
+
 void IContext::objectLabel(GLenum identifier, GLuint name, GLsizei length, const char* label) {
   if (objectLabelProc_ == nullptr) {
     if (deviceFeatureSet_.hasInternalRequirement(InternalRequirement::DebugLabelExtReq)) {
@@ -3499,6 +3798,22 @@ void IContext::polygonOffsetClamp(GLfloat factor, GLfloat units, float clamp) {
   GLCHECK_ERRORS();
 }
 
+void IContext::programBinary(GLuint program,
+                             GLenum binaryFormat,
+                             const void* binary,
+                             GLsizei length) {
+  APILOG("glProgramBinary(%u, 0x%x, %p, %d)\n", program, binaryFormat, binary, length);
+  IGLCALL(ProgramBinary)(program, binaryFormat, binary, length);
+  // NOTE: Explicitly *not* checking for errors
+  // A rejected binary is reported through GL_LINK_STATUS and handled by the caller.
+}
+
+void IContext::programParameteri(GLuint program, GLenum pname, GLint value) {
+  APILOG("glProgramParameteri(%u, %s, %d)\n", program, GL_ENUM_TO_STRING(pname), value);
+  IGLCALL(ProgramParameteri)(program, pname, value);
+  GLCHECK_ERRORS();
+}
+
 void IContext::pushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar* message) {
   if (pushDebugGroupProc_ == nullptr) {
     if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::DebugMessage)) {
@@ -3705,12 +4020,26 @@ void IContext::framebufferTextureMultisampleMultiview(GLenum target,
 }
 
 void IContext::scissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  const std::array<GLint, 4> rect = {x, y, width, height};
+  if (stateCache_.hasScissor && stateCache_.scissor == rect) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
+  stateCache_.scissor = rect;
+  stateCache_.hasScissor = true;
   APILOG("glScissor(%d, %d, %u, %u)\n", x, y, width, height);
   GLCALL(Scissor)(x, y, width, height);
   GLCHECK_ERRORS();
 }
 
 void IContext::setEnabled(bool shouldEnable, GLenum cap) {
+  const int capIndex = stateCacheCapIndex(cap);
+  if (capIndex != kNotCached &&
+      updateStateCache(stateCache_.caps[capIndex],
+                       static_cast<GLuint>(shouldEnable ? GL_TRUE : GL_FALSE))) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
   if (shouldEnable) {
     APILOG("glEnable(%s)\n", GL_ENUM_TO_STRING(cap));
     GLCALL(Enable)(cap);
@@ -4335,6 +4664,10 @@ void IContext::unmapBuffer(GLenum target) {
 }
 
 void IContext::useProgram(GLuint program) {
+  if (updateStateCache(stateCache_.program, program)) {
+    stateCacheStats_.numElidedBindings++;
+    return;
+  }
 #if IGL_API_LOG
   GLuint unboundProgram = boundProgram_;
   boundProgram_ = program;
@@ -4354,6 +4687,13 @@ void IContext::validateProgram(GLuint program) {
 }
 
 void IContext::viewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  const std::array<GLint, 4> rect = {x, y, width, height};
+  if (stateCache_.hasViewport && stateCache_.viewport == rect) {
+    stateCacheStats_.numElidedStateChanges++;
+    return;
+  }
+  stateCache_.viewport = rect;
+  stateCache_.hasViewport = true;
   APILOG("glViewport(%d, %d, %u, %u)\n", x, y, width, height);
   GLCALL(Viewport)(x, y, width, height);
   GLCHECK_ERRORS();
@@ -4576,10 +4916,53 @@ unsigned int IContext::getShaderCompilationCount() const {
   return shaderCompilationCount_;
 }
 
+GPUMemoryUsage IContext::getGPUMemoryUsage() const {
+  GPUMemoryUsage usage;
+  usage.textures = textureMemoryUsage_;
+  usage.buffers = bufferMemoryUsage_;
+  usage.total = usage.textures + usage.buffers;
+  return usage;
+}
+
+void IContext::addTextureMemoryUsage(size_t bytes) {
+  textureMemoryUsage_ += bytes;
+}
+
+void IContext::removeTextureMemoryUsage(size_t bytes) {
+  IGL_DEBUG_ASSERT(textureMemoryUsage_ >= bytes);
+  textureMemoryUsage_ -= bytes;
+}
+
+void IContext::addBufferMemoryUsage(size_t bytes) {
+  bufferMemoryUsage_ += bytes;
+}
+
+void IContext::removeBufferMemoryUsage(size_t bytes) {
+  IGL_DEBUG_ASSERT(bufferMemoryUsage_ >= bytes);
+  bufferMemoryUsage_ -= bytes;
+}
+
 void IContext::resetCounters() {
   callCounter_ = 0;
 }
 
+void IContext::invalidateStateCache() {
+  stateCache_.invalidate();
+}
+
+IContext::StateCacheStats IContext::getStateCacheStats() const {
+  return stateCacheStats_;
+}
+
+IContext::StateCacheStats IContext::getLastFrameStateCacheStats() const {
+  return lastFrameStateCacheStats_;
+}
+
+void IContext::endStateCacheFrame() {
+  lastFrameStateCacheStats_ = stateCacheStats_;
+  stateCacheStats_ = {};
+}
+
 bool IContext::addRef() {
   const bool ret = isLikelyValidObject();
   if (ret) {
@@ -4739,6 +5122,41 @@ bool IContext::shouldValidateShaders() const {
   return shouldValidateShaders_;
 }
 
+void IContext::setDeferredProgramLinking(bool deferredProgramLinking) {
+  const bool hasParallelShaderCompile =
+      deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompile);
+  if (deferredProgramLinking && hasParallelShaderCompile && !deferredProgramLinking_) {
+    // 0xFFFFFFFF lets the implementation pick the number of compiler threads
+    maxShaderCompilerThreads(0xFFFFFFFF);
+  }
+  deferredProgramLinking_ = deferredProgramLinking;
+}
+
+bool IContext::isDeferredProgramLinkingEnabled() const {
+  return deferredProgramLinking_ &&
+         deviceFeatureSet_.hasExtension(Extensions::ParallelShaderCompile);
+}
+
+void IContext::setProgramBinaryCacheDirectory(const std::string& directory) {
+  programBinaryCache_ = nullptr;
+  if (directory.empty()) {
+    return;
+  }
+  GLint numFormats = 0;
+  if (deviceFeatureSet_.hasInternalFeature(InternalFeatures::ProgramBinary)) {
+    getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+  }
+  if (numFormats <= 0) {
+    IGL_LOG_INFO("Program binaries are not supported, the program binary cache is disabled\n");
+    return;
+  }
+  programBinaryCache_ = std::make_shared<ProgramBinaryCache>(directory);
+}
+
+ProgramBinaryCache* IContext::getProgramBinaryCache() const {
+  return programBinaryCache_.get();
+}
+
 void IContext::SynchronizedDeletionQueues::flushDeletionQueue(IContext& context) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
   if (IGL_DEBUG_VERIFY(context.isCurrentContext() || context.isCurrentSharegroup())) {
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <ldrutils/lutils/Pool.h>
 #include <memory>
@@ -16,6 +17,7 @@
 #include <vector>
 #include <igl/CommandEncoder.h>
 #include <igl/Common.h>
+#include <igl/Device.h>
 #include <igl/PlatformDevice.h>
 #include <igl/opengl/ComputeCommandAdapter.h>
 #include <igl/opengl/Config.h>
@@ -29,6 +31,8 @@
 
 namespace igl::opengl {
 
+class ProgramBinaryCache;
+
 ///
 /// Represents an pure abstract class that encapsulates in it an OpenGL context.
 /// Individual types that implement this class are the ones that provide implementation
@@ -94,6 +98,10 @@ class IContext {
                        GLbitfield mask,
                        GLenum filter);
   void bufferData(GLenum target, GLsizeiptr size, const GLvoid* IGL_NULLABLE data, GLenum usage);
+  void bufferStorage(GLenum target,
+                     GLsizeiptr size,
+                     const GLvoid* IGL_NULLABLE data,
+                     GLbitfield flags);
   void bufferSubData(GLenum target,
                      GLintptr offset,
                      GLsizeiptr size,
@@ -284,6 +292,11 @@ class IContext {
                                            GLint* IGL_NULLABLE params) const;
   void getIntegerv(GLenum pname, GLint* IGL_NULLABLE params) const;
   void getProgramiv(GLuint program, GLenum pname, GLint* IGL_NULLABLE params) const;
+  void getProgramBinary(GLuint program,
+                        GLsizei bufSize,
+                        GLsizei* IGL_NULLABLE length,
+                        GLenum* IGL_NULLABLE binaryFormat,
+                        void* IGL_NULLABLE binary) const;
   void getProgramInterfaceiv(GLuint program,
                              GLenum programInterface,
                              GLenum pname,
@@ -335,10 +348,16 @@ class IContext {
                                     GLintptr offset,
                                     GLsizeiptr length,
                                     GLbitfield access);
+  void maxShaderCompilerThreads(GLuint count);
   void objectLabel(GLenum identifier, GLuint name, GLsizei length, const char* IGL_NULLABLE label);
   void pixelStorei(GLenum pname, GLint param);
   void polygonOffsetClamp(GLfloat factor, GLfloat units, float clamp);
   void popDebugGroup();
+  void programBinary(GLuint program,
+                     GLenum binaryFormat,
+                     const void* IGL_NULLABLE binary,
+                     GLsizei length);
+  void programParameteri(GLuint program, GLenum pname, GLint value);
   void pushDebugGroup(GLenum source, GLuint id, GLsizei length, const GLchar* IGL_NULLABLE message);
   void readBuffer(GLenum src);
   void readPixels(GLint x,
@@ -501,6 +520,14 @@ class IContext {
 
   unsigned int getShaderCompilationCount() const;
 
+  /** Returns the estimated memory used by textures and buffers created with this context. */
+  GPUMemoryUsage getGPUMemoryUsage() const;
+  /** Updates the memory usage reported by getGPUMemoryUsage(). */
+  void addTextureMemoryUsage(size_t bytes);
+  void removeTextureMemoryUsage(size_t bytes);
+  void addBufferMemoryUsage(size_t bytes);
+  void removeBufferMemoryUsage(size_t bytes);
+
   // Utility functions
   [[nodiscard]] const DeviceFeatureSet& deviceFeatures() const;
   /// Calls bindBuffer(target, 0) or enqueues to run when deletion queue is
@@ -516,12 +543,47 @@ class IContext {
 
   void setShouldValidateShaders(bool shouldValidateShaders);
   bool shouldValidateShaders() const;
+
+  /// When enabled, shader compilation and program linking are not waited on: the compile and link
+  /// status is queried only when a program is first used or when it is polled via
+  /// ShaderStages::isLinkComplete(). Takes effect only if GL_KHR_parallel_shader_compile is
+  /// supported, since the driver compiles synchronously otherwise.
+  void setDeferredProgramLinking(bool deferredProgramLinking);
+  [[nodiscard]] bool isDeferredProgramLinkingEnabled() const;
+
+  /// Enables the on-disk program binary cache in the existing directory `directory`, or disables
+  /// it if `directory` is empty. Has no effect if the context cannot retrieve program binaries.
+  /// While the cache is enabled, render shader modules are compiled only when their program is
+  /// not found in the cache, so compile errors are reported when the shader stages are created.
+  void setProgramBinaryCacheDirectory(const std::string& directory);
+  [[nodiscard]] ProgramBinaryCache* IGL_NULLABLE getProgramBinaryCache() const;
   inline bool isDestructionAllowed() const {
     return lockCount_ == 0;
   }
 
   void resetCounters();
 
+  /// Counts of redundant GL calls which were not sent to the driver by the state cache.
+  struct StateCacheStats {
+    /// Object bindings: bind*(), activeTexture() and useProgram()
+    uint32_t numElidedBindings = 0;
+    /// Fixed-function state: enable()/disable(), blending, depth, culling, viewport, etc.
+    uint32_t numElidedStateChanges = 0;
+  };
+
+  /** Forgets all the GL state shadowed by this context, so the next call of every cached GL API
+   * goes to the driver. Must be called after GL code outside of IGL has changed the state of this
+   * context, e.g. when IGL shares the context with another renderer.
+   */
+  void invalidateStateCache();
+  /// Returns the number of calls elided since the last endStateCacheFrame()
+  [[nodiscard]] StateCacheStats getStateCacheStats() const;
+  /// Returns the number of calls elided during the last frame
+  [[nodiscard]] StateCacheStats getLastFrameStateCacheStats() const;
+  /// Marks the end of a frame for the state cache stats. Called by CommandQueue::submit() for
+  /// end-of-frame command buffers.
+  void endStateCacheFrame();
+
   /** Manual reference counting.
    * In some cases, mostly for performance reasons, we hold unprotected
    * references to the IContext. When doing so, use the functions below to
@@ -610,9 +672,13 @@ class IContext {
   mutable unsigned int callCounter_ = 0;
   std::atomic<unsigned int> drawCallCount_{0};
   std::atomic<unsigned int> shaderCompilationCount_{0};
+  std::atomic<size_t> textureMemoryUsage_{0};
+  std::atomic<size_t> bufferMemoryUsage_{0};
   int lockCount_ = 0; // used by DestructionGuard
   int refCount_ = 0; // used by addRef/releaseRef
   bool shouldValidateShaders_ = false;
+  bool deferredProgramLinking_ = false;
+  std::shared_ptr<ProgramBinaryCache> programBinaryCache_;
 
   // API Logging
   unsigned int apiLogDrawsLeft_ = 0;
@@ -716,6 +782,7 @@ class IContext {
   PFNIGLBINDIMAGETEXTUREPROC IGL_NULLABLE bindImageTexturerProc_ = nullptr;
   PFNIGLBINDVERTEXARRAYPROC IGL_NULLABLE bindVertexArrayProc_ = nullptr;
   PFNIGLBLITFRAMEBUFFERPROC IGL_NULLABLE blitFramebufferProc_ = nullptr;
+  PFNIGLBUFFERSTORAGEPROC IGL_NULLABLE bufferStorageProc_ = nullptr;
   PFNIGLCLEARDEPTHFPROC IGL_NULLABLE clearDepthfProc_ = nullptr;
   PFNIGLCLIENTWAITSYNCPROC IGL_NULLABLE clientWaitSyncProc_ = nullptr;
   PFNIGLCOMPRESSEDTEXIMAGE3DPROC IGL_NULLABLE compressedTexImage3DProc_ = nullptr;
@@ -802,6 +869,54 @@ class IContext {
 
   SynchronizedDeletionQueues deletionQueues_;
 
+  /// Shadow copy of the GL state set through this context. Calls which would not change the state
+  /// are not sent to the driver. Only the state explicitly set by IGL is known: everything starts
+  /// as kUnknown and becomes kUnknown again on invalidateStateCache().
+  struct StateCache {
+    static constexpr GLuint kUnknown = ~0u;
+    static constexpr size_t kNumTextureUnits = 32;
+    static constexpr size_t kNumTextureTargets = 6;
+    static constexpr size_t kNumBufferTargets = 9;
+    static constexpr size_t kNumCaps = 9;
+
+    StateCache() {
+      invalidate();
+    }
+    void invalidate();
+    /// Sets `binding` to kUnknown if it is one of the `n` deleted objects in `names`
+    static void forgetDeleted(GLuint& binding, GLsizei n, const GLuint* IGL_NULLABLE names);
+
+    GLuint activeTextureUnit = kUnknown;
+    std::array<std::array<GLuint, kNumTextureTargets>, kNumTextureUnits> textures{};
+    std::array<GLuint, kNumBufferTargets> buffers{};
+    GLuint vao = kUnknown;
+    GLuint drawFramebuffer = kUnknown;
+    GLuint readFramebuffer = kUnknown;
+    GLuint renderbuffer = kUnknown;
+    GLuint program = kUnknown;
+    // GL_TRUE, GL_FALSE or kUnknown
+    std::array<GLuint, kNumCaps> caps{};
+    // srcRGB, dstRGB, srcAlpha, dstAlpha
+    std::array<GLenum, 4> blendFunc{};
+    // modeRGB, modeAlpha
+    std::array<GLenum, 2> blendEquation{};
+    std::array<GLfloat, 4> blendColor{};
+    bool hasBlendColor = false;
+    std::array<GLuint, 4> colorMask{};
+    GLuint depthMask = kUnknown;
+    GLenum depthFunc = kUnknown;
+    GLenum cullFace = kUnknown;
+    GLenum frontFace = kUnknown;
+    std::array<GLint, 4> viewport{};
+    bool hasViewport = false;
+    std::array<GLint, 4> scissor{};
+    bool hasScissor = false;
+  };
+
+  StateCache stateCache_;
+  StateCacheStats stateCacheStats_;
+  StateCacheStats lastFrameStateCacheStats_;
+
   UnbindPolicy unbindPolicy_ = UnbindPolicy::Default;
 
   void getGLMajorAndMinorVersions(GLint& majorVersion, GLint& minorVersion) const;
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/PixelReadbackQueue.h>
+
+#include <cstring>
+#include <utility>
+#include <igl/opengl/DeviceFeatureSet.h>
+#include <igl/opengl/Framebuffer.h>
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+PixelReadbackQueue::PixelReadbackQueue(IContext& context, uint32_t numBuffers) :
+  WithContext(context), slots_(numBuffers) {
+  IGL_DEBUG_ASSERT(numBuffers > 0);
+}
+
+PixelReadbackQueue::~PixelReadbackQueue() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_DESTROY);
+  for (Slot& slot : slots_) {
+    releaseFence(slot);
+    if (slot.pbo != 0) {
+      getContext().deleteBuffers(1, &slot.pbo);
+      getContext().removeBufferMemoryUsage(slot.capacity);
+      slot.pbo = 0;
+    }
+  }
+}
+
+bool PixelReadbackQueue::isSupported(const IContext& context) {
+  const DeviceFeatureSet& features = context.deviceFeatures();
+  return features.hasInternalFeature(InternalFeatures::PixelBufferObject) &&
+         features.hasInternalFeature(InternalFeatures::Sync) &&
+         features.hasFeature(DeviceFeatures::MapBufferRange);
+}
+
+PixelReadbackQueue::RequestId PixelReadbackQueue::requestColorAttachment(
+    const Framebuffer& framebuffer,
+    size_t index,
+    const TextureRangeDesc& range,
+    Result* IGL_NULLABLE outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  const auto texture = framebuffer.getColorAttachment(index);
+  if (texture == nullptr) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "No color attachment at index");
+    return kInvalidRequest;
+  }
+
+  // requests are served in ring order, so the oldest buffer is reused first
+  Slot* slot = nullptr;
+  for (size_t i = 0; i != slots_.size() && slot == nullptr; i++) {
+    Slot& candidate = slots_[(nextSlot_ + i) % slots_.size()];
+    if (candidate.requestId == kInvalidRequest) {
+      slot = &candidate;
+      nextSlot_ = static_cast<uint32_t>((nextSlot_ + i + 1) % slots_.size());
+    }
+  }
+  if (slot == nullptr) {
+    Result::setResult(outResult, Result::Code::InvalidOperation, "All readback buffers are busy");
+    return kInvalidRequest;
+  }
+
+  IContext& ctx = getContext();
+
+  slot->size = texture->getProperties().getBytesPerRange(range);
+  if (slot->pbo == 0) {
+    ctx.genBuffers(1, &slot->pbo);
+  }
+  ctx.bindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+  if (slot->capacity < slot->size) {
+    ctx.bufferData(
+        GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(slot->size), nullptr, GL_STREAM_READ);
+    ctx.removeBufferMemoryUsage(slot->capacity);
+    ctx.addBufferMemoryUsage(slot->size);
+    slot->capacity = slot->size;
+  }
+
+  // with a pixel pack buffer bound, glReadPixels() only schedules the copy
+  framebuffer.readColorAttachment(index, nullptr, range);
+  ctx.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  slot->fence = ctx.fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  // make sure the fence reaches the GPU, otherwise polling it may never succeed
+  ctx.flush();
+
+  slot->requestId = nextRequestId_++;
+  Result::setOk(outResult);
+  return slot->requestId;
+}
+
+PixelReadbackQueue::Status PixelReadbackQueue::getStatus(RequestId requestId) {
+  Slot* slot = findSlot(requestId);
+  if (slot == nullptr) {
+    return Status::Invalid;
+  }
+  if (slot->fence != nullptr) {
+    GLint status = 0;
+    GLsizei length = 0;
+    getContext().getSynciv(slot->fence, GL_SYNC_STATUS, 1, &length, &status);
+    if (status != GL_SIGNALED) {
+      return Status::InProgress;
+    }
+    releaseFence(*slot);
+  }
+  return Status::Ready;
+}
+
+PixelReadbackQueue::Status PixelReadbackQueue::wait(RequestId requestId, uint64_t timeoutNs) {
+  IGL_PROFILER_FUNCTION();
+  Slot* slot = findSlot(requestId);
+  if (slot == nullptr) {
+    return Status::Invalid;
+  }
+  if (slot->fence != nullptr) {
+    const GLenum result =
+        getContext().clientWaitSync(slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+    if (result == GL_TIMEOUT_EXPIRED) {
+      return Status::InProgress;
+    }
+    if (result == GL_WAIT_FAILED) {
+      return Status::Invalid;
+    }
+    releaseFence(*slot);
+  }
+  return Status::Ready;
+}
+
+size_t PixelReadbackQueue::getSizeInBytes(RequestId requestId) const {
+  const Slot* slot = findSlot(requestId);
+  return slot != nullptr ? slot->size : 0;
+}
+
+Result PixelReadbackQueue::getBytes(RequestId requestId, void* IGL_NONNULL data, size_t length) {
+  IGL_PROFILER_FUNCTION();
+  if (wait(requestId) != Status::Ready) {
+    return Result(Result::Code::ArgumentInvalid, "Invalid readback request");
+  }
+  Slot& slot = *findSlot(requestId);
+  if (length < slot.size) {
+    return Result(Result::Code::ArgumentOutOfRange, "Destination is too small");
+  }
+
+  IContext& ctx = getContext();
+  ctx.bindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+  const void* pixels = ctx.mapBufferRange(
+      GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(slot.size), GL_MAP_READ_BIT);
+  Result result;
+  if (pixels != nullptr) {
+    memcpy(data, pixels, slot.size);
+    ctx.unmapBuffer(GL_PIXEL_PACK_BUFFER);
+  } else {
+    result = Result(Result::Code::RuntimeError, "Cannot map readback buffer");
+  }
+  ctx.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+  slot.requestId = kInvalidRequest;
+  return result;
+}
+
+void PixelReadbackQueue::release(RequestId requestId) {
+  Slot* slot = findSlot(requestId);
+  if (slot != nullptr) {
+    releaseFence(*slot);
+    slot->requestId = kInvalidRequest;
+  }
+}
+
+uint32_t PixelReadbackQueue::getNumInFlight() const {
+  uint32_t num = 0;
+  for (const Slot& slot : slots_) {
+    num += slot.requestId != kInvalidRequest ? 1 : 0;
+  }
+  return num;
+}
+
+PixelReadbackQueue::Slot* IGL_NULLABLE PixelReadbackQueue::findSlot(RequestId requestId) {
+  return const_cast<Slot*>(std::as_const(*this).findSlot(requestId));
+}
+
+const PixelReadbackQueue::Slot* IGL_NULLABLE
+PixelReadbackQueue::findSlot(RequestId requestId) const {
+  if (requestId == kInvalidRequest) {
+    return nullptr;
+  }
+  for (const Slot& slot : slots_) {
+    if (slot.requestId == requestId) {
+      return &slot;
+    }
+  }
+  return nullptr;
+}
+
+void PixelReadbackQueue::releaseFence(Slot& slot) {
+  if (slot.fence != nullptr) {
+    getContext().deleteSync(slot.fence);
+    slot.fence = nullptr;
+  }
+}
+
+} // namespace igl::opengl
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <igl/Texture.h>
+#include <igl/opengl/GLIncludes.h>
+#include <igl/opengl/WithContext.h>
+
+namespace igl::opengl {
+
+class Framebuffer;
+class IContext;
+
+/**
+ * @brief Asynchronous readback of framebuffer color attachments through a ring of pixel buffer
+ * objects.
+ *
+ * Each request reads a region of a color attachment into its own PBO with glReadPixels() and
+ * places a fence after it, so the CPU does not wait for the GPU while the copy is in flight. Up to
+ * `numBuffers` requests can be in flight at a time, each with its own texture region and format.
+ * Callers poll with getStatus() or block with wait(), then copy the pixels out with getBytes(),
+ * which also frees the PBO for the next request.
+ *
+ * Created with opengl::Device::createPixelReadbackQueue() and must be used on the thread of its
+ * context.
+ */
+class PixelReadbackQueue final : public WithContext {
+ public:
+  using RequestId = uint64_t;
+  static constexpr RequestId kInvalidRequest = 0;
+  static constexpr uint32_t kDefaultNumBuffers = 4;
+
+  enum class Status : uint8_t {
+    Invalid, // unknown request, or it was released already
+    InProgress,
+    Ready,
+  };
+
+  PixelReadbackQueue(IContext& context, uint32_t numBuffers);
+  ~PixelReadbackQueue() override;
+
+  PixelReadbackQueue(const PixelReadbackQueue&) = delete;
+  PixelReadbackQueue& operator=(const PixelReadbackQueue&) = delete;
+  PixelReadbackQueue(PixelReadbackQueue&&) = delete;
+  PixelReadbackQueue& operator=(PixelReadbackQueue&&) = delete;
+
+  /// @brief Returns true if PBOs and sync objects are available
+  [[nodiscard]] static bool isSupported(const IContext& context);
+
+  /// @brief Starts reading `range` of color attachment `index` of `framebuffer`. Fails with
+  /// kInvalidRequest if all buffers are in flight or not yet read with getBytes().
+  RequestId requestColorAttachment(const Framebuffer& framebuffer,
+                                   size_t index,
+                                   const TextureRangeDesc& range,
+                                   Result* IGL_NULLABLE outResult);
+
+  /// @brief Returns the status of a request without blocking
+  [[nodiscard]] Status getStatus(RequestId requestId);
+
+  /// @brief Blocks until the request is ready or `timeoutNs` has passed
+  Status wait(RequestId requestId, uint64_t timeoutNs = std::numeric_limits<uint64_t>::max());
+
+  /// @brief The number of bytes getBytes() writes for a request, with tightly packed rows
+  [[nodiscard]] size_t getSizeInBytes(RequestId requestId) const;
+
+  /// @brief Waits for the request, copies its pixels into `data` and frees its buffer
+  Result getBytes(RequestId requestId, void* IGL_NONNULL data, size_t length);
+
+  /// @brief Frees the buffer of a request without reading it
+  void release(RequestId requestId);
+
+  [[nodiscard]] uint32_t getNumBuffers() const {
+    return static_cast<uint32_t>(slots_.size());
+  }
+  [[nodiscard]] uint32_t getNumInFlight() const;
+
+ private:
+  struct Slot {
+    GLuint pbo = 0;
+    size_t capacity = 0;
+    size_t size = 0;
+    GLsync IGL_NULLABLE fence = nullptr;
+    RequestId requestId = kInvalidRequest;
+  };
+
+  [[nodiscard]] Slot* IGL_NULLABLE findSlot(RequestId requestId);
+  [[nodiscard]] const Slot* IGL_NULLABLE findSlot(RequestId requestId) const;
+  void releaseFence(Slot& slot);
+
+  std::vector<Slot> slots_;
+  uint32_t nextSlot_ = 0;
+  RequestId nextRequestId_ = 1;
+};
+
+} // namespace igl::opengl
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/opengl/ProgramBinaryCache.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <igl/opengl/IContext.h>
+
+namespace igl::opengl {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x50474c49; // "IGLP"
+
+struct FileHeader {
+  uint32_t magic = kMagic;
+  uint32_t version = ProgramBinaryCache::kCacheVersion;
+  uint64_t key = 0;
+  uint32_t binaryFormat = 0;
+  uint32_t size = 0;
+};
+
+// 64-bit FNV-1a
+constexpr uint64_t kHashSeed = 14695981039346656037ull;
+
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size) noexcept {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i != size; i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+uint64_t hashString(uint64_t hash, const GLubyte* IGL_NULLABLE str) noexcept {
+  const char* s = str ? reinterpret_cast<const char*>(str) : "";
+  // include the terminator so that adjacent strings cannot alias
+  return hashBytes(hash, s, strlen(s) + 1);
+}
+
+} // namespace
+
+ProgramBinaryCache::ProgramBinaryCache(std::string directory) : directory_(std::move(directory)) {}
+
+uint64_t ProgramBinaryCache::computeKey(IContext& context,
+                                        std::initializer_list<std::string_view> sources) {
+  if (driverHash_ == 0) {
+    uint64_t hash = hashBytes(kHashSeed, &kCacheVersion, sizeof(kCacheVersion));
+    hash = hashString(hash, context.getString(GL_VENDOR));
+    hash = hashString(hash, context.getString(GL_RENDERER));
+    driverHash_ = hashString(hash, context.getString(GL_VERSION));
+  }
+  uint64_t hash = driverHash_;
+  for (const std::string_view source : sources) {
+    const uint64_t size = source.size();
+    hash = hashBytes(hash, &size, sizeof(size));
+    hash = hashBytes(hash, source.data(), source.size());
+  }
+  return hash;
+}
+
+std::string ProgramBinaryCache::getFilePath(uint64_t key) const {
+  char name[32] = {};
+  snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+  return (std::filesystem::path(directory_) / name).string();
+}
+
+bool ProgramBinaryCache::load(IContext& context, GLuint programID, uint64_t key) {
+  IGL_PROFILER_FUNCTION();
+
+  const std::string path = getFilePath(key);
+  std::vector<char> binary;
+  FileHeader header;
+  {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+      stats_.numMisses++;
+      return false;
+    }
+    if (file.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.magic == kMagic &&
+        header.version == kCacheVersion && header.key == key && header.size != 0) {
+      binary.resize(header.size);
+      if (!file.read(binary.data(), static_cast<std::streamsize>(binary.size()))) {
+        binary.clear();
+      }
+    }
+  }
+
+  GLint status = GL_FALSE;
+  if (!binary.empty()) {
+    context.programBinary(
+        programID, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+    context.getProgramiv(programID, GL_LINK_STATUS, &status);
+  }
+
+  if (status == GL_FALSE) {
+    // a damaged file or a binary from a driver which cannot load it anymore
+    IGL_LOG_INFO("Program binary %s was rejected, compiling from source\n", path.c_str());
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    stats_.numRejected++;
+    stats_.numMisses++;
+    return false;
+  }
+
+  stats_.numHits++;
+  return true;
+}
+
+void ProgramBinaryCache::store(IContext& context, GLuint programID, uint64_t key) {
+  IGL_PROFILER_FUNCTION();
+
+  GLint length = 0;
+  context.getProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) {
+    return;
+  }
+
+  std::vector<char> binary(length);
+  GLsizei size = 0;
+  GLenum binaryFormat = 0;
+  context.getProgramBinary(programID, length, &size, &binaryFormat, binary.data());
+  if (size <= 0) {
+    return;
+  }
+
+  FileHeader header;
+  header.key = key;
+  header.binaryFormat = binaryFormat;
+  header.size = static_cast<uint32_t>(size);
+
+  // write to a temporary file first so that a partially written binary is never loaded
+  const std::string path = getFilePath(key);
+  const std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+        !file.write(binary.data(), size)) {
+      IGL_LOG_ERROR("Cannot write program binary cache file %s\n", tmpPath.c_str());
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+  }
+}
+
+} // namespace igl::opengl
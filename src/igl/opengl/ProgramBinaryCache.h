@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <igl/opengl/GLIncludes.h>
+
+namespace igl::opengl {
+
+class IContext;
+
+/**
+ * @brief An on-disk cache of linked GL programs, stored with glGetProgramBinary() and restored with
+ * glProgramBinary(). Entries are keyed on a hash of the GLSL sources of all stages and of the
+ * GL_VENDOR, GL_RENDERER and GL_VERSION strings, so a driver update invalidates the whole cache.
+ *
+ * Each program is stored in its own file in `directory`, which has to exist. A binary which the
+ * driver rejects is removed from disk and the caller falls back to compiling from source.
+ *
+ * The cache is owned by IContext (see IContext::setProgramBinaryCacheDirectory()) and must be used
+ * on the thread of that context only.
+ */
+class ProgramBinaryCache final {
+ public:
+  /// Bump this whenever the file layout changes
+  static constexpr uint32_t kCacheVersion = 1;
+
+  struct Stats {
+    uint32_t numHits = 0; // loaded from disk
+    uint32_t numMisses = 0; // had to be compiled, including rejected binaries
+    uint32_t numRejected = 0; // found on disk but not accepted by the driver
+  };
+
+  explicit ProgramBinaryCache(std::string directory);
+
+  [[nodiscard]] uint64_t computeKey(IContext& context,
+                                    std::initializer_list<std::string_view> sources);
+
+  /// @brief Restores the binary stored for `key` into `programID`. Returns true if the program is
+  /// linked afterwards. Updates the hit/miss counters.
+  [[nodiscard]] bool load(IContext& context, GLuint programID, uint64_t key);
+
+  /// @brief Writes the binary of the linked program `programID` to disk.
+  void store(IContext& context, GLuint programID, uint64_t key);
+
+  [[nodiscard]] const std::string& getDirectory() const {
+    return directory_;
+  }
+  [[nodiscard]] Stats getStats() const {
+    return stats_;
+  }
+
+ private:
+  [[nodiscard]] std::string getFilePath(uint64_t key) const;
+
+ private:
+  const std::string directory_;
+  // hash of the driver identification strings, computed on first use
+  uint64_t driverHash_ = 0;
+  Stats stats_;
+};
+
+} // namespace igl::opengl
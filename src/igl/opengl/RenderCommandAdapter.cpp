@@ -314,7 +314,9 @@ void RenderCommandAdapter::setPipelineState(const std::shared_ptr<IRenderPipelin
 
 void RenderCommandAdapter::drawArrays(GLenum mode, GLint first, GLsizei count) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   getContext().drawArrays(toMockWireframeMode(mode), first, count);
   didDraw();
 }
@@ -323,7 +325,9 @@ void RenderCommandAdapter::drawArraysIndirect(GLenum mode,
                                               Buffer& indirectBuffer,
                                               const GLvoid* IGL_NULLABLE indirectBufferOffset) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DrawArraysIndirect)) {
     bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
     getContext().drawArraysIndirect(toMockWireframeMode(mode), indirectBufferOffset);
@@ -338,7 +342,9 @@ void RenderCommandAdapter::drawArraysInstanced(GLenum mode,
                                                GLsizei count,
                                                GLsizei instancecount) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasFeature(DeviceFeatures::DrawInstanced)) {
     getContext().drawArraysInstanced(toMockWireframeMode(mode), first, count, instancecount);
   } else {
@@ -352,7 +358,9 @@ void RenderCommandAdapter::drawElements(GLenum mode,
                                         GLenum indexType,
                                         const GLvoid* IGL_NULLABLE indexOffset) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   getContext().drawElements(toMockWireframeMode(mode), indexCount, indexType, indexOffset);
   didDraw();
 }
@@ -363,7 +371,9 @@ void RenderCommandAdapter::drawElementsInstanced(GLenum mode,
                                                  const GLvoid* IGL_NULLABLE indexOffset,
                                                  GLsizei instancecount) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasFeature(DeviceFeatures::DrawInstanced)) {
     getContext().drawElementsInstanced(
         toMockWireframeMode(mode), indexCount, indexType, indexOffset, instancecount);
@@ -378,7 +388,9 @@ void RenderCommandAdapter::drawElementsIndirect(GLenum mode,
                                                 Buffer& indirectBuffer,
                                                 const GLvoid* IGL_NULLABLE indirectBufferOffset) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasFeature(DeviceFeatures::DrawIndexedIndirect)) {
     bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
     getContext().drawElementsIndirect(toMockWireframeMode(mode), indexType, indirectBufferOffset);
@@ -394,7 +406,9 @@ void RenderCommandAdapter::multiDrawArraysIndirect(GLenum mode,
                                                    GLsizei drawcount,
                                                    GLsizei stride) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::MultiDrawIndirect)) {
     bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
     getContext().multiDrawArraysIndirect(
@@ -413,7 +427,9 @@ void RenderCommandAdapter::multiDrawElementsIndirect(GLenum mode,
                                                      GLsizei drawcount,
                                                      GLsizei stride) {
   IGL_PROFILER_FUNCTION();
-  willDraw();
+  if (!willDraw()) {
+    return;
+  }
   if (getContext().deviceFeatures().hasInternalFeature(InternalFeatures::MultiDrawIndirect)) {
     bindBufferWithShaderStorageBufferOverride(indirectBuffer, GL_DRAW_INDIRECT_BUFFER);
     getContext().multiDrawElementsIndirect(
@@ -454,12 +470,19 @@ void RenderCommandAdapter::endEncoding() {
  * state, depth/stencil state with stencil reference values, queued
  * uniforms, and dirty vertex/fragment texture-sampler pairs. Also
  * validates shader stages when shader validation is enabled.
+ * Returns false if the draw call has to be skipped because the program failed to link.
  */
-void RenderCommandAdapter::willDraw() {
+bool RenderCommandAdapter::willDraw() {
   IGL_PROFILER_FUNCTION();
   Result ret;
   auto* pipelineState = static_cast<RenderPipelineState*>(pipelineState_.get());
 
+  // a program whose deferred link failed cannot draw anything
+  if (pipelineState && !pipelineState->getLinkResult().isOk()) {
+    IGL_LOG_ERROR_ONCE("Skipping draw call: the render pipeline failed to link\n");
+    return false;
+  }
+
   // Vertex Buffers must be bound before pipelineState->bind()
   if (pipelineState) {
     pipelineState->clearActiveAttributesLocations();
@@ -468,7 +491,9 @@ void RenderCommandAdapter::willDraw() {
         auto& bufferState = vertexBuffers_[bufferIndex];
         bindBufferWithShaderStorageBufferOverride((*bufferState.resource), GL_ARRAY_BUFFER);
         // now bind the vertex attributes corresponding to this vertex buffer
-        pipelineState->bindVertexAttributes(bufferIndex, bufferState.offset, bufferState.stride);
+        const size_t offset =
+            bufferState.offset + static_cast<ArrayBuffer&>(*bufferState.resource).getBindOffset();
+        pipelineState->bindVertexAttributes(bufferIndex, offset, bufferState.stride);
         CLEAR_DIRTY(vertexBuffersDirty_, bufferIndex);
       }
     }
@@ -582,6 +607,8 @@ void RenderCommandAdapter::willDraw() {
       }
     }
   }
+
+  return true;
 }
 
 GLenum RenderCommandAdapter::toMockWireframeMode(GLenum mode) const {
@@ -151,7 +151,7 @@ class RenderCommandAdapter final : public WithContext {
 
   void clearDependentResources(const std::shared_ptr<IRenderPipelineState>& newValue,
                                Result* IGL_NULLABLE outResult = nullptr);
-  void willDraw();
+  [[nodiscard]] bool willDraw();
   void didDraw();
   void unbindVertexAttributes();
 
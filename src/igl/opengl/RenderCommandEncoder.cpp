@@ -433,6 +433,7 @@ void RenderCommandEncoder::bindIndexBuffer(IBuffer& buffer,
   IGL_PROFILER_FUNCTION();
   if (IGL_DEBUG_VERIFY(adapter_)) {
     indexType_ = toGlType(format);
+    bufferOffset += static_cast<ArrayBuffer&>(buffer).getBindOffset();
     indexBufferOffset_ = reinterpret_cast<void*>(bufferOffset); // NOLINT(performance-no-int-to-ptr)
     adapter_->setIndexBuffer(static_cast<Buffer&>(buffer));
   }
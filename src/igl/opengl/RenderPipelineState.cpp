@@ -120,9 +120,52 @@ Result RenderPipelineState::create() {
     return Result(Result::Code::ArgumentInvalid, "Missing required shader module(s).");
   }
 
+  const auto& mFramebufferDesc = desc_.targetDesc;
+
+  if (!mFramebufferDesc.colorAttachments.empty()) {
+    const ColorWriteMask colorWriteMask = mFramebufferDesc.colorAttachments[0].colorWriteMask;
+    colorMask_[0] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsRed) != 0);
+    colorMask_[1] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsGreen) != 0);
+    colorMask_[2] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsBlue) != 0);
+    colorMask_[3] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsAlpha) != 0);
+  }
+
+  if (!mFramebufferDesc.colorAttachments.empty() &&
+      mFramebufferDesc.colorAttachments[0].blendEnabled) {
+    blendEnabled_ = true;
+    // GL equation sets blending equation for both RGB and alpha
+    blendMode_ = {
+        .blendOpColor = convertBlendOp(mFramebufferDesc.colorAttachments[0].rgbBlendOp),
+        .blendOpAlpha = convertBlendOp(mFramebufferDesc.colorAttachments[0].alphaBlendOp),
+        .srcColor = convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcRGBBlendFactor),
+        .dstColor = convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstRGBBlendFactor),
+        .srcAlpha = convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcAlphaBlendFactor),
+        .dstAlpha = convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstAlphaBlendFactor)};
+  } else {
+    blendEnabled_ = false;
+  }
+
+  if (!shaderStages->isLinkComplete()) {
+    // the reflection is queried once the program is linked, see ensureLinked()
+    return Result();
+  }
+
+  linkResult_ = initializeReflection();
+  return linkResult_;
+}
+
+Result RenderPipelineState::initializeReflection() const {
+  IGL_PROFILER_FUNCTION();
+  isReflectionInitialized_ = true;
+
+  auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
+  Result result = shaderStages->resolveLink();
+  if (!result.isOk()) {
+    return result;
+  }
+
   reflection_ = std::make_shared<RenderPipelineReflection>(getContext(), *shaderStages);
 
-  const auto& mFramebufferDesc = desc_.targetDesc;
   // Get and cache all attribute locations, since this won't change throughout
   // the lifetime of this RenderPipelineState
   const auto* vertexInputState = static_cast<VertexInputState*>(desc_.vertexInputState.get());
@@ -194,34 +237,35 @@ Result RenderPipelineState::create() {
     unitSamplerLocationMap_[realTextureUnit] = loc;
   }
 
-  if (!mFramebufferDesc.colorAttachments.empty()) {
-    const ColorWriteMask colorWriteMask = mFramebufferDesc.colorAttachments[0].colorWriteMask;
-    colorMask_[0] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsRed) != 0);
-    colorMask_[1] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsGreen) != 0);
-    colorMask_[2] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsBlue) != 0);
-    colorMask_[3] = static_cast<GLboolean>((colorWriteMask & kColorWriteBitsAlpha) != 0);
-  }
+  return Result();
+}
 
-  if (!mFramebufferDesc.colorAttachments.empty() &&
-      mFramebufferDesc.colorAttachments[0].blendEnabled) {
-    blendEnabled_ = true;
-    // GL equation sets blending equation for both RGB and alpha
-    blendMode_ = {
-        .blendOpColor = convertBlendOp(mFramebufferDesc.colorAttachments[0].rgbBlendOp),
-        .blendOpAlpha = convertBlendOp(mFramebufferDesc.colorAttachments[0].alphaBlendOp),
-        .srcColor = convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcRGBBlendFactor),
-        .dstColor = convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstRGBBlendFactor),
-        .srcAlpha = convertBlendFactor(mFramebufferDesc.colorAttachments[0].srcAlphaBlendFactor),
-        .dstAlpha = convertBlendFactor(mFramebufferDesc.colorAttachments[0].dstAlphaBlendFactor)};
-  } else {
-    blendEnabled_ = false;
+void RenderPipelineState::ensureLinked() const {
+  if (isReflectionInitialized_ || !desc_.shaderStages) {
+    return;
   }
+  linkResult_ = initializeReflection();
+  IGL_SOFT_ASSERT(
+      linkResult_.isOk(), "Deferred pipeline creation failed: %s", linkResult_.message.c_str());
+}
 
-  return Result();
+const Result& RenderPipelineState::getLinkResult() const {
+  ensureLinked();
+  return linkResult_;
+}
+
+bool RenderPipelineState::isReady() const {
+  if (isReflectionInitialized_ || !desc_.shaderStages) {
+    return true;
+  }
+  return static_cast<const ShaderStages*>(desc_.shaderStages.get())->isLinkComplete();
 }
 
 void RenderPipelineState::bind() {
   IGL_PROFILER_FUNCTION();
+  if (!IGL_DEBUG_VERIFY(getLinkResult().isOk())) {
+    return;
+  }
   if (desc_.shaderStages) {
     const auto* shaderStages = static_cast<ShaderStages*>(desc_.shaderStages.get());
     shaderStages->bind();
@@ -279,6 +323,7 @@ void RenderPipelineState::bindVertexAttributes(size_t bufferIndex,
                                                size_t bufferOffset,
                                                size_t stride) {
   IGL_PROFILER_FUNCTION();
+  ensureLinked();
 #if IGL_DEBUG_ABORT_ENABLED
   static GLint sMaxNumVertexAttribs = 0;
   if (0 == sMaxNumVertexAttribs) {
@@ -364,6 +409,8 @@ Result RenderPipelineState::bindTextureUnit(const size_t unit,
     return Result{Result::Code::ArgumentInvalid, "Unit specified greater than maximum\n"};
   }
 
+  ensureLinked();
+
   GLint samplerLocation = -1;
   if (bindTarget == igl::BindTarget::kVertex) {
     auto it = vertexTextureUnitRemap_.find(unit);
@@ -397,6 +444,7 @@ bool RenderPipelineState::matchesVertexInputState(const RenderPipelineState& rhs
 }
 
 int RenderPipelineState::getIndexByName(const NameHandle& name, ShaderStage /*stage*/) const {
+  ensureLinked();
   if (reflection_ == nullptr) {
     return -1;
   }
@@ -404,6 +452,7 @@ int RenderPipelineState::getIndexByName(const NameHandle& name, ShaderStage /*st
 }
 
 int RenderPipelineState::getIndexByName(const std::string& name, ShaderStage /*stage*/) const {
+  ensureLinked();
   if (reflection_ == nullptr) {
     return -1;
   }
@@ -415,6 +464,7 @@ int RenderPipelineState::getUniformBlockBindingPoint(const NameHandle& uniformBl
 }
 
 std::shared_ptr<IRenderPipelineReflection> RenderPipelineState::renderPipelineReflection() {
+  ensureLinked();
   return reflection_;
 }
 
@@ -31,6 +31,8 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   friend class Device;
 
   Result create();
+  Result initializeReflection() const;
+  void ensureLinked() const;
 
  public:
   explicit RenderPipelineState(IContext& context,
@@ -45,6 +47,15 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   void bindVertexAttributes(size_t bufferIndex, size_t offset, size_t stride = 0);
   void unbindVertexAttributes();
 
+  /// Returns false while the program is still being linked by the driver in deferred linking mode
+  /// (see IContext::setDeferredProgramLinking()). Using a pipeline which is not ready is allowed
+  /// but waits for the link to finish.
+  [[nodiscard]] bool isReady() const;
+
+  /// Returns the result of linking the program, waiting for a deferred link to finish. A pipeline
+  /// whose deferred link failed is not bound and its draw calls are skipped.
+  [[nodiscard]] const Result& getLinkResult() const;
+
   [[nodiscard]] bool matchesShaderProgram(const RenderPipelineState& rhs) const;
   [[nodiscard]] bool matchesVertexInputState(const RenderPipelineState& rhs) const;
 
@@ -83,13 +94,17 @@ class RenderPipelineState final : public WithContext, public IRenderPipelineStat
   void unbindPrevPipelineVertexAttributes();
 
  private:
+  // Everything derived from the reflection is resolved lazily when the program is linked in
+  // deferred mode, hence mutable.
   // Tracks a list of attribute locations associated with a bufferIndex
-  std::vector<int> bufferAttribLocations_[IGL_BUFFER_BINDINGS_MAX];
-
-  std::shared_ptr<RenderPipelineReflection> reflection_;
-  std::unordered_map<size_t, size_t> vertexTextureUnitRemap_;
-  std::array<GLint, IGL_TEXTURE_SAMPLERS_MAX> unitSamplerLocationMap_{};
-  std::unordered_map<int, size_t> uniformBlockBindingMap_;
+  mutable std::vector<int> bufferAttribLocations_[IGL_BUFFER_BINDINGS_MAX];
+
+  mutable std::shared_ptr<RenderPipelineReflection> reflection_;
+  mutable std::unordered_map<size_t, size_t> vertexTextureUnitRemap_;
+  mutable std::array<GLint, IGL_TEXTURE_SAMPLERS_MAX> unitSamplerLocationMap_{};
+  mutable std::unordered_map<int, size_t> uniformBlockBindingMap_;
+  mutable bool isReflectionInitialized_ = false;
+  mutable Result linkResult_;
   std::array<GLboolean, 4> colorMask_ = {GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE};
   std::vector<int> prevPipelineStateAttributesLocations_;
   std::vector<int> activeAttributesLocations_;
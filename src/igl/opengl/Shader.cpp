@@ -10,9 +10,11 @@
 #include <cstdlib>
 #include <cstring>
 #include <string>
+#include <vector>
 #include <igl/DeviceFeatures.h>
 #include <igl/Macros.h>
 #include <igl/opengl/DeviceFeatureSet.h>
+#include <igl/opengl/ProgramBinaryCache.h>
 
 #if IGL_SHADER_DUMP
 #include <filesystem>
@@ -21,6 +23,23 @@
 
 namespace igl::opengl {
 
+namespace {
+
+std::string getShaderInfoLog(IContext& context, GLuint shaderID) {
+  // Get the size of log
+  GLsizei logSize = 0;
+  context.getShaderiv(shaderID, GL_INFO_LOG_LENGTH, &logSize);
+
+  // Pre-allocate vector for storage
+  std::vector<GLchar> log(logSize);
+  context.getShaderInfoLog(shaderID, logSize, nullptr, log.data());
+
+  // Create actual string from it
+  return {log.begin(), log.end()};
+}
+
+} // namespace
+
 ShaderStages::ShaderStages(const ShaderStagesDesc& desc, IContext& context) :
   IShaderStages(desc), WithContext(context) {}
 
@@ -48,8 +67,42 @@ void ShaderStages::createRenderProgram(Result* result) {
     return;
   }
 
-  const auto& vertexShader = static_cast<ShaderModule&>(*getVertexModule());
-  const auto& fragmentShader = static_cast<ShaderModule&>(*getFragmentModule());
+  auto& vertexShader = static_cast<ShaderModule&>(*getVertexModule());
+  auto& fragmentShader = static_cast<ShaderModule&>(*getFragmentModule());
+
+  // the cache can only be used if it was already enabled when the modules were created
+  ProgramBinaryCache* cache = getContext().getProgramBinaryCache();
+  if (cache != nullptr &&
+      (vertexShader.getSource().empty() || fragmentShader.getSource().empty())) {
+    cache = nullptr;
+  }
+  if (cache != nullptr) {
+    programBinaryKey_ =
+        cache->computeKey(getContext(), {vertexShader.getSource(), fragmentShader.getSource()});
+    const GLuint programID = getContext().createProgram();
+    if (programID != 0 && cache->load(getContext(), programID, programBinaryKey_)) {
+      if (programID_ != 0) {
+        getContext().deleteProgram(programID_);
+      }
+      programID_ = programID;
+      Result::setResult(result, Result::Code::Ok);
+      return;
+    }
+    if (programID != 0) {
+      getContext().deleteProgram(programID);
+    }
+  }
+
+  // the shaders are compiled lazily when the program binary cache is enabled
+  Result compileResult = vertexShader.ensureCompiled();
+  if (compileResult.isOk()) {
+    compileResult = fragmentShader.ensureCompiled();
+  }
+  if (!compileResult.isOk()) {
+    Result::setResult(result, std::move(compileResult));
+    return;
+  }
+
   const GLuint vertexShaderID = vertexShader.getShaderID();
   const GLuint fragmentShaderID = fragmentShader.getShaderID();
 
@@ -71,12 +124,27 @@ void ShaderStages::createRenderProgram(Result* result) {
   // attach the shaders and link them
   getContext().attachShader(programID, vertexShaderID);
   getContext().attachShader(programID, fragmentShaderID);
+  if (cache != nullptr) {
+    // without the hint, some drivers return an empty binary from glGetProgramBinary()
+    getContext().programParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   getContext().linkProgram(programID);
 
   // detach the shaders now that they've been linked
   getContext().detachShader(programID, vertexShaderID);
   getContext().detachShader(programID, fragmentShaderID);
 
+  if (getContext().isDeferredProgramLinkingEnabled()) {
+    // don't wait for the driver here: the link status is checked in resolveLink()
+    if (programID_ != 0) {
+      getContext().deleteProgram(programID_);
+    }
+    programID_ = programID;
+    isLinkPending_ = true;
+    Result::setResult(result, Result::Code::Ok);
+    return;
+  }
+
   // check to see if the linking succeeded
   GLint status = 0;
   getContext().getProgramiv(programID, GL_LINK_STATUS, &status);
@@ -89,6 +157,10 @@ void ShaderStages::createRenderProgram(Result* result) {
     return;
   }
 
+  if (cache != nullptr) {
+    cache->store(getContext(), programID, programBinaryKey_);
+  }
+
   // now that the program successfully linked, set the program
   if (programID_ != 0) {
     getContext().deleteProgram(programID_);
@@ -182,6 +254,48 @@ Result ShaderStages::validate() const {
   return Result{};
 }
 
+bool ShaderStages::isLinkComplete() const {
+  if (!isLinkPending_) {
+    return true;
+  }
+  GLint status = GL_FALSE;
+  getContext().getProgramiv(programID_, GL_COMPLETION_STATUS_KHR, &status);
+  return status == GL_TRUE;
+}
+
+Result ShaderStages::resolveLink() {
+  if (!isLinkPending_) {
+    return linkResult_;
+  }
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
+  isLinkPending_ = false;
+
+  GLint status = 0;
+  getContext().getProgramiv(programID_, GL_LINK_STATUS, &status);
+  if (status == GL_FALSE) {
+    // compile errors were not checked when the shader modules were created
+    std::string errorLog = getProgramInfoLog(programID_);
+    for (const auto& module : {getVertexModule(), getFragmentModule()}) {
+      const GLuint shaderID = static_cast<const ShaderModule&>(*module).getShaderID();
+      GLint compileStatus = 0;
+      getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &compileStatus);
+      if (compileStatus == GL_FALSE) {
+        errorLog += getShaderInfoLog(getContext(), shaderID);
+      }
+    }
+    IGL_LOG_ERROR("failed to link shaders:\n%s\n", errorLog.c_str());
+
+    getContext().deleteProgram(programID_);
+    programID_ = 0;
+    linkResult_ = Result(Result::Code::RuntimeError, std::move(errorLog));
+  } else if (ProgramBinaryCache* cache = getContext().getProgramBinaryCache();
+             cache != nullptr && programBinaryKey_ != 0) {
+    cache->store(getContext(), programID_, programBinaryKey_);
+  }
+
+  return linkResult_;
+}
+
 void ShaderStages::bind() const {
   IGL_PROFILER_FUNCTION();
   getContext().useProgram(programID_);
@@ -236,6 +350,28 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
     return Result(Result::Code::ArgumentInvalid, "Unknown shader type");
   }
 
+  hash_ = std::hash<std::string_view>()(
+      std::string_view(desc.input.source, std::strlen(desc.input.source)));
+
+  if (shaderType_ != GL_COMPUTE_SHADER && getContext().getProgramBinaryCache() != nullptr) {
+    // the shader is not needed if the program can be loaded from the cache, see ensureCompiled()
+    source_ = desc.input.source;
+    debugName_ = desc.debugName;
+    return Result();
+  }
+
+  return compile(desc.input.source, desc.debugName);
+}
+
+Result ShaderModule::ensureCompiled() {
+  if (shaderID_ != 0 || source_.empty()) {
+    return Result();
+  }
+  return compile(source_.c_str(), debugName_);
+}
+
+Result ShaderModule::compile(const GLchar* src, const std::string& debugName) {
+  IGL_PROFILER_FUNCTION();
   // always create a new temp shader ID
   // we'll set or update this object's shader ID after the compilation succeeds
   // otherwise we won't modify this shader
@@ -244,30 +380,27 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
     return Result(Result::Code::RuntimeError, "Failed to create shader ID");
   }
 
-  if (!desc.debugName.empty() &&
+  if (!debugName.empty() &&
       getContext().deviceFeatures().hasInternalFeature(InternalFeatures::DebugLabel)) {
     const GLenum identifier = getContext().deviceFeatures().hasInternalRequirement(
                                   InternalRequirement::DebugLabelExtEnumsReq)
                                   ? GL_SHADER_OBJECT_EXT
                                   : GL_SHADER;
     getContext().objectLabel(
-        identifier, shaderID, static_cast<GLsizei>(desc.debugName.size()), desc.debugName.c_str());
+        identifier, shaderID, static_cast<GLsizei>(debugName.size()), debugName.c_str());
   }
 
   // compile the shader
-  const GLchar* src = desc.input.source;
-
 #if IGL_SHADER_DUMP
   auto hash = std::hash<const GLchar*>()(src);
   std::string shaderStageExt;
-  switch (desc.info.stage) {
-  case ShaderStage::Vertex:
+  switch (shaderType_) {
+  case GL_VERTEX_SHADER:
     shaderStageExt = ".vert";
     break;
-  case ShaderStage::Fragment:
+  case GL_FRAGMENT_SHADER:
     shaderStageExt = ".frag";
     break;
-  case ShaderStage::Compute:
   default:
     shaderStageExt = ".compute";
   }
@@ -288,20 +421,14 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   getContext().shaderSource(shaderID, 1, &src, nullptr);
   getContext().compileShader(shaderID);
 
-  // see if the compilation succeeded
-  GLint status = 0;
-  getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
+  // see if the compilation succeeded; with deferred linking, compile errors of render shaders are
+  // reported when the program is linked
+  GLint status = GL_TRUE;
+  if (shaderType_ == GL_COMPUTE_SHADER || !getContext().isDeferredProgramLinkingEnabled()) {
+    getContext().getShaderiv(shaderID, GL_COMPILE_STATUS, &status);
+  }
   if (status == GL_FALSE) {
-    // Get the size of log
-    GLsizei logSize = 0;
-    getContext().getShaderiv(shaderID, GL_INFO_LOG_LENGTH, &logSize);
-
-    // Pre-allocate vector for storage
-    std::vector<GLchar> log(logSize);
-    getContext().getShaderInfoLog(shaderID, logSize, nullptr, log.data());
-
-    // Create actual string from it
-    const std::string errorLog(log.begin(), log.end());
+    const std::string errorLog = getShaderInfoLog(getContext(), shaderID);
     IGL_LOG_ERROR("failed to compile %s shader:\n%s\nSource\n%s",
                   (shaderType_ == GL_VERTEX_SHADER ? "vertex" : "fragment"),
                   errorLog.c_str(),
@@ -320,9 +447,6 @@ Result ShaderModule::create(const ShaderModuleDesc& desc) {
   }
   shaderID_ = shaderID;
 
-  hash_ = std::hash<std::string_view>()(
-      std::string_view(desc.input.source, std::strlen(desc.input.source)));
-
   return Result();
 }
 
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <string>
 #include <unordered_map>
 #include <igl/Shader.h>
 #include <igl/opengl/IContext.h>
@@ -23,6 +24,10 @@ class ShaderModule : public WithContext, public IShaderModule {
   ~ShaderModule() override;
   Result create(const ShaderModuleDesc& desc);
 
+  /// Compiles the shader if its compilation was skipped because the program binary cache is
+  /// enabled (see IContext::setProgramBinaryCacheDirectory()). Does nothing otherwise.
+  Result ensureCompiled();
+
   [[nodiscard]] inline GLenum getShaderType() const {
     return shaderType_;
   }
@@ -35,6 +40,12 @@ class ShaderModule : public WithContext, public IShaderModule {
     return hash_;
   }
 
+  /// The GLSL source, kept only if the program binary cache was enabled when this module was
+  /// created. Empty otherwise.
+  [[nodiscard]] const std::string& getSource() const {
+    return source_;
+  }
+
   ShaderModule(IContext& context, ShaderModuleInfo info);
 
   ShaderModule(const ShaderModule&) = delete;
@@ -43,6 +54,8 @@ class ShaderModule : public WithContext, public IShaderModule {
   ShaderModule& operator=(ShaderModule&&) = delete;
 
  private:
+  Result compile(const GLchar* src, const std::string& debugName);
+
   // Type of shader (vertex, fragment, compute)
   GLenum shaderType_ = 0;
 
@@ -51,6 +64,10 @@ class ShaderModule : public WithContext, public IShaderModule {
 
   // Hash of the shader source
   size_t hash_ = 0;
+
+  // Kept for ensureCompiled() and for the program binary cache key
+  std::string source_;
+  std::string debugName_;
 };
 
 class ShaderStages final : public IShaderStages, public WithContext {
@@ -75,6 +92,14 @@ class ShaderStages final : public IShaderStages, public WithContext {
     return programID_;
   }
 
+  /// Returns true if the program is linked and its status can be queried without stalling. Polls
+  /// GL_COMPLETION_STATUS_KHR while a deferred link is still pending.
+  [[nodiscard]] bool isLinkComplete() const;
+
+  /// Waits for a deferred link to finish and returns its result. If linking failed, the program
+  /// is deleted and getProgramID() returns 0 afterwards. Returns the cached result on later calls.
+  Result resolveLink();
+
  private:
   void createRenderProgram(Result* result);
   void createComputeProgram(Result* result);
@@ -82,6 +107,13 @@ class ShaderStages final : public IShaderStages, public WithContext {
 
   // the GL shader program ID
   GLuint programID_ = 0;
+
+  // true while a link started in deferred mode has not been checked yet
+  bool isLinkPending_ = false;
+  Result linkResult_;
+
+  // key of this program in the program binary cache, 0 if the cache is not used
+  uint64_t programBinaryKey_ = 0;
 };
 
 } // namespace opengl
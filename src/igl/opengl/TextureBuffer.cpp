@@ -47,6 +47,7 @@ TextureBuffer::~TextureBuffer() {
     }
     getContext().deleteTextures(1, &textureId);
   }
+  getContext().removeTextureMemoryUsage(memoryUsage_);
 }
 
 uint64_t TextureBuffer::getTextureId() const {
@@ -136,9 +137,14 @@ Result TextureBuffer::createTexture(const TextureDesc& desc) {
   if (desc.type == TextureType::ExternalImage) {
     // No further initialization needed for external image textures
     return Result{};
-  } else {
-    return initialize(desc.debugName);
   }
+
+  Result result = initialize(desc.debugName);
+  if (result.isOk()) {
+    memoryUsage_ = getEstimatedSizeInBytes();
+    getContext().addTextureMemoryUsage(memoryUsage_);
+  }
+  return result;
 }
 
 Result TextureBuffer::initialize(const std::string& debugName) const {
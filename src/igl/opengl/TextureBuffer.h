@@ -60,6 +60,8 @@ class TextureBuffer : public TextureBufferBase {
   bool canInitialize() const;
   bool supportsTexStorage() const;
   mutable uint64_t textureHandle_ = 0;
+  // estimated size of the texture storage reported to IContext::getGPUMemoryUsage()
+  size_t memoryUsage_ = 0;
 };
 
 } // namespace igl::opengl
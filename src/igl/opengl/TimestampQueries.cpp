@@ -142,4 +142,16 @@ void TimestampQueries::endElapsedQuery() {
   iglEndQuery(GL_TIME_ELAPSED);
 }
 
+bool TimestampQueries::beginFrameQuery() {
+  if (!valid_ || currentIndex_ >= maxSlots_) {
+    return false;
+  }
+  beginElapsedQuery(currentIndex_);
+  return true;
+}
+
+void TimestampQueries::endFrameQuery() {
+  endElapsedQuery();
+}
+
 } // namespace igl::opengl
@@ -48,6 +48,10 @@ class TimestampQueries : public ITimestampQueries, public WithContext {
   /// Virtual for the same reason as beginElapsedQuery() above.
   virtual void endElapsedQuery();
 
+  /// Starts a GL_TIME_ELAPSED query in the next free slot
+  [[nodiscard]] bool beginFrameQuery() override;
+  void endFrameQuery() override;
+
  private:
   std::vector<GLuint> queryIds_;
   uint32_t maxSlots_ = 0;
@@ -14,6 +14,7 @@
 #endif
 
 #include <string>
+#include <vector>
 #include <igl/CommandBuffer.h>
 #include <igl/RenderPass.h>
 #include <igl/RenderPipelineState.h>
@@ -213,6 +214,42 @@ TEST_F(DeviceTest, InDevelopmentFeature) {
   ASSERT_TRUE(iglDev_->testDevelopmentFlags(igl::InDevelopementFeatures::DummyFeatureExample) == 0);
 }
 
+//
+// GPU Memory Usage
+//
+// Make sure textures and buffers are accounted for in getGPUMemoryUsageBreakdown()
+//
+TEST_F(DeviceTest, GPUMemoryUsage) {
+  if (iglDev_->getBackendType() != igl::BackendType::OpenGL &&
+      iglDev_->getBackendType() != igl::BackendType::Vulkan) {
+    GTEST_SKIP() << "Memory usage breakdown is not tracked on this backend";
+  }
+
+  const GPUMemoryUsage before = iglDev_->getGPUMemoryUsageBreakdown();
+
+  Result ret;
+  const TextureDesc texDesc = TextureDesc::new2D(
+      TextureFormat::RGBA_UNorm8, 64, 64, TextureDesc::TextureUsageBits::Sampled);
+  auto texture = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // static OpenGL buffers require data on creation
+  const std::vector<uint8_t> bufferData(1024);
+  const BufferDesc bufferDesc{
+      .type = BufferDesc::BufferTypeBits::Vertex,
+      .data = bufferData.data(),
+      .length = bufferData.size(),
+  };
+  auto buffer = iglDev_->createBuffer(bufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const GPUMemoryUsage after = iglDev_->getGPUMemoryUsageBreakdown();
+  ASSERT_GE(after.textures - before.textures, 64u * 64u * 4u);
+  ASSERT_GE(after.buffers - before.buffers, 1024u);
+  ASSERT_GE(after.total, after.textures);
+  ASSERT_EQ(iglDev_->getGPUMemoryUsage(), after.total);
+}
+
 //
 // Get Backend Type
 //
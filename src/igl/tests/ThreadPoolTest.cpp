@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <igl/ThreadPool.h>
+
+namespace igl::tests {
+
+TEST(ThreadPoolTest, DefaultNumThreads) {
+  const ThreadPool pool;
+  EXPECT_GE(pool.getNumThreads(), 1u);
+}
+
+TEST(ThreadPoolTest, SubmitReturnsValue) {
+  ThreadPool pool(2);
+  auto future = pool.submit([]() { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPoolTest, RunsAllTasks) {
+  ThreadPool pool(4);
+  std::atomic<uint32_t> counter = 0;
+  std::vector<std::future<void>> futures;
+  futures.reserve(100);
+  for (uint32_t i = 0; i != 100; i++) {
+    futures.emplace_back(pool.submit([&counter]() { counter++; }));
+  }
+  for (auto& f : futures) {
+    f.get();
+  }
+  EXPECT_EQ(counter.load(), 100u);
+}
+
+TEST(ThreadPoolTest, WaitIdle) {
+  ThreadPool pool(3);
+  std::atomic<uint32_t> counter = 0;
+  for (uint32_t i = 0; i != 50; i++) {
+    (void)pool.submit([&counter]() { counter++; });
+  }
+  pool.waitIdle();
+  EXPECT_EQ(counter.load(), 50u);
+}
+
+TEST(ThreadPoolTest, IsWorkerThread) {
+  ThreadPool pool(1);
+  EXPECT_FALSE(pool.isWorkerThread());
+  auto future = pool.submit([&pool]() { return pool.isWorkerThread(); });
+  EXPECT_TRUE(future.get());
+}
+
+TEST(ThreadPoolTest, DestructorDrainsQueue) {
+  std::atomic<uint32_t> counter = 0;
+  {
+    ThreadPool pool(1);
+    for (uint32_t i = 0; i != 20; i++) {
+      (void)pool.submit([&counter]() { counter++; });
+    }
+  }
+  EXPECT_EQ(counter.load(), 20u);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/Common.h"
+
+#include <IGLU/simple_renderer/TransientGeometryArena.h>
+#include <array>
+#include <set>
+
+namespace igl::tests {
+
+using iglu::vertexdata::TransientGeometryArena;
+
+//
+// TransientGeometryArenaTest
+//
+// Unit tests for iglu::vertexdata::TransientGeometryArena
+//
+class TransientGeometryArenaTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    setDebugBreakEnabled(false);
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+  }
+
+ protected:
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_F(TransientGeometryArenaTest, AllocationsAreAligned) {
+  TransientGeometryArena arena(256, 64, "test");
+  const std::array<float, 5> vertices{};
+  const std::array<uint16_t, 3> indices{};
+
+  arena.begin();
+  const auto a = arena.allocate(vertices.data(), sizeof(vertices), indices.data(), sizeof(indices));
+  const auto b = arena.allocate(vertices.data(), sizeof(vertices), indices.data(), sizeof(indices));
+  EXPECT_EQ(a.vertexOffset, 0u);
+  EXPECT_EQ(a.indexOffset, 0u);
+  EXPECT_GE(b.vertexOffset, sizeof(vertices));
+  EXPECT_GE(b.indexOffset, sizeof(indices));
+  EXPECT_EQ(b.vertexOffset % TransientGeometryArena::kAlignment, 0u);
+  EXPECT_EQ(b.indexOffset % TransientGeometryArena::kAlignment, 0u);
+  ASSERT_TRUE(arena.commit(*iglDev_).isOk());
+  ASSERT_NE(arena.vertexBuffer(), nullptr);
+  ASSERT_NE(arena.indexBuffer(), nullptr);
+
+  // allocations start over every frame
+  arena.begin();
+  const auto c = arena.allocate(vertices.data(), sizeof(vertices), nullptr, 0);
+  EXPECT_EQ(c.vertexOffset, 0u);
+}
+
+TEST_F(TransientGeometryArenaTest, FramesUseDifferentBuffers) {
+  TransientGeometryArena arena(256, 64, "test");
+  const std::array<float, 4> vertices{};
+
+  std::set<IBuffer*> buffers;
+  for (uint32_t i = 0; i != TransientGeometryArena::kNumFrames; i++) {
+    arena.begin();
+    arena.allocate(vertices.data(), sizeof(vertices), nullptr, 0);
+    ASSERT_TRUE(arena.commit(*iglDev_).isOk());
+    buffers.insert(arena.vertexBuffer().get());
+  }
+  EXPECT_EQ(buffers.size(), TransientGeometryArena::kNumFrames);
+
+  // the first frame's buffers are reused afterwards
+  arena.begin();
+  ASSERT_TRUE(arena.commit(*iglDev_).isOk());
+  EXPECT_EQ(arena.currentFrame(), 0u);
+  EXPECT_EQ(buffers.count(arena.vertexBuffer().get()), 1u);
+}
+
+TEST_F(TransientGeometryArenaTest, GrowsBuffers) {
+  TransientGeometryArena arena(64, 16, "test");
+  const std::array<uint8_t, 100> vertices{};
+  const std::array<uint16_t, 20> indices{};
+
+  arena.begin();
+  arena.allocate(vertices.data(), sizeof(vertices), indices.data(), sizeof(indices));
+  arena.allocate(vertices.data(), sizeof(vertices), indices.data(), sizeof(indices));
+  ASSERT_TRUE(arena.commit(*iglDev_).isOk());
+  EXPECT_GE(arena.vertexBuffer()->getSizeInBytes(), 2 * sizeof(vertices));
+  EXPECT_GE(arena.indexBuffer()->getSizeInBytes(), 2 * sizeof(indices));
+}
+
+} // namespace igl::tests
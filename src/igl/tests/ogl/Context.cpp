@@ -10,6 +10,8 @@
 #include "../util/TestDevice.h"
 
 #include <cstring>
+#include <igl/CommandBuffer.h>
+#include <igl/CommandQueue.h>
 #include <igl/Common.h>
 #include <igl/DeviceFeatures.h>
 #include <igl/Texture.h>
@@ -203,6 +205,174 @@ TEST_F(ContextOGLTest, StateCacheInvalidateFramebufferCacheWhenSettingGLReadFram
   }
 }
 
+/// Calls which do not change the shadowed GL state should not reach OpenGL.
+TEST_F(ContextOGLTest, StateCacheElidesRedundantCalls) {
+  GLuint textureId = 0;
+  context_->genTextures(1, &textureId);
+
+  context_->activeTexture(GL_TEXTURE0);
+  context_->bindTexture(GL_TEXTURE_2D, textureId);
+  context_->enable(GL_BLEND);
+  context_->blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+  const opengl::IContext::StateCacheStats statsBefore = context_->getStateCacheStats();
+  const unsigned int callCountBefore = context_->getCallCount();
+
+  context_->activeTexture(GL_TEXTURE0);
+  context_->bindTexture(GL_TEXTURE_2D, textureId);
+  context_->enable(GL_BLEND);
+  context_->setEnabled(true, GL_BLEND);
+  context_->blendFuncSeparate(GL_ONE, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+  EXPECT_EQ(context_->getCallCount(), callCountBefore);
+  const opengl::IContext::StateCacheStats stats = context_->getStateCacheStats();
+  EXPECT_EQ(stats.numElidedBindings - statsBefore.numElidedBindings, 2u);
+  EXPECT_EQ(stats.numElidedStateChanges - statsBefore.numElidedStateChanges, 3u);
+
+  // A different value goes through
+  context_->disable(GL_BLEND);
+  EXPECT_EQ(context_->getCallCount(), callCountBefore + 1);
+
+  GLint isEnabled = GL_TRUE;
+  context_->getIntegerv(GL_BLEND, &isEnabled);
+  EXPECT_EQ(isEnabled, GL_FALSE);
+
+  // Clean up
+  context_->bindTexture(GL_TEXTURE_2D, 0);
+  context_->deleteTextures(1, &textureId);
+}
+
+/// After invalidateStateCache(), all calls should reach OpenGL again, as the state could have been
+/// changed by GL code outside of IGL.
+TEST_F(ContextOGLTest, StateCacheInvalidate) {
+  context_->enable(GL_DEPTH_TEST);
+  context_->depthFunc(GL_LESS);
+
+  context_->invalidateStateCache();
+
+  const opengl::IContext::StateCacheStats statsBefore = context_->getStateCacheStats();
+  const unsigned int callCountBefore = context_->getCallCount();
+
+  context_->enable(GL_DEPTH_TEST);
+  context_->depthFunc(GL_LESS);
+
+  EXPECT_EQ(context_->getCallCount(), callCountBefore + 2);
+  const opengl::IContext::StateCacheStats stats = context_->getStateCacheStats();
+  EXPECT_EQ(stats.numElidedBindings, statsBefore.numElidedBindings);
+  EXPECT_EQ(stats.numElidedStateChanges, statsBefore.numElidedStateChanges);
+
+  // Clean up
+  context_->disable(GL_DEPTH_TEST);
+}
+
+/// GL code outside of IGL can run between device scopes with any unbind policy, so entering the
+/// outermost scope must forget the shadowed state.
+TEST_F(ContextOGLTest, StateCacheInvalidatedByDeviceScope) {
+  ASSERT_EQ(context_->getUnbindPolicy(), opengl::UnbindPolicy::Default);
+
+  context_->enable(GL_DEPTH_TEST);
+  {
+    const DeviceScope scope(*device_);
+    const unsigned int callCountBefore = context_->getCallCount();
+    context_->enable(GL_DEPTH_TEST);
+    EXPECT_EQ(context_->getCallCount(), callCountBefore + 1);
+
+    // nested scopes keep the cache
+    const DeviceScope nestedScope(*device_);
+    context_->enable(GL_DEPTH_TEST);
+    EXPECT_EQ(context_->getCallCount(), callCountBefore + 1);
+  }
+
+  // Clean up
+  context_->disable(GL_DEPTH_TEST);
+}
+
+/// OpenGL unbinds deleted objects, so binding a new object which reuses the name of a deleted one
+/// should not be elided.
+TEST_F(ContextOGLTest, StateCacheForgetsDeletedObjects) {
+  GLuint bufferId = 0;
+  GLuint textureId = 0;
+  context_->genBuffers(1, &bufferId);
+  context_->genTextures(1, &textureId);
+  context_->bindBuffer(GL_ARRAY_BUFFER, bufferId);
+  context_->bindTexture(GL_TEXTURE_2D, textureId);
+
+  context_->deleteBuffers(1, &bufferId);
+  context_->deleteTextures(1, &textureId);
+
+  context_->genBuffers(1, &bufferId);
+  context_->genTextures(1, &textureId);
+  context_->bindBuffer(GL_ARRAY_BUFFER, bufferId);
+  context_->bindTexture(GL_TEXTURE_2D, textureId);
+
+  GLint retrievedBuffer = -1;
+  context_->getIntegerv(GL_ARRAY_BUFFER_BINDING, &retrievedBuffer);
+  EXPECT_EQ(bufferId, retrievedBuffer);
+
+  GLint retrievedTexture = -1;
+  context_->getIntegerv(GL_TEXTURE_BINDING_2D, &retrievedTexture);
+  EXPECT_EQ(textureId, retrievedTexture);
+
+  // Clean up
+  context_->bindBuffer(GL_ARRAY_BUFFER, 0);
+  context_->bindTexture(GL_TEXTURE_2D, 0);
+  context_->deleteBuffers(1, &bufferId);
+  context_->deleteTextures(1, &textureId);
+}
+
+/// GL_ELEMENT_ARRAY_BUFFER is part of the VAO state, so switching VAOs should invalidate it.
+TEST_F(ContextOGLTest, StateCacheVertexArrayInvalidatesElementArrayBuffer) {
+  if (!context_->deviceFeatures().hasInternalFeature(opengl::InternalFeatures::VertexArrayObject)) {
+    GTEST_SKIP() << "VAOs are not supported";
+  }
+
+  GLuint vaoIds[2];
+  context_->genVertexArrays(2, vaoIds);
+  GLuint bufferId = 0;
+  context_->genBuffers(1, &bufferId);
+
+  context_->bindVertexArray(vaoIds[0]);
+  context_->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
+  context_->bindVertexArray(vaoIds[1]);
+  // This should still set the value, as vaoIds[1] has no element array buffer
+  context_->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferId);
+
+  GLint retrievedBuffer = -1;
+  context_->getIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &retrievedBuffer);
+  EXPECT_EQ(bufferId, retrievedBuffer);
+
+  // Clean up
+  context_->bindVertexArray(0);
+  context_->deleteVertexArrays(2, vaoIds);
+  context_->deleteBuffers(1, &bufferId);
+}
+
+/// The stats of the current frame move to getLastFrameStateCacheStats() when an end-of-frame
+/// command buffer is submitted.
+TEST_F(ContextOGLTest, StateCacheStatsPerFrame) {
+  context_->useProgram(0);
+  context_->useProgram(0);
+  context_->viewport(0, 0, 1, 1);
+  context_->viewport(0, 0, 1, 1);
+
+  const opengl::IContext::StateCacheStats stats = context_->getStateCacheStats();
+  EXPECT_GE(stats.numElidedBindings, 1u);
+  EXPECT_GE(stats.numElidedStateChanges, 1u);
+
+  Result ret;
+  auto cmdQueue = device_->createCommandQueue({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  auto cmdBuffer = cmdQueue->createCommandBuffer({}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  cmdQueue->submit(*cmdBuffer, true);
+
+  const opengl::IContext::StateCacheStats lastFrameStats = context_->getLastFrameStateCacheStats();
+  EXPECT_EQ(lastFrameStats.numElidedBindings, stats.numElidedBindings);
+  EXPECT_EQ(lastFrameStats.numElidedStateChanges, stats.numElidedStateChanges);
+  EXPECT_EQ(context_->getStateCacheStats().numElidedBindings, 0u);
+  EXPECT_EQ(context_->getStateCacheStats().numElidedStateChanges, 0u);
+}
+
 /// This test is a sanity check that we should not have a GL error out of
 /// the blue.
 TEST_F(ContextOGLTest, CheckForErrorsNoError) {
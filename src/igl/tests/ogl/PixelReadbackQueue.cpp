@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <igl/opengl/PixelReadbackQueue.h>
+
+#include "../util/Common.h"
+
+#include <array>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/Framebuffer.h>
+
+namespace igl::tests {
+
+namespace {
+constexpr uint32_t kWidth = 4;
+constexpr uint32_t kHeight = 4;
+} // namespace
+
+//
+// PixelReadbackQueueOGLTest
+//
+// Unit tests for igl::opengl::PixelReadbackQueue
+//
+class PixelReadbackQueueOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_NE(iglDev_, nullptr);
+
+    Result ret;
+    queue_ = static_cast<opengl::Device&>(*iglDev_).createPixelReadbackQueue(2, &ret);
+    if (queue_ == nullptr) {
+      GTEST_SKIP() << ret.message;
+    }
+
+    const auto desc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                         kWidth,
+                                         kHeight,
+                                         TextureDesc::TextureUsageBits::Sampled |
+                                             TextureDesc::TextureUsageBits::Attachment);
+    texture_ = iglDev_->createTexture(desc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+    for (uint32_t i = 0; i != pixels_.size(); i++) {
+      pixels_[i] = 0xff000000u | i;
+    }
+    ASSERT_TRUE(texture_->upload(texture_->getFullRange(), pixels_.data()).isOk());
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture_;
+    framebuffer_ = iglDev_->createFramebuffer(framebufferDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message;
+  }
+
+ protected:
+  [[nodiscard]] const opengl::Framebuffer& getFramebuffer() const {
+    return static_cast<const opengl::Framebuffer&>(*framebuffer_);
+  }
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::unique_ptr<opengl::PixelReadbackQueue> queue_;
+  std::shared_ptr<ITexture> texture_;
+  std::shared_ptr<IFramebuffer> framebuffer_;
+  std::array<uint32_t, kWidth * kHeight> pixels_{};
+};
+
+TEST_F(PixelReadbackQueueOGLTest, ReadsFullTexture) {
+  Result ret;
+  const auto id =
+      queue_->requestColorAttachment(getFramebuffer(), 0, texture_->getFullRange(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  ASSERT_NE(id, opengl::PixelReadbackQueue::kInvalidRequest);
+  EXPECT_NE(queue_->getStatus(id), opengl::PixelReadbackQueue::Status::Invalid);
+  EXPECT_EQ(queue_->getSizeInBytes(id), sizeof(pixels_));
+
+  EXPECT_EQ(queue_->wait(id), opengl::PixelReadbackQueue::Status::Ready);
+  std::array<uint32_t, kWidth * kHeight> actual{};
+  ASSERT_TRUE(queue_->getBytes(id, actual.data(), sizeof(actual)).isOk());
+  EXPECT_EQ(actual, pixels_);
+
+  // the request is gone after reading it
+  EXPECT_EQ(queue_->getStatus(id), opengl::PixelReadbackQueue::Status::Invalid);
+  EXPECT_EQ(queue_->getNumInFlight(), 0u);
+}
+
+TEST_F(PixelReadbackQueueOGLTest, MultipleRequestsInFlight) {
+  Result ret;
+  const auto region = TextureRangeDesc::new2D(1, 2, 2, 1);
+  const auto id0 = queue_->requestColorAttachment(getFramebuffer(), 0, region, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  const auto id1 =
+      queue_->requestColorAttachment(getFramebuffer(), 0, texture_->getFullRange(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message;
+  EXPECT_NE(id0, id1);
+  EXPECT_EQ(queue_->getNumInFlight(), 2u);
+
+  // both buffers are taken until their requests are read or released
+  EXPECT_EQ(queue_->requestColorAttachment(getFramebuffer(), 0, region, &ret),
+            opengl::PixelReadbackQueue::kInvalidRequest);
+  EXPECT_FALSE(ret.isOk());
+
+  std::array<uint32_t, 2> actual{};
+  ASSERT_TRUE(queue_->getBytes(id0, actual.data(), sizeof(actual)).isOk());
+  EXPECT_EQ(actual[0], pixels_[2 * kWidth + 1]);
+  EXPECT_EQ(actual[1], pixels_[2 * kWidth + 2]);
+
+  queue_->release(id1);
+  EXPECT_EQ(queue_->getNumInFlight(), 0u);
+  EXPECT_NE(queue_->requestColorAttachment(getFramebuffer(), 0, region, &ret),
+            opengl::PixelReadbackQueue::kInvalidRequest);
+}
+
+} // namespace igl::tests
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <igl/opengl/ProgramBinaryCache.h>
+
+#include "../data/ShaderData.h"
+#include "../util/Common.h"
+
+#include <filesystem>
+#include <fstream>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+#include <igl/opengl/Shader.h>
+
+namespace igl::tests {
+
+//
+// ProgramBinaryCacheOGLTest
+//
+// Unit tests for igl::opengl::ProgramBinaryCache
+//
+class ProgramBinaryCacheOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_TRUE(iglDev_ != nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+
+    dir_ = std::filesystem::temp_directory_path() / "igl_program_binary_cache_test";
+    std::filesystem::remove_all(dir_);
+    std::filesystem::create_directories(dir_);
+
+    context_->setProgramBinaryCacheDirectory(dir_.string());
+    if (context_->getProgramBinaryCache() == nullptr) {
+      GTEST_SKIP() << "Program binaries are not supported";
+    }
+  }
+
+  void TearDown() override {
+    if (context_ != nullptr) {
+      context_->setProgramBinaryCacheDirectory({});
+    }
+    std::filesystem::remove_all(dir_);
+  }
+
+ protected:
+  [[nodiscard]] std::unique_ptr<IShaderStages> createStages() const {
+    std::unique_ptr<IShaderStages> stages;
+    util::createShaderStages(iglDev_,
+                             data::shader::kOglSimpleVertShader,
+                             "vertexShader",
+                             data::shader::kOglSimpleFragShader,
+                             "fragmentShader",
+                             stages);
+    return stages;
+  }
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+  std::filesystem::path dir_;
+};
+
+TEST_F(ProgramBinaryCacheOGLTest, StoreAndLoad) {
+  const opengl::ProgramBinaryCache& cache = *context_->getProgramBinaryCache();
+
+  auto stages = createStages();
+  ASSERT_TRUE(stages != nullptr);
+  EXPECT_NE(static_cast<opengl::ShaderStages&>(*stages).getProgramID(), 0u);
+  EXPECT_EQ(cache.getStats().numHits, 0u);
+  EXPECT_EQ(cache.getStats().numMisses, 1u);
+  EXPECT_FALSE(std::filesystem::is_empty(dir_));
+
+  // the second program is restored from disk
+  stages = createStages();
+  ASSERT_TRUE(stages != nullptr);
+  EXPECT_NE(static_cast<opengl::ShaderStages&>(*stages).getProgramID(), 0u);
+  EXPECT_EQ(cache.getStats().numHits, 1u);
+  EXPECT_EQ(cache.getStats().numMisses, 1u);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, ProgramsAreLinkedRetrievable) {
+  auto stages = createStages();
+  ASSERT_TRUE(stages != nullptr);
+
+  GLint retrievable = GL_FALSE;
+  context_->getProgramiv(static_cast<opengl::ShaderStages&>(*stages).getProgramID(),
+                         GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                         &retrievable);
+  EXPECT_EQ(retrievable, GL_TRUE);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, FallbackOnRejectedBinary) {
+  const opengl::ProgramBinaryCache& cache = *context_->getProgramBinaryCache();
+
+  ASSERT_TRUE(createStages() != nullptr);
+
+  // damage all cached binaries
+  for (const auto& entry : std::filesystem::directory_iterator(dir_)) {
+    std::ofstream file(entry.path(), std::ios::binary | std::ios::trunc);
+    file << "not a program binary";
+  }
+
+  auto stages = createStages();
+  ASSERT_TRUE(stages != nullptr);
+  EXPECT_NE(static_cast<opengl::ShaderStages&>(*stages).getProgramID(), 0u);
+  EXPECT_EQ(cache.getStats().numRejected, 1u);
+  EXPECT_EQ(cache.getStats().numHits, 0u);
+}
+
+TEST_F(ProgramBinaryCacheOGLTest, KeyDependsOnSources) {
+  opengl::ProgramBinaryCache& cache = *context_->getProgramBinaryCache();
+
+  const uint64_t key = cache.computeKey(*context_, {"a", "b"});
+  EXPECT_EQ(key, cache.computeKey(*context_, {"a", "b"}));
+  EXPECT_NE(key, cache.computeKey(*context_, {"b", "a"}));
+  EXPECT_NE(key, cache.computeKey(*context_, {"ab", ""}));
+}
+
+} // namespace igl::tests
@@ -12,9 +12,14 @@
 #include "../data/ShaderData.h"
 #include "../util/Common.h"
 
+#include <igl/CommandBuffer.h>
 #include <igl/Device.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderPass.h>
 #include <igl/RenderPipelineState.h>
 #include <igl/VertexInputState.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/RenderPipelineState.h>
 
 namespace igl::tests {
 
@@ -238,4 +243,101 @@ TEST_F(RenderPipelineReflectionTest, UniformBlocks) {
     }
   }
 }
+
+TEST_F(RenderPipelineReflectionTest, DeferredProgramLinking) {
+  auto& context = static_cast<opengl::Device&>(*iglDev_).getContext();
+  context.setDeferredProgramLinking(true);
+
+  std::unique_ptr<IShaderStages> stages;
+  util::createShaderStages(iglDev_,
+                           data::shader::kOglSimpleVertShaderCube,
+                           "vertexShader",
+                           data::shader::kOglSimpleFragShaderCube,
+                           "fragmentShader",
+                           stages);
+  ASSERT_TRUE(stages != nullptr);
+
+  RenderPipelineDesc renderPipelineDesc;
+  renderPipelineDesc.vertexInputState = vertexInputState_;
+  renderPipelineDesc.shaderStages = std::move(stages);
+
+  Result ret;
+  auto pipelineState = iglDev_->createRenderPipeline(renderPipelineDesc, &ret);
+  context.setDeferredProgramLinking(false);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(pipelineState != nullptr);
+
+  // the reflection is resolved on first use, whether or not the link has finished by now
+  auto* pipeRef = static_cast<opengl::RenderPipelineReflection*>(
+      pipelineState->renderPipelineReflection().get());
+  ASSERT_TRUE(pipeRef != nullptr);
+  EXPECT_TRUE(static_cast<opengl::RenderPipelineState&>(*pipelineState).isReady());
+  EXPECT_GE(pipeRef->getIndexByName(IGL_NAMEHANDLE(data::shader::kSimpleCubeView)), 0);
+  EXPECT_EQ(pipeRef->allTextures().size(), 1);
+  EXPECT_NE(static_cast<opengl::RenderPipelineState&>(*pipelineState)
+                .getShaderStages()
+                ->getProgramID(),
+            0u);
+}
+
+TEST_F(RenderPipelineReflectionTest, DeferredProgramLinkingFailure) {
+  // the varying types do not match, so the shaders compile but the program fails to link
+  constexpr std::string_view kVertShader = IGL_TO_STRING(
+      LEGACY_VERSION attribute vec4 position; varying vec2 uv;
+
+      void main() {
+        gl_Position = position;
+        uv = position.xy;
+      });
+  constexpr std::string_view kFragShader = IGL_TO_STRING(
+      LEGACY_VERSION PROLOG varying vec3 uv;
+
+      void main() { gl_FragColor = vec4(uv, 1.0); });
+
+  auto& context = static_cast<opengl::Device&>(*iglDev_).getContext();
+  context.setDeferredProgramLinking(true);
+
+  std::unique_ptr<IShaderStages> stages;
+  util::createShaderStages(iglDev_, kVertShader, "main", kFragShader, "main", stages);
+  ASSERT_TRUE(stages != nullptr);
+
+  RenderPipelineDesc renderPipelineDesc;
+  renderPipelineDesc.shaderStages = std::move(stages);
+  renderPipelineDesc.targetDesc.colorAttachments.resize(1);
+  renderPipelineDesc.targetDesc.colorAttachments[0].textureFormat =
+      offscreenTexture_->getProperties().format;
+
+  Result ret;
+  auto pipelineState = iglDev_->createRenderPipeline(renderPipelineDesc, &ret);
+  context.setDeferredProgramLinking(false);
+  if (!ret.isOk()) {
+    // the driver finished linking before the pipeline was created
+    EXPECT_TRUE(pipelineState == nullptr);
+    return;
+  }
+  ASSERT_TRUE(pipelineState != nullptr);
+
+  const auto& glPipelineState = static_cast<opengl::RenderPipelineState&>(*pipelineState);
+  EXPECT_FALSE(glPipelineState.getLinkResult().isOk());
+  EXPECT_TRUE(glPipelineState.isReady());
+
+  // draw calls with the failed pipeline are skipped
+  FramebufferDesc framebufferDesc;
+  framebufferDesc.colorAttachments[0].texture = offscreenTexture_;
+  auto framebuffer = iglDev_->createFramebuffer(framebufferDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  RenderPassDesc renderPass;
+  renderPass.colorAttachments.resize(1);
+  renderPass.colorAttachments[0].loadAction = LoadAction::Clear;
+
+  auto cmdBuf = cmdQueue_->createCommandBuffer(CommandBufferDesc{}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  auto cmdEncoder = cmdBuf->createRenderCommandEncoder(renderPass, framebuffer);
+  ASSERT_TRUE(cmdEncoder != nullptr);
+  cmdEncoder->bindRenderPipelineState(pipelineState);
+  cmdEncoder->draw(3);
+  cmdEncoder->endEncoding();
+  cmdQueue_->submit(*cmdBuf);
+}
 } // namespace igl::tests
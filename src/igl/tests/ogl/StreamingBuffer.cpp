@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/Common.h"
+
+#include <cstring>
+#include <igl/opengl/Buffer.h>
+#include <igl/opengl/Device.h>
+#include <igl/opengl/IContext.h>
+
+namespace igl::tests {
+
+//
+// StreamingBufferOGLTest
+//
+// Tests for the streaming mode of opengl::ArrayBuffer, enabled with BufferAPIHintBits::Ring.
+//
+class StreamingBufferOGLTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+    util::createDeviceAndQueue(iglDev_, cmdQueue_);
+    ASSERT_NE(iglDev_, nullptr);
+    context_ = &static_cast<opengl::Device&>(*iglDev_).getContext();
+  }
+
+ protected:
+  std::shared_ptr<IBuffer> createBuffer(BufferDesc::BufferType type,
+                                        BufferDesc::BufferAPIHint hint,
+                                        const void* data,
+                                        size_t length) {
+    BufferDesc desc;
+    desc.type = type;
+    desc.data = data;
+    desc.length = length;
+    desc.storage = ResourceStorage::Shared;
+    desc.hint = hint;
+    Result ret;
+    auto buffer = iglDev_->createBuffer(desc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    return buffer;
+  }
+
+  std::shared_ptr<IDevice> iglDev_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  opengl::IContext* context_ = nullptr;
+};
+
+TEST_F(StreamingBufferOGLTest, UploadAfterBindAdvancesSlot) {
+  const float data[] = {1.0f, 2.0f, 3.0f, 4.0f};
+  auto buffer = createBuffer(
+      BufferDesc::BufferTypeBits::Vertex, BufferDesc::BufferAPIHintBits::Ring, data, sizeof(data));
+  ASSERT_NE(buffer, nullptr);
+  auto& arrayBuffer = static_cast<opengl::ArrayBuffer&>(*buffer);
+  if (!arrayBuffer.isStreaming()) {
+    GTEST_SKIP() << "Streaming buffers are not supported";
+  }
+  EXPECT_EQ(buffer->acceptedApiHints(), BufferDesc::BufferAPIHintBits::Ring);
+  EXPECT_EQ(arrayBuffer.getBindOffset(), 0u);
+
+  // the GPU has not seen the buffer yet, so the upload stays in the current slot
+  const float first[] = {5.0f};
+  ASSERT_TRUE(buffer->upload(first, BufferRange(sizeof(first), 0)).isOk());
+  EXPECT_EQ(arrayBuffer.getBindOffset(), 0u);
+
+  size_t prevOffset = arrayBuffer.getBindOffset();
+  for (uint32_t i = 0; i != 2 * opengl::ArrayBuffer::kNumStreamingSlots; i++) {
+    arrayBuffer.bind();
+    const float value = 10.0f + static_cast<float>(i);
+    ASSERT_TRUE(buffer->upload(&value, BufferRange(sizeof(value), sizeof(float))).isOk());
+    EXPECT_NE(arrayBuffer.getBindOffset(), prevOffset);
+    prevOffset = arrayBuffer.getBindOffset();
+  }
+  arrayBuffer.unbind();
+
+  // partial uploads keep the rest of the contents
+  Result ret;
+  const auto* contents = static_cast<const float*>(buffer->map(BufferRange(sizeof(data)), &ret));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(contents, nullptr);
+  EXPECT_EQ(contents[0], 5.0f);
+  EXPECT_EQ(contents[1], 10.0f + (2 * opengl::ArrayBuffer::kNumStreamingSlots - 1));
+  EXPECT_EQ(contents[2], 3.0f);
+  EXPECT_EQ(contents[3], 4.0f);
+  buffer->unmap();
+
+  EXPECT_FALSE(buffer->upload(data, BufferRange(sizeof(data), sizeof(float))).isOk());
+  ASSERT_EQ(context_->checkForErrors(__FILE__, __LINE__), GL_NO_ERROR);
+}
+
+TEST_F(StreamingBufferOGLTest, PersistentlyMappedWithBufferStorage) {
+  const auto& features = context_->deviceFeatures();
+  const bool hasBufferStorage =
+      opengl::DeviceFeatureSet::usesOpenGLES()
+          ? features.isSupported("GL_EXT_buffer_storage")
+          : features.getGLVersion() >= opengl::GLVersion::v4_4 ||
+                features.isSupported("GL_ARB_buffer_storage");
+  EXPECT_EQ(features.hasInternalFeature(opengl::InternalFeatures::BufferStorage), hasBufferStorage);
+
+  const float data[] = {1.0f, 2.0f, 3.0f, 4.0f};
+  auto buffer = createBuffer(
+      BufferDesc::BufferTypeBits::Vertex, BufferDesc::BufferAPIHintBits::Ring, data, sizeof(data));
+  ASSERT_NE(buffer, nullptr);
+  auto& arrayBuffer = static_cast<opengl::ArrayBuffer&>(*buffer);
+  if (!arrayBuffer.isStreaming()) {
+    GTEST_SKIP() << "Streaming buffers are not supported";
+  }
+  EXPECT_EQ(arrayBuffer.isPersistentlyMapped(), hasBufferStorage);
+
+  // uploads to the persistently mapped slots reach the buffer
+  arrayBuffer.bind();
+  const float value = 7.0f;
+  ASSERT_TRUE(buffer->upload(&value, BufferRange(sizeof(value), 0)).isOk());
+  arrayBuffer.unbind();
+
+  Result ret;
+  const auto* contents = static_cast<const float*>(buffer->map(BufferRange(sizeof(data)), &ret));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(contents, nullptr);
+  EXPECT_EQ(contents[0], 7.0f);
+  EXPECT_EQ(contents[3], 4.0f);
+  buffer->unmap();
+  ASSERT_EQ(context_->checkForErrors(__FILE__, __LINE__), GL_NO_ERROR);
+}
+
+TEST_F(StreamingBufferOGLTest, UniformBlockBindRange) {
+  if (!iglDev_->hasFeature(DeviceFeatures::UniformBlocks)) {
+    GTEST_SKIP() << "Uniform blocks are not supported";
+  }
+  const float data[4] = {};
+  auto buffer = createBuffer(BufferDesc::BufferTypeBits::Uniform,
+                             BufferDesc::BufferAPIHintBits::UniformBlock |
+                                 BufferDesc::BufferAPIHintBits::Ring,
+                             data,
+                             sizeof(data));
+  ASSERT_NE(buffer, nullptr);
+  auto& uniformBuffer = static_cast<opengl::UniformBlockBuffer&>(*buffer);
+  if (!uniformBuffer.isStreaming()) {
+    GTEST_SKIP() << "Streaming buffers are not supported";
+  }
+
+  size_t alignment = 0;
+  ASSERT_TRUE(iglDev_->getFeatureLimits(DeviceFeatureLimits::BufferAlignment, alignment));
+
+  Result ret;
+  uniformBuffer.bindBase(0, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_TRUE(buffer->upload(data, BufferRange(sizeof(data), 0)).isOk());
+  EXPECT_NE(uniformBuffer.getBindOffset(), 0u);
+  EXPECT_EQ(uniformBuffer.getBindOffset() % alignment, 0u);
+
+  uniformBuffer.bindRange(0, 0, sizeof(data), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_EQ(context_->checkForErrors(__FILE__, __LINE__), GL_NO_ERROR);
+}
+
+} // namespace igl::tests
@@ -108,6 +108,114 @@ TEST_F(CommandBufferVulkanTest, CopyBuffer) {
   dstBuffer->unmap();
 }
 
+TEST_F(CommandBufferVulkanTest, ReadBufferAsync) {
+  Result ret;
+
+  BufferDesc srcDesc;
+  srcDesc.type = BufferDesc::BufferTypeBits::Storage;
+  srcDesc.storage = ResourceStorage::Private;
+  srcDesc.length = 256;
+  auto srcBuffer = iglDev_->createBuffer(srcDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::vector<uint32_t> srcData(64);
+  for (uint32_t i = 0; i != srcData.size(); i++) {
+    srcData[i] = i;
+  }
+  ret = srcBuffer->upload(srcData.data(), BufferRange(256, 0));
+  ASSERT_TRUE(ret.isOk());
+
+  auto cmdBuf = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  auto readback = cmdBuf->readBufferAsync(*srcBuffer, 16, 128, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(readback, nullptr);
+  EXPECT_EQ(readback->size(), 128u);
+  EXPECT_EQ(readback->bytesPerRow(), 0u);
+  EXPECT_FALSE(readback->isReady());
+  EXPECT_EQ(readback->data(), nullptr);
+
+  uint32_t numCalls = 0;
+  readback->setCompletionHandler([&numCalls](const IReadback& r) {
+    numCalls++;
+    EXPECT_NE(r.data(), nullptr);
+  });
+  EXPECT_EQ(numCalls, 0u);
+
+  cmdQueue_->submit(*cmdBuf);
+  readback->wait();
+
+  EXPECT_EQ(numCalls, 1u);
+  ASSERT_TRUE(readback->isReady());
+  const auto* data = static_cast<const uint32_t*>(readback->data());
+  ASSERT_NE(data, nullptr);
+  for (uint32_t i = 0; i != 32; i++) {
+    EXPECT_EQ(data[i], i + 4);
+  }
+
+  // the handler is invoked right away once the readback is complete
+  readback->setCompletionHandler([&numCalls](const IReadback&) { numCalls++; });
+  EXPECT_EQ(numCalls, 2u);
+}
+
+TEST_F(CommandBufferVulkanTest, ReadBufferAsyncOutOfRange) {
+  Result ret;
+
+  BufferDesc desc;
+  desc.type = BufferDesc::BufferTypeBits::Storage;
+  desc.storage = ResourceStorage::Private;
+  desc.length = 64;
+  auto buffer = iglDev_->createBuffer(desc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto cmdBuf = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  EXPECT_EQ(cmdBuf->readBufferAsync(*buffer, 32, 64, &ret), nullptr);
+  EXPECT_EQ(ret.code, Result::Code::ArgumentOutOfRange);
+
+  cmdQueue_->submit(*cmdBuf);
+}
+
+TEST_F(CommandBufferVulkanTest, ReadTextureAsync) {
+  Result ret;
+
+  const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                 4,
+                                                 4,
+                                                 TextureDesc::TextureUsageBits::Sampled |
+                                                     TextureDesc::TextureUsageBits::Attachment);
+  auto texture = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::vector<uint32_t> pixels(16);
+  for (uint32_t i = 0; i != pixels.size(); i++) {
+    pixels[i] = 0xFF000000 | i;
+  }
+  ret = texture->upload(TextureRangeDesc::new2D(0, 0, 4, 4), pixels.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto cmdBuf = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+  ASSERT_TRUE(ret.isOk());
+
+  auto readback = cmdBuf->readTextureAsync(*texture, TextureRangeDesc::new2D(1, 2, 2, 2), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(readback, nullptr);
+  EXPECT_EQ(readback->size(), 16u);
+  EXPECT_EQ(readback->bytesPerRow(), 8u);
+
+  cmdQueue_->submit(*cmdBuf);
+  readback->wait();
+
+  const auto* data = static_cast<const uint32_t*>(readback->data());
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(data[0], pixels[9]);
+  EXPECT_EQ(data[1], pixels[10]);
+  EXPECT_EQ(data[2], pixels[13]);
+  EXPECT_EQ(data[3], pixels[14]);
+}
+
 TEST_F(CommandBufferVulkanTest, WaitUntilCompleted) {
   Result ret;
   auto cmdBuf = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
@@ -25,6 +25,8 @@
 #include <igl/SamplerState.h>
 #include <igl/Texture.h>
 #include <igl/VertexInputState.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
 
 #if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
 
@@ -44,6 +46,8 @@ namespace igl::tests {
 ///   4. Extinct pool recycling: Pool + cached descriptor sets reused
 ///   5. allocatedDSet_ save/restore via ExtinctDescriptorPool
 ///   6. New pool creation fallback: No extinct pool ready, brand-new pool created
+///   7. Descriptor set cache: identical bindings reuse a set written earlier in the same command
+///      buffer
 class DescriptorPoolArenaTest : public ::testing::Test {
  public:
   DescriptorPoolArenaTest() = default;
@@ -363,6 +367,57 @@ TEST_F(DescriptorPoolArenaTest, ReusedPoolReExhausted) {
   renderFrame(65);
 }
 
+// Test 15: Alternating between two textures in one command buffer writes each descriptor set once
+// and then reuses it from the descriptor set cache.
+TEST_F(DescriptorPoolArenaTest, DescriptorSetCacheReusesIdenticalBindings) {
+  const auto& ctx = static_cast<vulkan::Device&>(*iglDev_).getVulkanContext();
+  if (ctx.features().has_VK_EXT_descriptor_buffer || !ctx.config_.enableDescriptorSetCache) {
+    GTEST_SKIP() << "Descriptor sets are not used";
+  }
+
+  Result ret;
+  const auto texDesc = TextureDesc::new2D(
+      TextureFormat::RGBA_UNorm8, 2, 2, TextureDesc::TextureUsageBits::Sampled);
+  const auto otherTex = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ret = otherTex->upload(otherTex->getFullRange(0), data::texture::kTexRgba2x2.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const auto cmdBuf = cmdQueue_->createCommandBuffer(CommandBufferDesc{}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const RenderPassDesc rpDesc = {
+      .colorAttachments = {{
+          .loadAction = LoadAction::Clear,
+          .storeAction = StoreAction::Store,
+      }},
+  };
+  const auto encoder = cmdBuf->createRenderCommandEncoder(rpDesc, framebuffer_, {}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  encoder->bindRenderPipelineState(pipeline_);
+  encoder->bindSamplerState(0, BindTarget::kFragment, sampler_.get());
+  encoder->bindVertexBuffer(data::shader::kSimplePosIndex, *vb_);
+  encoder->bindVertexBuffer(data::shader::kSimpleUvIndex, *uv_);
+
+  const vulkan::VulkanDescriptorSetCacheStats before = ctx.getDescriptorSetCacheStats();
+
+  constexpr uint32_t kNumDraws = 10;
+  for (uint32_t i = 0; i != kNumDraws; i++) {
+    encoder->bindTexture(0, BindTarget::kFragment, (i & 1) ? otherTex.get() : sampledTex_.get());
+    encoder->draw(3);
+  }
+
+  const vulkan::VulkanDescriptorSetCacheStats after = ctx.getDescriptorSetCacheStats();
+
+  encoder->endEncoding();
+  cmdQueue_->submit(*cmdBuf);
+  cmdBuf->waitUntilCompleted();
+
+  EXPECT_EQ(after.numMisses - before.numMisses, 2u);
+  EXPECT_EQ(after.numHits - before.numHits, kNumDraws - 2);
+}
+
 } // namespace igl::tests
 
 #endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
@@ -13,11 +13,14 @@
 #include <IGLU/managedUniformBuffer/ManagedUniformBuffer.h>
 #include <array>
 #include <cstdint>
+#include <string>
 #include <vector>
 #include <igl/CommandBuffer.h>
 #include <igl/Shader.h>
+#include <igl/ThreadPool.h>
 #include <igl/glslang/GlslCompiler.h>
 #include <igl/glslang/GlslangHelpers.h>
+#include <igl/glslang/SpirvCache.h>
 #if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/Device.h>
@@ -346,6 +349,43 @@ void main() {
   igl::glslang::finalizeCompiler();
 }
 
+GTEST_TEST(GlslCompilerBatch, CompilesJobsInParallel) {
+  glslang_resource_t resource = {};
+  glslangGetDefaultResource(&resource);
+
+  constexpr uint32_t kNumJobs = 16;
+
+  std::vector<glslang::CompileJob> jobs;
+  for (uint32_t i = 0; i != kNumJobs; i++) {
+    const std::string value = std::to_string(i) + ".0";
+    jobs.push_back({
+        .stage = ShaderStage::Fragment,
+        .code = "#version 460\n"
+                "layout(location = 0) out vec4 outColor;\n"
+                "void main() { outColor = vec4(" +
+                value + "); }\n",
+    });
+  }
+
+  ThreadPool pool(4);
+  glslang::SpirvCache cache(kNumJobs);
+
+  // the second batch is served from the cache
+  for (uint32_t pass = 0; pass != 2; pass++) {
+    auto futures = glslang::compileShaders(pool, jobs, resource, &cache);
+    ASSERT_EQ(futures.size(), jobs.size());
+    for (auto& f : futures) {
+      const glslang::CompileJobResult r = f.get();
+      EXPECT_TRUE(r.result.isOk()) << r.result.message.c_str();
+      ASSERT_FALSE(r.spirv.empty());
+      EXPECT_EQ(r.spirv.front(), 0x07230203u);
+    }
+  }
+
+  EXPECT_EQ(cache.getStats().numMisses, kNumJobs);
+  EXPECT_EQ(cache.getStats().numHits, kNumJobs);
+}
+
 TEST_F(DeviceVulkanTest, BufferDeviceAddress) {
   const igl::vulkan::VulkanContext& ctx =
       static_cast<const igl::vulkan::Device*>(iglDev_.get())->getVulkanContext();
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#include <array>
+#include <memory>
+#include <igl/CommandBuffer.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderCommandEncoder.h>
+#include <igl/RenderPass.h>
+#include <igl/ShaderCreator.h>
+#include <igl/Texture.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+
+// a full-screen triangle at a constant depth
+constexpr const char* kCodeVS = R"(
+  layout(push_constant) uniform Constants {
+    vec4 color;
+    float depth;
+  } pc;
+  void main() {
+    vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(uv * 2.0 - 1.0, pc.depth, 1.0);
+  }
+)";
+
+constexpr const char* kCodeFS = R"(
+  layout(push_constant) uniform Constants {
+    vec4 color;
+    float depth;
+  } pc;
+  layout(location = 0) out vec4 out_FragColor;
+  void main() {
+    out_FragColor = pc.color;
+  }
+)";
+
+struct Constants {
+  float color[4] = {};
+  float depth = 0;
+};
+
+constexpr uint32_t kSize = 4;
+constexpr uint32_t kRed = 0xFF0000FF;
+constexpr uint32_t kGreen = 0xFF00FF00;
+
+} // namespace
+
+/// @brief Renders the same frame with and without VK_KHR_dynamic_rendering. The results have to
+/// be identical.
+class DynamicRenderingTest : public ::testing::TestWithParam<bool> {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    auto config = util::device::vulkan::getContextConfig(true);
+    config.enableDynamicRendering = GetParam();
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_NE(device_, nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    colorTex_ = device_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kSize,
+                           kSize,
+                           TextureDesc::TextureUsageBits::Attachment |
+                               TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    TextureDesc depthDesc = TextureDesc::new2D(
+        TextureFormat::Z_UNorm24, kSize, kSize, TextureDesc::TextureUsageBits::Attachment);
+    depthDesc.storage = ResourceStorage::Private;
+    depthTex_ = device_->createTexture(depthDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc fbDesc;
+    fbDesc.colorAttachments[0].texture = colorTex_;
+    fbDesc.depthAttachment.texture = depthTex_;
+    fb_ = device_->createFramebuffer(fbDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    pipelineDesc.targetDesc.depthAttachmentFormat = TextureFormat::Z_UNorm24;
+    pipelineDesc.shaderStages = ShaderStagesCreator::fromModuleStringInput(
+        *device_, kCodeVS, "main", "", kCodeFS, "main", "", &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    pipeline_ = device_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    depthState_ = device_->createDepthStencilState(
+        {.compareFunction = CompareFunction::Less, .isDepthWriteEnabled = true}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+ protected:
+  void render(LoadAction loadAction, const Constants& constants) {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    RenderPassDesc rpDesc;
+    rpDesc.colorAttachments.resize(1);
+    rpDesc.colorAttachments[0].loadAction = loadAction;
+    rpDesc.colorAttachments[0].storeAction = StoreAction::Store;
+    rpDesc.colorAttachments[0].clearColor = {1.0f, 0.0f, 0.0f, 1.0f};
+    rpDesc.depthAttachment.loadAction = loadAction;
+    rpDesc.depthAttachment.storeAction = StoreAction::Store;
+    rpDesc.depthAttachment.clearDepth = 1.0f;
+
+    auto encoder = cmdBuffer->createRenderCommandEncoder(rpDesc, fb_, {}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_NE(encoder, nullptr);
+    encoder->bindRenderPipelineState(pipeline_);
+    encoder->bindDepthStencilState(depthState_);
+    encoder->bindPushConstants(&constants, sizeof(constants));
+    encoder->draw(3);
+    encoder->endEncoding();
+
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+  }
+
+  void checkPixels(uint32_t expected) {
+    std::array<uint32_t, kSize * kSize> pixels = {};
+    fb_->copyBytesColorAttachment(*cmdQueue_, 0, pixels.data(), colorTex_->getFullRange(0));
+    for (const uint32_t pixel : pixels) {
+      EXPECT_EQ(pixel, expected);
+    }
+  }
+
+  std::unique_ptr<vulkan::Device> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<ITexture> colorTex_;
+  std::shared_ptr<ITexture> depthTex_;
+  std::shared_ptr<IFramebuffer> fb_;
+  std::shared_ptr<IRenderPipelineState> pipeline_;
+  std::shared_ptr<IDepthStencilState> depthState_;
+};
+
+TEST_P(DynamicRenderingTest, FeatureSelection) {
+  const vulkan::VulkanContext& ctx = device_->getVulkanContext();
+  const vulkan::VulkanFeatures& features = ctx.features();
+
+  if (!GetParam()) {
+    EXPECT_FALSE(ctx.useDynamicRendering());
+    return;
+  }
+  EXPECT_EQ(ctx.useDynamicRendering(),
+            features.has_VK_KHR_dynamic_rendering &&
+                features.featuresDynamicRendering.dynamicRendering == VK_TRUE);
+}
+
+TEST_P(DynamicRenderingTest, ClearDrawAndLoad) {
+  if (GetParam() && !device_->getVulkanContext().useDynamicRendering()) {
+    GTEST_SKIP() << "VK_KHR_dynamic_rendering is not supported";
+  }
+
+  // the clear value is overwritten by the triangle and the depth buffer is set to 0.5
+  ASSERT_NO_FATAL_FAILURE(render(LoadAction::Clear, {.color = {0, 1, 0, 1}, .depth = 0.5f}));
+  checkPixels(kGreen);
+
+  // both attachments are loaded: the triangle behind the stored depth values is discarded
+  ASSERT_NO_FATAL_FAILURE(render(LoadAction::Load, {.color = {1, 0, 0, 1}, .depth = 0.75f}));
+  checkPixels(kGreen);
+
+  // the triangle in front of the stored depth values is drawn
+  ASSERT_NO_FATAL_FAILURE(render(LoadAction::Load, {.color = {1, 0, 0, 1}, .depth = 0.25f}));
+  checkPixels(kRed);
+}
+
+INSTANTIATE_TEST_SUITE_P(RenderPassAndDynamicRendering,
+                         DynamicRenderingTest,
+                         ::testing::Values(false, true));
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/TextureValidationHelpers.h"
+#include "../util/device/vulkan/TestDevice.h"
+
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include <igl/CommandBuffer.h>
+#include <igl/Framebuffer.h>
+#include <igl/Texture.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanTexture.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kRed = 0xFF0000FF;
+constexpr uint32_t kBlue = 0xFFFF0000;
+
+std::unique_ptr<vulkan::Device> createDevice(uint32_t computeMipmapMinSize) {
+  auto config = util::device::vulkan::getContextConfig(true);
+  config.computeMipmapMinSize = computeMipmapMinSize;
+  return util::device::vulkan::createTestDevice(config);
+}
+
+std::shared_ptr<ITexture> createTexture(IDevice& device, uint32_t size, Result& ret) {
+  TextureDesc desc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                        size,
+                                        size,
+                                        TextureDesc::TextureUsageBits::Sampled |
+                                            TextureDesc::TextureUsageBits::Attachment);
+  desc.numMipLevels = TextureDesc::calcNumMipLevels(size, size);
+  desc.mipmapGeneration = TextureDesc::TextureMipmapGeneration::Manual;
+  return device.createTexture(desc, &ret);
+}
+
+// the left half is red, the right half is blue
+std::vector<uint32_t> getHalves(uint32_t size) {
+  std::vector<uint32_t> pixels(static_cast<size_t>(size) * size);
+  for (uint32_t y = 0; y != size; y++) {
+    for (uint32_t x = 0; x != size; x++) {
+      pixels[static_cast<size_t>(y) * size + x] = x < size / 2 ? kRed : kBlue;
+    }
+  }
+  return pixels;
+}
+
+} // namespace
+
+/// @brief Generates a mip chain longer than VulkanMipmapGenerator::kMaxMipsPerDispatch over
+/// several workgroups and checks every level
+TEST(MipmapGeneratorTest, GenerateWithCompute) {
+  igl::setDebugBreakEnabled(false);
+
+  auto device = createDevice(1);
+  ASSERT_NE(device, nullptr);
+
+  const vulkan::VulkanContext& ctx = device->getVulkanContext();
+  ASSERT_NE(ctx.mipmapGenerator_, nullptr);
+  if (!ctx.mipmapGenerator_->isFormatSupported(VK_FORMAT_R8G8B8A8_UNORM)) {
+    GTEST_SKIP() << "VK_FORMAT_R8G8B8A8_UNORM cannot be a storage image";
+  }
+
+  constexpr uint32_t kSize = 64;
+
+  Result ret;
+  auto cmdQueue = device->createCommandQueue(CommandQueueDesc{}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto texture = createTexture(*device, kSize, ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  const vulkan::VulkanImage& image =
+      static_cast<vulkan::Texture&>(*texture).getVulkanTexture().image;
+  EXPECT_TRUE(image.isStorageImage());
+  EXPECT_TRUE(ctx.mipmapGenerator_->shouldGenerate(image));
+
+  const std::vector<uint32_t> level0 = getHalves(kSize);
+  ret = texture->upload(texture->getFullRange(0), level0.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  texture->generateMipmap(*cmdQueue);
+
+  // the halves survive a box filter down to 2x2
+  for (uint32_t mip = 1; (kSize >> mip) >= 2; mip++) {
+    const std::vector<uint32_t> expected = getHalves(kSize >> mip);
+    util::validateUploadedTextureRange(*device,
+                                       *cmdQueue,
+                                       texture,
+                                       texture->getFullRange(mip),
+                                       expected.data(),
+                                       "MipmapGeneratorTest: generated level");
+  }
+}
+
+/// @brief The compute shader and blits produce the same mip chain for a noisy texture. Blits round
+/// every level while the compute shader keeps up to kMaxMipsPerDispatch levels in shared memory, so
+/// level N may differ by N per channel.
+TEST(MipmapGeneratorTest, MatchesBlit) {
+  igl::setDebugBreakEnabled(false);
+
+  auto deviceBlit = createDevice(0);
+  ASSERT_NE(deviceBlit, nullptr);
+  auto deviceCompute = createDevice(1);
+  ASSERT_NE(deviceCompute, nullptr);
+  if (!deviceCompute->getVulkanContext().mipmapGenerator_->isFormatSupported(
+          VK_FORMAT_R8G8B8A8_UNORM)) {
+    GTEST_SKIP() << "VK_FORMAT_R8G8B8A8_UNORM cannot be a storage image";
+  }
+
+  // 9 levels take 3 dispatches of the compute shader
+  constexpr uint32_t kSize = 256;
+
+  std::vector<uint32_t> level0(static_cast<size_t>(kSize) * kSize);
+  uint32_t seed = 12345;
+  for (uint32_t& pixel : level0) {
+    seed = seed * 1664525u + 1013904223u;
+    pixel = seed;
+  }
+
+  // returns the generated levels 1..N
+  auto generate = [&level0](vulkan::Device& device, bool expectCompute) {
+    std::vector<std::vector<uint32_t>> levels;
+    Result ret;
+    auto cmdQueue = device.createCommandQueue(CommandQueueDesc{}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    auto texture = createTexture(device, kSize, ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    if (!texture) {
+      return levels;
+    }
+    EXPECT_EQ(device.getVulkanContext().mipmapGenerator_->shouldGenerate(
+                  static_cast<vulkan::Texture&>(*texture).getVulkanTexture().image),
+              expectCompute);
+    ret = texture->upload(texture->getFullRange(0), level0.data());
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    texture->generateMipmap(*cmdQueue);
+
+    FramebufferDesc framebufferDesc;
+    framebufferDesc.colorAttachments[0].texture = texture;
+    auto fb = device.createFramebuffer(framebufferDesc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    for (uint32_t mip = 1; mip != texture->getNumMipLevels(); mip++) {
+      const TextureRangeDesc range = texture->getFullRange(mip);
+      std::vector<uint32_t>& pixels = levels.emplace_back(range.width * range.height);
+      fb->copyBytesColorAttachment(*cmdQueue, 0, pixels.data(), range);
+    }
+    return levels;
+  };
+
+  const std::vector<std::vector<uint32_t>> blit = generate(*deviceBlit, false);
+  const std::vector<std::vector<uint32_t>> compute = generate(*deviceCompute, true);
+  ASSERT_EQ(blit.size(), TextureDesc::calcNumMipLevels(kSize, kSize) - 1);
+  ASSERT_EQ(blit.size(), compute.size());
+
+  for (size_t level = 0; level != blit.size(); level++) {
+    const int tolerance = static_cast<int>(level + 1);
+    ASSERT_EQ(blit[level].size(), compute[level].size());
+    for (size_t i = 0; i != blit[level].size(); i++) {
+      const uint32_t a = blit[level][i];
+      const uint32_t b = compute[level][i];
+      for (uint32_t shift = 0; shift != 32; shift += 8) {
+        ASSERT_LE(std::abs(static_cast<int>((a >> shift) & 0xFF) -
+                           static_cast<int>((b >> shift) & 0xFF)),
+                  tolerance)
+            << "level " << level + 1 << ", texel " << i << ": blit 0x" << std::hex << a
+            << ", compute 0x" << b;
+      }
+    }
+  }
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
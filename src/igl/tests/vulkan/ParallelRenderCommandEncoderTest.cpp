@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <igl/CommandBuffer.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderCommandEncoder.h>
+#include <igl/RenderPass.h>
+#include <igl/ShaderCreator.h>
+#include <igl/Texture.h>
+#include <igl/vulkan/CommandBuffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/ParallelRenderCommandEncoder.h>
+#include <igl/vulkan/VulkanContext.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+
+// a full-screen triangle
+constexpr const char* kCodeVS = R"(
+  void main() {
+    vec2 uv = vec2((gl_VertexIndex << 1) & 2, gl_VertexIndex & 2);
+    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);
+  }
+)";
+
+constexpr const char* kCodeFS = R"(
+  layout(push_constant) uniform Constants {
+    vec4 color;
+  } pc;
+  layout(location = 0) out vec4 out_FragColor;
+  void main() {
+    out_FragColor = pc.color;
+  }
+)";
+
+constexpr uint32_t kSize = 4;
+constexpr uint32_t kRed = 0xFF0000FF;
+constexpr uint32_t kGreen = 0xFF00FF00;
+constexpr uint32_t kBlue = 0xFFFF0000;
+
+} // namespace
+
+/// @brief Records one render pass from two threads, each drawing into one half of the framebuffer,
+/// with and without VK_KHR_dynamic_rendering
+class ParallelRenderCommandEncoderTest : public ::testing::TestWithParam<bool> {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    auto config = util::device::vulkan::getContextConfig(true);
+    config.enableDynamicRendering = GetParam();
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_NE(device_, nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    colorTex_ = device_->createTexture(
+        TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                           kSize,
+                           kSize,
+                           TextureDesc::TextureUsageBits::Attachment |
+                               TextureDesc::TextureUsageBits::Sampled),
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    FramebufferDesc fbDesc;
+    fbDesc.colorAttachments[0].texture = colorTex_;
+    fb_ = device_->createFramebuffer(fbDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    pipelineDesc.shaderStages = ShaderStagesCreator::fromModuleStringInput(
+        *device_, kCodeVS, "main", "", kCodeFS, "main", "", &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    pipeline_ = device_->createRenderPipeline(pipelineDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+ protected:
+  std::unique_ptr<vulkan::Device> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<ITexture> colorTex_;
+  std::shared_ptr<IFramebuffer> fb_;
+  std::shared_ptr<IRenderPipelineState> pipeline_;
+};
+
+TEST_P(ParallelRenderCommandEncoderTest, DrawFromTwoThreads) {
+  const vulkan::VulkanContext& ctx = device_->getVulkanContext();
+  if (GetParam() && !ctx.useDynamicRendering()) {
+    GTEST_SKIP() << "VK_KHR_dynamic_rendering is not supported";
+  }
+
+  Result ret;
+  auto cmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  RenderPassDesc rpDesc;
+  rpDesc.colorAttachments.resize(1);
+  rpDesc.colorAttachments[0].loadAction = LoadAction::Clear;
+  rpDesc.colorAttachments[0].storeAction = StoreAction::Store;
+  rpDesc.colorAttachments[0].clearColor = {1.0f, 0.0f, 0.0f, 1.0f};
+
+  auto parallelEncoder =
+      static_cast<vulkan::CommandBuffer&>(*cmdBuffer)
+          .createParallelRenderCommandEncoder(rpDesc, fb_, {}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(parallelEncoder, nullptr);
+
+  // the left half is green, the right half is blue
+  const std::array<std::array<float, 4>, 2> colors = {{{0, 1, 0, 1}, {0, 0, 1, 1}}};
+
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i != colors.size(); i++) {
+    threads.emplace_back([&, i]() {
+      auto encoder = parallelEncoder->createRenderCommandEncoder();
+      encoder->pushDebugGroupLabel("ParallelRenderCommandEncoderTest");
+      encoder->bindScissorRect({.x = i * kSize / 2, .y = 0, .width = kSize / 2, .height = kSize});
+      encoder->bindRenderPipelineState(pipeline_);
+      encoder->bindPushConstants(colors[i].data(), sizeof(colors[i]));
+      encoder->draw(3);
+      encoder->popDebugGroupLabel();
+      encoder->endEncoding();
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  EXPECT_EQ(parallelEncoder->getNumEncoders(), 2u);
+  parallelEncoder->endEncoding();
+
+  cmdQueue_->submit(*cmdBuffer);
+  cmdBuffer->waitUntilCompleted();
+
+  // every thread got its own command pool, kept until its command buffers retire
+  EXPECT_GE(ctx.threadCommandPools_->getNumPools(), 2u);
+
+  std::array<uint32_t, kSize * kSize> pixels = {};
+  fb_->copyBytesColorAttachment(*cmdQueue_, 0, pixels.data(), colorTex_->getFullRange(0));
+  for (uint32_t y = 0; y != kSize; y++) {
+    for (uint32_t x = 0; x != kSize; x++) {
+      EXPECT_EQ(pixels[y * kSize + x], x < kSize / 2 ? kGreen : kBlue);
+      EXPECT_NE(pixels[y * kSize + x], kRed);
+    }
+  }
+
+  // the pools of the exited threads are destroyed by the next submit
+  auto nextCmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  cmdQueue_->submit(*nextCmdBuffer);
+  nextCmdBuffer->waitUntilCompleted();
+  EXPECT_EQ(ctx.threadCommandPools_->getNumPools(), 0u);
+}
+
+TEST_P(ParallelRenderCommandEncoderTest, NoEncoders) {
+  if (GetParam() && !device_->getVulkanContext().useDynamicRendering()) {
+    GTEST_SKIP() << "VK_KHR_dynamic_rendering is not supported";
+  }
+
+  Result ret;
+  auto cmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  RenderPassDesc rpDesc;
+  rpDesc.colorAttachments.resize(1);
+  rpDesc.colorAttachments[0].loadAction = LoadAction::Clear;
+  rpDesc.colorAttachments[0].storeAction = StoreAction::Store;
+  rpDesc.colorAttachments[0].clearColor = {1.0f, 0.0f, 0.0f, 1.0f};
+
+  // the render pass still clears the framebuffer
+  auto parallelEncoder =
+      static_cast<vulkan::CommandBuffer&>(*cmdBuffer)
+          .createParallelRenderCommandEncoder(rpDesc, fb_, {}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  EXPECT_EQ(parallelEncoder->getNumEncoders(), 0u);
+  parallelEncoder->endEncoding();
+
+  cmdQueue_->submit(*cmdBuffer);
+  cmdBuffer->waitUntilCompleted();
+
+  std::array<uint32_t, kSize * kSize> pixels = {};
+  fb_->copyBytesColorAttachment(*cmdQueue_, 0, pixels.data(), colorTex_->getFullRange(0));
+  for (const uint32_t pixel : pixels) {
+    EXPECT_EQ(pixel, kRed);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(RenderPassAndDynamicRendering,
+                         ParallelRenderCommandEncoderTest,
+                         ::testing::Values(false, true));
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../data/ShaderData.h"
+#include "../util/device/vulkan/TestDevice.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <igl/Buffer.h>
+#include <igl/CommandBuffer.h>
+#include <igl/ComputeCommandEncoder.h>
+#include <igl/ComputePipelineState.h>
+#include <igl/NameHandle.h>
+#include <igl/ShaderCreator.h>
+#include <igl/vulkan/ComputePipelineState.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+
+// the number of floats read and written by kVulkanSimpleComputeShader
+constexpr size_t kNumValues = 6;
+
+} // namespace
+
+/// @brief Tests for the VK_KHR_push_descriptor path of ResourcesBinder, which updates buffer
+/// bindings via vkCmdPushDescriptorSetWithTemplateKHR() instead of descriptor sets. Textures and
+/// storage images keep using descriptor sets.
+class PushDescriptorsTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+  }
+
+ protected:
+  static std::unique_ptr<vulkan::Device> createDevice(bool enablePushDescriptors) {
+    auto config = util::device::vulkan::getContextConfig(true);
+    config.enablePushDescriptors = enablePushDescriptors;
+    return util::device::vulkan::createTestDevice(config);
+  }
+
+  static std::shared_ptr<IComputePipelineState> createPipeline(vulkan::Device& device) {
+    Result ret;
+    const std::string computeSource(data::shader::kVulkanSimpleComputeShader);
+    auto computeModule =
+        ShaderModuleCreator::fromStringInput(device,
+                                             computeSource.c_str(),
+                                             {.stage = ShaderStage::Compute, .entryPoint = "main"},
+                                             "PushDescriptorsTest",
+                                             &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    auto stages = ShaderStagesCreator::fromComputeModule(device, computeModule, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    const ComputePipelineDesc desc{
+        .buffersMap =
+            {
+                {data::shader::kSimpleComputeInputIndex,
+                 IGL_NAMEHANDLE(data::shader::kSimpleComputeInput)},
+                {data::shader::kSimpleComputeOutputIndex,
+                 IGL_NAMEHANDLE(data::shader::kSimpleComputeOutput)},
+            },
+        .shaderStages = std::move(stages),
+        .debugName = "PushDescriptorsTest",
+    };
+    auto pipeline = device.createComputePipeline(desc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    return pipeline;
+  }
+
+  /// Records `numDispatches` dispatches, each one binding a different range of the input and
+  /// output buffers, and verifies the results. Returns the number of descriptor sets looked up.
+  static uint64_t runDispatches(vulkan::Device& device, uint32_t numDispatches) {
+    const vulkan::VulkanContext& ctx = device.getVulkanContext();
+
+    Result ret;
+    auto cmdQueue = device.createCommandQueue(CommandQueueDesc{}, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto pipeline = createPipeline(device);
+    if (!pipeline) {
+      return 0;
+    }
+
+    const size_t alignment = std::max<size_t>(
+        ctx.getVkPhysicalDeviceProperties().limits.minStorageBufferOffsetAlignment, 1);
+    const size_t rangeSize = kNumValues * sizeof(float);
+    const size_t stride = (rangeSize + alignment - 1) / alignment * alignment;
+    const size_t strideInFloats = stride / sizeof(float);
+
+    std::vector<float> inputData(strideInFloats * numDispatches);
+    for (size_t i = 0; i != inputData.size(); i++) {
+      inputData[i] = static_cast<float>(i % 1000);
+    }
+
+    const BufferDesc inputDesc{
+        .type = BufferDesc::BufferTypeBits::Storage,
+        .data = inputData.data(),
+        .length = inputData.size() * sizeof(float),
+        .storage = ResourceStorage::Shared,
+    };
+    auto inputBuffer = device.createBuffer(inputDesc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    const BufferDesc outputDesc{
+        .type = BufferDesc::BufferTypeBits::Storage,
+        .length = inputData.size() * sizeof(float),
+        .storage = ResourceStorage::Shared,
+    };
+    auto outputBuffer = device.createBuffer(outputDesc, &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    if (!inputBuffer || !outputBuffer) {
+      return 0;
+    }
+
+    auto cmdBuffer = cmdQueue->createCommandBuffer(CommandBufferDesc(), &ret);
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    const vulkan::VulkanDescriptorSetCacheStats statsBefore = ctx.getDescriptorSetCacheStats();
+
+    auto encoder = cmdBuffer->createComputeCommandEncoder();
+    encoder->bindComputePipelineState(pipeline);
+    for (uint32_t i = 0; i != numDispatches; i++) {
+      encoder->bindBuffer(
+          data::shader::kSimpleComputeInputIndex, inputBuffer.get(), i * stride, rangeSize);
+      encoder->bindBuffer(
+          data::shader::kSimpleComputeOutputIndex, outputBuffer.get(), i * stride, rangeSize);
+      encoder->dispatchThreadGroups(Dimensions(1, 1, 1), Dimensions(kNumValues, 1, 1), {});
+    }
+    encoder->endEncoding();
+
+    const vulkan::VulkanDescriptorSetCacheStats statsAfter = ctx.getDescriptorSetCacheStats();
+
+    cmdQueue->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+
+    const auto* data = static_cast<const float*>(
+        outputBuffer->map(BufferRange(inputData.size() * sizeof(float), 0), &ret));
+    EXPECT_TRUE(ret.isOk()) << ret.message.c_str();
+    if (data) {
+      uint32_t numMismatches = 0;
+      for (uint32_t i = 0; i != numDispatches; i++) {
+        for (size_t j = 0; j != kNumValues; j++) {
+          const size_t idx = i * strideInFloats + j;
+          numMismatches += data[idx] != inputData[idx] * 2.0f ? 1 : 0;
+        }
+      }
+      EXPECT_EQ(numMismatches, 0u);
+      outputBuffer->unmap();
+    }
+
+    return (statsAfter.numHits - statsBefore.numHits) +
+           (statsAfter.numMisses - statsBefore.numMisses);
+  }
+};
+
+TEST_F(PushDescriptorsTest, PipelineSelection) {
+  auto device = createDevice(true);
+  ASSERT_NE(device, nullptr);
+  const vulkan::VulkanFeatures& features = device->getVulkanContext().features();
+
+  auto pipeline = createPipeline(*device);
+  ASSERT_NE(pipeline, nullptr);
+  const auto& cps = static_cast<const vulkan::ComputePipelineState&>(*pipeline);
+  EXPECT_EQ(cps.usePushDescriptors,
+            features.has_VK_KHR_push_descriptor && !features.has_VK_EXT_descriptor_buffer);
+
+  auto deviceNoPush = createDevice(false);
+  ASSERT_NE(deviceNoPush, nullptr);
+  EXPECT_FALSE(deviceNoPush->getVulkanContext().features().has_VK_KHR_push_descriptor);
+
+  auto pipelineNoPush = createPipeline(*deviceNoPush);
+  ASSERT_NE(pipelineNoPush, nullptr);
+  const auto& cpsNoPush = static_cast<const vulkan::ComputePipelineState&>(*pipelineNoPush);
+  EXPECT_FALSE(cpsNoPush.usePushDescriptors);
+}
+
+TEST_F(PushDescriptorsTest, ComputeDispatchSkipsDescriptorSets) {
+  auto device = createDevice(true);
+  ASSERT_NE(device, nullptr);
+  if (!device->getVulkanContext().features().has_VK_KHR_push_descriptor) {
+    GTEST_SKIP() << "VK_KHR_push_descriptor is not supported";
+  }
+
+  constexpr uint32_t kNumDispatches = 16;
+
+  // no descriptor sets are looked up or written for buffers
+  EXPECT_EQ(runDispatches(*device, kNumDispatches), 0u);
+}
+
+// Every dispatch binds unique buffer ranges, so the descriptor set cache cannot help: the descriptor
+// set path writes one set per dispatch while the push descriptor path writes none, and both produce
+// the same results
+TEST_F(PushDescriptorsTest, DescriptorSetsPerDispatch) {
+  auto devicePush = createDevice(true);
+  ASSERT_NE(devicePush, nullptr);
+  if (!devicePush->getVulkanContext().features().has_VK_KHR_push_descriptor) {
+    GTEST_SKIP() << "VK_KHR_push_descriptor is not supported";
+  }
+  auto deviceSets = createDevice(false);
+  ASSERT_NE(deviceSets, nullptr);
+
+  constexpr uint32_t kNumDispatches = 64;
+
+  EXPECT_EQ(runDispatches(*devicePush, kNumDispatches), 0u);
+  EXPECT_EQ(runDispatches(*deviceSets, kNumDispatches), kNumDispatches);
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
@@ -11,10 +11,14 @@
 
 #include <igl/Common.h>
 #include <igl/ShaderCreator.h>
+#include <igl/ThreadPool.h>
 #include <igl/VertexInputState.h>
 #include <igl/tests/util/device/TestDevice.h>
 #include <igl/vulkan/Device.h>
+#include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanPipelineBuilder.h>
+#include <igl/vulkan/VulkanRenderPassBuilder.h>
 
 #ifdef __ANDROID__
 #endif
@@ -194,6 +198,130 @@ INSTANTIATE_TEST_SUITE_P(AllBlendFactors,
                                                               BlendFactor::OneMinusSrc1Color,
                                                               BlendFactor::Src1Alpha,
                                                               BlendFactor::OneMinusSrc1Alpha)));
+
+//
+// RenderPipelineStatePrecompileTest
+//
+// Unit tests for RenderPipelineState::precompile() and RenderPipelineState::isPipelineReady()
+//
+class RenderPipelineStatePrecompileTest : public ::testing::Test {
+  void SetUp() override {
+    // Turn off debug break so unit tests can run
+    igl::setDebugBreakEnabled(false);
+
+    device_ = igl::tests::util::device::createTestDevice(igl::BackendType::Vulkan);
+    ASSERT_TRUE(device_ != nullptr);
+
+    constexpr const char* codeVS = R"(
+      void main() {
+        gl_Position = vec4(0., 0., 0., 1.0);
+      }
+    )";
+    constexpr const char* codeFS = R"(
+      layout(location = 0) out vec4 out_FragColor;
+      void main() {
+        out_FragColor = vec4(0., 0., 0., 1.0);
+      }
+    )";
+
+    Result result;
+    RenderPipelineDesc pipelineDesc;
+    pipelineDesc.targetDesc.colorAttachments.resize(1);
+    pipelineDesc.targetDesc.colorAttachments[0].textureFormat = TextureFormat::RGBA_UNorm8;
+    pipelineDesc.shaderStages = ShaderStagesCreator::fromModuleStringInput(
+        *device_, codeVS, "main", "", codeFS, "main", "", &result);
+    ASSERT_TRUE(result.isOk()) << result.message.c_str();
+    pipeline_ = device_->createRenderPipeline(pipelineDesc, &result);
+    ASSERT_TRUE(result.isOk()) << result.message.c_str();
+    ASSERT_TRUE(pipeline_ != nullptr);
+  }
+
+ protected:
+  [[nodiscard]] vulkan::RenderPipelineDynamicState createDynamicState(VkAttachmentLoadOp loadOp) {
+    auto& ctx = static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+    vulkan::VulkanRenderPassBuilder builder;
+    builder.addColor(VK_FORMAT_R8G8B8A8_UNORM, loadOp, VK_ATTACHMENT_STORE_OP_STORE);
+    vulkan::RenderPipelineDynamicState state;
+    state.renderPassIndex = ctx.findRenderPass(builder).index;
+    return state;
+  }
+
+  [[nodiscard]] const vulkan::RenderPipelineState& rps() const {
+    return static_cast<const vulkan::RenderPipelineState&>(*pipeline_);
+  }
+
+  std::shared_ptr<IDevice> device_;
+  std::shared_ptr<IRenderPipelineState> pipeline_;
+};
+
+TEST_F(RenderPipelineStatePrecompileTest, NotReadyBeforeFirstUse) {
+  EXPECT_FALSE(rps().isPipelineReady(createDynamicState(VK_ATTACHMENT_LOAD_OP_CLEAR)));
+}
+
+TEST_F(RenderPipelineStatePrecompileTest, ReadyAfterGetVkPipeline) {
+  const auto state = createDynamicState(VK_ATTACHMENT_LOAD_OP_CLEAR);
+  const VkPipeline pipeline = rps().getVkPipeline(state);
+  EXPECT_NE(pipeline, VK_NULL_HANDLE);
+  EXPECT_TRUE(rps().isPipelineReady(state));
+}
+
+TEST_F(RenderPipelineStatePrecompileTest, PrecompileSharesCache) {
+  const auto state = createDynamicState(VK_ATTACHMENT_LOAD_OP_CLEAR);
+
+  EXPECT_EQ(rps().precompile({state}), 1u);
+  // the same state is either in flight or already compiled
+  EXPECT_EQ(rps().precompile({state}), 0u);
+
+  // waits for the background compilation instead of compiling again
+  const VkPipeline pipeline = rps().getVkPipeline(state);
+  EXPECT_NE(pipeline, VK_NULL_HANDLE);
+  EXPECT_TRUE(rps().isPipelineReady(state));
+  EXPECT_EQ(rps().getVkPipeline(state), pipeline);
+}
+
+TEST_F(RenderPipelineStatePrecompileTest, CompatibleRenderPassesShareOnePipeline) {
+  const auto stateClear = createDynamicState(VK_ATTACHMENT_LOAD_OP_CLEAR);
+  const auto stateLoad = createDynamicState(VK_ATTACHMENT_LOAD_OP_LOAD);
+
+  EXPECT_EQ(rps().precompile({stateClear, stateLoad}), 1u);
+
+  auto& ctx = static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+  ctx.getPipelineCompilationThreadPool().waitIdle();
+
+  EXPECT_TRUE(rps().isPipelineReady(stateLoad));
+  EXPECT_EQ(rps().getVkPipeline(stateClear), rps().getVkPipeline(stateLoad));
+}
+
+TEST_F(RenderPipelineStatePrecompileTest, GraphicsPipelineLibrary) {
+  auto& ctx = static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+  if (!ctx.useGraphicsPipelineLibrary()) {
+    GTEST_SKIP() << "VK_EXT_graphics_pipeline_library with fast linking is not supported";
+  }
+
+  const uint32_t numLibraries = vulkan::VulkanPipelineBuilder::getNumPipelineLibrariesCreated();
+
+  // a new state is fast-linked from 4 pipeline libraries
+  const auto state = createDynamicState(VK_ATTACHMENT_LOAD_OP_CLEAR);
+  const VkPipeline fastLinkedPipeline = rps().getVkPipeline(state);
+  EXPECT_NE(fastLinkedPipeline, VK_NULL_HANDLE);
+  EXPECT_EQ(vulkan::VulkanPipelineBuilder::getNumPipelineLibrariesCreated(), numLibraries + 4);
+  EXPECT_TRUE(rps().isPipelineReady(state));
+
+  // ... and replaced by the optimized pipeline once it has been linked in the background
+  ctx.getPipelineCompilationThreadPool().waitIdle();
+  const VkPipeline optimizedPipeline = rps().getVkPipeline(state);
+  EXPECT_NE(optimizedPipeline, VK_NULL_HANDLE);
+  EXPECT_NE(optimizedPipeline, fastLinkedPipeline);
+  EXPECT_EQ(rps().getVkPipeline(state), optimizedPipeline);
+  EXPECT_EQ(vulkan::VulkanPipelineBuilder::getNumPipelineLibrariesCreated(), numLibraries + 4);
+}
+
+TEST_F(RenderPipelineStatePrecompileTest, DestroyWhileCompiling) {
+  (void)rps().precompile({createDynamicState(VK_ATTACHMENT_LOAD_OP_CLEAR)});
+  // the destructor has to wait for the worker thread
+  pipeline_.reset();
+}
+
 } // namespace igl::tests
 
 #endif
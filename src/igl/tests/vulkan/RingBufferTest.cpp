@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+#include <igl/Buffer.h>
+#include <igl/CommandBuffer.h>
+#include <igl/vulkan/Buffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanStagingDevice.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+
+bool operator==(const BufferRange& a, const BufferRange& b) {
+  return a.offset == b.offset && a.size == b.size;
+}
+
+} // namespace
+
+TEST(BufferRangeSetTest, AddMergesOverlappingAndAdjacentRanges) {
+  vulkan::BufferRangeSet set;
+  EXPECT_TRUE(set.empty());
+
+  set.add(BufferRange(10, 100));
+  set.add(BufferRange(10, 0));
+  set.add(BufferRange(0, 50)); // empty ranges are ignored
+  ASSERT_EQ(set.ranges().size(), 2u);
+
+  set.add(BufferRange(10, 10)); // adjacent to [0, 10)
+  set.add(BufferRange(15, 95)); // overlaps [100, 110)
+  ASSERT_EQ(set.ranges().size(), 2u);
+  EXPECT_TRUE(set.ranges()[0] == BufferRange(20, 0));
+  EXPECT_TRUE(set.ranges()[1] == BufferRange(15, 95));
+  EXPECT_EQ(set.getSizeInBytes(), 35u);
+
+  set.add(BufferRange(200, 0)); // covers everything
+  ASSERT_EQ(set.ranges().size(), 1u);
+  EXPECT_TRUE(set.ranges()[0] == BufferRange(200, 0));
+
+  set.clear();
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(BufferRangeSetTest, SubtractSplitsAndTrimsRanges) {
+  vulkan::BufferRangeSet set;
+  set.add(BufferRange(100, 0));
+  set.add(BufferRange(100, 200));
+
+  set.subtract(BufferRange(10, 40)); // split
+  set.subtract(BufferRange(120, 90)); // trims [50, 100) and [200, 300)
+  ASSERT_EQ(set.ranges().size(), 3u);
+  EXPECT_TRUE(set.ranges()[0] == BufferRange(40, 0));
+  EXPECT_TRUE(set.ranges()[1] == BufferRange(40, 50));
+  EXPECT_TRUE(set.ranges()[2] == BufferRange(90, 210));
+
+  set.subtract(BufferRange(300, 0));
+  EXPECT_TRUE(set.empty());
+}
+
+TEST(BufferRangeSetTest, NumberOfRangesIsBounded) {
+  vulkan::BufferRangeSet set;
+  for (size_t i = 0; i != vulkan::BufferRangeSet::kMaxRanges; i++) {
+    set.add(BufferRange(1, i * 10));
+  }
+  EXPECT_EQ(set.ranges().size(), vulkan::BufferRangeSet::kMaxRanges);
+
+  // the gap to the last range is the smallest one
+  const size_t last = (vulkan::BufferRangeSet::kMaxRanges - 1) * 10;
+  set.add(BufferRange(1, last + 3));
+  ASSERT_EQ(set.ranges().size(), vulkan::BufferRangeSet::kMaxRanges);
+  EXPECT_TRUE(set.ranges().back() == BufferRange(4, last));
+}
+
+/// @brief Uploads a small, different window of a large ring buffer every frame and checks that
+/// every slot receives the latest data while only the missed windows are replayed
+class RingBufferTest : public ::testing::TestWithParam<ResourceStorage> {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    device_ = util::device::vulkan::createTestDevice(util::device::vulkan::getContextConfig(true));
+    ASSERT_NE(device_, nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+ protected:
+  std::vector<uint8_t> readCurrentSlot(const vulkan::Buffer& buffer) const {
+    const auto& vkBuffer = buffer.currentVulkanBuffer();
+    std::vector<uint8_t> data(buffer.getSizeInBytes());
+    if (vkBuffer->isMapped()) {
+      std::memcpy(data.data(), vkBuffer->getMappedPtr(), data.size());
+    } else {
+      device_->getVulkanContext().stagingDevice_->getBufferSubData(
+          *vkBuffer, 0, data.size(), data.data());
+    }
+    return data;
+  }
+
+  std::unique_ptr<vulkan::Device> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+};
+
+TEST_P(RingBufferTest, UploadsOnlyMissedRanges) {
+  constexpr size_t kSize = 64 * 1024;
+  constexpr size_t kWindowSize = 256;
+  constexpr uint32_t kNumFrames = 16;
+
+  Result ret;
+  auto buffer = device_->createBuffer(
+      BufferDesc{
+          .type = BufferDesc::BufferTypeBits::Storage,
+          .length = kSize,
+          .storage = GetParam(),
+          .hint = BufferDesc::BufferAPIHintBits::Ring,
+      },
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  auto& vkBuffer = static_cast<vulkan::Buffer&>(*buffer);
+
+  const vulkan::VulkanContext& ctx = device_->getVulkanContext();
+  const uint32_t numSlots = ctx.config_.maxResourceCount;
+  ASSERT_LT(numSlots, kNumFrames);
+
+  std::vector<uint8_t> expected(kSize, 0);
+  for (size_t i = 0; i != kSize; i++) {
+    expected[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  auto endFrame = [this]() {
+    Result ret;
+    auto cmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    cmdQueue_->submit(*cmdBuffer);
+  };
+
+  ASSERT_TRUE(buffer->upload(expected.data(), BufferRange(kSize, 0)).isOk());
+  endFrame();
+
+  vulkan::VulkanRingBufferUploadStats before;
+
+  for (uint32_t frame = 0; frame != kNumFrames; frame++) {
+    // every slot replays the initial upload once; after that, only windows are missed
+    if (frame == numSlots) {
+      before = ctx.getRingBufferUploadStats();
+    }
+    // windows far apart, so that a union of the ranges would span most of the buffer
+    const size_t offset = (frame % 2 ? kSize - kWindowSize * (frame + 1) : kWindowSize * frame);
+    for (size_t i = 0; i != kWindowSize; i++) {
+      expected[offset + i] = static_cast<uint8_t>(frame + i);
+    }
+    ASSERT_TRUE(buffer->upload(expected.data() + offset, BufferRange(kWindowSize, offset)).isOk());
+
+    EXPECT_EQ(readCurrentSlot(vkBuffer), expected) << "frame " << frame;
+    endFrame();
+  }
+
+  const vulkan::VulkanRingBufferUploadStats after = ctx.getRingBufferUploadStats();
+  const uint64_t numBytesRequested = after.numBytesRequested - before.numBytesRequested;
+  const uint64_t numBytesUploaded = after.numBytesUploaded - before.numBytesUploaded;
+  EXPECT_EQ(numBytesRequested, (kNumFrames - numSlots) * kWindowSize);
+  // every frame replays at most the windows uploaded to the other slots
+  EXPECT_GE(numBytesUploaded, numBytesRequested);
+  EXPECT_LE(numBytesUploaded, numBytesRequested * numSlots);
+}
+
+INSTANTIATE_TEST_SUITE_P(SharedAndPrivate,
+                         RingBufferTest,
+                         ::testing::Values(ResourceStorage::Shared, ResourceStorage::Private));
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+#include <igl/glslang/SpirvCache.h>
+
+namespace igl::tests {
+
+namespace {
+
+constexpr const char* kSource = "void main() {}";
+
+std::vector<uint32_t> makeSpirv(uint32_t payload) {
+  return {0x07230203, 0x00010000, payload};
+}
+
+} // namespace
+
+//
+// SpirvCacheTest
+//
+// Unit tests for igl::glslang::SpirvCache
+//
+class SpirvCacheTest : public ::testing::Test {
+ protected:
+  [[nodiscard]] glslang::SpirvCache::Key makeKey(uint32_t value) const {
+    const std::string source = "const int kValue = " + std::to_string(value) + ";";
+    return glslang::SpirvCache::computeKey(ShaderStage::Fragment, source.c_str(), {}, resource_);
+  }
+
+  glslang_resource_t resource_ = {};
+};
+
+TEST_F(SpirvCacheTest, KeyDependsOnAllInputs) {
+  using glslang::SpirvCache;
+
+  const ShaderCompilerOptions options;
+  const uint64_t key =
+      SpirvCache::computeKey(ShaderStage::Fragment, kSource, options, resource_).hash;
+
+  EXPECT_EQ(key, SpirvCache::computeKey(ShaderStage::Fragment, kSource, options, resource_).hash);
+  EXPECT_NE(key, SpirvCache::computeKey(ShaderStage::Vertex, kSource, options, resource_).hash);
+  EXPECT_NE(
+      key,
+      SpirvCache::computeKey(ShaderStage::Fragment, "void main() { }", options, resource_).hash);
+
+  ShaderCompilerOptions otherOptions;
+  otherOptions.fastMathEnabled = !options.fastMathEnabled;
+  EXPECT_NE(key,
+            SpirvCache::computeKey(ShaderStage::Fragment, kSource, otherOptions, resource_).hash);
+
+  glslang_resource_t otherResource = resource_;
+  otherResource.max_lights++;
+  EXPECT_NE(key,
+            SpirvCache::computeKey(ShaderStage::Fragment, kSource, options, otherResource).hash);
+}
+
+TEST_F(SpirvCacheTest, HitsAndMisses) {
+  glslang::SpirvCache cache(4);
+
+  std::vector<uint32_t> spirv;
+  EXPECT_FALSE(cache.find(makeKey(1), spirv));
+
+  cache.insert(makeKey(1), makeSpirv(1));
+  ASSERT_TRUE(cache.find(makeKey(1), spirv));
+  EXPECT_EQ(spirv, makeSpirv(1));
+
+  const auto stats = cache.getStats();
+  EXPECT_EQ(stats.numHits, 1u);
+  EXPECT_EQ(stats.numDiskHits, 0u);
+  EXPECT_EQ(stats.numMisses, 1u);
+}
+
+TEST_F(SpirvCacheTest, EvictsLeastRecentlyUsed) {
+  glslang::SpirvCache cache(2);
+
+  cache.insert(makeKey(1), makeSpirv(1));
+  cache.insert(makeKey(2), makeSpirv(2));
+
+  // touch 1 so that 2 becomes the least recently used entry
+  std::vector<uint32_t> spirv;
+  EXPECT_TRUE(cache.find(makeKey(1), spirv));
+
+  cache.insert(makeKey(3), makeSpirv(3));
+
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_TRUE(cache.find(makeKey(1), spirv));
+  EXPECT_FALSE(cache.find(makeKey(2), spirv));
+  EXPECT_TRUE(cache.find(makeKey(3), spirv));
+}
+
+TEST_F(SpirvCacheTest, DiskTier) {
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "igl_spirv_cache_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  {
+    glslang::SpirvCache cache(4, dir.string().c_str());
+    cache.insert(makeKey(42), makeSpirv(42));
+  }
+
+  glslang::SpirvCache cache(4, dir.string().c_str());
+  std::vector<uint32_t> spirv;
+  ASSERT_TRUE(cache.find(makeKey(42), spirv));
+  EXPECT_EQ(spirv, makeSpirv(42));
+  EXPECT_EQ(cache.getStats().numDiskHits, 1u);
+
+  // promoted to the memory tier
+  EXPECT_TRUE(cache.find(makeKey(42), spirv));
+  EXPECT_EQ(cache.getStats().numHits, 1u);
+
+  std::filesystem::remove_all(dir);
+}
+
+TEST_F(SpirvCacheTest, HashCollisionIsAMiss) {
+  const std::filesystem::path dir =
+      std::filesystem::temp_directory_path() / "igl_spirv_cache_collision_test";
+  std::filesystem::remove_all(dir);
+  std::filesystem::create_directories(dir);
+
+  const glslang::SpirvCache::Key key = makeKey(1);
+  // same hash, different key material
+  glslang::SpirvCache::Key collidingKey = makeKey(2);
+  collidingKey.hash = key.hash;
+
+  {
+    glslang::SpirvCache cache(4, dir.string().c_str());
+    cache.insert(key, makeSpirv(1));
+
+    std::vector<uint32_t> spirv;
+    EXPECT_FALSE(cache.find(collidingKey, spirv));
+  }
+
+  // disk tier only
+  glslang::SpirvCache cache(0, dir.string().c_str());
+  std::vector<uint32_t> spirv;
+  EXPECT_FALSE(cache.find(collidingKey, spirv));
+  ASSERT_TRUE(cache.find(key, spirv));
+  EXPECT_EQ(spirv, makeSpirv(1));
+  EXPECT_EQ(cache.getStats().numDiskHits, 1u);
+
+  std::filesystem::remove_all(dir);
+}
+
+} // namespace igl::tests
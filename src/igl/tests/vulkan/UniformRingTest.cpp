@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "../util/device/vulkan/TestDevice.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <igl/Buffer.h>
+#include <igl/CommandBuffer.h>
+#include <igl/ComputeCommandEncoder.h>
+#include <igl/ComputePipelineState.h>
+#include <igl/NameHandle.h>
+#include <igl/ShaderCreator.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/VulkanContext.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
+
+namespace igl::tests {
+
+namespace {
+
+constexpr uint32_t kNumValues = 6;
+
+// every dispatch writes kNumValues values starting at `base`, using the constants from bindBytes()
+constexpr std::string_view kComputeShader = IGL_TO_STRING(
+    layout(local_size_x = 6, local_size_y = 1, local_size_z = 1) in;
+    layout(std140, binding = 0, set = 1) uniform Params {
+      float scale;
+      uint base;
+    };
+    layout(std430, binding = 1, set = 1) writeonly buffer floatsOut {
+      float fOut[];
+    };
+
+    void main() {
+      uint id = gl_LocalInvocationIndex;
+
+      fOut[base + id] = scale * float(id);
+    });
+
+struct Params {
+  float scale = 0;
+  uint32_t base = 0;
+};
+
+} // namespace
+
+/// @brief Tests for VulkanUniformRing, which backs RenderCommandEncoder::bindBytes() and
+/// ComputeCommandEncoder::bindBytes()
+class UniformRingTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+  }
+
+ protected:
+  void createDevice(uint32_t uniformRingSize = 256u * 1024u) {
+    auto config = util::device::vulkan::getContextConfig(true);
+    config.uniformRingSize = uniformRingSize;
+    device_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_NE(device_, nullptr);
+
+    Result ret;
+    cmdQueue_ = device_->createCommandQueue(CommandQueueDesc{}, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto computeModule = ShaderModuleCreator::fromStringInput(
+        *device_,
+        std::string(kComputeShader).c_str(),
+        {.stage = ShaderStage::Compute, .entryPoint = "main"},
+        "UniformRingTest",
+        &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    auto stages = ShaderStagesCreator::fromComputeModule(*device_, computeModule, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    const ComputePipelineDesc desc{
+        .buffersMap =
+            {
+                {0, IGL_NAMEHANDLE("Params")},
+                {1, IGL_NAMEHANDLE("floatsOut")},
+            },
+        .shaderStages = std::move(stages),
+        .debugName = "UniformRingTest",
+    };
+    pipeline_ = device_->createComputePipeline(desc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  /// Records `numDispatches` dispatches with different constants passed via bindBytes(), submits
+  /// them and verifies the results
+  void runDispatches(uint32_t numDispatches) {
+    Result ret;
+    const BufferDesc outputDesc{
+        .type = BufferDesc::BufferTypeBits::Storage,
+        .length = numDispatches * kNumValues * sizeof(float),
+        .storage = ResourceStorage::Shared,
+    };
+    auto outputBuffer = device_->createBuffer(outputDesc, &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto cmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+    auto encoder = cmdBuffer->createComputeCommandEncoder();
+    encoder->bindComputePipelineState(pipeline_);
+    encoder->bindBuffer(1, outputBuffer.get(), 0, 0);
+    for (uint32_t i = 0; i != numDispatches; i++) {
+      const Params params = {
+          .scale = static_cast<float>(i + 1),
+          .base = i * kNumValues,
+      };
+      encoder->bindBytes(0, &params, sizeof(params));
+      encoder->dispatchThreadGroups(Dimensions(1, 1, 1), Dimensions(kNumValues, 1, 1), {});
+    }
+    encoder->endEncoding();
+
+    cmdQueue_->submit(*cmdBuffer);
+    cmdBuffer->waitUntilCompleted();
+
+    const auto* data =
+        static_cast<const float*>(outputBuffer->map(BufferRange(outputDesc.length, 0), &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    ASSERT_NE(data, nullptr);
+    uint32_t numMismatches = 0;
+    for (uint32_t i = 0; i != numDispatches; i++) {
+      for (uint32_t j = 0; j != kNumValues; j++) {
+        numMismatches += data[i * kNumValues + j] != static_cast<float>((i + 1) * j) ? 1 : 0;
+      }
+    }
+    EXPECT_EQ(numMismatches, 0u);
+    outputBuffer->unmap();
+  }
+
+  /// Submits empty command buffers until the current sync index wraps around
+  void cycleFrames() {
+    const vulkan::VulkanContext& ctx = device_->getVulkanContext();
+    for (uint32_t i = 0; i != ctx.config_.maxResourceCount; i++) {
+      Result ret;
+      auto cmdBuffer = cmdQueue_->createCommandBuffer(CommandBufferDesc(), &ret);
+      ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+      cmdQueue_->submit(*cmdBuffer);
+      cmdBuffer->waitUntilCompleted();
+    }
+  }
+
+  [[nodiscard]] vulkan::VulkanUniformRingStats getStats() const {
+    return device_->getVulkanContext().uniformRing_->getStats();
+  }
+
+  std::unique_ptr<vulkan::Device> device_;
+  std::shared_ptr<ICommandQueue> cmdQueue_;
+  std::shared_ptr<IComputePipelineState> pipeline_;
+};
+
+TEST_F(UniformRingTest, BindBytesCompute) {
+  createDevice();
+  ASSERT_NE(pipeline_, nullptr);
+
+  // nothing is allocated until bindBytes() is used
+  EXPECT_EQ(getStats().capacity, 0u);
+
+  constexpr uint32_t kNumDispatches = 16;
+  ASSERT_NO_FATAL_FAILURE(runDispatches(kNumDispatches));
+
+  const vulkan::VulkanUniformRingStats stats = getStats();
+  EXPECT_EQ(stats.numAllocations, kNumDispatches);
+  EXPECT_GE(stats.highWaterMark, kNumDispatches * sizeof(Params));
+  EXPECT_EQ(stats.capacity, 256u * 1024u);
+}
+
+TEST_F(UniformRingTest, RecyclesCompletedFrames) {
+  createDevice();
+  ASSERT_NE(pipeline_, nullptr);
+
+  const uint32_t syncIndex = device_->getVulkanContext().currentSyncIndex();
+
+  ASSERT_NO_FATAL_FAILURE(runDispatches(4));
+  const vulkan::VulkanUniformRingStats statsBefore = getStats();
+
+  // the frame which recorded the dispatches comes around again and its memory is reused
+  ASSERT_NO_FATAL_FAILURE(cycleFrames());
+  const vulkan::VulkanContext& ctx = device_->getVulkanContext();
+  ASSERT_EQ(ctx.currentSyncIndex(), (syncIndex + 1) % ctx.config_.maxResourceCount);
+
+  const vulkan::VulkanUniformRingStats stats = getStats();
+  EXPECT_EQ(stats.numBytesUsed, 0u);
+  EXPECT_EQ(stats.highWaterMark, statsBefore.highWaterMark);
+  EXPECT_EQ(stats.capacity, statsBefore.capacity);
+
+  ASSERT_NO_FATAL_FAILURE(runDispatches(4));
+  EXPECT_EQ(getStats().capacity, statsBefore.capacity);
+}
+
+TEST_F(UniformRingTest, GrowsWhenFrameIsFull) {
+  // a tiny ring fits only a few allocations
+  createDevice(256);
+  ASSERT_NE(pipeline_, nullptr);
+
+  constexpr uint32_t kNumDispatches = 64;
+  ASSERT_NO_FATAL_FAILURE(runDispatches(kNumDispatches));
+
+  const vulkan::VulkanUniformRingStats stats = getStats();
+  EXPECT_EQ(stats.numAllocations, kNumDispatches);
+  EXPECT_GT(stats.capacity, 256u);
+  EXPECT_GE(stats.capacity, stats.highWaterMark);
+
+  // only the largest buffer is kept once the frame is recycled
+  ASSERT_NO_FATAL_FAILURE(cycleFrames());
+  EXPECT_LT(getStats().capacity, stats.capacity);
+
+  ASSERT_NO_FATAL_FAILURE(runDispatches(kNumDispatches));
+}
+
+} // namespace igl::tests
+
+#endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <igl/vulkan/VulkanBarrierBatch.h>
+
+#include <memory>
+#include <igl/tests/util/device/TestDevice.h>
+#include <igl/vulkan/CommandBuffer.h>
+#include <igl/vulkan/Device.h>
+#include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanImage.h>
+#include <igl/vulkan/VulkanTexture.h>
+
+#if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_LINUX
+namespace igl::tests {
+
+/// @brief Tests per-subresource layout tracking in VulkanImage and VulkanBarrierBatch
+class VulkanBarrierBatchTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    device_ = igl::tests::util::device::createTestDevice(igl::BackendType::Vulkan);
+    ASSERT_TRUE(device_ != nullptr);
+    context_ = &static_cast<igl::vulkan::Device&>(*device_).getVulkanContext();
+
+    Result result;
+    auto commandQueue = device_->createCommandQueue(CommandQueueDesc{}, &result);
+    ASSERT_TRUE(result.isOk());
+    cmdBuffer_ = commandQueue->createCommandBuffer(CommandBufferDesc{}, &result);
+    ASSERT_TRUE(result.isOk());
+  }
+
+ protected:
+  [[nodiscard]] VkCommandBuffer getVkCommandBuffer() const {
+    return static_cast<const vulkan::CommandBuffer&>(*cmdBuffer_).getVkCommandBuffer();
+  }
+
+  [[nodiscard]] std::shared_ptr<ITexture> createTexture(uint32_t numMipLevels,
+                                                        uint32_t numLayers) const {
+    TextureDesc desc = TextureDesc::new2DArray(TextureFormat::RGBA_UNorm8,
+                                               4,
+                                               4,
+                                               numLayers,
+                                               TextureDesc::TextureUsageBits::Sampled |
+                                                   TextureDesc::TextureUsageBits::Attachment);
+    desc.numMipLevels = numMipLevels;
+    Result result;
+    auto texture = device_->createTexture(desc, &result);
+    EXPECT_TRUE(result.isOk());
+    return texture;
+  }
+
+  static const vulkan::VulkanImage& getImage(const std::shared_ptr<ITexture>& texture) {
+    return static_cast<const vulkan::Texture&>(*texture).getVulkanTexture().image;
+  }
+
+  std::shared_ptr<IDevice> device_;
+  vulkan::VulkanContext* context_ = nullptr;
+  std::shared_ptr<ICommandBuffer> cmdBuffer_;
+};
+
+TEST_F(VulkanBarrierBatchTest, SubresourceLayouts) {
+  const auto texture = createTexture(3, 2);
+  ASSERT_NE(texture, nullptr);
+  const vulkan::VulkanImage& img = getImage(texture);
+  const VkImageLayout initialLayout = img.imageLayout_;
+
+  // transition a single mip level of a single layer
+  img.transitionLayout(getVkCommandBuffer(),
+                       VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                       VkImageSubresourceRange{
+                           .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                           .baseMipLevel = 1,
+                           .levelCount = 1,
+                           .baseArrayLayer = 1,
+                           .layerCount = 1,
+                       });
+
+  EXPECT_EQ(img.getLayout(1, 1), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+  EXPECT_EQ(img.getLayout(0, 0), initialLayout);
+  EXPECT_EQ(img.getLayout(0, 1), initialLayout);
+  EXPECT_EQ(img.getLayout(1, 0), initialLayout);
+  EXPECT_EQ(img.getLayout(2, 1), initialLayout);
+
+  const uint32_t numBarriers = vulkan::VulkanBarrierBatch::getNumBarriers();
+  const uint32_t numPipelineBarriers = vulkan::VulkanBarrierBatch::getNumPipelineBarriers();
+
+  // the whole image needs one barrier per run of layers with the same layout: 1 + 2 + 1
+  img.transitionLayout(getVkCommandBuffer(),
+                       VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                       VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                       VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                       VkImageSubresourceRange{
+                           .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+                           .baseMipLevel = 0,
+                           .levelCount = VK_REMAINING_MIP_LEVELS,
+                           .baseArrayLayer = 0,
+                           .layerCount = VK_REMAINING_ARRAY_LAYERS,
+                       });
+
+  EXPECT_EQ(vulkan::VulkanBarrierBatch::getNumBarriers() - numBarriers, 4u);
+  EXPECT_EQ(vulkan::VulkanBarrierBatch::getNumPipelineBarriers() - numPipelineBarriers, 1u);
+
+  for (uint32_t mipLevel = 0; mipLevel != 3; mipLevel++) {
+    for (uint32_t layer = 0; layer != 2; layer++) {
+      EXPECT_EQ(img.getLayout(mipLevel, layer), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
+  }
+  EXPECT_EQ(img.imageLayout_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+TEST_F(VulkanBarrierBatchTest, MergesBarriers) {
+  const auto texture0 = createTexture(1, 1);
+  const auto texture1 = createTexture(1, 1);
+  ASSERT_NE(texture0, nullptr);
+  ASSERT_NE(texture1, nullptr);
+
+  const uint32_t numBarriers = vulkan::VulkanBarrierBatch::getNumBarriers();
+  const uint32_t numPipelineBarriers = vulkan::VulkanBarrierBatch::getNumPipelineBarriers();
+  const uint32_t numBarriersMerged = vulkan::VulkanBarrierBatch::getNumBarriersMerged();
+
+  vulkan::VulkanBarrierBatch batch(*context_, getVkCommandBuffer());
+  vulkan::transitionToShaderReadOnly(batch, texture0.get());
+  vulkan::transitionToShaderReadOnly(batch, texture1.get());
+  EXPECT_FALSE(batch.empty());
+  batch.flush();
+  EXPECT_TRUE(batch.empty());
+
+  EXPECT_EQ(vulkan::VulkanBarrierBatch::getNumBarriers() - numBarriers, 2u);
+  EXPECT_EQ(vulkan::VulkanBarrierBatch::getNumPipelineBarriers() - numPipelineBarriers, 1u);
+  EXPECT_EQ(vulkan::VulkanBarrierBatch::getNumBarriersMerged() - numBarriersMerged, 1u);
+
+  EXPECT_EQ(getImage(texture0).imageLayout_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  EXPECT_EQ(getImage(texture1).imageLayout_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+TEST_F(VulkanBarrierBatchTest, FlushesOverlappingBarriers) {
+  const auto texture = createTexture(1, 1);
+  ASSERT_NE(texture, nullptr);
+
+  const uint32_t numPipelineBarriers = vulkan::VulkanBarrierBatch::getNumPipelineBarriers();
+
+  // barriers in one command are not ordered: the second transition of the same subresource has to
+  // go into a separate command
+  vulkan::VulkanBarrierBatch batch(*context_, getVkCommandBuffer());
+  vulkan::transitionToColorAttachment(batch, texture.get(), vulkan::kAllSubresources);
+  vulkan::transitionToShaderReadOnly(batch, texture.get());
+  batch.flush();
+
+  EXPECT_EQ(vulkan::VulkanBarrierBatch::getNumPipelineBarriers() - numPipelineBarriers, 2u);
+  EXPECT_EQ(getImage(texture).imageLayout_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+}
+
+} // namespace igl::tests
+
+#endif
@@ -109,6 +109,7 @@ TEST_F(VulkanFeaturesTest, ExtensionBoolsDefaultToFalse) {
   EXPECT_FALSE(features.has_VK_KHR_buffer_device_address);
   EXPECT_FALSE(features.has_VK_KHR_get_surface_capabilities2);
   EXPECT_FALSE(features.has_VK_KHR_portability_enumeration);
+  EXPECT_FALSE(features.has_VK_KHR_push_descriptor);
   EXPECT_FALSE(features.has_VK_KHR_shader_non_semantic_info);
   EXPECT_FALSE(features.has_VK_KHR_synchronization2);
   EXPECT_FALSE(features.has_VK_KHR_timeline_semaphore);
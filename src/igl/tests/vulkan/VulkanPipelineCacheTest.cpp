@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <igl/vulkan/VulkanPipelineCache.h>
+
+namespace igl::tests {
+
+//
+// VulkanPipelineCacheTest
+//
+// Unit tests for the file format used by VulkanPipelineCache
+//
+class VulkanPipelineCacheTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    props_.vendorID = 0x10DE;
+    props_.deviceID = 0x1234;
+    props_.driverVersion = 42;
+    for (uint8_t i = 0; i != VK_UUID_SIZE; i++) {
+      props_.pipelineCacheUUID[i] = i;
+    }
+    for (uint32_t i = 0; i != 256; i++) {
+      data_.push_back(static_cast<uint8_t>(i * 7));
+    }
+  }
+
+ protected:
+  VkPhysicalDeviceProperties props_ = {};
+  std::vector<uint8_t> data_;
+};
+
+TEST_F(VulkanPipelineCacheTest, RoundTrip) {
+  const std::vector<uint8_t> blob =
+      vulkan::VulkanPipelineCache::serialize(props_, data_.data(), data_.size());
+  ASSERT_EQ(blob.size(), sizeof(vulkan::VulkanPipelineCacheFileHeader) + data_.size());
+
+  size_t size = 0;
+  const uint8_t* data = vulkan::VulkanPipelineCache::deserialize(props_, blob, size);
+  ASSERT_NE(data, nullptr);
+  ASSERT_EQ(size, data_.size());
+  EXPECT_EQ(memcmp(data, data_.data(), size), 0);
+}
+
+TEST_F(VulkanPipelineCacheTest, RejectsDifferentDevice) {
+  const std::vector<uint8_t> blob =
+      vulkan::VulkanPipelineCache::serialize(props_, data_.data(), data_.size());
+
+  size_t size = 0;
+
+  VkPhysicalDeviceProperties props = props_;
+  props.vendorID++;
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props, blob, size), nullptr);
+
+  props = props_;
+  props.deviceID++;
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props, blob, size), nullptr);
+
+  props = props_;
+  props.driverVersion++;
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props, blob, size), nullptr);
+
+  props = props_;
+  props.pipelineCacheUUID[VK_UUID_SIZE - 1]++;
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props, blob, size), nullptr);
+  EXPECT_EQ(size, 0u);
+}
+
+TEST_F(VulkanPipelineCacheTest, RejectsDifferentIGLVersion) {
+  std::vector<uint8_t> blob =
+      vulkan::VulkanPipelineCache::serialize(props_, data_.data(), data_.size());
+
+  vulkan::VulkanPipelineCacheFileHeader header;
+  memcpy(&header, blob.data(), sizeof(header));
+  header.iglCacheVersion++;
+  memcpy(blob.data(), &header, sizeof(header));
+
+  size_t size = 0;
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props_, blob, size), nullptr);
+}
+
+TEST_F(VulkanPipelineCacheTest, RejectsCorruptedData) {
+  std::vector<uint8_t> blob =
+      vulkan::VulkanPipelineCache::serialize(props_, data_.data(), data_.size());
+  blob.back() ^= 0xFF;
+
+  size_t size = 0;
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props_, blob, size), nullptr);
+}
+
+TEST_F(VulkanPipelineCacheTest, RejectsTruncatedData) {
+  std::vector<uint8_t> blob =
+      vulkan::VulkanPipelineCache::serialize(props_, data_.data(), data_.size());
+
+  size_t size = 0;
+
+  blob.resize(blob.size() - 1);
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props_, blob, size), nullptr);
+
+  blob.resize(sizeof(vulkan::VulkanPipelineCacheFileHeader) - 1);
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props_, blob, size), nullptr);
+
+  blob.clear();
+  EXPECT_EQ(vulkan::VulkanPipelineCache::deserialize(props_, blob, size), nullptr);
+}
+
+} // namespace igl::tests
@@ -310,4 +310,43 @@ TEST(VulkanQueuePoolTest, ReturnMultipleQueueCreationInfosForDifferentQueueFamil
   EXPECT_EQ(qcis[1].queueCount, 1);
 }
 
+TEST(VulkanQueuePoolTest, FindDedicatedTransferQueue) {
+  // Given an all in one queue, an async compute queue and a transfer-only queue
+  const VulkanQueueDescriptor allInOneQueueDescriptor{
+      .queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
+      .queueIndex = 0,
+      .familyIndex = 0};
+  const VulkanQueueDescriptor computeQueueDescriptor{
+      .queueFlags = VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
+      .queueIndex = 0,
+      .familyIndex = 1};
+  const VulkanQueueDescriptor transferQueueDescriptor{
+      .queueFlags = VK_QUEUE_TRANSFER_BIT, .queueIndex = 0, .familyIndex = 2};
+  const VulkanQueuePool queuePool(
+      {allInOneQueueDescriptor, computeQueueDescriptor, transferQueueDescriptor});
+
+  // When a transfer queue without graphics and compute capabilities is requested
+  auto queueDescriptor = queuePool.findDedicatedQueueDescriptor(
+      VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+
+  // Then return the transfer-only queue
+  ASSERT_TRUE(queueDescriptor.isValid());
+  EXPECT_EQ(queueDescriptor, transferQueueDescriptor);
+}
+
+TEST(VulkanQueuePoolTest, FindDedicatedQueueReturnsInvalidWhenNoMatch) {
+  // Given an all in one queue
+  const VulkanQueueDescriptor allInOneQueueDescriptor{
+      .queueFlags = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT,
+      .queueIndex = 0,
+      .familyIndex = 0};
+  const VulkanQueuePool queuePool({allInOneQueueDescriptor});
+
+  // When a transfer-only queue is requested, then nothing is returned
+  EXPECT_FALSE(queuePool
+                   .findDedicatedQueueDescriptor(VK_QUEUE_TRANSFER_BIT,
+                                                 VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)
+                   .isValid());
+}
+
 } // namespace igl::tests
@@ -10,6 +10,7 @@
 #include <igl/vulkan/VulkanStagingDevice.h>
 
 #include "../util/TestDevice.h"
+#include "../util/device/vulkan/TestDevice.h"
 
 #include <array>
 #include <cstring>
@@ -347,6 +348,230 @@ TEST_F(VulkanStagingDeviceTest, BufferSubDataZeroOffset) {
   buffer->unmap();
 }
 
+TEST_F(VulkanStagingDeviceTest, BatchedUploadsSubmitOnce) {
+  auto& ctx = getVulkanContext();
+  auto& stagingDevice = *ctx.stagingDevice_;
+
+  Result ret;
+  constexpr uint32_t kNumBuffers = 8;
+  constexpr size_t kSize = 128 * 1024; // larger than vkCmdUpdateBuffer() limit to use staging
+
+  std::vector<std::shared_ptr<IBuffer>> buffers;
+  for (uint32_t i = 0; i != kNumBuffers; i++) {
+    buffers.push_back(iglDev_->createBuffer(
+        BufferDesc{
+            .type = BufferDesc::BufferTypeBits::Storage,
+            .length = kSize,
+            .storage = ResourceStorage::Private,
+        },
+        &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+
+  const auto lastHandle = stagingDevice.immediate->getLastSubmitHandle();
+
+  stagingDevice.beginBatch();
+  EXPECT_TRUE(stagingDevice.isBatching());
+  for (uint32_t i = 0; i != kNumBuffers; i++) {
+    const std::vector<uint8_t> srcData(kSize, static_cast<uint8_t>(i + 1));
+    ret = buffers[i]->upload(srcData.data(), BufferRange(kSize, 0));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  }
+  // nothing is submitted until the batch ends
+  EXPECT_EQ(stagingDevice.immediate->getLastSubmitHandle(), lastHandle);
+  const auto handle = stagingDevice.endBatch();
+  EXPECT_FALSE(stagingDevice.isBatching());
+  EXPECT_FALSE(handle.empty());
+  EXPECT_NE(stagingDevice.immediate->getLastSubmitHandle(), lastHandle);
+
+  stagingDevice.immediate->wait(handle);
+
+  for (uint32_t i = 0; i != kNumBuffers; i++) {
+    const auto* downloaded = static_cast<uint8_t*>(buffers[i]->map(BufferRange(kSize, 0), &ret));
+    ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+    EXPECT_EQ(downloaded[0], i + 1);
+    EXPECT_EQ(downloaded[kSize - 1], i + 1);
+    buffers[i]->unmap();
+  }
+}
+
+TEST_F(VulkanStagingDeviceTest, OverlappingBatchedUploadsLandInOrder) {
+  Result ret;
+  constexpr size_t kSize = 128 * 1024; // larger than vkCmdUpdateBuffer() limit to use staging
+
+  auto buffer = iglDev_->createBuffer(
+      BufferDesc{
+          .type = BufferDesc::BufferTypeBits::Storage,
+          .length = kSize,
+          .storage = ResourceStorage::Private,
+      },
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto& stagingDevice = *getVulkanContext().stagingDevice_;
+
+  stagingDevice.beginBatch();
+  const std::vector<uint8_t> fullData(kSize, 0x11);
+  ret = buffer->upload(fullData.data(), BufferRange(kSize, 0));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  // overlaps the first upload and has to be ordered after it
+  const std::vector<uint8_t> halfData(kSize / 2, 0x22);
+  ret = buffer->upload(halfData.data(), BufferRange(kSize / 2, kSize / 4));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  stagingDevice.immediate->wait(stagingDevice.endBatch());
+
+  const auto* downloaded = static_cast<uint8_t*>(buffer->map(BufferRange(kSize, 0), &ret));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  EXPECT_EQ(downloaded[0], 0x11);
+  EXPECT_EQ(downloaded[kSize / 4 - 1], 0x11);
+  EXPECT_EQ(downloaded[kSize / 4], 0x22);
+  EXPECT_EQ(downloaded[kSize * 3 / 4 - 1], 0x22);
+  EXPECT_EQ(downloaded[kSize * 3 / 4], 0x11);
+  EXPECT_EQ(downloaded[kSize - 1], 0x11);
+  buffer->unmap();
+}
+
+TEST_F(VulkanStagingDeviceTest, ReadbackFlushesBatch) {
+  Result ret;
+
+  auto buffer = iglDev_->createBuffer(
+      BufferDesc{
+          .type = BufferDesc::BufferTypeBits::Storage,
+          .length = 256,
+          .storage = ResourceStorage::Private,
+      },
+      &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  auto& stagingDevice = *getVulkanContext().stagingDevice_;
+
+  stagingDevice.beginBatch();
+  const std::vector<uint8_t> srcData(256, 0x5A);
+  ret = buffer->upload(srcData.data(), BufferRange(256, 0));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  // reading back inside the batch must see the upload
+  const auto* downloaded = static_cast<uint8_t*>(buffer->map(BufferRange(256, 0), &ret));
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  EXPECT_EQ(downloaded[0], 0x5A);
+  EXPECT_EQ(downloaded[255], 0x5A);
+  buffer->unmap();
+
+  stagingDevice.endBatch();
+}
+
+TEST_F(VulkanStagingDeviceTest, AutoGenerateMipmapInsideBatch) {
+  Result ret;
+
+  TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                           2,
+                                           2,
+                                           TextureDesc::TextureUsageBits::Sampled |
+                                               TextureDesc::TextureUsageBits::Attachment);
+  texDesc.numMipLevels = 2;
+  texDesc.mipmapGeneration = TextureDesc::TextureMipmapGeneration::AutoGenerateOnUpload;
+  auto texture = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(texture, nullptr);
+
+  constexpr uint32_t kColor = 0xFF336699;
+  const std::array<uint32_t, 4> srcData = {kColor, kColor, kColor, kColor};
+
+  // the mip chain has to be generated from the uploaded mip 0, not from the image before the batch
+  auto& stagingDevice = *getVulkanContext().stagingDevice_;
+  stagingDevice.beginBatch();
+  ret = texture->upload(texture->getFullRange(0), srcData.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  stagingDevice.endBatch();
+
+  auto cmdQueue = iglDev_->createCommandQueue(CommandQueueDesc{}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  FramebufferDesc fbDesc;
+  fbDesc.colorAttachments[0].texture = texture;
+  auto fb = iglDev_->createFramebuffer(fbDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  uint32_t mip1 = 0;
+  fb->copyBytesColorAttachment(*cmdQueue, 0, &mip1, texture->getFullRange(1));
+  EXPECT_EQ(mip1, kColor);
+}
+
+class VulkanStagingDeviceTransferQueueTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    igl::setDebugBreakEnabled(false);
+
+    auto config = util::device::vulkan::getContextConfig(true);
+    config.enableTransferQueue = true;
+    iglDev_ = util::device::vulkan::createTestDevice(config);
+    ASSERT_NE(iglDev_, nullptr);
+  }
+
+ protected:
+  std::unique_ptr<igl::vulkan::Device> iglDev_;
+};
+
+TEST_F(VulkanStagingDeviceTransferQueueTest, TransferQueueSelection) {
+  const auto& ctx = iglDev_->getVulkanContext();
+  ASSERT_NE(ctx.stagingDevice_, nullptr);
+
+  // falls back to the graphics queue on devices without a dedicated transfer queue family
+  EXPECT_EQ(ctx.stagingDevice_->hasTransferQueue(), ctx.deviceQueues_.transferQueue != nullptr);
+  if (ctx.deviceQueues_.transferQueue) {
+    EXPECT_NE(ctx.deviceQueues_.transferQueueFamilyIndex,
+              ctx.deviceQueues_.graphicsQueueFamilyIndex);
+  }
+}
+
+TEST_F(VulkanStagingDeviceTransferQueueTest, ImageUpload) {
+  Result ret;
+
+  const TextureDesc texDesc = TextureDesc::new2D(TextureFormat::RGBA_UNorm8,
+                                                 2,
+                                                 2,
+                                                 TextureDesc::TextureUsageBits::Sampled |
+                                                     TextureDesc::TextureUsageBits::Attachment);
+  auto texture = iglDev_->createTexture(texDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  ASSERT_NE(texture, nullptr);
+
+  constexpr uint32_t kColor = 0x11223344;
+  const std::array<uint32_t, 4> srcData = {kColor, kColor, kColor, kColor};
+
+  // the initial upload may go to the transfer queue, later ones always use the graphics queue
+  iglDev_->beginUploadBatch();
+  ret = texture->upload(texture->getFullRange(0), srcData.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+  iglDev_->endUploadBatch();
+
+  auto cmdQueue = iglDev_->createCommandQueue(CommandQueueDesc{}, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  FramebufferDesc fbDesc;
+  fbDesc.colorAttachments[0].texture = texture;
+  auto fb = iglDev_->createFramebuffer(fbDesc, &ret);
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  std::array<uint32_t, 4> downloadedData = {};
+  fb->copyBytesColorAttachment(*cmdQueue, 0, downloadedData.data(), texture->getFullRange(0));
+
+  for (size_t i = 0; i < downloadedData.size(); ++i) {
+    EXPECT_EQ(downloadedData[i], kColor);
+  }
+
+  constexpr uint32_t kNewColor = 0x55667788;
+  const std::array<uint32_t, 4> newData = {kNewColor, kNewColor, kNewColor, kNewColor};
+  ret = texture->upload(texture->getFullRange(0), newData.data());
+  ASSERT_TRUE(ret.isOk()) << ret.message.c_str();
+
+  fb->copyBytesColorAttachment(*cmdQueue, 0, downloadedData.data(), texture->getFullRange(0));
+
+  for (size_t i = 0; i < downloadedData.size(); ++i) {
+    EXPECT_EQ(downloadedData[i], kNewColor);
+  }
+}
+
 } // namespace igl::tests
 
 #endif // IGL_PLATFORM_WINDOWS || IGL_PLATFORM_ANDROID || IGL_PLATFORM_MACOSX || IGL_PLATFORM_LINUX
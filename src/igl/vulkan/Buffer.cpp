@@ -7,7 +7,9 @@
 
 #include <igl/vulkan/Buffer.h>
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <igl/IGLSafeC.h>
 #include <igl/vulkan/Common.h>
@@ -18,6 +20,88 @@
 
 namespace igl::vulkan {
 
+void BufferRangeSet::add(const BufferRange& range) {
+  if (range.size == 0) {
+    return;
+  }
+
+  size_t start = range.offset;
+  size_t end = range.offset + range.size;
+
+  // the first range which ends at or after `start`
+  auto it = std::lower_bound(
+      ranges_.begin(), ranges_.end(), start, [](const BufferRange& r, size_t value) {
+        return r.offset + r.size < value;
+      });
+
+  // absorb all ranges which overlap or touch [start, end)
+  auto last = it;
+  for (; last != ranges_.end() && last->offset <= end; ++last) {
+    start = std::min<size_t>(start, last->offset);
+    end = std::max<size_t>(end, last->offset + last->size);
+  }
+  it = ranges_.erase(it, last);
+  ranges_.insert(it, BufferRange(end - start, start));
+
+  if (ranges_.size() > kMaxRanges) {
+    size_t merge = 0;
+    size_t minGap = std::numeric_limits<size_t>::max();
+    for (size_t i = 0; i + 1 < ranges_.size(); i++) {
+      const size_t gap = ranges_[i + 1].offset - (ranges_[i].offset + ranges_[i].size);
+      if (gap < minGap) {
+        minGap = gap;
+        merge = i;
+      }
+    }
+    const BufferRange& next = ranges_[merge + 1];
+    ranges_[merge].size = next.offset + next.size - ranges_[merge].offset;
+    ranges_.erase(ranges_.begin() + static_cast<ptrdiff_t>(merge) + 1);
+  }
+}
+
+void BufferRangeSet::subtract(const BufferRange& range) {
+  if (range.size == 0) {
+    return;
+  }
+
+  const size_t start = range.offset;
+  const size_t end = range.offset + range.size;
+
+  // the first range which ends after `start`
+  auto it = std::lower_bound(
+      ranges_.begin(), ranges_.end(), start, [](const BufferRange& r, size_t value) {
+        return r.offset + r.size <= value;
+      });
+
+  while (it != ranges_.end() && it->offset < end) {
+    const size_t rangeStart = it->offset;
+    const size_t rangeEnd = it->offset + it->size;
+    if (rangeStart < start && rangeEnd > end) {
+      // split in two
+      it->size = start - rangeStart;
+      ranges_.insert(it + 1, BufferRange(rangeEnd - end, end));
+      return;
+    }
+    if (rangeStart < start) {
+      it->size = start - rangeStart;
+      ++it;
+    } else if (rangeEnd > end) {
+      *it = BufferRange(rangeEnd - end, end);
+      return;
+    } else {
+      it = ranges_.erase(it);
+    }
+  }
+}
+
+size_t BufferRangeSet::getSizeInBytes() const {
+  size_t size = 0;
+  for (const BufferRange& range : ranges_) {
+    size += range.size;
+  }
+  return size;
+}
+
 Buffer::Buffer(const igl::vulkan::Device& device) : device_(device) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
 }
@@ -79,7 +163,7 @@ Result Buffer::create(const BufferDesc& desc) {
   bufferCount_ = isRingBuffer_ ? device_.getVulkanContext().config_.maxResourceCount : 1u;
 
   buffers_ = std::make_unique<std::unique_ptr<VulkanBuffer>[]>(bufferCount_);
-  bufferPatches_ = std::make_unique<BufferRange[]>(bufferCount_);
+  missedRanges_ = std::make_unique<BufferRangeSet[]>(bufferCount_);
 
   // This is used to generate a unique number for unnamed buffers
   static uint32_t bufferId = 0;
@@ -112,41 +196,6 @@ const std::unique_ptr<VulkanBuffer>& Buffer::currentVulkanBuffer() const {
   return buffers_[isRingBuffer_ ? device_.getVulkanContext().currentSyncIndex() : 0u];
 }
 
-BufferRange Buffer::getUpdateRange() const {
-  size_t start = std::numeric_limits<size_t>::max();
-  size_t end = 0;
-
-  for (uint32_t i = 0; i < bufferCount_; ++i) {
-    const auto& bufferPatch = bufferPatches_[i];
-    // skip this buffer, if update size is zero
-    if (bufferPatch.size == 0) {
-      continue;
-    }
-    end = std::max(end, bufferPatch.offset + bufferPatch.size);
-    start = std::min(start, bufferPatch.offset);
-  }
-
-  // If there is no new data, return an empty range to indicate that no data is available
-  if (start == std::numeric_limits<size_t>::max()) {
-    return {};
-  }
-
-  return {end - start, start};
-}
-
-void Buffer::extendUpdateRange(uint32_t ringBufferIndex, const BufferRange& range) {
-  auto& bufferPatch = bufferPatches_[ringBufferIndex];
-  const size_t start = std::min(bufferPatch.offset, range.offset);
-  const size_t end = std::max(bufferPatch.offset + bufferPatch.size, range.size + range.offset);
-
-  bufferPatch.offset = start;
-  bufferPatch.size = end - start;
-}
-
-void Buffer::resetUpdateRange(uint32_t ringBufferIndex, const BufferRange& range) {
-  bufferPatches_[ringBufferIndex] = range;
-}
-
 Result Buffer::upload(const void* data, const BufferRange& range) {
   IGL_PROFILER_FUNCTION();
 
@@ -158,81 +207,62 @@ Result Buffer::upload(const void* data, const BufferRange& range) {
     return Result(Result::Code::ArgumentOutOfRange, "Out of range");
   }
 
-  // To handle an upload to a ring-buffer, we update the local copy first and upload the entire
-  // local data to the device below
   const VulkanContext& ctx = device_.getVulkanContext();
   if (isRingBuffer_) {
-    // get the current ring buffer index
-    const uint32_t currentBufferIndex = device_.getVulkanContext().currentSyncIndex();
-    uint8_t* prevDataPtr = nullptr; // pointer to the previous local copy of the data
-    BufferRange currentUpdateRange = range;
-    if (currentBufferIndex != previousBufferIndex_) {
-      prevDataPtr = previousBufferIndex_ < bufferCount_
-                        ? buffers_[previousBufferIndex_]->getMappedPtr()
-                        : nullptr;
-      // if the index has changed update the index
-      previousBufferIndex_ = currentBufferIndex;
-      // reset update range at the current index, using input range
-      resetUpdateRange(currentBufferIndex, range);
-      // get full update range for this index, based on updates made in all the other buffers
-      currentUpdateRange = getUpdateRange();
-    } else {
-      // increase buffer update range at the current index, based on new range
-      extendUpdateRange(currentBufferIndex, range);
+    const uint32_t currentBufferIndex = ctx.currentSyncIndex();
+    const std::unique_ptr<VulkanBuffer>& buffer = buffers_[currentBufferIndex];
+    // if the ring buffer's Vulkan Buffers are not CPU mapped, localData_ always contains the latest
+    // data and the staging device is used to copy it to the device
+    const bool isMapped = buffer->isMapped();
+    size_t numBytesUploaded = range.size;
+
+    if (!isMapped) {
+      checked_memcpy(localData_.get() + range.offset, range.size, data, range.size);
     }
 
-    // If ring buffer's Vulkan Buffers are CPU mapped
-    if (buffers_[0]->isMapped()) { // if the buffer is mapped
-      // if current updated range differs from the input range, copy data outside of the input range
-      // from previous buffer
-      if ((currentUpdateRange.offset != range.offset || currentUpdateRange.size != range.size) &&
-          prevDataPtr) {
-        uint8_t* currDataPtr = currentVulkanBuffer()->getMappedPtr();
-        // this block is not required for non-mapped buffers, because in that case localData_ always
-        // contains the latest data; and staging device is used to copy data from localData_ to the
-        // device.
-
-        // this block is needed for mapped buffer, because device buffer data will be updated based
-        // on CPU accessible portion of the currentVulkanBuffer (which is in currDataPtr). And so
-        // data changes outside the input range will be copied from the previous buffer.
-
-        // this should never happen, but check just in case
-        IGL_DEBUG_ASSERT(currentUpdateRange.offset <= range.offset);
-
-        // copy data from starting of current update range to range offset
-        const auto frontCopySize = range.offset - currentUpdateRange.offset;
-        if (frontCopySize > 0) {
-          checked_memcpy(currDataPtr + currentUpdateRange.offset,
-                         getSizeInBytes() - currentUpdateRange.offset,
-                         prevDataPtr + currentUpdateRange.offset,
-                         frontCopySize);
-        }
-
-        // copy data from range end to current update range end
-        const auto rangeEnd = range.offset + range.size;
-        const auto currentUpdateRangeEnd = currentUpdateRange.offset + currentUpdateRange.size;
-
-        // this should never happen, but check just in case
-        IGL_DEBUG_ASSERT(currentUpdateRangeEnd >= rangeEnd);
+    // record the replayed ranges and this upload into one staging submission
+    if (!isMapped) {
+      ctx.stagingDevice_->beginBatch();
+    }
 
-        const auto backCopySize = currentUpdateRangeEnd - rangeEnd;
-        if (backCopySize > 0) {
-          checked_memcpy(currDataPtr + rangeEnd,
-                         getSizeInBytes() - rangeEnd,
-                         prevDataPtr + rangeEnd,
-                         backCopySize);
+    if (currentBufferIndex != previousBufferIndex_) {
+      // This slot is current for the first time since the other slots were written. Bring it up to
+      // date by replaying only the ranges it missed, except those overwritten by this upload.
+      BufferRangeSet& missedRanges = missedRanges_[currentBufferIndex];
+      missedRanges.subtract(range);
+      // the previous slot contains the latest data
+      const uint8_t* prevDataPtr = previousBufferIndex_ < bufferCount_
+                                       ? buffers_[previousBufferIndex_]->getMappedPtr()
+                                       : nullptr;
+      IGL_DEBUG_ASSERT(!isMapped || prevDataPtr || missedRanges.empty());
+      for (const BufferRange& missed : missedRanges.ranges()) {
+        if (isMapped) {
+          buffer->bufferSubData(missed.offset, missed.size, prevDataPtr + missed.offset);
+        } else {
+          ctx.stagingDevice_->bufferSubData(
+              *buffer, missed.offset, missed.size, localData_.get() + missed.offset);
         }
       }
-      currentVulkanBuffer()->bufferSubData(range.offset, range.size, data);
+      numBytesUploaded += missedRanges.getSizeInBytes();
+      missedRanges.clear();
+      previousBufferIndex_ = currentBufferIndex;
+    }
+
+    if (isMapped) {
+      buffer->bufferSubData(range.offset, range.size, data);
     } else {
-      // update local data copy
-      checked_memcpy(localData_.get() + range.offset, range.size, data, range.size);
-      // use staging to upload data to device-local buffers
-      ctx.stagingDevice_->bufferSubData(*currentVulkanBuffer(),
-                                        currentUpdateRange.offset,
-                                        currentUpdateRange.size,
-                                        localData_.get() + currentUpdateRange.offset);
+      ctx.stagingDevice_->bufferSubData(
+          *buffer, range.offset, range.size, localData_.get() + range.offset);
+      ctx.stagingDevice_->endBatch();
+    }
+
+    for (uint32_t i = 0; i != bufferCount_; i++) {
+      if (i != currentBufferIndex) {
+        missedRanges_[i].add(range);
+      }
     }
+
+    ctx.addRingBufferUploadStats(range.size, numBytesUploaded);
   } else {
     // use staging to upload data to device-local buffers
     ctx.stagingDevice_->bufferSubData(*currentVulkanBuffer(), range.offset, range.size, data);
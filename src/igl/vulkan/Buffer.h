@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <vector>
 #include <igl/Buffer.h>
 #include <igl/vulkan/Common.h>
 
@@ -15,6 +16,31 @@ namespace igl::vulkan {
 class Device;
 class VulkanBuffer;
 
+/// @brief A set of disjoint byte ranges sorted by offset. Overlapping and adjacent ranges are
+/// merged. When add() exceeds kMaxRanges ranges, the two neighbours with the smallest gap between
+/// them are merged, so the set may cover a few bytes which were never added.
+class BufferRangeSet final {
+ public:
+  static constexpr size_t kMaxRanges = 16;
+
+  void add(const BufferRange& range);
+  void subtract(const BufferRange& range);
+  void clear() {
+    ranges_.clear();
+  }
+
+  [[nodiscard]] bool empty() const {
+    return ranges_.empty();
+  }
+  [[nodiscard]] size_t getSizeInBytes() const;
+  [[nodiscard]] const std::vector<BufferRange>& ranges() const {
+    return ranges_;
+  }
+
+ private:
+  std::vector<BufferRange> ranges_;
+};
+
 /// @brief Implements the igl::IBuffer interface for Vulkan. Contains one or more VulkanBuffers,
 /// depending on the type of buffer this class represents. If this class represents a ring buffer,
 /// then there will be multiple VulkanBuffers, each with its own index. Otherwise it contains only
@@ -57,17 +83,12 @@ class Buffer final : public IBuffer {
   uint32_t previousBufferIndex_ = UINT32_MAX;
   std::unique_ptr<std::unique_ptr<VulkanBuffer>[]> buffers_;
   std::unique_ptr<uint8_t[]> localData_;
-  std::unique_ptr<BufferRange[]> bufferPatches_;
+  // for every ring buffer slot, the ranges uploaded to the other slots since it was last current
+  std::unique_ptr<BufferRangeSet[]> missedRanges_;
   uint32_t bufferCount_ = 0;
 
   Result create(const BufferDesc& desc);
 
-  // Function determines smallest starting and largest ending offset by iterating over all
-  // bufferPatches_, and returns it in the form of buffer range
-  [[nodiscard]] BufferRange getUpdateRange() const;
-  void extendUpdateRange(uint32_t ringBufferIndex, const BufferRange& range);
-  void resetUpdateRange(uint32_t ringBufferIndex, const BufferRange& range);
-
   // Used for map/unmap API for DEVICE_LOCAL buffers
   std::vector<uint8_t> tmpBuffer_;
   BufferRange mappedRange_ = {};
@@ -10,8 +10,11 @@
 #include <igl/Framebuffer.h>
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/ComputeCommandEncoder.h>
+#include <igl/vulkan/ParallelRenderCommandEncoder.h>
+#include <igl/vulkan/Readback.h>
 #include <igl/vulkan/RenderCommandEncoder.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanBarrierBatch.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanImage.h>
 #include <igl/vulkan/VulkanTexture.h>
@@ -37,15 +40,61 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
   IGL_PROFILER_FUNCTION();
   IGL_DEBUG_ASSERT(framebuffer);
 
+  transitionAttachments(renderPass, framebuffer);
+
+  auto encoder = RenderCommandEncoder::create(
+      shared_from_this(), ctx_, renderPass, framebuffer, dependencies, outResult);
+
+  return encoder;
+}
+
+std::unique_ptr<ParallelRenderCommandEncoder> CommandBuffer::createParallelRenderCommandEncoder(
+    const RenderPassDesc& renderPass,
+    const std::shared_ptr<IFramebuffer>& framebuffer,
+    const Dependencies& dependencies,
+    Result* outResult) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(framebuffer);
+
+  transitionAttachments(renderPass, framebuffer);
+
+  return ParallelRenderCommandEncoder::create(
+      shared_from_this(), ctx_, renderPass, framebuffer, dependencies, outResult);
+}
+
+void CommandBuffer::transitionAttachments(const RenderPassDesc& renderPass,
+                                          const std::shared_ptr<IFramebuffer>& framebuffer) {
   framebuffer_ = framebuffer;
 
+  const FramebufferMode mode = framebuffer->getMode();
+
+  // only the mip level and layers which are rendered into are transitioned; all the barriers are
+  // recorded together
+  VulkanBarrierBatch batch(ctx_, wrapper_.cmdBuf);
+
   // prepare all the color attachments
   for (const auto i : framebuffer->getColorAttachmentIndices()) {
+    // RenderCommandEncoder reports a mismatch between the framebuffer and the render pass
+    const RenderPassDesc::AttachmentDesc& descColor =
+        i < renderPass.colorAttachments.size() ? renderPass.colorAttachments[i]
+                                               : RenderPassDesc::AttachmentDesc{};
     ITexture* colorTex = framebuffer->getColorAttachment(i).get();
-    transitionToColorAttachment(wrapper_.cmdBuf, colorTex);
-    // handle MSAA
+    if (colorTex) {
+      transitionToColorAttachment(
+          batch,
+          colorTex,
+          getAttachmentSubresourceRange(
+              *colorTex, descColor.mipLevel, descColor.face, descColor.layer, mode));
+    }
+    // handle MSAA: only the first mip level is resolved into
     ITexture* colorResolveTex = framebuffer->getResolveColorAttachment(i).get();
-    transitionToColorAttachment(wrapper_.cmdBuf, colorResolveTex);
+    if (colorResolveTex) {
+      transitionToColorAttachment(
+          batch,
+          colorResolveTex,
+          getAttachmentSubresourceRange(
+              *colorResolveTex, 0, descColor.face, descColor.layer, mode));
+    }
   }
 
   // prepare depth attachment
@@ -55,23 +104,30 @@ std::unique_ptr<IRenderCommandEncoder> CommandBuffer::createRenderCommandEncoder
     const igl::vulkan::VulkanImage& depthImg = vkDepthTex.getVulkanTexture().image;
     IGL_DEBUG_ASSERT(depthImg.imageFormat_ != VK_FORMAT_UNDEFINED,
                      "Invalid depth attachment format");
-    const VkImageAspectFlags flags = vkDepthTex.getVulkanTexture().image.getImageAspectFlags();
-    depthImg.transitionLayout(wrapper_.cmdBuf,
+    const RenderPassDesc::AttachmentDesc& descDepth = renderPass.depthAttachment;
+    VkImageSubresourceRange range = getAttachmentSubresourceRange(
+        *depthTex, descDepth.mipLevel, descDepth.face, descDepth.layer, mode);
+    range.aspectMask = vkDepthTex.getVulkanTexture().image.getImageAspectFlags();
+    depthImg.transitionLayout(batch,
                               VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
                               VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
                               VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
                                   VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                              VkImageSubresourceRange{.aspectMask = flags,
-                                                      .baseMipLevel = 0,
-                                                      .levelCount = VK_REMAINING_MIP_LEVELS,
-                                                      .baseArrayLayer = 0,
-                                                      .layerCount = VK_REMAINING_ARRAY_LAYERS});
+                              range);
+    // handle MSAA
+    if (descDepth.storeAction == StoreAction::MsaaResolve) {
+      ITexture* depthResolveTex = framebuffer->getResolveDepthAttachment().get();
+      if (depthResolveTex) {
+        transitionToDepthStencilAttachment(
+            batch,
+            depthResolveTex,
+            getAttachmentSubresourceRange(
+                *depthResolveTex, descDepth.mipLevel, descDepth.face, descDepth.layer, mode));
+      }
+    }
   }
 
-  auto encoder = RenderCommandEncoder::create(
-      shared_from_this(), ctx_, renderPass, framebuffer, dependencies, outResult);
-
-  return encoder;
+  batch.flush();
 }
 
 void CommandBuffer::present(const std::shared_ptr<ITexture>& surface) const {
@@ -191,7 +247,7 @@ void CommandBuffer::copyTextureToBuffer(ITexture& src,
 
   VulkanImage& image = texSrc.getVulkanTexture().image;
 
-  const VkImageLayout oldLayout = image.imageLayout_;
+  const VkImageLayout oldLayout = image.getLayout(level, layer);
 
   IGL_DEBUG_ASSERT(oldLayout != VK_IMAGE_LAYOUT_UNDEFINED);
 
@@ -257,6 +313,176 @@ void CommandBuffer::copyTextureToBuffer(ITexture& src,
                          range);
 }
 
+namespace {
+
+// makes the transfer writes into the readback memory visible to the host
+void readbackBarrier(const VulkanFunctionTable& vf,
+                     VkCommandBuffer cmdBuf,
+                     const Readback& readback) {
+  const VkBufferMemoryBarrier barrier = {
+      .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .buffer = readback.getVkBuffer(),
+      .offset = readback.getOffset(),
+      .size = readback.size(),
+  };
+  vf.vkCmdPipelineBarrier(cmdBuf,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT,
+                          VK_PIPELINE_STAGE_HOST_BIT,
+                          0,
+                          0,
+                          nullptr,
+                          1,
+                          &barrier,
+                          0,
+                          nullptr);
+}
+
+} // namespace
+
+std::shared_ptr<IReadback> CommandBuffer::readBufferAsync(IBuffer& src,
+                                                          uint64_t srcOffset,
+                                                          uint64_t size,
+                                                          Result* IGL_NULLABLE outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  if (srcOffset + size > src.getSizeInBytes()) {
+    Result::setResult(outResult, Result::Code::ArgumentOutOfRange, "Readback range out of bounds");
+    return nullptr;
+  }
+
+  std::shared_ptr<Readback> readback =
+      ctx_.readbackRing_->createReadback(wrapper_.handle, size, 0, 4, outResult);
+  if (!readback) {
+    return nullptr;
+  }
+
+  const auto& bufSrc = static_cast<Buffer&>(src);
+
+  ivkBufferBarrier(&ctx_.vf_,
+                   wrapper_.cmdBuf,
+                   bufSrc.getVkBuffer(),
+                   bufSrc.getBufferUsageFlags(),
+                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                   VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+  const VkBufferCopy region = {
+      .srcOffset = srcOffset,
+      .dstOffset = readback->getOffset(),
+      .size = size,
+  };
+
+  ctx_.vf_.vkCmdCopyBuffer(
+      wrapper_.cmdBuf, bufSrc.getVkBuffer(), readback->getVkBuffer(), 1, &region);
+
+  ivkBufferBarrier(&ctx_.vf_,
+                   wrapper_.cmdBuf,
+                   bufSrc.getVkBuffer(),
+                   bufSrc.getBufferUsageFlags(),
+                   VK_PIPELINE_STAGE_TRANSFER_BIT,
+                   VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+
+  readbackBarrier(ctx_.vf_, wrapper_.cmdBuf, *readback);
+
+  return readback;
+}
+
+std::shared_ptr<IReadback> CommandBuffer::readTextureAsync(ITexture& src,
+                                                           const TextureRangeDesc& range,
+                                                           Result* IGL_NULLABLE outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  const Result rangeResult = src.validateRange(range);
+  if (!rangeResult.isOk()) {
+    Result::setResult(outResult, rangeResult);
+    return nullptr;
+  }
+  if (range.numMipLevels != 1) {
+    Result::setResult(
+        outResult, Result::Code::ArgumentInvalid, "Readback range must cover one mip level");
+    return nullptr;
+  }
+
+  const auto& texSrc = static_cast<Texture&>(src);
+  const TextureFormatProperties& properties = texSrc.getProperties();
+
+  std::shared_ptr<Readback> readback =
+      ctx_.readbackRing_->createReadback(wrapper_.handle,
+                                         properties.getBytesPerRange(range),
+                                         properties.getBytesPerRow(range),
+                                         properties.bytesPerBlock,
+                                         outResult);
+  if (!readback) {
+    return nullptr;
+  }
+
+  const VulkanImage& image = texSrc.getVulkanTexture().image;
+
+  const VkImageAspectFlags aspectMask =
+      image.isDepthFormat_
+          ? VK_IMAGE_ASPECT_DEPTH_BIT
+          : (image.isStencilFormat_ ? VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_COLOR_BIT);
+
+  const TextureType type = texSrc.getType();
+  const uint32_t baseLayer = getVkLayer(type, range.face, range.layer);
+  const uint32_t numLayers = getVkLayer(type, range.numFaces, range.numLayers);
+
+  const VkImageLayout oldLayout = image.getLayout(range.mipLevel, baseLayer);
+
+  IGL_DEBUG_ASSERT(oldLayout != VK_IMAGE_LAYOUT_UNDEFINED);
+
+  const VkImageSubresourceRange subresourceRange = {
+      .aspectMask = aspectMask,
+      .baseMipLevel = range.mipLevel,
+      .levelCount = 1u,
+      .baseArrayLayer = baseLayer,
+      .layerCount = numLayers,
+  };
+
+  image.transitionLayout(wrapper_.cmdBuf,
+                         VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         subresourceRange);
+
+  const VkBufferImageCopy region = {
+      .bufferOffset = readback->getOffset(),
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource =
+          {
+              .aspectMask = aspectMask,
+              .mipLevel = range.mipLevel,
+              .baseArrayLayer = baseLayer,
+              .layerCount = numLayers,
+          },
+      .imageOffset = {.x = static_cast<int32_t>(range.x),
+                      .y = static_cast<int32_t>(range.y),
+                      .z = static_cast<int32_t>(range.z)},
+      .imageExtent = {.width = range.width, .height = range.height, .depth = range.depth},
+  };
+
+  ctx_.vf_.vkCmdCopyImageToBuffer(wrapper_.cmdBuf,
+                                  texSrc.getVkImage(),
+                                  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                                  readback->getVkBuffer(),
+                                  1u,
+                                  &region);
+
+  readbackBarrier(ctx_.vf_, wrapper_.cmdBuf, *readback);
+
+  image.transitionLayout(wrapper_.cmdBuf,
+                         oldLayout,
+                         VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         subresourceRange);
+
+  return readback;
+}
+
 void CommandBuffer::waitUntilCompleted() {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
 
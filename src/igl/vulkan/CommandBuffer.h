@@ -13,6 +13,7 @@
 
 namespace igl::vulkan {
 
+class ParallelRenderCommandEncoder;
 class VulkanContext;
 
 /// @brief This class implements the igl::ICommandBuffer interface for Vulkan
@@ -42,6 +43,16 @@ class CommandBuffer final : public ICommandBuffer,
       const Dependencies& dependencies,
       Result* outResult) override;
 
+  /** @brief Creates a ParallelRenderCommandEncoder, which records one render pass from multiple
+   * threads into secondary command buffers. Performs the same layout transitions as
+   * createRenderCommandEncoder().
+   */
+  std::unique_ptr<ParallelRenderCommandEncoder> createParallelRenderCommandEncoder(
+      const RenderPassDesc& renderPass,
+      const std::shared_ptr<IFramebuffer>& framebuffer,
+      const Dependencies& dependencies,
+      Result* outResult);
+
   /** @brief Caches the texture passed in to the function for presentation later. If the texture
    * belongs to a swapchain, this function
    * transitions the texture to VK_IMAGE_LAYOUT_PRESENT_SRC_KHR layout. Otherwise it transitions the
@@ -65,6 +76,16 @@ class CommandBuffer final : public ICommandBuffer,
                            uint32_t level,
                            uint32_t layer) override;
 
+  /// @brief Records a copy into a region of the context's VulkanReadbackRing. The returned
+  /// Readback completes when this command buffer has been retired by the GPU.
+  std::shared_ptr<IReadback> readBufferAsync(IBuffer& src,
+                                             uint64_t srcOffset,
+                                             uint64_t size,
+                                             Result* IGL_NULLABLE outResult) override;
+  std::shared_ptr<IReadback> readTextureAsync(ITexture& src,
+                                              const TextureRangeDesc& range,
+                                              Result* IGL_NULLABLE outResult) override;
+
   /// @brief Waits until the command bufer has been executed by the device.
   void waitUntilCompleted() override;
 
@@ -90,6 +111,11 @@ class CommandBuffer final : public ICommandBuffer,
  private:
   friend class CommandQueue;
 
+  /// @brief Transitions the rendered subresources of all attachments of `framebuffer` to their
+  /// attachment layouts
+  void transitionAttachments(const RenderPassDesc& renderPass,
+                             const std::shared_ptr<IFramebuffer>& framebuffer);
+
   VulkanContext& ctx_;
   const VulkanImmediateCommands::CommandBufferWrapper& wrapper_;
   // was present() called with a swapchain image?
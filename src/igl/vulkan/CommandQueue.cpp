@@ -84,6 +84,9 @@ SubmitHandle CommandQueue::endCommandBuffer(VulkanContext& ctx,
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
   IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx);
 
+  // uploads batched so far have to reach the queue before the work which consumes them
+  ctx.stagingDevice_->flushBatch();
+
   // Submit to the graphics queue.
   const bool shouldPresent = ctx.hasSwapchain() && cmdBuffer->isFromSwapchain() && present;
   const auto finishCommandBuffer = [&](VulkanImmediateCommands::SubmitHandle submitHandle) {
@@ -91,6 +94,8 @@ SubmitHandle CommandQueue::endCommandBuffer(VulkanContext& ctx,
     ctx.syncMarkSubmitted(submitHandle);
     ctx.processDeferredTasks();
     ctx.stagingDevice_->mergeRegionsAndFreeBuffers();
+    ctx.readbackRing_->processCompletedReadbacks();
+    ctx.threadCommandPools_->recycle(*ctx.immediate_);
     return submitHandle.handle();
   };
   if (shouldPresent) {
@@ -27,6 +27,7 @@
 
 #include <igl/vulkan/ShaderModule.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanBarrierBatch.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanImage.h>
 #include <igl/vulkan/VulkanShaderModule.h>
@@ -598,7 +599,10 @@ TextureRangeDesc atVkLayer(TextureType type, const TextureRangeDesc& range, uint
   return type == TextureType::Cube ? range.atFace(vkLayer) : range.atLayer(vkLayer);
 }
 
-void transitionToGeneral(VkCommandBuffer cmdBuf, ITexture* texture) {
+namespace {
+
+template<typename Target>
+void transitionToGeneralImpl(Target& target, ITexture* texture) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_TRANSITION);
 
   if (!texture) {
@@ -620,7 +624,7 @@ void transitionToGeneral(VkCommandBuffer cmdBuf, ITexture* texture) {
       (img.imageLayout_ == VK_IMAGE_LAYOUT_GENERAL) ? VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT
       : img.isDepthOrStencilFormat_                 ? VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
                                                     : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  img.transitionLayout(cmdBuf,
+  img.transitionLayout(target,
                        VK_IMAGE_LAYOUT_GENERAL,
                        srcStage,
                        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
@@ -631,7 +635,10 @@ void transitionToGeneral(VkCommandBuffer cmdBuf, ITexture* texture) {
                                                .layerCount = VK_REMAINING_ARRAY_LAYERS});
 }
 
-void transitionToColorAttachment(VkCommandBuffer cmdBuf, ITexture* colorTex) {
+template<typename Target>
+void transitionToColorAttachmentImpl(Target& target,
+                                     ITexture* colorTex,
+                                     const VkImageSubresourceRange& range) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_TRANSITION);
 
   if (!colorTex) {
@@ -653,21 +660,24 @@ void transitionToColorAttachment(VkCommandBuffer cmdBuf, ITexture* colorTex) {
   }
   if (img.usageFlags_ & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) {
     // transition to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-    img.transitionLayout(cmdBuf,
+    img.transitionLayout(target,
                          VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, // wait for all subsequent
                                                                    // fragment/compute shaders
                          VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
                          VkImageSubresourceRange{.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-                                                 .baseMipLevel = 0,
-                                                 .levelCount = VK_REMAINING_MIP_LEVELS,
-                                                 .baseArrayLayer = 0,
-                                                 .layerCount = VK_REMAINING_ARRAY_LAYERS});
+                                                 .baseMipLevel = range.baseMipLevel,
+                                                 .levelCount = range.levelCount,
+                                                 .baseArrayLayer = range.baseArrayLayer,
+                                                 .layerCount = range.layerCount});
   }
 }
 
-void transitionToDepthStencilAttachment(VkCommandBuffer cmdBuf, ITexture* depthStencilTex) {
+template<typename Target>
+void transitionToDepthStencilAttachmentImpl(Target& target,
+                                            ITexture* depthStencilTex,
+                                            const VkImageSubresourceRange& range) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_TRANSITION);
 
   if (!depthStencilTex) {
@@ -695,21 +705,22 @@ void transitionToDepthStencilAttachment(VkCommandBuffer cmdBuf, ITexture* depthS
     if (img.isStencilFormat_) {
       aspectFlags |= VK_IMAGE_ASPECT_STENCIL_BIT;
     }
-    img.transitionLayout(cmdBuf,
+    img.transitionLayout(target,
                          VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
                          VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, // wait for all subsequent
                                                                    // fragment/compute shaders
                          VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
                          VkImageSubresourceRange{.aspectMask = aspectFlags,
-                                                 .baseMipLevel = 0,
-                                                 .levelCount = VK_REMAINING_MIP_LEVELS,
-                                                 .baseArrayLayer = 0,
-                                                 .layerCount = VK_REMAINING_ARRAY_LAYERS});
+                                                 .baseMipLevel = range.baseMipLevel,
+                                                 .levelCount = range.levelCount,
+                                                 .baseArrayLayer = range.baseArrayLayer,
+                                                 .layerCount = range.layerCount});
   }
 }
 
-void transitionToShaderReadOnly(VkCommandBuffer cmdBuf, ITexture* texture) {
+template<typename Target>
+void transitionToShaderReadOnlyImpl(Target& target, ITexture* texture) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_TRANSITION);
 
   if (!texture) {
@@ -724,7 +735,7 @@ void transitionToShaderReadOnly(VkCommandBuffer cmdBuf, ITexture* texture) {
 
   if (img.usageFlags_ & VK_IMAGE_USAGE_SAMPLED_BIT) {
     // transition sampled images to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    img.transitionLayout(cmdBuf,
+    img.transitionLayout(target,
                          VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                          isColor ? VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
                                  : VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
@@ -739,12 +750,63 @@ void transitionToShaderReadOnly(VkCommandBuffer cmdBuf, ITexture* texture) {
   }
 }
 
+} // namespace
+
+void transitionToGeneral(VkCommandBuffer cmdBuf, ITexture* texture) {
+  transitionToGeneralImpl(cmdBuf, texture);
+}
+
+void transitionToGeneral(VulkanBarrierBatch& batch, ITexture* texture) {
+  transitionToGeneralImpl(batch, texture);
+}
+
+void transitionToColorAttachment(VkCommandBuffer cmdBuf, ITexture* colorTex) {
+  transitionToColorAttachmentImpl(cmdBuf, colorTex, kAllSubresources);
+}
+
+void transitionToColorAttachment(VulkanBarrierBatch& batch,
+                                 ITexture* colorTex,
+                                 const VkImageSubresourceRange& range) {
+  transitionToColorAttachmentImpl(batch, colorTex, range);
+}
+
+void transitionToDepthStencilAttachment(VkCommandBuffer cmdBuf, ITexture* depthStencilTex) {
+  transitionToDepthStencilAttachmentImpl(cmdBuf, depthStencilTex, kAllSubresources);
+}
+
+void transitionToDepthStencilAttachment(VulkanBarrierBatch& batch,
+                                        ITexture* depthStencilTex,
+                                        const VkImageSubresourceRange& range) {
+  transitionToDepthStencilAttachmentImpl(batch, depthStencilTex, range);
+}
+
+void transitionToShaderReadOnly(VkCommandBuffer cmdBuf, ITexture* texture) {
+  transitionToShaderReadOnlyImpl(cmdBuf, texture);
+}
+
+void transitionToShaderReadOnly(VulkanBarrierBatch& batch, ITexture* texture) {
+  transitionToShaderReadOnlyImpl(batch, texture);
+}
+
+VkImageSubresourceRange getAttachmentSubresourceRange(const ITexture& texture,
+                                                      uint32_t mipLevel,
+                                                      uint32_t face,
+                                                      uint32_t layer,
+                                                      FramebufferMode mode) {
+  return VkImageSubresourceRange{
+      .baseMipLevel = mipLevel,
+      .levelCount = 1,
+      .baseArrayLayer = getVkLayer(texture.getType(), face, layer),
+      .layerCount = mode == FramebufferMode::Stereo ? 2u : 1u,
+  };
+}
+
 void overrideImageLayout(ITexture* texture, VkImageLayout layout) {
   if (!texture) {
     return;
   }
   const vulkan::Texture* tex = static_cast<Texture*>(texture);
-  tex->getVulkanTexture().image.imageLayout_ = layout;
+  tex->getVulkanTexture().image.setLayout(layout);
 }
 
 void ensureShaderModule(IShaderModule* sm) {
@@ -27,6 +27,7 @@
 #include <igl/Common.h> // IWYU pragma: export
 #include <igl/DepthStencilState.h> // IWYU pragma: export
 #include <igl/Format.h> // IWYU pragma: export
+#include <igl/Framebuffer.h>
 #include <igl/Texture.h> // IWYU pragma: export
 #include <igl/VertexInputState.h> // IWYU pragma: export
 #include <igl/vulkan/VulkanHelpers.h> // IWYU pragma: export
@@ -97,9 +98,12 @@
 #define VK_ASSERT_RETURN_NULL_HANDLE(func) VK_ASSERT_RETURN_VALUE(func, VK_NULL_HANDLE)
 
 #define IGL_ENSURE_VULKAN_CONTEXT_THREAD(ctx) (ctx)->ensureCurrentContextThread()
+#define IGL_ENSURE_VULKAN_RECORDING_THREAD(ctx) (ctx)->ensureRecordingThread()
 
 namespace igl::vulkan {
 
+class VulkanBarrierBatch;
+
 // The color definitions below are used by debugging utility functions, such as the ones provided by
 // VK_EXT_debug_utils
 #define K_COLOR_GENERATE_MIPMAPS igl::Color(1.f, 0.75f, 0.f)
@@ -135,6 +139,65 @@ struct VulkanContextConfig {
   const void* pipelineCacheData = nullptr;
   size_t pipelineCacheDataSize = 0;
 
+  // If not null, the pipeline cache is loaded from this file (unless pipelineCacheData is provided)
+  // and saved back to it whenever new pipelines are added. Stale or corrupted files are ignored.
+  // Owned by the application - should be alive until initContext() returns
+  const char* pipelineCachePath = nullptr;
+  // How often the pipeline cache is written to pipelineCachePath from a background thread. Passing
+  // 0 disables the background thread and the file is written only when the context is destroyed.
+  uint32_t pipelineCacheFlushIntervalMs = 5000;
+
+  // The number of SPIR-V binaries kept in memory by Device::createShaderModule() to skip
+  // recompiling identical GLSL sources. Passing 0 disables the in-memory tier.
+  uint32_t spirvCacheCapacity = 256;
+  // If not null, an existing directory where compiled SPIR-V binaries are stored across runs.
+  // Owned by the application - should be alive until the context is created
+  const char* spirvCachePath = nullptr;
+
+  // Reuse descriptor sets already written with identical bindings within the same command buffer
+  // instead of writing new ones with vkUpdateDescriptorSets()
+  bool enableDescriptorSetCache = true;
+
+  // Update uniform and storage buffer bindings with vkCmdPushDescriptorSetWithTemplateKHR()
+  // instead of allocating and writing descriptor sets, if VK_KHR_push_descriptor is supported.
+  // Pipelines with dynamic buffers always use regular descriptor sets, and so do textures and
+  // storage images.
+  bool enablePushDescriptors = true;
+
+  // The number of worker threads used by RenderPipelineState::precompile(). The threads are
+  // created lazily on the first call. Passing 0 picks a value based on the number of CPU cores.
+  uint32_t numPipelineCompilationThreads = 0;
+
+  // The size of the persistently mapped buffer used by CommandBuffer::readBufferAsync() and
+  // CommandBuffer::readTextureAsync(). The buffer is created on first use. Readbacks which do not
+  // fit get their own buffers. Passing 0 disables the ring.
+  uint32_t readbackRingSize = 4u * 1024u * 1024u;
+
+  // The initial size of the persistently mapped uniform buffer of each of the `maxResourceCount`
+  // frames used by bindBytes(). A frame which needs more memory gets a larger buffer.
+  uint32_t uniformRingSize = 256u * 1024u;
+
+  // Generate mipmaps with a compute shader instead of vkCmdBlitImage() for textures whose width or
+  // height is at least this size. Formats which cannot be blitted always use the compute shader if
+  // they can be storage images. Passing 0 keeps blits for all other formats.
+  uint32_t computeMipmapMinSize = 0;
+
+  // Render with vkCmdBeginRendering() directly into attachment image views and create graphics
+  // pipelines with VkPipelineRenderingCreateInfo, if VK_KHR_dynamic_rendering is supported. No
+  // VkRenderPass and VkFramebuffer objects are created by render command encoders in this mode.
+  bool enableDynamicRendering = true;
+
+  // Split graphics pipelines into vertex input, pre-rasterization, fragment shader and fragment
+  // output libraries if VK_EXT_graphics_pipeline_library with fast linking is supported. A new
+  // RenderPipelineDynamicState then costs a link of cached libraries instead of a full compile,
+  // and an optimized pipeline is built on the pipeline compilation threads to replace it later.
+  bool enableGraphicsPipelineLibrary = true;
+
+  // Upload staging data on a dedicated transfer-only queue, if the device has one, so that
+  // streaming overlaps with rendering. Requires VK_KHR_timeline_semaphore and
+  // VK_KHR_synchronization2; falls back to the graphics queue otherwise.
+  bool enableTransferQueue = false;
+
   // This enables fences generated at the end of submission to be exported to the client.
   // The client can then use the SubmitHandle to wait for the completion of the GPU work.
   bool exportableFences = false;
@@ -213,17 +276,43 @@ VkComponentMapping componentMappingToVkComponentMapping(const ComponentMapping&
 VkSpecializationInfo buildSpecializationInfo(const FunctionConstantValues& constantValues,
                                              std::vector<VkSpecializationMapEntry>& outEntries);
 
+/// @brief All mip levels and array layers of an image. The aspect mask is not set.
+constexpr VkImageSubresourceRange kAllSubresources = {
+    .baseMipLevel = 0,
+    .levelCount = VK_REMAINING_MIP_LEVELS,
+    .baseArrayLayer = 0,
+    .layerCount = VK_REMAINING_ARRAY_LAYERS,
+};
+
 /// @brief Transition from the current layout to VK_IMAGE_LAYOUT_GENERAL
 void transitionToGeneral(VkCommandBuffer cmdBuf, ITexture* texture);
+void transitionToGeneral(VulkanBarrierBatch& batch, ITexture* texture);
 
-/// @brief Transition from the current layout to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+/// @brief Transition from the current layout to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL. The
+/// batched version transitions only the mip levels and array layers in `range`.
 void transitionToColorAttachment(VkCommandBuffer cmdBuf, ITexture* colorTex);
+void transitionToColorAttachment(VulkanBarrierBatch& batch,
+                                 ITexture* colorTex,
+                                 const VkImageSubresourceRange& range);
 
-/// @brief Transition from the current layout to VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL
+/// @brief Transition from the current layout to VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL.
+/// The batched version transitions only the mip levels and array layers in `range`.
 void transitionToDepthStencilAttachment(VkCommandBuffer cmdBuf, ITexture* depthStencilTex);
+void transitionToDepthStencilAttachment(VulkanBarrierBatch& batch,
+                                        ITexture* depthStencilTex,
+                                        const VkImageSubresourceRange& range);
 
 /// @brief Transition from the current layout to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
 void transitionToShaderReadOnly(VkCommandBuffer cmdBuf, ITexture* texture);
+void transitionToShaderReadOnly(VulkanBarrierBatch& batch, ITexture* texture);
+
+/// @brief Returns the mip level and array layers of `texture` rendered into by a framebuffer
+/// attachment. The aspect mask is not set.
+VkImageSubresourceRange getAttachmentSubresourceRange(const ITexture& texture,
+                                                      uint32_t mipLevel,
+                                                      uint32_t face,
+                                                      uint32_t layer,
+                                                      FramebufferMode mode);
 
 /// @brief Overrides the layout stored in the `texture` with the one in `layout`. This function does
 /// not perform a transition, it only updates the texture's member variable that stores its current
@@ -11,6 +11,7 @@
 #include <igl/vulkan/ComputePipelineState.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanBarrierBatch.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanImage.h>
@@ -44,11 +45,12 @@ void ComputeCommandEncoder::endEncoding() {
 
   isEncoding_ = false;
 
+  VulkanBarrierBatch batch(ctx_, cmdBuffer_);
   for (size_t i = 0; i < numRestoreLayouts_; ++i) {
     const VulkanImage* const img = restoreLayout_[i];
     if (img->isSampledImage()) {
       // only sampled images can be transitioned to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-      img->transitionLayout(cmdBuffer_,
+      img->transitionLayout(batch,
                             VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
                             VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
@@ -62,6 +64,7 @@ void ComputeCommandEncoder::endEncoding() {
                             });
     }
   }
+  batch.flush();
   numRestoreLayouts_ = 0;
 }
 
@@ -95,6 +98,8 @@ void ComputeCommandEncoder::bindComputePipelineState(
 }
 
 void ComputeCommandEncoder::processDependencies(const Dependencies& dependencies) {
+  VulkanBarrierBatch batch(ctx_, cmdBuffer_);
+
   // 1. Process all textures
   {
     const Dependencies* deps = &dependencies;
@@ -104,7 +109,7 @@ void ComputeCommandEncoder::processDependencies(const Dependencies& dependencies
         if (!tex) {
           break;
         }
-        transitionToGeneral(cmdBuffer_, tex);
+        transitionToGeneral(batch, tex);
       }
       deps = deps->next;
     }
@@ -137,12 +142,13 @@ void ComputeCommandEncoder::processDependencies(const Dependencies& dependencies
                 ? VK_PIPELINE_STAGE_HOST_BIT
                 : VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
                       VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-        ivkBufferBarrier(
-            &ctx_.vf_, cmdBuffer_, vkBuf->getVkBuffer(), flags, srcStageFlags, dstStageFlags);
+        batch.bufferBarrier(vkBuf->getVkBuffer(), flags, srcStageFlags, dstStageFlags);
       }
       deps = deps->next;
     }
   }
+
+  batch.flush();
 }
 
 void ComputeCommandEncoder::dispatchThreadGroups(const Dimensions& threadgroupCount,
@@ -332,8 +338,10 @@ void ComputeCommandEncoder::bindBuffer(uint32_t index,
   binder_.bindBuffer(index, buf, offset, bufferSize);
 }
 
-void ComputeCommandEncoder::bindBytes(uint32_t /*index*/, const void* /*data*/, size_t /*length*/) {
-  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+void ComputeCommandEncoder::bindBytes(uint32_t index, const void* data, size_t length) {
+  IGL_PROFILER_FUNCTION();
+
+  binder_.bindBytes(index, data, length);
 }
 
 void ComputeCommandEncoder::bindPushConstants(const void* data, size_t length, size_t offset) {
@@ -117,6 +117,8 @@ VkPipeline ComputePipelineState::getVkPipeline() const {
   const VkSpecializationInfo specInfo =
       buildSpecializationInfo(shaderModule->info().functionConstantValues, specEntries);
 
+  VkPipelineCreationFeedback feedback = {};
+
   // `device` comes from ctx.getVkDevice(), which is annotated IGL_NULLABLE but is non-null by
   // construction whenever a pipeline is being created; this is a false positive.
   // NOLINTNEXTLINE(facebook-hte-NullableDereference)
@@ -128,6 +130,7 @@ VkPipeline ComputePipelineState::getVkPipeline() const {
                     .pName = shaderModule->info().entryPoint.c_str(),
                     .pSpecializationInfo = specInfo.mapEntryCount ? &specInfo : nullptr,
                 })
+                .creationFeedback(ctx.hasPipelineCreationFeedback() ? &feedback : nullptr)
                 .build(ctx.vf_,
                        device,
                        flags,
@@ -136,6 +139,8 @@ VkPipeline ComputePipelineState::getVkPipeline() const {
                        &pipeline_,
                        desc_.debugName.c_str()));
 
+  ctx.recordPipelineCreationFeedback(feedback);
+
   return pipeline_;
 }
 
@@ -11,6 +11,7 @@
 #include <igl/FramebufferWrapper.h>
 #include <igl/glslang/GlslCompiler.h>
 #include <igl/glslang/GlslangHelpers.h>
+#include <igl/glslang/SpirvCache.h>
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/CommandQueue.h>
 #include <igl/vulkan/Common.h>
@@ -519,7 +520,19 @@ std::shared_ptr<VulkanShaderModule> Device::createShaderModule(ShaderStage stage
                            &ctx_->getvkPhysicalDeviceMeshShaderPropertiesEXT());
 
   std::vector<uint32_t> spirv;
-  const Result result = glslang::compileShader(stage, source, spirv, &glslangResource, options);
+  Result result;
+
+  glslang::SpirvCache* spirvCache = ctx_->getSpirvCache();
+  const glslang::SpirvCache::Key cacheKey =
+      spirvCache ? glslang::SpirvCache::computeKey(stage, source, options, glslangResource)
+                 : glslang::SpirvCache::Key{};
+
+  if (!spirvCache || !spirvCache->find(cacheKey, spirv)) {
+    result = glslang::compileShader(stage, source, spirv, &glslangResource, options);
+    if (spirvCache && result.isOk()) {
+      spirvCache->insert(cacheKey, spirv);
+    }
+  }
 
   VkShaderModule vkShaderModule = VK_NULL_HANDLE;
   const VkShaderModuleCreateInfo ci = {
@@ -615,6 +628,41 @@ size_t Device::getShaderCompilationCountInternal() const {
   return ctx_->shaderCompilationCount_;
 }
 
+size_t Device::getGPUMemoryUsage() const {
+  return ctx_->getMemoryUsage().total;
+}
+
+GPUMemoryUsage Device::getGPUMemoryUsageBreakdown() const {
+  return ctx_->getMemoryUsage();
+}
+
+void Device::beginUploadBatch() {
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(ctx_);
+
+  ctx_->stagingDevice_->beginBatch();
+}
+
+void Device::endUploadBatch() {
+  IGL_PROFILER_FUNCTION();
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(ctx_);
+
+  ctx_->stagingDevice_->endBatch();
+}
+
+size_t Device::getShaderCacheHitCount() const {
+  const glslang::SpirvCache* spirvCache = ctx_->getSpirvCache();
+  if (!spirvCache) {
+    return 0;
+  }
+  const glslang::SpirvCache::Stats stats = spirvCache->getStats();
+  return stats.numHits + stats.numDiskHits;
+}
+
+size_t Device::getShaderCacheMissCount() const {
+  const glslang::SpirvCache* spirvCache = ctx_->getSpirvCache();
+  return spirvCache ? spirvCache->getStats().numMisses : 0;
+}
+
 std::unique_ptr<IShaderLibrary> Device::createShaderLibraryInternal(const ShaderLibraryDesc& desc,
                                                                     Result* IGL_NULLABLE
                                                                         outResult) const {
@@ -116,6 +116,19 @@ class Device final : public IDevice {
   [[nodiscard]] BackendType getBackendType() const override;
   [[nodiscard]] size_t getCurrentDrawCount() const override;
   [[nodiscard]] size_t getShaderCompilationCount() const override;
+  /// @brief The number of GLSL shader modules served from the SPIR-V cache (see
+  /// VulkanContextConfig::spirvCacheCapacity). getShaderCompilationCount() counts both.
+  [[nodiscard]] size_t getShaderCacheHitCount() const;
+  /// @brief The number of GLSL shader modules which had to be compiled by glslang
+  [[nodiscard]] size_t getShaderCacheMissCount() const;
+  [[nodiscard]] size_t getGPUMemoryUsage() const override;
+  [[nodiscard]] GPUMemoryUsage getGPUMemoryUsageBreakdown() const override;
+
+  /// @brief Buffer and texture uploads done between beginUploadBatch() and endUploadBatch() are
+  /// recorded into one command buffer and submitted together (see VulkanStagingDevice::beginBatch()).
+  void beginUploadBatch();
+  /// @brief Submits the uploads of the current batch with a single vkQueueSubmit()
+  void endUploadBatch();
 
   void setCurrentThread() override;
 
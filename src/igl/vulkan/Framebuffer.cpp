@@ -91,6 +91,8 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* Not Used */,
   // range's cube face or array layer.
   const uint32_t layer = getVkLayer(itexture->getType(), range.face, range.layer);
 
+  const VulkanImage& image = vkTex.getVulkanTexture().image;
+
   const VulkanContext& ctx = device_.getVulkanContext();
   ctx.stagingDevice_->getImageData2D(vkTex.getVkImage(),
                                      range.mipLevel,
@@ -98,7 +100,7 @@ void Framebuffer::copyBytesColorAttachment(ICommandQueue& /* Not Used */,
                                      imageRegion,
                                      vkTex.getProperties(),
                                      VK_FORMAT_R8G8B8A8_UNORM,
-                                     vkTex.getVulkanTexture().image.imageLayout_,
+                                     image.getLayout(range.mipLevel, layer),
                                      vkTex.getVulkanTexture().imageView_.getVkImageAspectFlags(),
                                      pixelBytes,
                                      static_cast<uint32_t>(bytesPerRow),
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/ParallelRenderCommandEncoder.h>
+
+#include <igl/vulkan/CommandBuffer.h>
+#include <igl/vulkan/RenderCommandEncoder.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::vulkan {
+
+ParallelRenderCommandEncoder::ParallelRenderCommandEncoder(
+    std::unique_ptr<RenderCommandEncoder> primary) :
+  primary_(std::move(primary)) {}
+
+ParallelRenderCommandEncoder::~ParallelRenderCommandEncoder() {
+  IGL_DEBUG_ASSERT(!isEncoding_); // did you forget to call endEncoding()?
+  endEncoding();
+}
+
+std::unique_ptr<ParallelRenderCommandEncoder> ParallelRenderCommandEncoder::create(
+    const std::shared_ptr<CommandBuffer>& commandBuffer,
+    VulkanContext& ctx,
+    const RenderPassDesc& renderPass,
+    const std::shared_ptr<IFramebuffer>& framebuffer,
+    const Dependencies& dependencies,
+    Result* outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  Result ret;
+
+  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+  std::unique_ptr<RenderCommandEncoder> primary(new RenderCommandEncoder(commandBuffer, ctx));
+  primary->hasSecondaryContents_ = true;
+  primary->initialize(renderPass, framebuffer, dependencies, ret);
+
+  Result::setResult(outResult, ret);
+  if (!ret.isOk()) {
+    return nullptr;
+  }
+
+  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+  return std::unique_ptr<ParallelRenderCommandEncoder>(
+      new ParallelRenderCommandEncoder(std::move(primary)));
+}
+
+std::unique_ptr<IRenderCommandEncoder> ParallelRenderCommandEncoder::createRenderCommandEncoder() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+  IGL_DEBUG_ASSERT(isEncoding_);
+
+  numRecording_++;
+
+  std::unique_ptr<RenderCommandEncoder> encoder =
+      RenderCommandEncoder::createSecondary(*primary_, this);
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+  secondaries_.push_back(encoder->getVkCommandBuffer());
+
+  return encoder;
+}
+
+void ParallelRenderCommandEncoder::endSecondary() {
+  IGL_DEBUG_ASSERT(numRecording_ > 0);
+  numRecording_--;
+}
+
+void ParallelRenderCommandEncoder::endEncoding() {
+  IGL_PROFILER_FUNCTION();
+
+  if (!isEncoding_) {
+    return;
+  }
+
+  const VulkanContext& ctx = primary_->ctx_;
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx);
+  IGL_DEBUG_ASSERT(numRecording_ == 0, "All encoders have to be ended before endEncoding()");
+
+  isEncoding_ = false;
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!secondaries_.empty()) {
+    ctx.vf_.vkCmdExecuteCommands(primary_->getVkCommandBuffer(),
+                                 static_cast<uint32_t>(secondaries_.size()),
+                                 secondaries_.data());
+  }
+
+  primary_->endEncoding();
+}
+
+uint32_t ParallelRenderCommandEncoder::getNumEncoders() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return static_cast<uint32_t>(secondaries_.size());
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <igl/CommandEncoder.h>
+#include <igl/Common.h>
+#include <igl/Framebuffer.h>
+#include <igl/RenderCommandEncoder.h>
+#include <igl/RenderPass.h>
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+class CommandBuffer;
+class RenderCommandEncoder;
+class VulkanContext;
+
+/**
+ * @brief Records one render pass from multiple threads.
+ *
+ * The render pass is begun in the primary command buffer on the context thread. Every encoder
+ * returned by createRenderCommandEncoder() records into its own secondary command buffer, which
+ * comes from a command pool owned by the calling thread (see VulkanThreadCommandPools).
+ * endEncoding() executes all secondary command buffers in the order their encoders were created
+ * and ends the render pass.
+ *
+ * While encoders are recording on other threads, the context thread must not use the device, the
+ * command queue or any other encoder until it calls endEncoding().
+ */
+class ParallelRenderCommandEncoder final {
+ public:
+  static std::unique_ptr<ParallelRenderCommandEncoder> create(
+      const std::shared_ptr<CommandBuffer>& commandBuffer,
+      VulkanContext& ctx,
+      const RenderPassDesc& renderPass,
+      const std::shared_ptr<IFramebuffer>& framebuffer,
+      const Dependencies& dependencies,
+      Result* outResult);
+
+  ~ParallelRenderCommandEncoder();
+
+  ParallelRenderCommandEncoder(const ParallelRenderCommandEncoder&) = delete;
+  ParallelRenderCommandEncoder(ParallelRenderCommandEncoder&&) = delete;
+  ParallelRenderCommandEncoder& operator=(const ParallelRenderCommandEncoder&) = delete;
+  ParallelRenderCommandEncoder& operator=(ParallelRenderCommandEncoder&&) = delete;
+
+  /// @brief Creates an encoder which records a part of the render pass. Can be called from any
+  /// thread, but the returned encoder has to be used and ended on the calling thread. No state
+  /// (pipelines, bindings, viewport) is shared between encoders.
+  std::unique_ptr<IRenderCommandEncoder> createRenderCommandEncoder();
+
+  /// @brief Executes the secondary command buffers of all encoders and ends the render pass. All
+  /// encoders have to be ended before. Must be called on the context thread.
+  void endEncoding();
+
+  /// @brief The number of encoders created so far
+  [[nodiscard]] uint32_t getNumEncoders() const;
+
+ private:
+  friend class RenderCommandEncoder;
+
+  explicit ParallelRenderCommandEncoder(std::unique_ptr<RenderCommandEncoder> primary);
+
+  void endSecondary();
+
+  std::unique_ptr<RenderCommandEncoder> primary_;
+
+  mutable std::mutex mutex_;
+  // in creation order
+  std::vector<VkCommandBuffer> secondaries_;
+  std::atomic<uint32_t> numRecording_{0};
+  bool isEncoding_ = true;
+};
+
+} // namespace igl::vulkan
@@ -165,10 +165,21 @@ PipelineState::PipelineState(
   }
   // 1. Buffers
   {
+    // push descriptors cannot be dynamic: use them only if no buffers are dynamic
+    usePushDescriptors = ctx.features().has_VK_KHR_push_descriptor &&
+                         !ctx.features().has_VK_EXT_descriptor_buffer && !info.buffers.empty();
+    for (const auto& b : info.buffers) {
+      if ((isDynamicBufferMask & (1ul << b.bindingLocation)) != 0) {
+        usePushDescriptors = false;
+      }
+    }
     std::vector<VkDescriptorSetLayoutBinding> bindings;
     bindings.reserve(info.buffers.size());
     for (const auto& b : info.buffers) {
       const bool isDynamic = (isDynamicBufferMask & (1ul << b.bindingLocation)) != 0;
+      if (isDynamic) {
+        dynamicBufferMask |= 1u << b.bindingLocation;
+      }
       const VkDescriptorType type = b.isStorage
                                         ? (isDynamic ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC
                                                      : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
@@ -184,7 +195,7 @@ PipelineState::PipelineState(
     std::vector<VkDescriptorBindingFlags> bindingFlags(bindings.size());
     dslBuffers = std::make_unique<VulkanDescriptorSetLayout>(
         ctx,
-        flag,
+        usePushDescriptors ? VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR : flag,
         static_cast<uint32_t>(bindings.size()),
         bindings.data(),
         bindingFlags.data(),
@@ -46,6 +46,14 @@ class PipelineState {
 
   mutable VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
 
+  // the buffers set is updated via VK_KHR_push_descriptor instead of descriptor sets, see
+  // VulkanContext::updateBindingsBuffersByPushDescriptors()
+  bool usePushDescriptors = false;
+
+  // buffer bindings declared as *_DYNAMIC in dslBuffers; ResourcesBinder passes their offsets as
+  // dynamic offsets, so rebinding them at a different offset reuses the same descriptor set
+  uint32_t dynamicBufferMask = 0;
+
   // the last seen VkDescriptorSetLayout from VulkanContext::dslBindless_
   mutable VkDescriptorSetLayout lastBindlessVkDescriptorSetLayout = VK_NULL_HANDLE;
 
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/Readback.h>
+
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::vulkan {
+
+Readback::Readback(VulkanContext& ctx,
+                   VulkanImmediateCommands::SubmitHandle handle,
+                   std::shared_ptr<const VulkanBuffer> buffer,
+                   VkDeviceSize offset,
+                   size_t size,
+                   uint32_t bytesPerRow) :
+  ctx_(ctx),
+  handle_(handle),
+  buffer_(std::move(buffer)),
+  offset_(offset),
+  size_(size),
+  bytesPerRow_(bytesPerRow) {
+  IGL_DEBUG_ASSERT(buffer_ && buffer_->isMapped());
+  IGL_DEBUG_ASSERT(offset_ + size_ <= buffer_->getSize());
+}
+
+// a buffer still in use by the GPU is destroyed by VulkanBuffer via a deferred task
+Readback::~Readback() = default;
+
+bool Readback::isReady() const {
+  if (isCompleted_) {
+    return true;
+  }
+
+  if (!ctx_.immediate_->isReady(handle_)) {
+    return false;
+  }
+
+  // make the GPU writes visible to the host before anyone reads the data
+  buffer_->invalidateMappedMemory(offset_, VK_WHOLE_SIZE);
+  isCompleted_ = true;
+
+  return true;
+}
+
+void Readback::wait() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_WAIT);
+
+  ctx_.immediate_->wait(handle_, ctx_.config_.fenceTimeoutNanoseconds);
+
+  processCompletion();
+}
+
+const void* IGL_NULLABLE Readback::data() const {
+  return isReady() ? buffer_->getMappedPtr() + offset_ : nullptr;
+}
+
+void Readback::setCompletionHandler(CompletionHandler handler) {
+  handler_ = std::move(handler);
+
+  processCompletion();
+}
+
+VkBuffer Readback::getVkBuffer() const {
+  return buffer_->getVkBuffer();
+}
+
+bool Readback::processCompletion() {
+  if (!isReady()) {
+    return false;
+  }
+
+  if (handler_) {
+    // the handler is invoked only once
+    const CompletionHandler handler = std::move(handler_);
+    handler_ = nullptr;
+    handler(*this);
+  }
+
+  return true;
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <igl/Readback.h>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+class VulkanBuffer;
+class VulkanContext;
+
+/// @brief Implements the igl::IReadback interface for Vulkan. The data is copied by the GPU into a
+/// persistently mapped host-visible buffer, either the buffer of VulkanReadbackRing or a dedicated
+/// buffer, and is accessed in place without any extra CPU copies. The buffer is shared with the
+/// ring, so it stays valid as long as this object. Like every other resource, a Readback has to be
+/// released before the device which created it; VulkanReadbackRing asserts this on destruction.
+class Readback final : public IReadback {
+ public:
+  Readback(VulkanContext& ctx,
+           VulkanImmediateCommands::SubmitHandle handle,
+           std::shared_ptr<const VulkanBuffer> buffer,
+           VkDeviceSize offset,
+           size_t size,
+           uint32_t bytesPerRow);
+  ~Readback() override;
+
+  Readback(const Readback&) = delete;
+  Readback& operator=(const Readback&) = delete;
+
+  [[nodiscard]] bool isReady() const override;
+  void wait() override;
+  [[nodiscard]] const void* IGL_NULLABLE data() const override;
+  [[nodiscard]] size_t size() const override {
+    return size_;
+  }
+  [[nodiscard]] uint32_t bytesPerRow() const override {
+    return bytesPerRow_;
+  }
+  void setCompletionHandler(CompletionHandler handler) override;
+
+  /// @brief The buffer the GPU copies the data into
+  [[nodiscard]] VkBuffer getVkBuffer() const;
+  /// @brief The offset within getVkBuffer() the GPU copies the data to
+  [[nodiscard]] VkDeviceSize getOffset() const {
+    return offset_;
+  }
+  [[nodiscard]] VulkanImmediateCommands::SubmitHandle getSubmitHandle() const {
+    return handle_;
+  }
+
+  /// @brief Invokes the completion handler if the copy has finished and the handler has not been
+  /// invoked yet. Returns true if the copy has finished.
+  bool processCompletion();
+
+ private:
+  VulkanContext& ctx_;
+  const VulkanImmediateCommands::SubmitHandle handle_;
+  const std::shared_ptr<const VulkanBuffer> buffer_;
+  const VkDeviceSize offset_;
+  const size_t size_;
+  const uint32_t bytesPerRow_;
+
+  CompletionHandler handler_;
+  // set once the GPU has finished the copy and the mapped memory has been invalidated
+  mutable bool isCompleted_ = false;
+};
+
+} // namespace igl::vulkan
@@ -15,9 +15,11 @@
 #include <igl/vulkan/CommandBuffer.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/Framebuffer.h>
+#include <igl/vulkan/ParallelRenderCommandEncoder.h>
 #include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/SamplerState.h>
 #include <igl/vulkan/Texture.h>
+#include <igl/vulkan/VulkanBarrierBatch.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanImage.h>
 #include <igl/vulkan/VulkanRenderPassBuilder.h>
@@ -70,6 +72,18 @@ RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>&
   IGL_DEBUG_ASSERT(cmdBuffer_ != VK_NULL_HANDLE);
 }
 
+RenderCommandEncoder::RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                                           VulkanContext& ctx,
+                                           VkCommandBuffer cmdBuffer) :
+  IRenderCommandEncoder::IRenderCommandEncoder(commandBuffer),
+  ctx_(ctx),
+  cmdBuffer_(cmdBuffer),
+  isSecondary_(true),
+  binder_(cmdBuffer, commandBuffer->getNextSubmitHandle(), ctx, VK_PIPELINE_BIND_POINT_GRAPHICS) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(cmdBuffer_ != VK_NULL_HANDLE);
+}
+
 void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
                                       const std::shared_ptr<IFramebuffer>& framebuffer,
                                       const Dependencies& dependencies,
@@ -104,6 +118,15 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
 
   VulkanRenderPassBuilder builder;
 
+  // with dynamic rendering, no VkRenderPass and VkFramebuffer objects are needed
+  isDynamicRendering_ = ctx_.useDynamicRendering();
+
+  std::array<VkRenderingAttachmentInfo, IGL_COLOR_ATTACHMENTS_MAX> colorAttachmentInfos{};
+  uint32_t numColorAttachments = 0;
+  VkRenderingAttachmentInfo depthAttachmentInfo{};
+  VkRenderingAttachmentInfo stencilAttachmentInfo{};
+  bool hasStencilAttachment = false;
+
   if (desc.mode != FramebufferMode::Mono) {
     if (desc.mode == FramebufferMode::Stereo) {
       builder.setMultiviewMasks(0x00000003, 0x00000003);
@@ -111,6 +134,7 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
       IGL_DEBUG_ABORT("FramebufferMode::Multiview is not implemented.");
     }
   }
+  dynamicState_.viewMask = desc.mode == FramebufferMode::Stereo ? 0x3 : 0;
 
   for (size_t i = 0; i != IGL_COLOR_ATTACHMENTS_MAX; i++) {
     const auto& attachment = desc.colorAttachments[i];
@@ -149,8 +173,37 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
     }
     mipLevel = descColor.mipLevel;
     layer = colorLayer;
+    if (isDynamicRendering_) {
+      inheritance_.colorFormats[numColorAttachments] =
+          textureFormatToVkFormat(colorTexture.getFormat());
+      inheritance_.samples = colorTexture.getVulkanTexture().image.samples_;
+      VkRenderingAttachmentInfo& info = colorAttachmentInfos[numColorAttachments++];
+      info = VkRenderingAttachmentInfo{
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = colorTexture.getVkImageViewForFramebuffer(mipLevel, layer, desc.mode),
+          .imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+          .resolveMode = VK_RESOLVE_MODE_NONE,
+          .loadOp = loadActionToVkAttachmentLoadOp(descColor.loadAction),
+          .storeOp = storeActionToVkAttachmentStoreOp(descColor.storeAction),
+          .clearValue = clearValues[numClearValues - 1],
+      };
+      if (descColor.storeAction == StoreAction::MsaaResolve) {
+        IGL_DEBUG_ASSERT(attachment.resolveTexture,
+                         "Framebuffer attachment should contain a resolve texture");
+        const auto& colorResolveTexture = static_cast<Texture&>(*attachment.resolveTexture);
+        // integer formats cannot be averaged
+        info.resolveMode = colorTexture.getProperties().isInteger()
+                               ? VK_RESOLVE_MODE_SAMPLE_ZERO_BIT
+                               : VK_RESOLVE_MODE_AVERAGE_BIT;
+        info.resolveImageView =
+            colorResolveTexture.getVkImageViewForFramebuffer(0, layer, desc.mode);
+        info.resolveImageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+      }
+      continue;
+    }
+    const VulkanImage& colorImage = colorTexture.getVulkanTexture().image;
     const auto initialLayout = descColor.loadAction == igl::LoadAction::Load
-                                   ? colorTexture.getVulkanTexture().image.imageLayout_
+                                   ? colorImage.getLayout(mipLevel, layer)
                                    : VK_IMAGE_LAYOUT_UNDEFINED;
     builder.addColor(textureFormatToVkFormat(colorTexture.getFormat()),
                      loadActionToVkAttachmentLoadOp(descColor.loadAction),
@@ -191,8 +244,53 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
                                                      .depth = descDepth.clearDepth,
                                                      .stencil = descStencil.clearStencil,
                                                  }};
+    if (isDynamicRendering_) {
+      const igl::vulkan::VulkanImage& img = depthTexture.getVulkanTexture().image;
+      const VkImageView imageView =
+          depthTexture.getVkImageViewForFramebuffer(mipLevel, layer, desc.mode);
+      depthAttachmentInfo = VkRenderingAttachmentInfo{
+          .sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO,
+          .imageView = img.isDepthFormat_ ? imageView : VK_NULL_HANDLE,
+          .imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+          .resolveMode = VK_RESOLVE_MODE_NONE,
+          .loadOp = loadActionToVkAttachmentLoadOp(descDepth.loadAction),
+          .storeOp = storeActionToVkAttachmentStoreOp(descDepth.storeAction),
+          .clearValue = clearValues[numClearValues - 1],
+      };
+      stencilAttachmentInfo = depthAttachmentInfo;
+      stencilAttachmentInfo.imageView = img.isStencilFormat_ ? imageView : VK_NULL_HANDLE;
+      stencilAttachmentInfo.loadOp = loadActionToVkAttachmentLoadOp(descStencil.loadAction);
+      stencilAttachmentInfo.storeOp = storeActionToVkAttachmentStoreOp(descStencil.storeAction);
+      hasStencilAttachment = img.isStencilFormat_;
+      inheritance_.depthFormat =
+          img.isDepthFormat_ ? depthTexture.getVkFormat() : VK_FORMAT_UNDEFINED;
+      inheritance_.stencilFormat =
+          img.isStencilFormat_ ? depthTexture.getVkFormat() : VK_FORMAT_UNDEFINED;
+      inheritance_.samples = img.samples_;
+      if (descDepth.storeAction == StoreAction::MsaaResolve) {
+        IGL_DEBUG_ASSERT(framebuffer->getResolveDepthAttachment(),
+                         "Framebuffer attachment should contain a resolve depth texture");
+        const auto& depthResolveTexture =
+            static_cast<Texture&>(*framebuffer->getResolveDepthAttachment());
+        depthAttachmentInfo.resolveMode = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT;
+        depthAttachmentInfo.resolveImageView =
+            depthResolveTexture.getVkImageViewForFramebuffer(mipLevel, layer, desc.mode);
+        depthAttachmentInfo.resolveImageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        if (hasStencilAttachment) {
+          stencilAttachmentInfo.resolveMode = VK_RESOLVE_MODE_SAMPLE_ZERO_BIT;
+          stencilAttachmentInfo.resolveImageView = depthAttachmentInfo.resolveImageView;
+          stencilAttachmentInfo.resolveImageLayout =
+              VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        }
+      }
+    }
+  }
+
+  if (framebuffer->getDepthAttachment() && !isDynamicRendering_) {
+    const auto& depthTexture = static_cast<Texture&>(*(framebuffer->getDepthAttachment()));
+    const VulkanImage& depthImage = depthTexture.getVulkanTexture().image;
     const auto initialLayout = descDepth.loadAction == igl::LoadAction::Load
-                                   ? depthTexture.getVulkanTexture().image.imageLayout_
+                                   ? depthImage.getLayout(mipLevel, layer)
                                    : VK_IMAGE_LAYOUT_UNDEFINED;
     builder.addDepthStencil(depthTexture.getVkFormat(),
                             loadActionToVkAttachmentLoadOp(descDepth.loadAction),
@@ -225,13 +323,21 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
 
   const auto& fb = static_cast<Framebuffer&>(*framebuffer);
 
-  const auto renderPassHandle = ctx_.findRenderPass(builder);
+  VkRenderPassBeginInfo bi = {};
 
-  dynamicState_.renderPassIndex = renderPassHandle.index;
-  dynamicState_.depthBiasEnable = false;
+  if (!isDynamicRendering_) {
+    const auto renderPassHandle = ctx_.findRenderPass(builder);
 
-  const VkRenderPassBeginInfo bi = fb.getRenderPassBeginInfo(
-      renderPassHandle.pass, mipLevel, layer, numClearValues, clearValues.data());
+    dynamicState_.renderPassIndex = renderPassHandle.index;
+
+    bi = fb.getRenderPassBeginInfo(
+        renderPassHandle.pass, mipLevel, layer, numClearValues, clearValues.data());
+
+    inheritance_.renderPass = renderPassHandle.pass;
+    inheritance_.framebuffer = bi.framebuffer;
+  }
+  inheritance_.numColorFormats = numColorAttachments;
+  dynamicState_.depthBiasEnable = false;
 
   const uint32_t width = std::max(fb.getWidth() >> mipLevel, 1u);
   const uint32_t height = std::max(fb.getHeight() >> mipLevel, 1u);
@@ -246,6 +352,9 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
   bindViewport(viewport);
   bindScissorRect(scissor);
 
+  inheritance_.viewport = viewport;
+  inheritance_.scissor = scissor;
+
   const VkResult vkResult = ctx_.checkAndUpdateDescriptorSets();
   if (vkResult != VK_SUCCESS) {
     IGL_LOG_ERROR("checkAndUpdateDescriptorSets returned a non-successful result: %d", vkResult);
@@ -253,7 +362,29 @@ void RenderCommandEncoder::initialize(const RenderPassDesc& renderPass,
     return;
   }
 
-  ctx_.vf_.vkCmdBeginRenderPass(cmdBuffer_, &bi, VK_SUBPASS_CONTENTS_INLINE);
+  if (isDynamicRendering_) {
+    const VkRenderingInfo renderingInfo = {
+        .sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
+        .flags = hasSecondaryContents_
+                     ? static_cast<VkRenderingFlags>(
+                           VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT)
+                     : 0u,
+        .renderArea = {.offset = {0, 0}, .extent = {.width = width, .height = height}},
+        .layerCount = 1,
+        .viewMask = dynamicState_.viewMask,
+        .colorAttachmentCount = numColorAttachments,
+        .pColorAttachments = colorAttachmentInfos.data(),
+        .pDepthAttachment = depthAttachmentInfo.imageView ? &depthAttachmentInfo : nullptr,
+        .pStencilAttachment = hasStencilAttachment ? &stencilAttachmentInfo : nullptr,
+    };
+    ctx_.vf_.vkCmdBeginRendering(cmdBuffer_, &renderingInfo);
+  } else {
+    ctx_.vf_.vkCmdBeginRenderPass(cmdBuffer_,
+                                  &bi,
+                                  hasSecondaryContents_
+                                      ? VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+                                      : VK_SUBPASS_CONTENTS_INLINE);
+  }
 
   isEncoding_ = true;
 
@@ -279,10 +410,73 @@ std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::create(
   return ret.isOk() ? std::move(encoder) : nullptr;
 }
 
-void RenderCommandEncoder::endEncoding() {
+std::unique_ptr<RenderCommandEncoder> RenderCommandEncoder::createSecondary(
+    const RenderCommandEncoder& primary,
+    ParallelRenderCommandEncoder* parallelEncoder) {
   IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(primary.hasSecondaryContents_ && primary.isEncoding_);
 
-  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
+  VulkanContext& ctx = primary.ctx_;
+  const auto commandBuffer = std::static_pointer_cast<CommandBuffer>(primary.getCommandBufferPtr());
+
+  const VkCommandBuffer cmdBuf =
+      ctx.threadCommandPools_->acquireSecondary(commandBuffer->getNextSubmitHandle());
+
+  // stays a recording thread until the encoder ends
+  ctx.beginRecordingThread();
+
+  // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
+  std::unique_ptr<RenderCommandEncoder> encoder(
+      new RenderCommandEncoder(commandBuffer, ctx, cmdBuf));
+  encoder->parallelEncoder_ = parallelEncoder;
+  encoder->beginSecondary(primary);
+
+  return encoder;
+}
+
+void RenderCommandEncoder::beginSecondary(const RenderCommandEncoder& primary) {
+  IGL_PROFILER_FUNCTION();
+
+  const SecondaryInheritance& inheritance = primary.inheritance_;
+
+  isDynamicRendering_ = primary.isDynamicRendering_;
+  hasDepthAttachment_ = primary.hasDepthAttachment_;
+  framebuffer_ = primary.framebuffer_;
+  dynamicState_ = primary.dynamicState_;
+
+  const VkCommandBufferInheritanceRenderingInfo renderingInfo = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+      .viewMask = dynamicState_.viewMask,
+      .colorAttachmentCount = inheritance.numColorFormats,
+      .pColorAttachmentFormats = inheritance.colorFormats.data(),
+      .depthAttachmentFormat = inheritance.depthFormat,
+      .stencilAttachmentFormat = inheritance.stencilFormat,
+      .rasterizationSamples = inheritance.samples,
+  };
+  const VkCommandBufferInheritanceInfo inheritanceInfo = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+      .pNext = isDynamicRendering_ ? &renderingInfo : nullptr,
+      .renderPass = inheritance.renderPass,
+      .subpass = 0,
+      .framebuffer = inheritance.framebuffer,
+  };
+  const VkCommandBufferBeginInfo bi = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+               VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+      .pInheritanceInfo = &inheritanceInfo,
+  };
+  VK_ASSERT(ctx_.vf_.vkBeginCommandBuffer(cmdBuffer_, &bi));
+
+  // no dynamic state is inherited from the primary command buffer
+  bindViewport(inheritance.viewport);
+  bindScissorRect(inheritance.scissor);
+
+  isEncoding_ = true;
+}
+
+void RenderCommandEncoder::endEncoding() {
+  IGL_PROFILER_FUNCTION();
 
   if (!isEncoding_) {
     return;
@@ -290,7 +484,23 @@ void RenderCommandEncoder::endEncoding() {
 
   isEncoding_ = false;
 
-  ctx_.vf_.vkCmdEndRenderPass(cmdBuffer_);
+  if (isSecondary_) {
+    IGL_ENSURE_VULKAN_RECORDING_THREAD(&ctx_);
+    VK_ASSERT(ctx_.vf_.vkEndCommandBuffer(cmdBuffer_));
+    ctx_.endRecordingThread();
+    parallelEncoder_->endSecondary();
+    return;
+  }
+
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
+
+  if (isDynamicRendering_) {
+    ctx_.vf_.vkCmdEndRendering(cmdBuffer_);
+  } else {
+    ctx_.vf_.vkCmdEndRenderPass(cmdBuffer_);
+  }
+
+  VulkanBarrierBatch batch(ctx_, cmdBuffer_);
 
   for (ITexture* IGL_NULLABLE tex : dependencies_.textures) {
     // TODO: at some point we might want to know in which layout a dependent texture wants to be. We
@@ -308,38 +518,33 @@ void RenderCommandEncoder::endEncoding() {
       // (TextureDesc::TextureUsageBits::Attachment), don't transition it to a depth/stencil
       // attchment
       if (img.usageFlags_ & VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT) {
-        transitionToDepthStencilAttachment(cmdBuffer_, tex);
+        transitionToDepthStencilAttachment(batch, tex, kAllSubresources);
       }
     } else {
       // If the texture has not been marked as a color attachment
       // (TextureDesc::TextureUsageBits::Attachment), don't transition it to a color attchment
       if (img.usageFlags_ & VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT) {
-        transitionToColorAttachment(cmdBuffer_, tex);
+        transitionToColorAttachment(batch, tex, kAllSubresources);
       }
     }
   }
   dependencies_ = {};
 
-  // set image layouts after the render pass
+  // The final layouts of the render pass are always VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL and
+  // VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL (check VulkanRenderPassBuilder.cpp). They
+  // match the layouts CommandBuffer::createRenderCommandEncoder() has transitioned the rendered
+  // subresources of all attachments to.
   const FramebufferDesc& desc = static_cast<const Framebuffer&>((*framebuffer_)).getDesc();
 
   for (const auto& attachment : desc.colorAttachments) {
-    // the image layouts of color attachments must match the final layout of the render pass, which
-    // is always VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL (check VulkanRenderPassBuilder.cpp)
-    overrideImageLayout(attachment.texture.get(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-    overrideImageLayout(attachment.resolveTexture.get(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
-    transitionToShaderReadOnly(cmdBuffer_, attachment.texture.get());
-    transitionToShaderReadOnly(cmdBuffer_, attachment.resolveTexture.get());
+    transitionToShaderReadOnly(batch, attachment.texture.get());
+    transitionToShaderReadOnly(batch, attachment.resolveTexture.get());
   }
 
-  // this must match the final layout of the render pass, which is always
-  // VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL (check VulkanRenderPassBuilder.cpp)
-  overrideImageLayout(desc.depthAttachment.texture.get(),
-                      VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-  overrideImageLayout(desc.depthAttachment.resolveTexture.get(),
-                      VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
-  transitionToShaderReadOnly(cmdBuffer_, desc.depthAttachment.texture.get());
-  transitionToShaderReadOnly(cmdBuffer_, desc.depthAttachment.resolveTexture.get());
+  transitionToShaderReadOnly(batch, desc.depthAttachment.texture.get());
+  transitionToShaderReadOnly(batch, desc.depthAttachment.resolveTexture.get());
+
+  batch.flush();
 
 #if defined(IGL_WITH_TRACY_GPU)
   TracyVkCollect(ctx_.tracyCtx_, cmdBuffer_);
@@ -424,6 +629,10 @@ void RenderCommandEncoder::bindRenderPipelineState(
   applyPipelineRasterizationDynamicState();
 }
 
+bool RenderCommandEncoder::isPipelineReady(const IRenderPipelineState& pipelineState) const {
+  return static_cast<const RenderPipelineState&>(pipelineState).isPipelineReady(dynamicState_);
+}
+
 void RenderCommandEncoder::applyPipelineRasterizationDynamicState() {
   IGL_PROFILER_FUNCTION();
 
@@ -586,11 +795,20 @@ void RenderCommandEncoder::bindIndexBuffer(IBuffer& buffer,
   ctx_.vf_.vkCmdBindIndexBuffer(cmdBuffer_, buf.getVkBuffer(), bufferOffset, type);
 }
 
-void RenderCommandEncoder::bindBytes(size_t /*index*/,
+void RenderCommandEncoder::bindBytes(size_t index,
                                      uint8_t /*target*/,
-                                     const void* /*data*/,
-                                     size_t /*length*/) {
-  IGL_DEBUG_ASSERT_NOT_IMPLEMENTED();
+                                     const void* data,
+                                     size_t length) {
+  IGL_PROFILER_FUNCTION();
+
+#if IGL_VULKAN_PRINT_COMMANDS
+  IGL_LOG_INFO("%p  bindBytes(%u, %u)\n",
+               cmdBuffer_,
+               static_cast<uint32_t>(index),
+               static_cast<uint32_t>(length));
+#endif // IGL_VULKAN_PRINT_COMMANDS
+
+  binder_.bindBytes(static_cast<uint32_t>(index), data, length);
 }
 
 void RenderCommandEncoder::bindPushConstants(const void* data, size_t length, size_t offset) {
@@ -966,17 +1184,24 @@ void RenderCommandEncoder::flushDynamicState() {
       return;
     }
 
+    if (rps_->usePushDescriptors) {
+      // the pipeline layout has a push descriptor set for buffers, which cannot be bound
+      IGL_DEBUG_ASSERT(numDynamicOffsets_ == 0);
+      ctx_.updateBindingsBuffersByPushDescriptors(
+          cmdBuffer_, layout, bindPoint, pendingBindGroupBuffer_, *rps_);
+    } else {
 #if IGL_VULKAN_PRINT_COMMANDS
-    IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - buffers bind group\n", cmdBuffer_);
+      IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - buffers bind group\n", cmdBuffer_);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    ctx_.vf_.vkCmdBindDescriptorSets(cmdBuffer_,
-                                     bindPoint,
-                                     layout,
-                                     kBindPoint_Buffers,
-                                     1,
-                                     &dset,
-                                     numDynamicOffsets_,
-                                     dynamicOffsets_);
+      ctx_.vf_.vkCmdBindDescriptorSets(cmdBuffer_,
+                                       bindPoint,
+                                       layout,
+                                       kBindPoint_Buffers,
+                                       1,
+                                       &dset,
+                                       numDynamicOffsets_,
+                                       dynamicOffsets_);
+    }
     // This is necessary to support a mix of BindGroups and bindBuffer() calls in the same command
     // encoder.
     binder_.isDirtyFlags_ &= ~igl::vulkan::ResourcesBinder::DirtyFlagBits_Buffers;
@@ -1124,11 +1349,11 @@ void RenderCommandEncoder::blitColorImage(const igl::vulkan::VulkanImage& srcIma
                              VK_PIPELINE_STAGE_TRANSFER_BIT,
                              VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
                              destSubresourceRange);
-
-  destImage.imageLayout_ = targetLayout;
 }
 
 void RenderCommandEncoder::processDependencies(const Dependencies& dependencies) {
+  VulkanBarrierBatch batch(ctx_, cmdBuffer_);
+
   // 1. Process all textures
   {
     const Dependencies* deps = &dependencies;
@@ -1138,7 +1363,7 @@ void RenderCommandEncoder::processDependencies(const Dependencies& dependencies)
         if (!tex) {
           break;
         }
-        transitionToShaderReadOnly(cmdBuffer_, tex);
+        transitionToShaderReadOnly(batch, tex);
       }
       deps = deps->next;
     }
@@ -1169,16 +1394,14 @@ void RenderCommandEncoder::processDependencies(const Dependencies& dependencies)
             (deps->hostWriteBufferMask & (uint32_t{1} << index)) != 0
                 ? VK_PIPELINE_STAGE_HOST_BIT
                 : VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-        ivkBufferBarrier(&ctx_.vf_,
-                         cmdBuffer_,
-                         vkBuf->getVkBuffer(),
-                         vkBuf->getBufferUsageFlags(),
-                         srcStageFlags,
-                         dstStageFlags);
+        batch.bufferBarrier(
+            vkBuf->getVkBuffer(), vkBuf->getBufferUsageFlags(), srcStageFlags, dstStageFlags);
       }
       deps = deps->next;
     }
   }
+
+  batch.flush();
 }
 
 void RenderCommandEncoder::bindBindGroup(BindGroupTextureHandle handle) {
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <array>
 #include <igl/Buffer.h>
 #include <igl/CommandEncoder.h>
 #include <igl/Common.h>
@@ -20,6 +21,8 @@
 
 namespace igl::vulkan {
 
+class ParallelRenderCommandEncoder;
+
 /// @brief This class implements the igl::IRenderCommandEncoder interface for Vulkan
 class RenderCommandEncoder : public IRenderCommandEncoder {
  public:
@@ -43,7 +46,8 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
 
   /// @brief Ends encoding for render commands and transitions the layouts of all images bound to
   /// this encoder back to `VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL`. Also transitions all
-  /// dependent textures to `VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL`
+  /// dependent textures to `VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL`. Encoders created by a
+  /// ParallelRenderCommandEncoder only end their secondary command buffer here.
   void endEncoding() override;
 
   void pushDebugGroupLabel(const char* label, const igl::Color& color) const override;
@@ -125,6 +129,17 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
     return binder_;
   }
 
+  /// @brief Returns the mutable pipeline parameters (render pass, depth-stencil state) of this
+  /// encoder. Can be recorded and passed to `RenderPipelineState::precompile()` later.
+  [[nodiscard]] const RenderPipelineDynamicState& getDynamicState() const {
+    return dynamicState_;
+  }
+
+  /// @brief Returns true if a draw call with `pipelineState` bound to this encoder in its current
+  /// state would neither compile a Vulkan pipeline nor wait for a compilation started by
+  /// `RenderPipelineState::precompile()`. Can be used to pick a fallback pipeline instead.
+  [[nodiscard]] bool isPipelineReady(const IRenderPipelineState& pipelineState) const;
+
   /// @brief Enables or disables the draw call count. If enabled, it will increment the draw call,
   /// otherwise it won't. This is used to disable the draw call count when we are doing auxiliary
   /// draw calls.
@@ -136,7 +151,35 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
                       const igl::TextureRangeDesc& destRange);
 
  private:
+  friend class ParallelRenderCommandEncoder;
+
+  /// @brief Everything a secondary command buffer has to know about the render pass of the
+  /// primary command buffer which executes it
+  struct SecondaryInheritance {
+    VkRenderPass renderPass = VK_NULL_HANDLE;
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+    std::array<VkFormat, IGL_COLOR_ATTACHMENTS_MAX> colorFormats = {};
+    uint32_t numColorFormats = 0;
+    VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+    VkFormat stencilFormat = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits samples = VK_SAMPLE_COUNT_1_BIT;
+    Viewport viewport = {};
+    ScissorRect scissor = {};
+  };
+
   RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer, VulkanContext& ctx);
+  /// @brief Constructs an encoder which records into the secondary command buffer `cmdBuffer`
+  RenderCommandEncoder(const std::shared_ptr<CommandBuffer>& commandBuffer,
+                       VulkanContext& ctx,
+                       VkCommandBuffer cmdBuffer);
+
+  /// @brief Creates an encoder which continues the render pass of `primary` in a secondary command
+  /// buffer from the calling thread's command pool. `primary` has to be created by a
+  /// ParallelRenderCommandEncoder.
+  static std::unique_ptr<RenderCommandEncoder> createSecondary(
+      const RenderCommandEncoder& primary,
+      ParallelRenderCommandEncoder* parallelEncoder);
+  void beginSecondary(const RenderCommandEncoder& primary);
 
   void applyPipelineRasterizationDynamicState();
 
@@ -157,7 +200,13 @@ class RenderCommandEncoder : public IRenderCommandEncoder {
   VkCommandBuffer cmdBuffer_ = VK_NULL_HANDLE;
   bool isEncoding_ = false;
   bool hasDepthAttachment_ = false;
+  bool isDynamicRendering_ = false; // vkCmdBeginRendering() instead of vkCmdBeginRenderPass()
+  // the render pass is recorded in secondary command buffers by a ParallelRenderCommandEncoder
+  bool hasSecondaryContents_ = false;
+  bool isSecondary_ = false; // cmdBuffer_ is a secondary command buffer
   std::shared_ptr<IFramebuffer> framebuffer_;
+  SecondaryInheritance inheritance_;
+  ParallelRenderCommandEncoder* parallelEncoder_ = nullptr; // set for secondary encoders only
 
   ResourcesBinder binder_;
 
@@ -7,6 +7,9 @@
 
 #include <igl/vulkan/RenderPipelineState.h>
 
+#include <chrono>
+
+#include <igl/ThreadPool.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/Device.h>
 #include <igl/vulkan/ShaderModule.h>
@@ -16,6 +19,50 @@
 
 namespace igl::vulkan {
 
+namespace {
+
+// the state subsets of a graphics pipeline, in the order of RenderPipelineState::pipelineLibraries_
+constexpr std::array<VkGraphicsPipelineLibraryFlagsEXT, 4> kPipelineLibraryParts = {
+    VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT,
+    VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT,
+    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT,
+    VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT,
+};
+
+VkPipelineCreateFlags getPipelineCreateFlags(const VulkanContext& ctx) {
+  return ctx.features().has_VK_EXT_descriptor_buffer ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
+                                                     : VkPipelineCreateFlags{};
+}
+
+/// Keeps only the fields of `cacheKey` which are baked into the state subset `part`
+RenderPipelineDynamicState getPipelineLibraryKey(const RenderPipelineDynamicState& cacheKey,
+                                                 VkGraphicsPipelineLibraryFlagsEXT part) {
+  RenderPipelineDynamicState key;
+  switch (part) {
+  case VK_GRAPHICS_PIPELINE_LIBRARY_VERTEX_INPUT_INTERFACE_BIT_EXT:
+    // everything comes from RenderPipelineDesc
+    break;
+  case VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT:
+    key.depthBiasEnable = cacheKey.depthBiasEnable;
+    key.viewMask = cacheKey.viewMask;
+    break;
+  case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT:
+    // depth and stencil state
+    key = cacheKey;
+    key.depthBiasEnable = 0;
+    break;
+  case VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_OUTPUT_INTERFACE_BIT_EXT:
+    key.viewMask = cacheKey.viewMask;
+    break;
+  default:
+    IGL_DEBUG_ASSERT_NOT_REACHED();
+    break;
+  }
+  return key;
+}
+
+} // namespace
+
 VkPrimitiveTopology primitiveTypeToVkPrimitiveTopology(PrimitiveType t) {
   switch (t) {
   case igl::PrimitiveType::Point:
@@ -345,6 +392,16 @@ void RenderPipelineState::deferDestroyPipelinesAndLayout(const VulkanContext& ct
       }));
     }
   }
+  for (auto& libraries : pipelineLibraries_) {
+    for (const auto& p : libraries) {
+      if (p.second != VK_NULL_HANDLE) {
+        ctx.deferredTask(std::packaged_task<void()>([vf = &ctx.vf_, device, library = p.second]() {
+          vf->vkDestroyPipeline(device, library, nullptr);
+        }));
+      }
+    }
+    libraries.clear();
+  }
   if (pipelineLayout) {
     ctx.deferredTask(std::packaged_task<void()>([vf = &ctx.vf_, device, layout = pipelineLayout]() {
       vf->vkDestroyPipelineLayout(device, layout, nullptr);
@@ -352,30 +409,57 @@ void RenderPipelineState::deferDestroyPipelinesAndLayout(const VulkanContext& ct
   }
 }
 
+void RenderPipelineState::deferDestroyPendingPipelines(const VulkanContext& ctx) const {
+  const VkDevice device = ctx.getVkDevice();
+  for (auto& p : pendingPipelines_) {
+    // worker threads reference this object, so every compilation has to finish first
+    const VkPipeline pipeline = p.second.get();
+    if (pipeline != VK_NULL_HANDLE) {
+      ctx.deferredTask(std::packaged_task<void()>([vf = &ctx.vf_, device, pipeline]() {
+        vf->vkDestroyPipeline(device, pipeline, nullptr);
+      }));
+    }
+  }
+  pendingPipelines_.clear();
+  for (auto& p : optimizedPipelines_) {
+    const VkPipeline pipeline = p.second.get();
+    if (pipeline != VK_NULL_HANDLE) {
+      ctx.deferredTask(std::packaged_task<void()>([vf = &ctx.vf_, device, pipeline]() {
+        vf->vkDestroyPipeline(device, pipeline, nullptr);
+      }));
+    }
+  }
+  optimizedPipelines_.clear();
+}
+
 RenderPipelineState::~RenderPipelineState() {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_DESTROY);
 
-  deferDestroyPipelinesAndLayout(device_.getVulkanContext());
-}
-
-// NOLINTNEXTLINE(facebook-hte-NullableReturn)
-VkPipeline RenderPipelineState::getVkPipeline(
-    const RenderPipelineDynamicState& dynamicState) const {
   const VulkanContext& ctx = device_.getVulkanContext();
-  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx);
 
-  if (ctx.config_.enableDescriptorIndexing) {
-    // the bindless descriptor set layout can be changed in VulkanContext when the number of
-    // existing textures increases
-    if (lastBindlessVkDescriptorSetLayout != ctx.getBindlessVkDescriptorSetLayout()) {
-      // there's a new descriptor set layout - drop the previous Vulkan pipeline
-      deferDestroyPipelinesAndLayout(ctx);
-      pipelines_.clear();
-      pipelineLayout = VK_NULL_HANDLE;
-      lastBindlessVkDescriptorSetLayout = ctx.getBindlessVkDescriptorSetLayout();
-    }
+  deferDestroyPendingPipelines(ctx);
+  deferDestroyPipelinesAndLayout(ctx);
+}
+
+void RenderPipelineState::checkBindlessDescriptorSetLayout(const VulkanContext& ctx) const {
+  if (!ctx.config_.enableDescriptorIndexing) {
+    return;
   }
+  // the bindless descriptor set layout can be changed in VulkanContext when the number of
+  // existing textures increases
+  if (lastBindlessVkDescriptorSetLayout != ctx.getBindlessVkDescriptorSetLayout()) {
+    // there's a new descriptor set layout - drop the previous Vulkan pipeline
+    deferDestroyPendingPipelines(ctx);
+    deferDestroyPipelinesAndLayout(ctx);
+    pipelines_.clear();
+    pipelineLayout = VK_NULL_HANDLE;
+    lastBindlessVkDescriptorSetLayout = ctx.getBindlessVkDescriptorSetLayout();
+  }
+}
 
+RenderPipelineDynamicState RenderPipelineState::getCacheKey(
+    const VulkanContext& ctx,
+    const RenderPipelineDynamicState& dynamicState) const {
   const auto& vkFeatures = ctx.features();
   const bool isVulkan13 = ctx.getVkPhysicalDeviceProperties().apiVersion >= VK_API_VERSION_1_3;
   const bool useEDS = isVulkan13 || vkFeatures.has_VK_EXT_extended_dynamic_state;
@@ -405,57 +489,307 @@ VkPipeline RenderPipelineState::getVkPipeline(
   // and flags -- NOT on loadOp/storeOp/initialLayout/finalLayout.
   // This is safe because desc_.targetDesc already pins the format expectations
   // for this RenderPipelineState, so all render passes it encounters are compatible.
+  // With dynamic rendering, there are no render passes at all and the formats come from
+  // desc_.targetDesc. The view mask is the only per-pass state left and stays in the key.
   cacheKey.renderPassIndex = 0;
 
-  const auto it = pipelines_.find(cacheKey);
+  return cacheKey;
+}
+
+void RenderPipelineState::retirePendingPipeline(const RenderPipelineDynamicState& cacheKey,
+                                                bool wait) const {
+  const auto it = pendingPipelines_.find(cacheKey);
+
+  if (it == pendingPipelines_.end()) {
+    return;
+  }
+
+  if (!wait && it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+
+  pipelines_[cacheKey] = it->second.get();
+
+  pendingPipelines_.erase(it);
+}
+
+void RenderPipelineState::retireOptimizedPipeline(
+    const RenderPipelineDynamicState& cacheKey) const {
+  const auto it = optimizedPipelines_.find(cacheKey);
+
+  if (it == optimizedPipelines_.end() ||
+      it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return;
+  }
+
+  const VkPipeline optimizedPipeline = it->second.get();
+
+  optimizedPipelines_.erase(it);
+
+  if (optimizedPipeline == VK_NULL_HANDLE) {
+    // keep using the fast-linked pipeline
+    return;
+  }
+
+  // the fast-linked pipeline can still be used by command buffers in flight
+  const VulkanContext& ctx = device_.getVulkanContext();
+  VkPipeline& pipeline = pipelines_[cacheKey];
+  ctx.deferredTask(std::packaged_task<void()>(
+      [vf = &ctx.vf_, device = ctx.getVkDevice(), pipeline = pipeline]() {
+        vf->vkDestroyPipeline(device, pipeline, nullptr);
+      }));
+  pipeline = optimizedPipeline;
+}
+
+void RenderPipelineState::ensurePipelineLayout(const VulkanContext& ctx) const {
+  if (pipelineLayout) {
+    return;
+  }
+
+  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+  const VkDescriptorSetLayout dsls[] = {
+      dslCombinedImageSamplers->getVkDescriptorSetLayout(),
+      dslBuffers->getVkDescriptorSetLayout(),
+      dslStorageImages->getVkDescriptorSetLayout(),
+      ctx.getBindlessVkDescriptorSetLayout(),
+  };
+
+  const VkPipelineLayoutCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+      .setLayoutCount = static_cast<uint32_t>(ctx.config_.enableDescriptorIndexing
+                                                  ? IGL_ARRAY_NUM_ELEMENTS(dsls)
+                                                  : IGL_ARRAY_NUM_ELEMENTS(dsls) - 1u),
+      .pSetLayouts = dsls,
+      .pushConstantRangeCount = info.hasPushConstants ? 1u : 0u,
+      .pPushConstantRanges = info.hasPushConstants ? &pushConstantRange : nullptr,
+  };
+
+  const VkDevice device = ctx.getVkDevice();
+  VK_ASSERT(ctx.vf_.vkCreatePipelineLayout(device, &ci, nullptr, &pipelineLayout));
+  VK_ASSERT(
+      ivkSetDebugObjectName(&ctx.vf_,
+                            device,
+                            VK_OBJECT_TYPE_PIPELINE_LAYOUT,
+                            (uint64_t)pipelineLayout,
+                            IGL_FORMAT("Pipeline Layout: {}", desc_.debugName.c_str()).c_str()));
+}
+
+// NOLINTNEXTLINE(facebook-hte-NullableReturn)
+VkPipeline RenderPipelineState::getVkPipeline(
+    const RenderPipelineDynamicState& dynamicState) const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+  IGL_ENSURE_VULKAN_RECORDING_THREAD(&ctx);
+
+  const std::lock_guard<std::mutex> lock(pipelinesMutex_);
+
+  checkBindlessDescriptorSetLayout(ctx);
+
+  const RenderPipelineDynamicState cacheKey = getCacheKey(ctx, dynamicState);
+
+  auto it = pipelines_.find(cacheKey);
 
   if (it != pipelines_.end()) {
+    if (!optimizedPipelines_.empty()) {
+      retireOptimizedPipeline(cacheKey);
+    }
     return it->second;
   }
 
+  if (!pendingPipelines_.empty()) {
+    // waiting for an in-flight compilation is never slower than compiling the same pipeline again
+    retirePendingPipeline(cacheKey, true);
+    it = pipelines_.find(cacheKey);
+    if (it != pipelines_.end()) {
+      return it->second;
+    }
+  }
+
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
 
-  if (!pipelineLayout) {
-    // NOLINTNEXTLINE(modernize-avoid-c-arrays)
-    const VkDescriptorSetLayout dsls[] = {
-        dslCombinedImageSamplers->getVkDescriptorSetLayout(),
-        dslBuffers->getVkDescriptorSetLayout(),
-        dslStorageImages->getVkDescriptorSetLayout(),
-        ctx.getBindlessVkDescriptorSetLayout(),
-    };
-
-    const VkPipelineLayoutCreateInfo ci = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
-        .setLayoutCount = static_cast<uint32_t>(ctx.config_.enableDescriptorIndexing
-                                                    ? IGL_ARRAY_NUM_ELEMENTS(dsls)
-                                                    : IGL_ARRAY_NUM_ELEMENTS(dsls) - 1u),
-        .pSetLayouts = dsls,
-        .pushConstantRangeCount = info.hasPushConstants ? 1u : 0u,
-        .pPushConstantRanges = info.hasPushConstants ? &pushConstantRange : nullptr,
-    };
-
-    const VkDevice device = ctx.getVkDevice();
-    VK_ASSERT(ctx.vf_.vkCreatePipelineLayout(device, &ci, nullptr, &pipelineLayout));
-    VK_ASSERT(
-        ivkSetDebugObjectName(&ctx.vf_,
-                              device,
-                              VK_OBJECT_TYPE_PIPELINE_LAYOUT,
-                              (uint64_t)pipelineLayout,
-                              IGL_FORMAT("Pipeline Layout: {}", desc_.debugName.c_str()).c_str()));
+  ensurePipelineLayout(ctx);
+
+  // build a new Vulkan pipeline
+  const VkRenderPass renderPass = ctx.useDynamicRendering()
+                                      ? VK_NULL_HANDLE
+                                      : ctx.getRenderPass(dynamicState.renderPassIndex).pass;
+  // mesh shader pipelines have no vertex input state and are always built monolithically
+  const bool useLibraries = ctx.useGraphicsPipelineLibrary() &&
+                            desc_.shaderStages->getType() == igl::ShaderStagesType::Render;
+  const VkPipeline pipeline = useLibraries
+                                  ? linkVkPipeline(ctx, cacheKey, renderPass)
+                                  : createVkPipeline(ctx, cacheKey, pipelineLayout, renderPass);
+
+  pipelines_[cacheKey] = pipeline;
+
+  // @fb-only
+  // @lint-ignore CLANGTIDY
+  return pipeline;
+}
+
+uint32_t RenderPipelineState::precompile(
+    const std::vector<RenderPipelineDynamicState>& dynamicStates) const {
+  IGL_PROFILER_FUNCTION();
+
+  const VulkanContext& ctx = device_.getVulkanContext();
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx);
+
+  const std::lock_guard<std::mutex> lock(pipelinesMutex_);
+
+  checkBindlessDescriptorSetLayout(ctx);
+
+  // the layout is shared by all pipelines and has to exist before any worker can use it
+  ensurePipelineLayout(ctx);
+
+  uint32_t numScheduled = 0;
+
+  for (const RenderPipelineDynamicState& dynamicState : dynamicStates) {
+    const RenderPipelineDynamicState cacheKey = getCacheKey(ctx, dynamicState);
+
+    if (pipelines_.contains(cacheKey) || pendingPipelines_.contains(cacheKey)) {
+      continue;
+    }
+
+    // render passes are owned by the context and can only be looked up on the context thread
+    const VkRenderPass renderPass = ctx.useDynamicRendering()
+                                        ? VK_NULL_HANDLE
+                                        : ctx.getRenderPass(dynamicState.renderPassIndex).pass;
+
+    pendingPipelines_[cacheKey] = ctx.getPipelineCompilationThreadPool().submit(
+        [this, &ctx, cacheKey, layout = pipelineLayout, renderPass]() {
+          IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+          return createVkPipeline(ctx, cacheKey, layout, renderPass);
+        });
+    numScheduled++;
+  }
+
+  return numScheduled;
+}
+
+bool RenderPipelineState::isPipelineReady(const RenderPipelineDynamicState& dynamicState) const {
+  const VulkanContext& ctx = device_.getVulkanContext();
+  IGL_ENSURE_VULKAN_RECORDING_THREAD(&ctx);
+
+  const std::lock_guard<std::mutex> lock(pipelinesMutex_);
+
+  if (ctx.config_.enableDescriptorIndexing &&
+      lastBindlessVkDescriptorSetLayout != ctx.getBindlessVkDescriptorSetLayout()) {
+    // all pipelines will be recreated by the next getVkPipeline() call
+    return false;
+  }
+
+  const RenderPipelineDynamicState cacheKey = getCacheKey(ctx, dynamicState);
+
+  if (pipelines_.contains(cacheKey)) {
+    return true;
+  }
+
+  retirePendingPipeline(cacheKey, false);
+
+  return pipelines_.contains(cacheKey);
+}
+
+// NOLINTNEXTLINE(facebook-hte-NullableReturn)
+VkPipeline RenderPipelineState::getPipelineLibrary(const VulkanContext& ctx,
+                                                   const RenderPipelineDynamicState& cacheKey,
+                                                   size_t partIndex,
+                                                   VkRenderPass renderPass) const {
+  const VkGraphicsPipelineLibraryFlagsEXT part = kPipelineLibraryParts[partIndex];
+  const RenderPipelineDynamicState key = getPipelineLibraryKey(cacheKey, part);
+
+  auto& libraries = pipelineLibraries_[partIndex];
+
+  const auto it = libraries.find(key);
+
+  if (it != libraries.end()) {
+    return it->second;
+  }
+
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  const VkPipeline library = createVkPipeline(ctx, key, pipelineLayout, renderPass, part);
+
+  libraries[key] = library;
+
+  // @fb-only
+  // @lint-ignore CLANGTIDY
+  return library;
+}
+
+// NOLINTNEXTLINE(facebook-hte-NullableReturn)
+VkPipeline RenderPipelineState::linkVkPipeline(const VulkanContext& ctx,
+                                               const RenderPipelineDynamicState& cacheKey,
+                                               VkRenderPass renderPass) const {
+  std::vector<VkPipeline> libraries;
+  libraries.reserve(kPipelineLibraryParts.size());
+
+  for (size_t i = 0; i != kPipelineLibraryParts.size(); i++) {
+    const VkPipeline library = getPipelineLibrary(ctx, cacheKey, i, renderPass);
+    if (library == VK_NULL_HANDLE) {
+      return VK_NULL_HANDLE;
+    }
+    libraries.push_back(library);
   }
 
+  const VkPipelineCreateFlags flags = getPipelineCreateFlags(ctx);
+
+  VkPipeline pipeline = VK_NULL_HANDLE;
+
+  VK_ASSERT_RETURN_NULL_HANDLE(VulkanPipelineBuilder::link(ctx.vf_,
+                                                           ctx.getVkDevice(),
+                                                           flags,
+                                                           ctx.pipelineCache_,
+                                                           pipelineLayout,
+                                                           libraries,
+                                                           false,
+                                                           nullptr,
+                                                           &pipeline,
+                                                           desc_.debugName.c_str()));
+
+  // libraries are destroyed only after all optimized links have finished
+  optimizedPipelines_[cacheKey] = ctx.getPipelineCompilationThreadPool().submit(
+      [this, &ctx, libraries = std::move(libraries), layout = pipelineLayout, flags]()
+          -> VkPipeline {
+        IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+        VkPipelineCreationFeedback feedback = {};
+        VkPipeline optimizedPipeline = VK_NULL_HANDLE;
+        VK_ASSERT_RETURN_NULL_HANDLE(VulkanPipelineBuilder::link(
+            ctx.vf_,
+            ctx.getVkDevice(),
+            flags,
+            ctx.pipelineCache_,
+            layout,
+            libraries,
+            true,
+            ctx.hasPipelineCreationFeedback() ? &feedback : nullptr,
+            &optimizedPipeline,
+            desc_.debugName.c_str()));
+        ctx.recordPipelineCreationFeedback(feedback);
+        return optimizedPipeline;
+      });
+
+  // @fb-only
+  // @lint-ignore CLANGTIDY
+  return pipeline;
+}
+
+// NOLINTNEXTLINE(facebook-hte-NullableReturn)
+VkPipeline RenderPipelineState::createVkPipeline(
+    const VulkanContext& ctx,
+    const RenderPipelineDynamicState& cacheKey,
+    VkPipelineLayout layout,
+    VkRenderPass renderPass,
+    VkGraphicsPipelineLibraryFlagsEXT libraryParts) const {
+  const bool isVulkan13 = ctx.getVkPhysicalDeviceProperties().apiVersion >= VK_API_VERSION_1_3;
+  const bool useEDS = isVulkan13 || ctx.features().has_VK_EXT_extended_dynamic_state;
+  const bool useEDS2 = isVulkan13 || ctx.features().has_VK_EXT_extended_dynamic_state2;
+
   const auto& deviceFeatures = ctx.features();
   const VkBool32 dualSrcBlendSupported =
       deviceFeatures.vkPhysicalDeviceFeatures2.features.dualSrcBlend;
 
-  // build a new Vulkan pipeline
-  const VkRenderPass renderPass = ctx.getRenderPass(dynamicState.renderPassIndex).pass;
-
   VkPipeline pipeline = VK_NULL_HANDLE;
 
-  const VkPipelineCreateFlags flags = ctx.features().has_VK_EXT_descriptor_buffer
-                                          ? VK_PIPELINE_CREATE_DESCRIPTOR_BUFFER_BIT_EXT
-                                          : VkPipelineCreateFlags{};
+  const VkPipelineCreateFlags flags = getPipelineCreateFlags(ctx);
 
   // Not all attachments are valid. We need to create color blend attachments only for active
   // attachments
@@ -590,7 +924,7 @@ VkPipeline RenderPipelineState::getVkPipeline(
 
   // Cull mode and front face are not part of RenderPipelineDynamicState, so default them here when
   // they will be set dynamically at draw time. All depth/stencil/bias state is read directly from
-  // cacheKey, which already holds these defaults when EDS is active (see the normalization above)
+  // cacheKey, which already holds these defaults when EDS is active (see getCacheKey())
   // -- keeping a single source of truth for the baked static state.
   //
   // Primitive topology stays static and is always baked from desc_. Under
@@ -604,44 +938,84 @@ VkPipeline RenderPipelineState::getVkPipeline(
                                        : windingModeToVkFrontFace(desc_.frontFaceWinding);
   const VkPrimitiveTopology primitiveTopology = primitiveTypeToVkPrimitiveTopology(desc_.topology);
 
+  VkPipelineCreationFeedback feedback = {};
+
+  igl::vulkan::VulkanPipelineBuilder builder;
+
+  if (renderPass == VK_NULL_HANDLE) {
+    // attachments are compacted the same way as in RenderCommandEncoder::initialize()
+    std::vector<VkFormat> colorFormats;
+    colorFormats.reserve(desc_.targetDesc.colorAttachments.size());
+    for (const auto& attachment : desc_.targetDesc.colorAttachments) {
+      if (attachment.textureFormat != TextureFormat::Invalid) {
+        colorFormats.push_back(textureFormatToVkFormat(attachment.textureFormat));
+      }
+    }
+    // a combined depth-stencil texture is bound as both the depth and the stencil attachment
+    const TextureFormat depthStencilFormat =
+        desc_.targetDesc.depthAttachmentFormat != TextureFormat::Invalid
+            ? desc_.targetDesc.depthAttachmentFormat
+            : desc_.targetDesc.stencilAttachmentFormat;
+    const VkFormat format = depthStencilFormat != TextureFormat::Invalid
+                                ? ctx.getClosestDepthStencilFormat(depthStencilFormat)
+                                : VK_FORMAT_UNDEFINED;
+    builder.renderingFormats(colorFormats,
+                             hasDepth(format) ? format : VK_FORMAT_UNDEFINED,
+                             hasStencil(format) ? format : VK_FORMAT_UNDEFINED,
+                             cacheKey.viewMask);
+  }
+
+  builder.dynamicStates(dynamicStates)
+      .primitiveTopology(primitiveTopology)
+      .depthBiasEnable(cacheKey.depthBiasEnable)
+      .depthCompareOp(cacheKey.getDepthCompareOp(), static_cast<bool>(cacheKey.depthWriteEnable))
+      .depthWriteEnable(static_cast<bool>(cacheKey.depthWriteEnable))
+      .rasterizationSamples(getVulkanSampleCountFlags(desc_.sampleCount))
+      .alphaToCoverageEnable(desc_.alphaToCoverageEnabled)
+      .polygonMode(polygonFillModeToVkPolygonMode(desc_.polygonFillMode))
+      .stencilStateOps(VK_STENCIL_FACE_FRONT_BIT,
+                       cacheKey.getStencilStateFailOp(true),
+                       cacheKey.getStencilStatePassOp(true),
+                       cacheKey.getStencilStateDepthFailOp(true),
+                       cacheKey.getStencilStateCompareOp(true))
+      .stencilStateOps(VK_STENCIL_FACE_BACK_BIT,
+                       cacheKey.getStencilStateFailOp(false),
+                       cacheKey.getStencilStatePassOp(false),
+                       cacheKey.getStencilStateDepthFailOp(false),
+                       cacheKey.getStencilStateCompareOp(false))
+      .shaderStages(stages)
+      .cullMode(cullMode)
+      .frontFace(frontFace)
+      .vertexInputState(vertexInputStateCreateInfo_)
+      .colorBlendAttachmentStates(colorBlendAttachmentStates);
+
+  if (libraryParts) {
+    VK_ASSERT_RETURN_NULL_HANDLE(builder.buildLibrary(ctx.vf_,
+                                                      ctx.getVkDevice(),
+                                                      flags,
+                                                      ctx.pipelineCache_,
+                                                      layout,
+                                                      renderPass,
+                                                      libraryParts,
+                                                      &pipeline,
+                                                      desc_.debugName.c_str()));
+    return pipeline;
+  }
+
   VK_ASSERT_RETURN_NULL_HANDLE(
-      igl::vulkan::VulkanPipelineBuilder()
-          .dynamicStates(dynamicStates)
-          .primitiveTopology(primitiveTopology)
-          .depthBiasEnable(cacheKey.depthBiasEnable)
-          .depthCompareOp(cacheKey.getDepthCompareOp(),
-                          static_cast<bool>(cacheKey.depthWriteEnable))
-          .depthWriteEnable(static_cast<bool>(cacheKey.depthWriteEnable))
-          .rasterizationSamples(getVulkanSampleCountFlags(desc_.sampleCount))
-          .alphaToCoverageEnable(desc_.alphaToCoverageEnabled)
-          .polygonMode(polygonFillModeToVkPolygonMode(desc_.polygonFillMode))
-          .stencilStateOps(VK_STENCIL_FACE_FRONT_BIT,
-                           cacheKey.getStencilStateFailOp(true),
-                           cacheKey.getStencilStatePassOp(true),
-                           cacheKey.getStencilStateDepthFailOp(true),
-                           cacheKey.getStencilStateCompareOp(true))
-          .stencilStateOps(VK_STENCIL_FACE_BACK_BIT,
-                           cacheKey.getStencilStateFailOp(false),
-                           cacheKey.getStencilStatePassOp(false),
-                           cacheKey.getStencilStateDepthFailOp(false),
-                           cacheKey.getStencilStateCompareOp(false))
-          .shaderStages(stages)
-          .cullMode(cullMode)
-          .frontFace(frontFace)
-          .vertexInputState(vertexInputStateCreateInfo_)
-          .colorBlendAttachmentStates(colorBlendAttachmentStates)
+      builder.creationFeedback(ctx.hasPipelineCreationFeedback() ? &feedback : nullptr)
           .build(ctx.vf_,
                  ctx.getVkDevice(),
                  flags,
                  ctx.pipelineCache_,
-                 pipelineLayout,
+                 layout,
                  renderPass,
                  &pipeline,
                  desc_.debugName.c_str()));
 
   IGL_DEBUG_ASSERT(pipeline != VK_NULL_HANDLE);
 
-  pipelines_[cacheKey] = pipeline;
+  ctx.recordPipelineCreationFeedback(feedback);
 
   // @fb-only
   // @lint-ignore CLANGTIDY
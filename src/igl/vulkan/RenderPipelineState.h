@@ -7,7 +7,11 @@
 
 #pragma once
 
+#include <array>
+#include <future>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 #include <igl/RenderPipelineState.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/PipelineState.h>
@@ -70,6 +74,11 @@ class alignas(sizeof(uint64_t)) RenderPipelineDynamicState {
   // Ignore modernize-use-default-member-init
   // @lint-ignore CLANGTIDY
   uint32_t stencilTestEnable : 1;
+  // Multiview mask of the framebuffer (0 for FramebufferMode::Mono). With dynamic rendering, it is
+  // baked into the pipeline instead of coming from a render pass.
+  // Ignore modernize-use-default-member-init
+  // @lint-ignore CLANGTIDY
+  uint32_t viewMask : 2;
 
   RenderPipelineDynamicState() {
     // memset makes sure all padding bits are zero
@@ -89,6 +98,7 @@ class alignas(sizeof(uint64_t)) RenderPipelineDynamicState {
     depthBiasEnable = false;
     depthWriteEnable = false;
     stencilTestEnable = false;
+    viewMask = 0;
   }
 
   [[nodiscard]] VkCompareOp getDepthCompareOp() const {
@@ -163,7 +173,9 @@ static_assert(alignof(RenderPipelineDynamicState) == sizeof(uint64_t));
  * mutable parameters. If a pipeline doesn't exist with those parameters, one is created and
  * returned. Otherwise an existing pipeline with those settings is returned. This class also tracks
  * the pipeline layout in the context. If a pipeline layout change is detected, this class purges
- * all the pipelines that have been created so far.
+ * all the pipelines that have been created so far. With VK_EXT_graphics_pipeline_library, new
+ * pipelines are linked from cached pipeline libraries and replaced by optimized pipelines, which
+ * are built in the background.
  */
 class RenderPipelineState final : public IRenderPipelineState, public PipelineState {
  public:
@@ -179,12 +191,76 @@ class RenderPipelineState final : public IRenderPipelineState, public PipelineSt
    */
   [[nodiscard]] VkPipeline getVkPipeline(const RenderPipelineDynamicState& dynamicState) const;
 
+  /** @brief Schedules creation of Vulkan pipelines for all `dynamicStates` on the context's
+   * pipeline compilation threads (see `VulkanContext::getPipelineCompilationThreadPool()`) and
+   * returns immediately. The `renderPassIndex` of each state should come from
+   * `VulkanContext::findRenderPass()`, unless `VulkanContext::useDynamicRendering()` is true, in
+   * which case it is ignored. Compiled pipelines end up in the same cache as the ones
+   * created by `getVkPipeline()`. If `getVkPipeline()` is called for a state which is still being
+   * compiled, it waits for that compilation instead of starting another one. Returns the number of
+   * pipelines which were scheduled, i.e. not already cached or in flight.
+   */
+  uint32_t precompile(const std::vector<RenderPipelineDynamicState>& dynamicStates) const;
+
+  /** @brief Returns true if a Vulkan pipeline for `dynamicState` can be retrieved with
+   * `getVkPipeline()` without compiling or waiting for a compilation. Never blocks.
+   */
+  [[nodiscard]] bool isPipelineReady(const RenderPipelineDynamicState& dynamicState) const;
+
  private:
   friend class Device;
 
   /// @brief Defers destruction of all cached pipelines and the pipeline layout
   void deferDestroyPipelinesAndLayout(const VulkanContext& ctx) const;
 
+  /// @brief Waits for all in-flight compilations (including optimized links) and defers
+  /// destruction of their pipelines
+  void deferDestroyPendingPipelines(const VulkanContext& ctx) const;
+
+  /// @brief Drops all pipelines if the bindless descriptor set layout has changed
+  void checkBindlessDescriptorSetLayout(const VulkanContext& ctx) const;
+
+  /// @brief Zeroes out all fields of `dynamicState` which do not affect the Vulkan pipeline
+  [[nodiscard]] RenderPipelineDynamicState getCacheKey(
+      const VulkanContext& ctx,
+      const RenderPipelineDynamicState& dynamicState) const;
+
+  /// @brief Moves a finished compilation for `cacheKey` (if any) into `pipelines_`
+  void retirePendingPipeline(const RenderPipelineDynamicState& cacheKey, bool wait) const;
+
+  /// @brief Replaces the fast-linked pipeline for `cacheKey` with its optimized version, if the
+  /// optimized link has finished. Never blocks.
+  void retireOptimizedPipeline(const RenderPipelineDynamicState& cacheKey) const;
+
+  void ensurePipelineLayout(const VulkanContext& ctx) const;
+
+  /** @brief Builds a Vulkan pipeline. Does not touch any mutable state of this object or the
+   * context, so it can run on any thread. If `renderPass` is VK_NULL_HANDLE, the pipeline is built
+   * for dynamic rendering with the attachment formats from `RenderPipelineDesc::targetDesc`. If
+   * `libraryParts` is not 0, a pipeline library with only these state subsets is built instead.
+   */
+  [[nodiscard]] VkPipeline createVkPipeline(
+      const VulkanContext& ctx,
+      const RenderPipelineDynamicState& cacheKey,
+      VkPipelineLayout layout,
+      VkRenderPass renderPass,
+      VkGraphicsPipelineLibraryFlagsEXT libraryParts = 0) const;
+
+  /// @brief Returns the cached pipeline library which contains the state subset `part` of the
+  /// pipeline for `cacheKey`. The library is created if it does not exist yet.
+  [[nodiscard]] VkPipeline getPipelineLibrary(const VulkanContext& ctx,
+                                              const RenderPipelineDynamicState& cacheKey,
+                                              size_t partIndex,
+                                              VkRenderPass renderPass) const;
+
+  /** @brief Links a pipeline for `cacheKey` from pipeline libraries without link-time
+   * optimizations and schedules an optimized link on the pipeline compilation threads. The
+   * optimized pipeline replaces the returned one in `retireOptimizedPipeline()`.
+   */
+  [[nodiscard]] VkPipeline linkVkPipeline(const VulkanContext& ctx,
+                                          const RenderPipelineDynamicState& cacheKey,
+                                          VkRenderPass renderPass) const;
+
   int getIndexByName(const igl::NameHandle& name, ShaderStage stage) const override;
   int getIndexByName(const std::string& name, ShaderStage stage) const override;
 
@@ -203,10 +279,35 @@ class RenderPipelineState final : public IRenderPipelineState, public PipelineSt
   // This is empty for now.
   std::shared_ptr<RenderPipelineReflection> reflection_;
 
+  // guards all pipeline caches below: getVkPipeline() is called from every thread which records
+  // a secondary command buffer
+  mutable std::mutex pipelinesMutex_;
+
   mutable std::unordered_map<RenderPipelineDynamicState,
                              VkPipeline,
                              RenderPipelineDynamicState::HashFunction>
       pipelines_;
+
+  // pipelines being compiled on worker threads
+  mutable std::unordered_map<RenderPipelineDynamicState,
+                             std::future<VkPipeline>,
+                             RenderPipelineDynamicState::HashFunction>
+      pendingPipelines_;
+
+  // optimized replacements of fast-linked pipelines in `pipelines_`
+  mutable std::unordered_map<RenderPipelineDynamicState,
+                             std::future<VkPipeline>,
+                             RenderPipelineDynamicState::HashFunction>
+      optimizedPipelines_;
+
+  // vertex input, pre-rasterization shaders, fragment shader and fragment output libraries, keyed
+  // by the fields of RenderPipelineDynamicState which affect each state subset
+  static constexpr size_t kNumPipelineLibraryParts = 4;
+  mutable std::array<std::unordered_map<RenderPipelineDynamicState,
+                                        VkPipeline,
+                                        RenderPipelineDynamicState::HashFunction>,
+                     kNumPipelineLibraryParts>
+      pipelineLibraries_;
 };
 
 } // namespace igl::vulkan
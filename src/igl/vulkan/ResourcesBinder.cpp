@@ -23,6 +23,36 @@ static_assert(std::is_trivially_copyable_v<BindingsBuffers>);
 static_assert(std::is_trivially_copyable_v<BindingsTextures>);
 static_assert(std::is_trivially_copyable_v<BindingsStorageImages>);
 
+#if IGL_DEBUG_ABORT_ENABLED
+namespace {
+
+// true if all subresources of the image seen through `view` are in one of the layouts
+bool hasLayout(const VulkanImage& img,
+               const VulkanImageView& view,
+               VkImageLayout layout0,
+               VkImageLayout layout1 = VK_IMAGE_LAYOUT_MAX_ENUM) {
+  const VkImageSubresourceRange& range = view.getVkImageSubresourceRange();
+  const uint32_t numLevels = range.levelCount == VK_REMAINING_MIP_LEVELS
+                                 ? img.mipLevels_ - range.baseMipLevel
+                                 : range.levelCount;
+  const uint32_t numLayers = range.layerCount == VK_REMAINING_ARRAY_LAYERS
+                                 ? img.arrayLayers_ - range.baseArrayLayer
+                                 : range.layerCount;
+  for (uint32_t mip = range.baseMipLevel; mip != range.baseMipLevel + numLevels; mip++) {
+    for (uint32_t layer = range.baseArrayLayer; layer != range.baseArrayLayer + numLayers;
+         layer++) {
+      const VkImageLayout layout = img.getLayout(mip, layer);
+      if (layout != layout0 && layout != layout1) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+#endif // IGL_DEBUG_ABORT_ENABLED
+
 ResourcesBinder::ResourcesBinder(const CommandBuffer* commandBuffer,
                                  VulkanContext& ctx,
                                  VkPipelineBindPoint bindPoint) :
@@ -35,6 +65,15 @@ ResourcesBinder::ResourcesBinder(const CommandBuffer* commandBuffer,
   IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
 }
 
+ResourcesBinder::ResourcesBinder(VkCommandBuffer cmdBuffer,
+                                 VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
+                                 VulkanContext& ctx,
+                                 VkPipelineBindPoint bindPoint) :
+  ctx_(ctx), cmdBuffer_(cmdBuffer), bindPoint_(bindPoint), nextSubmitHandle_(nextSubmitHandle) {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+  IGL_ENSURE_VULKAN_RECORDING_THREAD(&ctx_);
+}
+
 void ResourcesBinder::bindBuffer(uint32_t index,
                                  Buffer* buffer,
                                  size_t bufferOffset,
@@ -89,6 +128,45 @@ void ResourcesBinder::bindBuffer(uint32_t index,
   }
 }
 
+void ResourcesBinder::bindBytes(uint32_t index, const void* data, size_t length) {
+  IGL_PROFILER_FUNCTION();
+
+  if (!IGL_DEBUG_VERIFY(index < IGL_UNIFORM_BLOCKS_BINDING_MAX)) {
+    IGL_DEBUG_ABORT("Buffer index should not exceed kMaxBindingSlots");
+    return;
+  }
+
+  if (!IGL_DEBUG_VERIFY(data && length)) {
+    return;
+  }
+
+  const uint32_t maxRange = ctx_.getVkPhysicalDeviceProperties().limits.maxUniformBufferRange;
+  if (!IGL_DEBUG_VERIFY(length <= maxRange)) {
+    IGL_LOG_ERROR("`length = %u` must not exceed `VkPhysicalDeviceLimits::maxUniformBufferRange = "
+                  "%u`",
+                  static_cast<uint32_t>(length),
+                  maxRange);
+    return;
+  }
+
+  const VulkanUniformRing::Allocation allocation =
+      ctx_.uniformRing_->allocate(data, length, nextSubmitHandle_);
+
+  if (!allocation.buffer) {
+    return;
+  }
+
+  bindingsBuffers_.buffers[index] = {
+      .buffer = allocation.buffer->getVkBuffer(),
+      .offset = allocation.offset,
+      .range = length,
+  };
+  if (ctx_.features().has_VK_KHR_buffer_device_address) {
+    bindingsBuffers_.addresses[index] = allocation.buffer->getVkDeviceAddress() + allocation.offset;
+  }
+  isDirtyFlags_ |= DirtyFlagBits_Buffers;
+}
+
 void ResourcesBinder::bindSamplerState(uint32_t index, SamplerState* samplerState) {
   IGL_PROFILER_FUNCTION();
 
@@ -141,10 +219,13 @@ void ResourcesBinder::bindTexture(uint32_t index, Texture* tex) {
       // that was not rendered to by IGL. If that's the case, then make sure
       // the underlying image is transitioned to
       // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-      IGL_DEBUG_ASSERT(img.imageLayout_ == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+      IGL_DEBUG_ASSERT(
+          hasLayout(img, newTexture->imageView_, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL));
     } else {
-      IGL_DEBUG_ASSERT(img.imageLayout_ == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL ||
-                       img.imageLayout_ == VK_IMAGE_LAYOUT_GENERAL);
+      IGL_DEBUG_ASSERT(hasLayout(img,
+                                 newTexture->imageView_,
+                                 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                 VK_IMAGE_LAYOUT_GENERAL));
     }
   }
 #endif // IGL_DEBUG_ABORT_ENABLED
@@ -192,7 +273,7 @@ void ResourcesBinder::bindStorageImage(uint32_t index, Texture* tex) {
     // that was not rendered to by IGL. If that's the case, then make sure
     // the underlying image is transitioned to
     // VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    IGL_DEBUG_ASSERT(img.imageLayout_ == VK_IMAGE_LAYOUT_GENERAL);
+    IGL_DEBUG_ASSERT(hasLayout(img, newTexture->imageView_, VK_IMAGE_LAYOUT_GENERAL));
   }
 #endif // IGL_DEBUG_ABORT_ENABLED
 
@@ -269,13 +350,19 @@ void ResourcesBinder::updateBindingsByDescriptorSet(VkPipelineLayout layout,
                                 state.info);
   }
   if ((isDirtyFlags_ & DirtyFlagBits_Buffers) != 0) {
-    ctx_.updateBindingsBuffers(cmdBuffer_,
-                               layout,
-                               bindPoint_,
-                               nextSubmitHandle_,
-                               bindingsBuffers_,
-                               *state.dslBuffers,
-                               state.info);
+    if (state.usePushDescriptors) {
+      ctx_.updateBindingsBuffersByPushDescriptors(
+          cmdBuffer_, layout, bindPoint_, bindingsBuffers_, state);
+    } else {
+      ctx_.updateBindingsBuffers(cmdBuffer_,
+                                 layout,
+                                 bindPoint_,
+                                 nextSubmitHandle_,
+                                 bindingsBuffers_,
+                                 *state.dslBuffers,
+                                 state.info,
+                                 state.dynamicBufferMask);
+    }
   }
   if ((isDirtyFlags_ & DirtyFlagBits_StorageImages) != 0) {
     ctx_.updateBindingsStorageImages(cmdBuffer_,
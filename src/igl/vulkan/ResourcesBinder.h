@@ -60,9 +60,20 @@ class ResourcesBinder final {
                   VulkanContext& ctx,
                   VkPipelineBindPoint bindPoint);
 
+  /// @brief Records into `cmdBuffer`, which is a secondary command buffer executed by the primary
+  /// command buffer identified by `nextSubmitHandle`. Can be constructed on a recording thread.
+  ResourcesBinder(VkCommandBuffer cmdBuffer,
+                  VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
+                  VulkanContext& ctx,
+                  VkPipelineBindPoint bindPoint);
+
   /// @brief Binds a uniform buffer with an offset to index equal to `index`
   void bindBuffer(uint32_t index, Buffer* buffer, size_t bufferOffset, size_t bufferSize);
 
+  /// @brief Copies `length` bytes into transient memory from VulkanUniformRing and binds them as a
+  /// uniform buffer to index equal to `index`
+  void bindBytes(uint32_t index, const void* data, size_t length);
+
   /// @brief Binds a sampler state to index equal to `index`
   void bindSamplerState(uint32_t index, SamplerState* samplerState);
 
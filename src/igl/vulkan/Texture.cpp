@@ -99,6 +99,14 @@ Result Texture::create(const TextureDesc& desc) {
     IGL_DEBUG_ASSERT(desc_.numSamples <= 1, "Storage images cannot be multisampled");
     usageFlags |= VK_IMAGE_USAGE_STORAGE_BIT;
   }
+  if ((desc_.usage & TextureDesc::TextureUsageBits::Sampled) != 0 && desc_.numMipLevels > 1 &&
+      desc_.numSamples <= 1 && desc_.type != TextureType::ThreeD &&
+      desc_.tiling == TextureDesc::TextureTiling::Optimal && !getProperties().isDepthOrStencil() &&
+      getProperties().numPlanes == 1 && ctx.mipmapGenerator_ &&
+      ctx.mipmapGenerator_->needsStorageUsage(vkFormat, desc_.width, desc_.height)) {
+    // mipmaps of this texture are generated by a compute shader (see VulkanMipmapGenerator)
+    usageFlags |= VK_IMAGE_USAGE_STORAGE_BIT;
+  }
   if ((desc_.usage & TextureDesc::TextureUsageBits::Attachment) != 0) {
     usageFlags |= getProperties().isDepthOrStencil() ? VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
                                                      : VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
@@ -471,6 +479,8 @@ void Texture::generateMipmap(ICommandQueue& /* unused */,
     if (!IGL_DEBUG_VERIFY(ctx.immediate_)) {
       return;
     }
+    // the mip chain is built from mip 0, which may still be waiting in a batched upload
+    ctx.stagingDevice_->flushBatch();
     const auto& wrapper = ctx.immediate_->acquire();
     texture_->image.generateMipmap(wrapper.cmdBuf, range ? *range : desc_.asRange());
     ctx.immediate_->submit(wrapper);
@@ -575,6 +585,9 @@ void Texture::clearColorTexture(const igl::Color& rgba) {
   const igl::vulkan::VulkanImage& img = texture_->image;
   IGL_DEBUG_ASSERT(img.valid());
 
+  // keep the clear ordered after any batched uploads to this texture
+  img.ctx_->stagingDevice_->flushBatch();
+
   const auto& wrapper = img.ctx_->stagingDevice_->immediate->acquire();
 
   // There is a memory barrier inserted in clearColorImage().
@@ -70,6 +70,7 @@ uint32_t TimestampQueries::count() const {
 
 void TimestampQueries::reset() {
   currentSlot_ = 0;
+  frameSlot_ = kInvalidSlot;
   commandBuffer_ = VK_NULL_HANDLE;
   resetRecorded_ = false;
   resultsReady_ = false;
@@ -142,6 +143,52 @@ void TimestampQueries::endElapsedQuery(VkCommandBuffer commandBuffer, uint32_t s
                                slotIndex * kTimestampsPerTimingSlot + 1);
 }
 
+bool TimestampQueries::beginFrameQuery() {
+  IGL_PROFILER_FUNCTION();
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
+
+  if (!isValid() || currentSlot_ >= maxSlots_ || frameSlot_ != kInvalidSlot) {
+    return false;
+  }
+
+  const auto& wrapper = ctx_.immediate_->acquire();
+  if (!resetRecorded_) {
+    ctx_.vf_.vkCmdResetQueryPool(
+        wrapper.cmdBuf, queryPool_, 0, maxSlots_ * kTimestampsPerTimingSlot);
+    resetRecorded_ = true;
+  }
+
+  frameSlot_ = currentSlot_++;
+  labels_[frameSlot_].clear();
+  resultsReady_ = false;
+
+  // bottom-of-pipe: latched once all previously submitted work has completed. The GPU may then
+  // idle until the frame's work is submitted, so the slot measures latency, not GPU cost.
+  ctx_.vf_.vkCmdWriteTimestamp(wrapper.cmdBuf,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                               queryPool_,
+                               frameSlot_ * kTimestampsPerTimingSlot);
+  ctx_.immediate_->submit(wrapper);
+  return true;
+}
+
+void TimestampQueries::endFrameQuery() {
+  IGL_PROFILER_FUNCTION();
+  IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
+
+  if (frameSlot_ == kInvalidSlot) {
+    return;
+  }
+
+  const auto& wrapper = ctx_.immediate_->acquire();
+  ctx_.vf_.vkCmdWriteTimestamp(wrapper.cmdBuf,
+                               VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                               queryPool_,
+                               frameSlot_ * kTimestampsPerTimingSlot + 1);
+  ctx_.immediate_->submit(wrapper);
+  frameSlot_ = kInvalidSlot;
+}
+
 const char* TimestampQueries::getLabel(uint32_t slotIndex) const {
   if (slotIndex >= labels_.size()) {
     return "";
@@ -47,6 +47,11 @@ class TimestampQueries final : public ITimestampQueries {
   [[nodiscard]] uint32_t beginElapsedQuery(VkCommandBuffer commandBuffer, const char* label);
   void endElapsedQuery(VkCommandBuffer commandBuffer, uint32_t slotIndex);
 
+  /// Writes the timestamps of a slot in separate submissions to the graphics queue, so that the
+  /// slot covers everything submitted in between
+  [[nodiscard]] bool beginFrameQuery() override;
+  void endFrameQuery() override;
+
   [[nodiscard]] const char* getLabel(uint32_t slotIndex) const override;
 
  private:
@@ -64,6 +69,7 @@ class TimestampQueries final : public ITimestampQueries {
   VkCommandBuffer commandBuffer_ = VK_NULL_HANDLE;
   uint32_t maxSlots_ = 0;
   uint32_t currentSlot_ = 0;
+  uint32_t frameSlot_ = kInvalidSlot;
   bool resetRecorded_ = false;
   float timestampPeriod_ = 0.0f;
   std::vector<std::string> labels_;
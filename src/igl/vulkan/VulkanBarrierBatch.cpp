@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanBarrierBatch.h>
+
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::vulkan {
+
+std::atomic<uint32_t> VulkanBarrierBatch::numBarriers = 0;
+std::atomic<uint32_t> VulkanBarrierBatch::numPipelineBarriers = 0;
+
+namespace {
+
+uint64_t getRangeEnd(uint32_t base, uint32_t count) {
+  // VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS extend a range to the end of the image
+  return count == VK_REMAINING_MIP_LEVELS ? UINT64_MAX : static_cast<uint64_t>(base) + count;
+}
+
+bool overlaps(uint32_t base0, uint32_t count0, uint32_t base1, uint32_t count1) {
+  return base0 < getRangeEnd(base1, count1) && base1 < getRangeEnd(base0, count0);
+}
+
+} // namespace
+
+VulkanBarrierBatch::VulkanBarrierBatch(const VulkanContext& ctx, VkCommandBuffer cmdBuf) :
+  ctx_(ctx),
+  cmdBuf_(cmdBuf),
+  useSynchronization2_(ctx.features().has_VK_KHR_synchronization2 &&
+                       ctx.vf_.vkCmdPipelineBarrier2KHR != nullptr) {}
+
+VulkanBarrierBatch::~VulkanBarrierBatch() {
+  IGL_DEBUG_ASSERT(empty(), "Barriers were not flushed");
+}
+
+void VulkanBarrierBatch::imageBarrier(VkImage image,
+                                      VkAccessFlags srcAccessMask,
+                                      VkAccessFlags dstAccessMask,
+                                      VkImageLayout oldImageLayout,
+                                      VkImageLayout newImageLayout,
+                                      VkPipelineStageFlags srcStageMask,
+                                      VkPipelineStageFlags dstStageMask,
+                                      const VkImageSubresourceRange& subresourceRange) {
+  for (const VkImageMemoryBarrier2KHR& b : imageBarriers_) {
+    const VkImageSubresourceRange& r = b.subresourceRange;
+    if (b.image == image &&
+        overlaps(r.baseMipLevel,
+                 r.levelCount,
+                 subresourceRange.baseMipLevel,
+                 subresourceRange.levelCount) &&
+        overlaps(r.baseArrayLayer,
+                 r.layerCount,
+                 subresourceRange.baseArrayLayer,
+                 subresourceRange.layerCount)) {
+      flush();
+      break;
+    }
+  }
+
+  // the values of the legacy stage and access flags are identical to their 64-bit counterparts
+  imageBarriers_.push_back(VkImageMemoryBarrier2KHR{
+      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR,
+      .srcStageMask = srcStageMask,
+      .srcAccessMask = srcAccessMask,
+      .dstStageMask = dstStageMask,
+      .dstAccessMask = dstAccessMask,
+      .oldLayout = oldImageLayout,
+      .newLayout = newImageLayout,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .image = image,
+      .subresourceRange = subresourceRange,
+  });
+}
+
+void VulkanBarrierBatch::bufferBarrier(VkBuffer buffer,
+                                       VkBufferUsageFlags usageFlags,
+                                       VkPipelineStageFlags srcStageMask,
+                                       VkPipelineStageFlags dstStageMask) {
+  VkAccessFlags srcAccessMask = 0;
+  VkAccessFlags dstAccessMask = 0;
+  ivkGetBufferBarrierAccessMasks(
+      usageFlags, srcStageMask, dstStageMask, &srcAccessMask, &dstAccessMask);
+
+  bufferBarriers_.push_back(VkBufferMemoryBarrier2KHR{
+      .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2_KHR,
+      .srcStageMask = srcStageMask,
+      .srcAccessMask = srcAccessMask,
+      .dstStageMask = dstStageMask,
+      .dstAccessMask = dstAccessMask,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .buffer = buffer,
+      .offset = 0,
+      .size = VK_WHOLE_SIZE,
+  });
+}
+
+void VulkanBarrierBatch::flush() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_TRANSITION);
+
+  if (empty()) {
+    return;
+  }
+
+  numBarriers += static_cast<uint32_t>(imageBarriers_.size() + bufferBarriers_.size());
+  numPipelineBarriers++;
+
+  if (useSynchronization2_) {
+    const VkDependencyInfoKHR di = {
+        .sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR,
+        .bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers_.size()),
+        .pBufferMemoryBarriers = bufferBarriers_.data(),
+        .imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers_.size()),
+        .pImageMemoryBarriers = imageBarriers_.data(),
+    };
+    ctx_.vf_.vkCmdPipelineBarrier2KHR(cmdBuf_, &di);
+  } else {
+    VkPipelineStageFlags srcStageMask = 0;
+    VkPipelineStageFlags dstStageMask = 0;
+
+    std::vector<VkImageMemoryBarrier> imageBarriers;
+    imageBarriers.reserve(imageBarriers_.size());
+    for (const VkImageMemoryBarrier2KHR& b : imageBarriers_) {
+      srcStageMask |= static_cast<VkPipelineStageFlags>(b.srcStageMask);
+      dstStageMask |= static_cast<VkPipelineStageFlags>(b.dstStageMask);
+      imageBarriers.push_back(VkImageMemoryBarrier{
+          .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+          .srcAccessMask = static_cast<VkAccessFlags>(b.srcAccessMask),
+          .dstAccessMask = static_cast<VkAccessFlags>(b.dstAccessMask),
+          .oldLayout = b.oldLayout,
+          .newLayout = b.newLayout,
+          .srcQueueFamilyIndex = b.srcQueueFamilyIndex,
+          .dstQueueFamilyIndex = b.dstQueueFamilyIndex,
+          .image = b.image,
+          .subresourceRange = b.subresourceRange,
+      });
+    }
+
+    std::vector<VkBufferMemoryBarrier> bufferBarriers;
+    bufferBarriers.reserve(bufferBarriers_.size());
+    for (const VkBufferMemoryBarrier2KHR& b : bufferBarriers_) {
+      srcStageMask |= static_cast<VkPipelineStageFlags>(b.srcStageMask);
+      dstStageMask |= static_cast<VkPipelineStageFlags>(b.dstStageMask);
+      bufferBarriers.push_back(VkBufferMemoryBarrier{
+          .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+          .srcAccessMask = static_cast<VkAccessFlags>(b.srcAccessMask),
+          .dstAccessMask = static_cast<VkAccessFlags>(b.dstAccessMask),
+          .srcQueueFamilyIndex = b.srcQueueFamilyIndex,
+          .dstQueueFamilyIndex = b.dstQueueFamilyIndex,
+          .buffer = b.buffer,
+          .offset = b.offset,
+          .size = b.size,
+      });
+    }
+
+    ctx_.vf_.vkCmdPipelineBarrier(cmdBuf_,
+                                  srcStageMask,
+                                  dstStageMask,
+                                  0,
+                                  0,
+                                  nullptr,
+                                  static_cast<uint32_t>(bufferBarriers.size()),
+                                  bufferBarriers.data(),
+                                  static_cast<uint32_t>(imageBarriers.size()),
+                                  imageBarriers.data());
+  }
+
+  imageBarriers_.clear();
+  bufferBarriers_.clear();
+}
+
+} // namespace igl::vulkan
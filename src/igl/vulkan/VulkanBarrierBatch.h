@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+class VulkanContext;
+
+/**
+ * @brief Collects image and buffer memory barriers and records all of them into `cmdBuf` with a
+ * single `vkCmdPipelineBarrier2KHR()` call when `flush()` is invoked. Every barrier keeps its own
+ * stage masks. If VK_KHR_synchronization2 is not available, the barriers are recorded with a
+ * single `vkCmdPipelineBarrier()` call using the union of all stage masks.
+ *
+ * Barriers within one pipeline barrier command are not ordered, so adding an image barrier which
+ * overlaps the subresources of a pending one flushes the pending barriers first.
+ *
+ * A batch is meant to be short-lived: fill it in one place, e.g. while processing the
+ * dependencies of an encoder, and flush it before recording any commands which depend on it.
+ */
+class VulkanBarrierBatch final {
+ public:
+  VulkanBarrierBatch(const VulkanContext& ctx, VkCommandBuffer cmdBuf);
+  ~VulkanBarrierBatch();
+
+  VulkanBarrierBatch(const VulkanBarrierBatch&) = delete;
+  VulkanBarrierBatch& operator=(const VulkanBarrierBatch&) = delete;
+
+  void imageBarrier(VkImage image,
+                    VkAccessFlags srcAccessMask,
+                    VkAccessFlags dstAccessMask,
+                    VkImageLayout oldImageLayout,
+                    VkImageLayout newImageLayout,
+                    VkPipelineStageFlags srcStageMask,
+                    VkPipelineStageFlags dstStageMask,
+                    const VkImageSubresourceRange& subresourceRange);
+
+  /// @brief Deduces the access masks from the stages and the usage of the buffer in the same way
+  /// `ivkBufferBarrier()` does.
+  void bufferBarrier(VkBuffer buffer,
+                     VkBufferUsageFlags usageFlags,
+                     VkPipelineStageFlags srcStageMask,
+                     VkPipelineStageFlags dstStageMask);
+
+  /// @brief Records all pending barriers. Does nothing if the batch is empty.
+  void flush();
+
+  [[nodiscard]] bool empty() const {
+    return imageBarriers_.empty() && bufferBarriers_.empty();
+  }
+
+  /// @brief The total number of image and buffer barriers recorded by all batches
+  static uint32_t getNumBarriers() {
+    return numBarriers;
+  }
+  /// @brief The total number of pipeline barrier commands recorded by all batches
+  static uint32_t getNumPipelineBarriers() {
+    return numPipelineBarriers;
+  }
+  /// @brief The number of barriers which did not need their own pipeline barrier command
+  static uint32_t getNumBarriersMerged() {
+    return numBarriers - numPipelineBarriers;
+  }
+
+ private:
+  const VulkanContext& ctx_;
+  VkCommandBuffer cmdBuf_ = VK_NULL_HANDLE;
+  bool useSynchronization2_ = false;
+  std::vector<VkImageMemoryBarrier2KHR> imageBarriers_;
+  std::vector<VkBufferMemoryBarrier2KHR> bufferBarriers_;
+
+  static std::atomic<uint32_t> numBarriers;
+  static std::atomic<uint32_t> numPipelineBarriers;
+};
+
+} // namespace igl::vulkan
@@ -14,6 +14,22 @@
 
 namespace igl::vulkan {
 
+namespace {
+
+VulkanMemoryCategory getMemoryCategory(VkBufferUsageFlags usageFlags) {
+  if (usageFlags & (VK_BUFFER_USAGE_SAMPLER_DESCRIPTOR_BUFFER_BIT_EXT |
+                    VK_BUFFER_USAGE_RESOURCE_DESCRIPTOR_BUFFER_BIT_EXT)) {
+    return VulkanMemoryCategory::DescriptorPool;
+  }
+  // buffers which can only be copied from and to are staging buffers
+  constexpr VkBufferUsageFlags kTransferUsage =
+      VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+  return (usageFlags & ~kTransferUsage) == 0 ? VulkanMemoryCategory::Staging
+                                             : VulkanMemoryCategory::Buffer;
+}
+
+} // namespace
+
 VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
                            VkDevice device,
                            VkDeviceSize bufferSize,
@@ -89,6 +105,11 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
                            vmaAllocation_,
                            IGL_FORMAT("VMA Allocation: {}", debugName).c_str());
 
+      VmaAllocationInfo allocationInfo;
+      vmaGetAllocationInfo(
+          static_cast<VmaAllocator>(ctx_.getVmaAllocator()), vmaAllocation_, &allocationInfo);
+      allocatedSize_ = allocationInfo.size;
+
       // handle memory-mapped buffers
       if (memFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
         vmaMapMemory(
@@ -115,6 +136,7 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
                                   ctx.features().has_VK_KHR_buffer_device_address,
                                   &vkMemory_));
       VK_ASSERT(ctx_.vf_.vkBindBufferMemory(device_, vkBuffer_, vkMemory_, 0));
+      allocatedSize_ = requirements.size;
 
       VK_ASSERT(ivkSetDebugObjectName(&ctx_.vf_,
                                       device_,
@@ -131,6 +153,8 @@ VulkanBuffer::VulkanBuffer(const VulkanContext& ctx,
 
   IGL_DEBUG_ASSERT(vkBuffer_ != VK_NULL_HANDLE);
 
+  ctx_.addMemoryUsage(getMemoryCategory(usageFlags_), allocatedSize_);
+
   // set debug name
   VK_ASSERT(ivkSetDebugObjectName(
       &ctx_.vf_, device_, VK_OBJECT_TYPE_BUFFER, (uint64_t)vkBuffer_, debugName));
@@ -151,6 +175,8 @@ VulkanBuffer::~VulkanBuffer() {
 
   IGL_ENSURE_VULKAN_CONTEXT_THREAD(&ctx_);
 
+  ctx_.removeMemoryUsage(getMemoryCategory(usageFlags_), allocatedSize_);
+
   if (IGL_VULKAN_USE_VMA) {
     if (mappedPtr_) {
       vmaUnmapMemory(static_cast<VmaAllocator>(ctx_.getVmaAllocator()), vmaAllocation_);
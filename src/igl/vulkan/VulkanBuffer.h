@@ -93,6 +93,7 @@ class VulkanBuffer {
   VmaAllocation vmaAllocation_ = VK_NULL_HANDLE;
   VkDeviceAddress vkDeviceAddress_ = 0;
   VkDeviceSize bufferSize_ = 0;
+  VkDeviceSize allocatedSize_ = 0;
   VkBufferUsageFlags usageFlags_ = 0;
   VkMemoryPropertyFlags memFlags_ = 0;
   void* mappedPtr_ = nullptr;
@@ -5,9 +5,12 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <type_traits>
 #include <utility>
@@ -26,7 +29,9 @@
 #endif // IGL_CMAKE_BUILD
 
 #include <igl/SamplerState.h>
+#include <igl/ThreadPool.h>
 #include <igl/glslang/GlslCompiler.h>
+#include <igl/glslang/SpirvCache.h>
 #include <igl/vulkan/Buffer.h>
 #include <igl/vulkan/RenderPipelineState.h>
 #include <igl/vulkan/ResourcesBinder.h>
@@ -38,6 +43,7 @@
 #include <igl/vulkan/VulkanFeatures.h>
 #include <igl/vulkan/VulkanImageView.h>
 #include <igl/vulkan/VulkanPipelineBuilder.h>
+#include <igl/vulkan/VulkanPipelineCache.h>
 #include <igl/vulkan/VulkanSwapchain.h>
 #include <igl/vulkan/VulkanTexture.h>
 #include <igl/vulkan/VulkanVma.h>
@@ -52,6 +58,11 @@ namespace {
 [[maybe_unused]] const char* kValidationLayerName = "VK_LAYER_KHRONOS_validation";
 const char* kGfxReconstructLayerName = "VK_LAYER_LUNARG_gfxreconstruct";
 
+// the context whose secondary render command encoders are recorded on the calling thread, and how
+// many of them are alive (see VulkanContext::ensureRecordingThread())
+thread_local const igl::vulkan::VulkanContext* tlsRecordingContext = nullptr;
+thread_local uint32_t tlsNumRecordingEncoders = 0;
+
 /*
  BINDLESS ONLY: these bindings should match GLSL declarations injected into shaders in
  Device::compileShaderModule(). Same with SparkSL.
@@ -201,6 +212,46 @@ bool validateImageLimits(VkImageType imageType,
   return true;
 }
 
+// Boost-style hash combiner. Mixes `v` into the accumulated seed `h` with a golden-ratio
+// constant plus a self-shift so that the seed's existing bits are re-distributed before each
+// new field is folded in.
+inline void hashCombine(size_t& h, size_t v) noexcept {
+  h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+}
+
+// Flattened contents of a descriptor set (the bound handles per binding location), used as the key
+// of the descriptor set cache in DescriptorPoolsArena
+template<size_t N>
+struct DescriptorSetContents {
+  uint64_t values[N]; // uninitialized
+  uint32_t numValues = 0;
+
+  void add(uint64_t value) {
+    IGL_DEBUG_ASSERT(numValues < N);
+    values[numValues++] = value;
+  }
+  [[nodiscard]] size_t hash() const noexcept {
+    size_t h = std::hash<uint32_t>{}(numValues);
+    for (uint32_t i = 0; i != numValues; i++) {
+      hashCombine(h, std::hash<uint64_t>{}(values[i]));
+    }
+    return h;
+  }
+};
+
+// Vulkan does not report how much memory a descriptor pool occupies: estimate it from the number of
+// descriptors the pool can hold
+constexpr VkDeviceSize kEstimatedDescriptorSize = 64;
+
+VkDeviceSize getEstimatedDescriptorPoolSize(uint32_t numPoolSizes,
+                                            const VkDescriptorPoolSize* poolSizes) {
+  VkDeviceSize size = 0;
+  for (uint32_t i = 0; i != numPoolSizes; i++) {
+    size += poolSizes[i].descriptorCount * kEstimatedDescriptorSize;
+  }
+  return size;
+}
+
 } // namespace
 
 namespace igl::vulkan {
@@ -244,6 +295,7 @@ class DescriptorPoolsArena final {
   DescriptorPoolsArena(DescriptorPoolsArena&&) = delete;
   DescriptorPoolsArena& operator=(DescriptorPoolsArena&&) = delete;
   ~DescriptorPoolsArena() {
+    ctx_.removeMemoryUsage(VulkanMemoryCategory::DescriptorPool, poolsSize_);
     extinct_.push_back({.pool = pool_, .handle = {}});
     ctx_.deferredTask(std::packaged_task<void()>(
         [extinct = std::move(extinct_), vf = ctx_.vf_, device = device_]() {
@@ -279,11 +331,48 @@ class DescriptorPoolsArena final {
     return dset;
   }
 
+  /// Returns a descriptor set which was written with `contents` earlier in the command buffer
+  /// identified by `nextSubmitHandle`, or VK_NULL_HANDLE
+  template<size_t N>
+  [[nodiscard]] VkDescriptorSet findCachedDescriptorSet(
+      const DescriptorSetContents<N>& contents,
+      size_t hash,
+      VulkanImmediateCommands::SubmitHandle nextSubmitHandle) {
+    // cached sets are reused only within one command buffer: the resources they reference are kept
+    // alive by it, and their pool cannot be recycled before it retires
+    if (cacheSubmitHandle_ != nextSubmitHandle) {
+      cache_.clear();
+      cacheSubmitHandle_ = nextSubmitHandle;
+    }
+    const auto it = cache_.find(hash);
+    if (it == cache_.end() || !std::equal(contents.values,
+                                          contents.values + contents.numValues,
+                                          it->second.values.begin(),
+                                          it->second.values.end())) {
+      return VK_NULL_HANDLE;
+    }
+    return it->second.dset;
+  }
+  template<size_t N>
+  void cacheDescriptorSet(const DescriptorSetContents<N>& contents,
+                          size_t hash,
+                          VkDescriptorSet dset) {
+    // a hash collision replaces the older entry
+    cache_[hash] = CachedDescriptorSet{
+        .values = std::vector<uint64_t>(contents.values, contents.values + contents.numValues),
+        .dset = dset,
+    };
+  }
+
  private:
   void switchToNewDescriptorPool(VulkanImmediateCommands& ic,
                                  VulkanImmediateCommands::SubmitHandle nextSubmitHandle) {
     numRemainingDSetsInPool_ = kNumDSetsPerPool;
 
+    // the retired pool can be recycled once `nextSubmitHandle` retires, but cached sets might be
+    // used by later command buffers
+    cache_.clear();
+
     if (pool_ != VK_NULL_HANDLE) {
       extinct_.push_back(
           {.pool = pool_, .handle = nextSubmitHandle, .allocatedDSet = std::move(allocatedDSet_)});
@@ -316,6 +405,9 @@ class DescriptorPoolsArena final {
                                       &pool_));
     VK_ASSERT(ivkSetDebugObjectName(
         &ctx_.vf_, device_, VK_OBJECT_TYPE_DESCRIPTOR_POOL, (uint64_t)pool_, dpDebugName_.c_str()));
+    const VkDeviceSize poolSize = getEstimatedDescriptorPoolSize(numTypes_, poolSizes);
+    ctx_.addMemoryUsage(VulkanMemoryCategory::DescriptorPool, poolSize);
+    poolsSize_ += poolSize;
     allocatedDSet_.clear();
     dsetCursor_ = 0;
     isNewPool_ = true;
@@ -335,6 +427,7 @@ class DescriptorPoolsArena final {
   const uint32_t numDescriptorsPerDSet_ = 0;
   uint32_t numRemainingDSetsInPool_ = 0;
   std::string dpDebugName_;
+  VkDeviceSize poolsSize_ = 0; // estimated size of all pools owned by this arena
 
   VkDescriptorSetLayout dsl_ = VK_NULL_HANDLE; // owned elsewhere
 
@@ -345,6 +438,16 @@ class DescriptorPoolsArena final {
   };
 
   std::deque<ExtinctDescriptorPool> extinct_;
+
+  struct CachedDescriptorSet {
+    std::vector<uint64_t> values;
+    VkDescriptorSet dset = VK_NULL_HANDLE;
+  };
+
+  // descriptor sets of the current pool written in the current command buffer, keyed by the hash of
+  // their contents
+  std::unordered_map<size_t, CachedDescriptorSet> cache_;
+  VulkanImmediateCommands::SubmitHandle cacheSubmitHandle_ = {};
 };
 
 namespace {
@@ -410,6 +513,7 @@ class DescriptorBuffersArena final {
 
 struct BindGroupMetadataTextures {
   // cold
+  VkDeviceSize poolSize = 0;
   BindGroupTextureDesc desc = {};
   VkDescriptorPool pool = VK_NULL_HANDLE;
   // hot
@@ -419,6 +523,7 @@ struct BindGroupMetadataTextures {
 
 struct BindGroupMetadataBuffers {
   // cold
+  VkDeviceSize poolSize = 0;
   BindGroupBufferDesc desc = {};
   VkDescriptorPool pool = VK_NULL_HANDLE;
   // hot
@@ -467,15 +572,6 @@ struct DescriptorSetLayoutCacheKey {
   }
 };
 
-// Boost-style hash combiner. Mixes `v` into the accumulated seed `h` with a golden-ratio
-// constant plus a self-shift so that the seed's existing bits are re-distributed before each
-// new field is folded in.
-namespace {
-inline void hashCombine(size_t& h, size_t v) noexcept {
-  h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
-}
-} // namespace
-
 struct DescriptorSetLayoutCacheKeyHash {
   size_t operator()(const DescriptorSetLayoutCacheKey& key) const noexcept {
     size_t h = std::hash<uint32_t>{}(static_cast<uint32_t>(key.flags));
@@ -494,11 +590,47 @@ struct DescriptorSetLayoutCacheKeyHash {
   }
 };
 
+// A push descriptor update template can be used with any pipeline layout compatible for the set
+// kBindPoint_Buffers, i.e. with identical descriptor set layouts for sets 0..1 and identical push
+// constant ranges. All descriptor set layouts are de-duplicated via dslCache, which makes their
+// handles a stable key.
+struct PushDescriptorTemplateKey {
+  VkDescriptorSetLayout dslCombinedImageSamplers = VK_NULL_HANDLE;
+  VkDescriptorSetLayout dslBuffers = VK_NULL_HANDLE;
+  VkPipelineBindPoint bindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+  VkShaderStageFlags pushConstantStageFlags = 0;
+  uint32_t pushConstantSize = 0;
+
+  bool operator==(const PushDescriptorTemplateKey& other) const noexcept {
+    return dslCombinedImageSamplers == other.dslCombinedImageSamplers &&
+           dslBuffers == other.dslBuffers && bindPoint == other.bindPoint &&
+           pushConstantStageFlags == other.pushConstantStageFlags &&
+           pushConstantSize == other.pushConstantSize;
+  }
+};
+
+struct PushDescriptorTemplateKeyHash {
+  size_t operator()(const PushDescriptorTemplateKey& key) const noexcept {
+    size_t h = std::hash<VkDescriptorSetLayout>{}(key.dslCombinedImageSamplers);
+    hashCombine(h, std::hash<VkDescriptorSetLayout>{}(key.dslBuffers));
+    hashCombine(h, std::hash<uint32_t>{}(static_cast<uint32_t>(key.bindPoint)));
+    hashCombine(h, std::hash<uint32_t>{}(static_cast<uint32_t>(key.pushConstantStageFlags)));
+    hashCombine(h, std::hash<uint32_t>{}(key.pushConstantSize));
+    return h;
+  }
+};
+
 } // namespace
 
 struct VulkanContextImpl final {
   std::thread::id contextThread = std::this_thread::get_id();
 
+  // guards the descriptor arenas below, which are shared by all threads recording commands
+  std::mutex descriptorArenasMutex;
+  // deferredTask() can be called by recording threads (e.g. when pipelines are recreated); the
+  // tasks themselves are processed on the context thread only
+  std::mutex deferredTasksMutex;
+
   // Vulkan Memory Allocator
   VmaAllocator vma = VK_NULL_HANDLE;
   // :)
@@ -516,9 +648,16 @@ struct VulkanContextImpl final {
                      VkDescriptorSetLayout,
                      DescriptorSetLayoutCacheKeyHash>
       dslCache;
+  // VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR templates for the buffers set; live
+  // until the context is destroyed
+  std::unordered_map<PushDescriptorTemplateKey,
+                     VkDescriptorUpdateTemplate,
+                     PushDescriptorTemplateKeyHash>
+      pushDescriptorTemplates;
   std::unique_ptr<VulkanDescriptorSetLayout> dslBindless; // everything
   std::unique_ptr<DescriptorBuffersArena> descriptorBuffersArena;
   VkDescriptorPool dpBindless = VK_NULL_HANDLE;
+  VkDeviceSize dpBindlessSize = 0;
   VkDescriptorSet dsBindless = VK_NULL_HANDLE;
   uint32_t currentMaxBindlessTextures = 8;
   uint32_t currentMaxBindlessSamplers = 8;
@@ -529,6 +668,15 @@ struct VulkanContextImpl final {
   SamplerHandle dummySampler = {};
   TextureHandle dummyTexture = {};
 
+  // worker threads for RenderPipelineState::precompile(), created lazily
+  std::unique_ptr<igl::ThreadPool> pipelineCompilationPool;
+  std::once_flag pipelineCompilationPoolOnce;
+
+  std::unique_ptr<igl::vulkan::VulkanPipelineCache> pipelineCache;
+  std::unique_ptr<igl::glslang::SpirvCache> spirvCache;
+
+  VulkanDescriptorSetCacheStats descriptorSetCacheStats;
+
   // NOLINTBEGIN(readability-identifier-naming)
   DescriptorPoolsArena& getOrCreateArena_CombinedImageSamplers(const VulkanContext& ctx,
                                                                VkDescriptorSetLayout dsl,
@@ -579,6 +727,99 @@ struct VulkanContextImpl final {
                                                                "arenaBuffers_");
     return *arenaBuffers[dsl].get();
   }
+
+  VkDescriptorUpdateTemplate getOrCreatePushDescriptorTemplate(const VulkanContext& ctx,
+                                                               VkPipelineLayout layout,
+                                                               VkPipelineBindPoint bindPoint,
+                                                               const PipelineState& state) {
+    const PushDescriptorTemplateKey key = {
+        .dslCombinedImageSamplers = state.dslCombinedImageSamplers->getVkDescriptorSetLayout(),
+        .dslBuffers = state.dslBuffers->getVkDescriptorSetLayout(),
+        .bindPoint = bindPoint,
+        .pushConstantStageFlags = state.pushConstantRange.stageFlags,
+        .pushConstantSize = state.pushConstantRange.size,
+    };
+
+    auto it = pushDescriptorTemplates.find(key);
+    if (it != pushDescriptorTemplates.end()) {
+      return it->second;
+    }
+
+    IGL_PROFILER_ZONE("createPushDescriptorTemplate()", IGL_PROFILER_COLOR_CREATE);
+
+    // every entry reads one element of BindingsBuffers::buffers[]
+    // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+    VkDescriptorUpdateTemplateEntry entries[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+    uint32_t numEntries = 0;
+
+    for (const util::BufferDescription& b : state.info.buffers) {
+      IGL_DEBUG_ASSERT(b.bindingLocation < IGL_UNIFORM_BLOCKS_BINDING_MAX);
+      entries[numEntries++] = VkDescriptorUpdateTemplateEntry{
+          .dstBinding = b.bindingLocation,
+          .dstArrayElement = 0,
+          .descriptorCount = 1,
+          .descriptorType =
+              b.isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+          .offset = offsetof(BindingsBuffers, buffers) +
+                    b.bindingLocation * sizeof(VkDescriptorBufferInfo),
+          .stride = sizeof(VkDescriptorBufferInfo),
+      };
+    }
+
+    const VkDescriptorUpdateTemplateCreateInfo ci = {
+        .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+        .descriptorUpdateEntryCount = numEntries,
+        .pDescriptorUpdateEntries = entries,
+        .templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR,
+        .pipelineBindPoint = bindPoint,
+        .pipelineLayout = layout,
+        .set = kBindPoint_Buffers,
+    };
+
+    VkDescriptorUpdateTemplate tmpl = VK_NULL_HANDLE;
+    VK_ASSERT(ctx.vf_.vkCreateDescriptorUpdateTemplate(ctx.getVkDevice(), &ci, nullptr, &tmpl));
+
+    IGL_PROFILER_ZONE_END();
+
+    pushDescriptorTemplates[key] = tmpl;
+
+    return tmpl;
+  }
+
+  /// Returns a descriptor set with the bindings described by `contents`. A set written earlier in
+  /// the same command buffer is reused if the cache is enabled; otherwise a new set is allocated
+  /// from `arena` and written by `writeDescriptorSet`
+  template<size_t N, typename WriteDescriptorSet>
+  VkDescriptorSet findOrWriteDescriptorSet(const VulkanContext& ctx,
+                                           DescriptorPoolsArena& arena,
+                                           const DescriptorSetContents<N>& contents,
+                                           VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
+                                           WriteDescriptorSet&& writeDescriptorSet) {
+    const bool useCache = ctx.config_.enableDescriptorSetCache;
+    const size_t hash = useCache ? contents.hash() : 0;
+
+    if (useCache) {
+      VkDescriptorSet dset = arena.findCachedDescriptorSet(contents, hash, nextSubmitHandle);
+      if (dset != VK_NULL_HANDLE) {
+        descriptorSetCacheStats.numHits++;
+        return dset;
+      }
+    }
+
+    descriptorSetCacheStats.numMisses++;
+
+    VkDescriptorSet dset = arena.getNextDescriptorSet(*ctx.immediate_, nextSubmitHandle);
+
+    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
+    writeDescriptorSet(dset);
+    IGL_PROFILER_ZONE_END();
+
+    if (useCache) {
+      arena.cacheDescriptorSet(contents, hash, dset);
+    }
+
+    return dset;
+  }
 };
 
 VulkanContext::VulkanContext(VulkanContextConfig config,
@@ -615,6 +856,11 @@ VulkanContext::VulkanContext(VulkanContextConfig config,
 
   pimpl_ = std::make_unique<VulkanContextImpl>();
 
+  if (config_.spirvCacheCapacity || config_.spirvCachePath) {
+    pimpl_->spirvCache =
+        std::make_unique<glslang::SpirvCache>(config_.spirvCacheCapacity, config_.spirvCachePath);
+  }
+
 #if defined(IGL_CMAKE_BUILD)
   const auto result = volkInitialize();
 
@@ -642,6 +888,9 @@ VulkanContext::VulkanContext(VulkanContextConfig config,
 VulkanContext::~VulkanContext() {
   IGL_PROFILER_FUNCTION();
 
+  // finish all in-flight pipeline compilations while the device is still alive
+  pimpl_->pipelineCompilationPool.reset();
+
   if (vkDevice_) {
     waitIdle();
   }
@@ -692,6 +941,9 @@ VulkanContext::~VulkanContext() {
 
   // This will free an internal buffer that was allocated by VMA
   stagingDevice_.reset(nullptr);
+  readbackRing_.reset(nullptr);
+  uniformRing_.reset(nullptr);
+  mipmapGenerator_.reset(nullptr);
 
   if (vkDevice_) {
     for (VkRenderPass r : renderPasses_) {
@@ -719,8 +971,16 @@ VulkanContext::~VulkanContext() {
   }
   pimpl_->dslCache.clear();
 
+  if (vkDevice_) {
+    for (auto& kv : pimpl_->pushDescriptorTemplates) {
+      vf_.vkDestroyDescriptorUpdateTemplate(vkDevice_, kv.second, nullptr);
+    }
+  }
+  pimpl_->pushDescriptorTemplates.clear();
+
   waitDeferredTasks();
 
+  threadCommandPools_.reset(nullptr);
   immediate_.reset(nullptr);
   timelineSemaphore_.reset(nullptr);
 
@@ -738,9 +998,24 @@ VulkanContext::~VulkanContext() {
         vf_.vkDestroySamplerYcbcrConversion(vkDevice_, entry.conversion, nullptr);
       }
     }
-    vf_.vkDestroyPipelineCache(vkDevice_, pipelineCache_, nullptr);
   }
 
+#if IGL_LOGGING_ENABLED
+  if (config_.enableExtraLogs && pimpl_->pipelineCache) {
+    const VulkanPipelineCacheStats stats = pimpl_->pipelineCache->getStats();
+    IGL_LOG_INFO("Vulkan pipeline cache: %s %zu bytes, %u hits, %u misses, %u flushes\n",
+                 stats.loadedFromFile ? "loaded from file" : "seeded with",
+                 stats.loadedBytes,
+                 stats.numHits,
+                 stats.numMisses,
+                 stats.numFlushes);
+  }
+#endif // IGL_LOGGING_ENABLED
+
+  // writes the pipeline cache file one last time
+  pimpl_->pipelineCache.reset();
+  pipelineCache_ = VK_NULL_HANDLE;
+
   if (vkSurface_ != VK_NULL_HANDLE) {
     vf_.vkDestroySurfaceKHR(vkInstance_, vkSurface_, nullptr);
   }
@@ -768,6 +1043,8 @@ VulkanContext::~VulkanContext() {
   if (config_.enableExtraLogs) {
     IGL_LOG_INFO("Vulkan graphics pipelines created: %u\n",
                  VulkanPipelineBuilder::getNumPipelinesCreated());
+    IGL_LOG_INFO("Vulkan graphics pipeline libraries created: %u\n",
+                 VulkanPipelineBuilder::getNumPipelineLibrariesCreated());
     IGL_LOG_INFO("Vulkan compute pipelines created: %u\n",
                  VulkanComputePipelineBuilder::getNumPipelinesCreated());
   }
@@ -1131,6 +1408,27 @@ Result VulkanContext::initContext(const HWDeviceDesc& desc,
   queuePool.reserveQueue(graphicsQueueDescriptor);
   queuePool.reserveQueue(computeQueueDescriptor);
 
+  // queue family ownership is handed over to the graphics queue via timeline semaphores
+  if (config_.enableTransferQueue && features_.has_VK_KHR_timeline_semaphore &&
+      features_.has_VK_KHR_synchronization2) {
+    const auto transferQueueDescriptor = queuePool.findDedicatedQueueDescriptor(
+        VK_QUEUE_TRANSFER_BIT, VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
+    if (transferQueueDescriptor.isValid()) {
+      uint32_t queueFamilyCount = 0;
+      vf_.vkGetPhysicalDeviceQueueFamilyProperties(vkPhysicalDevice_, &queueFamilyCount, nullptr);
+      std::vector<VkQueueFamilyProperties> properties(queueFamilyCount);
+      vf_.vkGetPhysicalDeviceQueueFamilyProperties(
+          vkPhysicalDevice_, &queueFamilyCount, properties.data());
+
+      deviceQueues_.transferQueueFamilyIndex = transferQueueDescriptor.familyIndex;
+      deviceQueues_.transferQueueImageGranularity =
+          properties[transferQueueDescriptor.familyIndex].minImageTransferGranularity;
+      queuePool.reserveQueue(transferQueueDescriptor);
+    } else if (config_.enableExtraLogs) {
+      IGL_LOG_INFO("No dedicated transfer queue available, uploading on the graphics queue\n");
+    }
+  }
+
   const auto qcis = queuePool.getQueueCreationInfos();
 
   auto deviceExtensions = features_.allEnabled(VulkanFeatures::ExtensionType::Device);
@@ -1165,10 +1463,35 @@ Result VulkanContext::initContext(const HWDeviceDesc& desc,
     return Result(Result::Code::InvalidOperation, "Cannot initialize VK_KHR_buffer_device_address");
   }
 
+  useDynamicRendering_ = config_.enableDynamicRendering && features_.has_VK_KHR_dynamic_rendering &&
+                         features_.featuresDynamicRendering.dynamicRendering == VK_TRUE &&
+                         vf_.vkCmdBeginRendering && vf_.vkCmdEndRendering;
+  if (config_.enableExtraLogs) {
+    IGL_LOG_INFO("Dynamic rendering: %s\n", useDynamicRendering_ ? "ON" : "OFF");
+  }
+
+  if (features_.has_VK_EXT_graphics_pipeline_library &&
+      features_.featuresGraphicsPipelineLibrary.graphicsPipelineLibrary == VK_TRUE) {
+    // without fast linking, a link at draw time is not cheaper than a monolithic pipeline
+    VkPhysicalDeviceGraphicsPipelineLibraryPropertiesEXT gplProperties = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_PROPERTIES_EXT};
+    VkPhysicalDeviceProperties2 properties2 = {
+        .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &gplProperties};
+    vf_.vkGetPhysicalDeviceProperties2(vkPhysicalDevice_, &properties2);
+    useGraphicsPipelineLibrary_ = gplProperties.graphicsPipelineLibraryFastLinking == VK_TRUE;
+  }
+  if (config_.enableExtraLogs) {
+    IGL_LOG_INFO("Graphics pipeline library: %s\n", useGraphicsPipelineLibrary_ ? "ON" : "OFF");
+  }
+
   vf_.vkGetDeviceQueue(
       device, deviceQueues_.graphicsQueueFamilyIndex, 0, &deviceQueues_.graphicsQueue);
   vf_.vkGetDeviceQueue(
       device, deviceQueues_.computeQueueFamilyIndex, 0, &deviceQueues_.computeQueue);
+  if (deviceQueues_.transferQueueFamilyIndex != DeviceQueues::kInvalid) {
+    vf_.vkGetDeviceQueue(
+        device, deviceQueues_.transferQueueFamilyIndex, 0, &deviceQueues_.transferQueue);
+  }
 
   vkDevice_ = device;
 
@@ -1198,6 +1521,15 @@ Result VulkanContext::initContext(const HWDeviceDesc& desc,
         IGL_FORMAT("Compute queue: {}", debugName ? debugName : "igl/vulkan/VulkanContext.cpp")
             .c_str()));
   }
+  if (deviceQueues_.transferQueue) {
+    VK_ASSERT(ivkSetDebugObjectName(
+        &vf_,
+        vkDevice_,
+        VK_OBJECT_TYPE_QUEUE,
+        (uint64_t)deviceQueues_.transferQueue,
+        IGL_FORMAT("Transfer queue: {}", debugName ? debugName : "igl/vulkan/VulkanContext.cpp")
+            .c_str()));
+  }
 
   immediate_ = std::make_unique<VulkanImmediateCommands>(vf_,
                                                          device,
@@ -1206,25 +1538,16 @@ Result VulkanContext::initContext(const HWDeviceDesc& desc,
                                                          features_.has_VK_KHR_timeline_semaphore &&
                                                              features_.has_VK_KHR_synchronization2,
                                                          "VulkanContext::immediate_");
+  threadCommandPools_ = std::make_unique<VulkanThreadCommandPools>(
+      vf_, device, deviceQueues_.graphicsQueueFamilyIndex);
   IGL_DEBUG_ASSERT(config_.maxResourceCount > 0,
                    "Max resource count needs to be greater than zero");
   syncSubmitHandles.resize(config_.maxResourceCount);
 
   // create Vulkan pipeline cache
-  {
-    const VkPipelineCacheCreateInfo ci = {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
-        .flags = VkPipelineCacheCreateFlags(0),
-        .initialDataSize = config_.pipelineCacheDataSize,
-        .pInitialData = config_.pipelineCacheData,
-    };
-    vf_.vkCreatePipelineCache(device, &ci, nullptr, &pipelineCache_);
-    VK_ASSERT(ivkSetDebugObjectName(&vf_,
-                                    device,
-                                    VK_OBJECT_TYPE_PIPELINE_CACHE,
-                                    (uint64_t)pipelineCache_,
-                                    "Pipeline Cache: VulkanContext::pipelineCache_"));
-  }
+  pimpl_->pipelineCache = std::make_unique<VulkanPipelineCache>(
+      vf_, device, vkPhysicalDeviceProperties2_.properties, config_);
+  pipelineCache_ = pimpl_->pipelineCache->getVkPipelineCache();
 
   // Create Vulkan Memory Allocator
   if (IGL_VULKAN_USE_VMA) {
@@ -1245,6 +1568,9 @@ Result VulkanContext::initContext(const HWDeviceDesc& desc,
   // The staging device will use VMA to allocate a buffer, so this needs
   // to happen after VMA has been initialized.
   stagingDevice_ = std::make_unique<VulkanStagingDevice>(*this);
+  readbackRing_ = std::make_unique<VulkanReadbackRing>(*this, config_.readbackRingSize);
+  uniformRing_ = std::make_unique<VulkanUniformRing>(*this, config_.uniformRingSize);
+  mipmapGenerator_ = std::make_unique<VulkanMipmapGenerator>(*this);
 
   // Unextended Vulkan 1.1 does not allow sparse (VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT)
   // bindings. Our descriptor set layout emulates OpenGL binding slots but we cannot put
@@ -1431,6 +1757,7 @@ void VulkanContext::growBindlessDescriptorPool(uint32_t newMaxTextures, uint32_t
     deferredTask(std::packaged_task<void()>([vf = &vf_, device, dp = pimpl_->dpBindless]() {
       vf->vkDestroyDescriptorPool(device, dp, nullptr);
     }));
+    removeMemoryUsage(VulkanMemoryCategory::DescriptorPool, pimpl_->dpBindlessSize);
   }
 
   // create default descriptor set layout which is going to be shared by graphics pipelines
@@ -1523,6 +1850,9 @@ void VulkanContext::growBindlessDescriptorPool(uint32_t newMaxTextures, uint32_t
                                   VK_OBJECT_TYPE_DESCRIPTOR_POOL,
                                   (uint64_t)pimpl_->dpBindless,
                                   "Descriptor Pool: dpBindless_"));
+  pimpl_->dpBindlessSize =
+      getEstimatedDescriptorPoolSize(static_cast<uint32_t>(poolSizes.size()), poolSizes.data());
+  addMemoryUsage(VulkanMemoryCategory::DescriptorPool, pimpl_->dpBindlessSize);
   VK_ASSERT(ivkAllocateDescriptorSet(&vf_,
                                      device,
                                      pimpl_->dpBindless,
@@ -1572,6 +1902,9 @@ Result VulkanContext::waitIdle() const {
   for (VkQueue queue : {deviceQueues_.graphicsQueue, deviceQueues_.computeQueue}) {
     VK_ASSERT_RETURN(vf_.vkQueueWaitIdle(queue));
   }
+  if (deviceQueues_.transferQueue) {
+    VK_ASSERT_RETURN(vf_.vkQueueWaitIdle(deviceQueues_.transferQueue));
+  }
 
   return getResultFromVkResult(VK_SUCCESS);
 }
@@ -2036,17 +2369,89 @@ VulkanContext::RenderPassHandle VulkanContext::findRenderPass(
   return RenderPassHandle{.pass = pass, .index = static_cast<uint8_t>(index)};
 }
 
+ThreadPool& VulkanContext::getPipelineCompilationThreadPool() const {
+  std::call_once(pimpl_->pipelineCompilationPoolOnce, [this]() {
+    pimpl_->pipelineCompilationPool = std::make_unique<igl::ThreadPool>(
+        config_.numPipelineCompilationThreads, "IGL Vulkan Pipelines");
+  });
+  return *pimpl_->pipelineCompilationPool;
+}
+
 std::vector<uint8_t> VulkanContext::getPipelineCacheData() const {
-  size_t size = 0;
-  vf_.vkGetPipelineCacheData(vkDevice_, pipelineCache_, &size, nullptr);
+  return pimpl_->pipelineCache->getData();
+}
+
+void VulkanContext::flushPipelineCache() const {
+  pimpl_->pipelineCache->flush();
+}
+
+VulkanPipelineCacheStats VulkanContext::getPipelineCacheStats() const {
+  return pimpl_->pipelineCache->getStats();
+}
+
+VulkanDescriptorSetCacheStats VulkanContext::getDescriptorSetCacheStats() const {
+  return pimpl_->descriptorSetCacheStats;
+}
 
-  std::vector<uint8_t> data(size);
+VulkanRingBufferUploadStats VulkanContext::getRingBufferUploadStats() const {
+  return {
+      .numBytesRequested = ringBufferBytesRequested_,
+      .numBytesUploaded = ringBufferBytesUploaded_,
+  };
+}
+
+void VulkanContext::addRingBufferUploadStats(uint64_t numBytesRequested,
+                                             uint64_t numBytesUploaded) const {
+  ringBufferBytesRequested_ += numBytesRequested;
+  ringBufferBytesUploaded_ += numBytesUploaded;
+}
 
-  if (size) {
-    vf_.vkGetPipelineCacheData(vkDevice_, pipelineCache_, &size, data.data());
+GPUMemoryUsage VulkanContext::getMemoryUsage() const {
+  GPUMemoryUsage usage;
+  usage.textures = memoryUsage_[static_cast<size_t>(VulkanMemoryCategory::Texture)];
+  usage.buffers = memoryUsage_[static_cast<size_t>(VulkanMemoryCategory::Buffer)];
+  usage.staging = memoryUsage_[static_cast<size_t>(VulkanMemoryCategory::Staging)];
+  usage.descriptorPools = memoryUsage_[static_cast<size_t>(VulkanMemoryCategory::DescriptorPool)];
+
+  if (IGL_VULKAN_USE_VMA && pimpl_->vma) {
+    // without VK_EXT_memory_budget, VMA reports its own allocations and estimates the budget as a
+    // fraction of the heap sizes
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets = {};
+    vmaGetHeapBudgets(pimpl_->vma, budgets.data());
+    for (uint32_t i = 0; i != memoryProperties.memoryHeapCount; i++) {
+      usage.total += budgets[i].usage;
+      usage.budget += budgets[i].budget;
+    }
+  } else {
+    usage.total = usage.textures + usage.buffers + usage.staging + usage.descriptorPools;
   }
 
-  return data;
+  return usage;
+}
+
+void VulkanContext::addMemoryUsage(VulkanMemoryCategory category, VkDeviceSize size) const {
+  IGL_DEBUG_ASSERT(category < VulkanMemoryCategory::Count);
+  memoryUsage_[static_cast<size_t>(category)] += size;
+}
+
+void VulkanContext::removeMemoryUsage(VulkanMemoryCategory category, VkDeviceSize size) const {
+  IGL_DEBUG_ASSERT(category < VulkanMemoryCategory::Count);
+  IGL_DEBUG_ASSERT(memoryUsage_[static_cast<size_t>(category)] >= size);
+  memoryUsage_[static_cast<size_t>(category)] -= size;
+}
+
+glslang::SpirvCache* IGL_NULLABLE VulkanContext::getSpirvCache() const {
+  return pimpl_->spirvCache.get();
+}
+
+bool VulkanContext::hasPipelineCreationFeedback() const {
+  return vkPhysicalDeviceProperties2_.properties.apiVersion >= VK_API_VERSION_1_3 ||
+         features_.has_VK_EXT_pipeline_creation_feedback;
+}
+
+void VulkanContext::recordPipelineCreationFeedback(
+    const VkPipelineCreationFeedback& feedback) const {
+  pimpl_->pipelineCache->recordCreationFeedback(feedback);
 }
 
 uint64_t VulkanContext::getFrameNumber() const {
@@ -2061,19 +2466,18 @@ void VulkanContext::updateBindingsTextures(VkCommandBuffer IGL_NONNULL cmdBuf,
                                            const VulkanDescriptorSetLayout& dsl,
                                            const util::SpvModuleInfo& info) const {
   IGL_PROFILER_FUNCTION();
+  const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
 
   DescriptorPoolsArena& arena = pimpl_->getOrCreateArena_CombinedImageSamplers(
       *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings);
 
-  VkDescriptorSet dset = arena.getNextDescriptorSet(*immediate_, nextSubmitHandle);
-
   // NOLINTNEXTLINE(modernize-avoid-c-arrays)
   VkDescriptorImageInfo infoSampledImages[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
+  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+  uint32_t locations[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
   uint32_t numImages = 0;
 
-  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
-  VkWriteDescriptorSet writes[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
-  uint32_t numWrites = 0;
+  DescriptorSetContents<3 * IGL_TEXTURE_SAMPLERS_MAX> contents;
 
   // make sure the guard value is always there
   IGL_DEBUG_ASSERT(!textures_.objects_.empty());
@@ -2095,19 +2499,32 @@ void VulkanContext::updateBindingsTextures(VkCommandBuffer IGL_NONNULL cmdBuf,
       IGL_DEBUG_ASSERT(data.samplers[loc], "A sampler should be bound to every bound texture slot");
     }
     VkSampler sampler = data.samplers[loc] ? data.samplers[loc] : dummySampler;
-    writes[numWrites++] = ivkGetWriteDescriptorSetImageInfo(
-        dset, loc, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, &infoSampledImages[numImages]);
-    infoSampledImages[numImages++] = VkDescriptorImageInfo{
+    locations[numImages] = loc;
+    infoSampledImages[numImages] = VkDescriptorImageInfo{
         .sampler = hasTexture ? sampler : dummySampler,
         .imageView = hasTexture ? texture : dummyImageView,
         .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
     };
-  }
-
-  if (numWrites) {
-    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
-    vf_.vkUpdateDescriptorSets(vkDevice_, numWrites, writes, 0, nullptr);
-    IGL_PROFILER_ZONE_END();
+    contents.add(loc);
+    contents.add((uint64_t)infoSampledImages[numImages].sampler);
+    contents.add((uint64_t)infoSampledImages[numImages].imageView);
+    numImages++;
+  }
+
+  if (numImages) {
+    VkDescriptorSet dset = pimpl_->findOrWriteDescriptorSet(
+        *this, arena, contents, nextSubmitHandle, [&](VkDescriptorSet newDSet) {
+          // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+          VkWriteDescriptorSet writes[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
+          for (uint32_t i = 0; i != numImages; i++) {
+            writes[i] = ivkGetWriteDescriptorSetImageInfo(newDSet,
+                                                          locations[i],
+                                                          VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                                          1,
+                                                          &infoSampledImages[i]);
+          }
+          vf_.vkUpdateDescriptorSets(vkDevice_, numImages, writes, 0, nullptr);
+        });
 
 #if IGL_VULKAN_PRINT_COMMANDS
     IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - textures\n", cmdBuf, bindPoint);
@@ -2126,19 +2543,18 @@ void VulkanContext::updateBindingsStorageImages(
     const VulkanDescriptorSetLayout& dsl,
     const util::SpvModuleInfo& info) const {
   IGL_PROFILER_FUNCTION();
+  const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
 
   DescriptorPoolsArena& arena = pimpl_->getOrCreateArena_StorageImages(
       *this, dsl.getVkDescriptorSetLayout(), dsl.numBindings);
 
-  VkDescriptorSet dset = arena.getNextDescriptorSet(*immediate_, nextSubmitHandle);
-
   // NOLINTNEXTLINE(modernize-avoid-c-arrays)
   VkDescriptorImageInfo infoStorageImages[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
+  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+  uint32_t locations[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
   uint32_t numStorageImages = 0;
 
-  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
-  VkWriteDescriptorSet writes[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
-  uint32_t numWrites = 0;
+  DescriptorSetContents<2 * IGL_TEXTURE_SAMPLERS_MAX> contents;
 
   // make sure the guard value is always there
   IGL_DEBUG_ASSERT(!textures_.objects_.empty());
@@ -2151,19 +2567,28 @@ void VulkanContext::updateBindingsStorageImages(
     const uint32_t loc = d.bindingLocation;
     IGL_DEBUG_ASSERT(loc < IGL_TEXTURE_SAMPLERS_MAX);
     VkImageView imageView = data.images[loc];
-    writes[numWrites++] = ivkGetWriteDescriptorSetImageInfo(
-        dset, loc, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, &infoStorageImages[numStorageImages]);
-    infoStorageImages[numStorageImages++] = VkDescriptorImageInfo{
+    locations[numStorageImages] = loc;
+    infoStorageImages[numStorageImages] = VkDescriptorImageInfo{
         .sampler = VK_NULL_HANDLE,
         .imageView = imageView ? imageView : dummyImageView,
         .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
     };
-  }
-
-  if (numWrites) {
-    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
-    vf_.vkUpdateDescriptorSets(vkDevice_, numWrites, writes, 0, nullptr);
-    IGL_PROFILER_ZONE_END();
+    contents.add(loc);
+    contents.add((uint64_t)infoStorageImages[numStorageImages].imageView);
+    numStorageImages++;
+  }
+
+  if (numStorageImages) {
+    VkDescriptorSet dset = pimpl_->findOrWriteDescriptorSet(
+        *this, arena, contents, nextSubmitHandle, [&](VkDescriptorSet newDSet) {
+          // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+          VkWriteDescriptorSet writes[IGL_TEXTURE_SAMPLERS_MAX]; // uninitialized
+          for (uint32_t i = 0; i != numStorageImages; i++) {
+            writes[i] = ivkGetWriteDescriptorSetImageInfo(
+                newDSet, locations[i], VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, &infoStorageImages[i]);
+          }
+          vf_.vkUpdateDescriptorSets(vkDevice_, numStorageImages, writes, 0, nullptr);
+        });
 
 #if IGL_VULKAN_PRINT_COMMANDS
     IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - storage images\n", cmdBuf, bindPoint);
@@ -2179,17 +2604,27 @@ void VulkanContext::updateBindingsBuffers(VkCommandBuffer IGL_NONNULL cmdBuf,
                                           VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
                                           BindingsBuffers& data,
                                           const VulkanDescriptorSetLayout& dsl,
-                                          const util::SpvModuleInfo& info) const {
+                                          const util::SpvModuleInfo& info,
+                                          uint32_t dynamicBufferMask) const {
   IGL_PROFILER_FUNCTION();
+  const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
 
   DescriptorPoolsArena& arena =
       pimpl_->getOrCreateArena_Buffers(*this, dsl.getVkDescriptorSetLayout(), dsl.numBindings);
 
-  VkDescriptorSet dset = arena.getNextDescriptorSet(*immediate_, nextSubmitHandle);
+  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+  const util::BufferDescription* descs[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+  uint32_t numBuffers = 0;
 
+  // dynamic buffers are written at offset 0 and their offsets are passed to
+  // vkCmdBindDescriptorSets(), ordered by binding location
   // NOLINTNEXTLINE(modernize-avoid-c-arrays)
-  VkWriteDescriptorSet writes[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
-  uint32_t numWrites = 0;
+  VkDescriptorBufferInfo dynamicBufferInfos[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+  // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+  uint32_t dynamicOffsets[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+  uint32_t numDynamicOffsets = 0;
+
+  DescriptorSetContents<4 * IGL_UNIFORM_BLOCKS_BINDING_MAX> contents;
 
   for (const util::BufferDescription& b : info.buffers) {
     IGL_DEBUG_ASSERT(b.descriptorSet == kBindPoint_Buffers);
@@ -2198,25 +2633,123 @@ void VulkanContext::updateBindingsBuffers(VkCommandBuffer IGL_NONNULL cmdBuf,
         IGL_FORMAT("Did you forget to call bindBuffer() for a buffer at the binding location {}?",
                    b.bindingLocation)
             .c_str());
-    writes[numWrites++] = ivkGetWriteDescriptorSetBufferInfo(
-        dset,
-        b.bindingLocation,
-        b.isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-        1,
-        &data.buffers[b.bindingLocation]);
+    const bool isDynamic = (dynamicBufferMask & (1u << b.bindingLocation)) != 0;
+    const VkDescriptorBufferInfo& bufferInfo = data.buffers[b.bindingLocation];
+    descs[numBuffers++] = &b;
+    contents.add((uint64_t(b.bindingLocation) << 1) | uint64_t(b.isStorage));
+    contents.add((uint64_t)bufferInfo.buffer);
+    contents.add(isDynamic ? 0 : bufferInfo.offset);
+    contents.add(bufferInfo.range);
+    if (isDynamic) {
+      dynamicBufferInfos[b.bindingLocation] = {
+          .buffer = bufferInfo.buffer,
+          .offset = 0,
+          .range = bufferInfo.range,
+      };
+    }
   }
 
-  if (numWrites) {
-    IGL_PROFILER_ZONE("vkUpdateDescriptorSets()", IGL_PROFILER_COLOR_UPDATE);
-    vf_.vkUpdateDescriptorSets(vkDevice_, numWrites, writes, 0, nullptr);
-    IGL_PROFILER_ZONE_END();
+  for (uint32_t loc = 0; loc != IGL_UNIFORM_BLOCKS_BINDING_MAX; loc++) {
+    if ((dynamicBufferMask & (1u << loc)) != 0) {
+      dynamicOffsets[numDynamicOffsets++] = static_cast<uint32_t>(data.buffers[loc].offset);
+    }
+  }
+
+  if (numBuffers) {
+    VkDescriptorSet dset = pimpl_->findOrWriteDescriptorSet(
+        *this, arena, contents, nextSubmitHandle, [&](VkDescriptorSet newDSet) {
+          // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+          VkWriteDescriptorSet writes[IGL_UNIFORM_BLOCKS_BINDING_MAX]; // uninitialized
+          for (uint32_t i = 0; i != numBuffers; i++) {
+            const util::BufferDescription& b = *descs[i];
+            const bool isDynamic = (dynamicBufferMask & (1u << b.bindingLocation)) != 0;
+            const VkDescriptorType type =
+                b.isStorage ? (isDynamic ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC
+                                         : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER)
+                            : (isDynamic ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
+                                         : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER);
+            writes[i] = ivkGetWriteDescriptorSetBufferInfo(
+                newDSet,
+                b.bindingLocation,
+                type,
+                1,
+                isDynamic ? &dynamicBufferInfos[b.bindingLocation]
+                          : &data.buffers[b.bindingLocation]);
+          }
+          vf_.vkUpdateDescriptorSets(vkDevice_, numBuffers, writes, 0, nullptr);
+        });
 
 #if IGL_VULKAN_PRINT_COMMANDS
     IGL_LOG_INFO("%p vkCmdBindDescriptorSets(%u) - buffers\n", cmdBuf, bindPoint);
 #endif // IGL_VULKAN_PRINT_COMMANDS
-    vf_.vkCmdBindDescriptorSets(
-        cmdBuf, bindPoint, layout, kBindPoint_Buffers, 1, &dset, 0, nullptr);
+    vf_.vkCmdBindDescriptorSets(cmdBuf,
+                                bindPoint,
+                                layout,
+                                kBindPoint_Buffers,
+                                1,
+                                &dset,
+                                numDynamicOffsets,
+                                numDynamicOffsets ? dynamicOffsets : nullptr);
+  }
+}
+
+void VulkanContext::updateBindingsBuffersByPushDescriptors(VkCommandBuffer IGL_NONNULL cmdBuf,
+                                                           VkPipelineLayout layout,
+                                                           VkPipelineBindPoint bindPoint,
+                                                           const BindingsBuffers& data,
+                                                           const PipelineState& state) const {
+  IGL_PROFILER_FUNCTION();
+
+  IGL_DEBUG_ASSERT(state.usePushDescriptors);
+
+  for (const util::BufferDescription& b : state.info.buffers) {
+    IGL_DEBUG_ASSERT(b.descriptorSet == kBindPoint_Buffers);
+    IGL_DEBUG_ASSERT(
+        data.buffers[b.bindingLocation].buffer != VK_NULL_HANDLE,
+        IGL_FORMAT("Did you forget to call bindBuffer() for a buffer at the binding location {}?",
+                   b.bindingLocation)
+            .c_str());
+  }
+
+  VkDescriptorUpdateTemplate tmpl = VK_NULL_HANDLE;
+  {
+    const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
+    tmpl = pimpl_->getOrCreatePushDescriptorTemplate(*this, layout, bindPoint, state);
   }
+
+#if IGL_VULKAN_PRINT_COMMANDS
+  IGL_LOG_INFO("%p vkCmdPushDescriptorSetWithTemplateKHR(%u) - buffers\n", cmdBuf, bindPoint);
+#endif // IGL_VULKAN_PRINT_COMMANDS
+  vf_.vkCmdPushDescriptorSetWithTemplateKHR(cmdBuf, tmpl, layout, kBindPoint_Buffers, &data);
+}
+
+void VulkanContext::updateBindingsBuffersByPushDescriptors(VkCommandBuffer IGL_NONNULL cmdBuf,
+                                                           VkPipelineLayout layout,
+                                                           VkPipelineBindPoint bindPoint,
+                                                           BindGroupBufferHandle handle,
+                                                           const PipelineState& state) const {
+  const BindGroupMetadataBuffers* metadata = pimpl_->bindGroupBuffersPool.get(handle);
+
+  if (!IGL_DEBUG_VERIFY(metadata)) {
+    return;
+  }
+
+  const BindGroupBufferDesc& desc = metadata->desc;
+
+  BindingsBuffers data;
+
+  for (uint32_t loc = 0; loc != IGL_ARRAY_NUM_ELEMENTS(desc.buffers); loc++) {
+    if (!desc.buffers[loc]) {
+      continue;
+    }
+    data.buffers[loc] = VkDescriptorBufferInfo{
+        .buffer = static_cast<Buffer*>(desc.buffers[loc].get())->getVkBuffer(),
+        .offset = desc.offset[loc],
+        .range = desc.size[loc] ? desc.size[loc] : VK_WHOLE_SIZE,
+    };
+  }
+
+  updateBindingsBuffersByPushDescriptors(cmdBuf, layout, bindPoint, data, state);
 }
 
 void VulkanContext::updateBindingsTexturesByDescriptorBuffer(
@@ -2246,6 +2779,8 @@ void VulkanContext::updateBindingsTexturesByDescriptorBuffer(
   auto alignment = vkPhysicalDeviceDescriptorBufferProperties_.descriptorBufferOffsetAlignment;
   auto layoutSize = dsl.layoutSize;
 
+  // the lock also covers the writes into the returned range of the descriptor buffer
+  const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
   auto& descriptorBuffer = pimpl_->descriptorBuffersArena->getDescriptorBuffer(
       layoutSize, alignment, *immediate_, nextSubmitHandle);
 
@@ -2325,6 +2860,8 @@ void VulkanContext::updateBindingsStorageImagesByDescriptorBuffer(
   auto alignment = vkPhysicalDeviceDescriptorBufferProperties_.descriptorBufferOffsetAlignment;
   auto layoutSize = dsl.layoutSize;
 
+  // the lock also covers the writes into the returned range of the descriptor buffer
+  const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
   auto& descriptorBuffer = pimpl_->descriptorBuffersArena->getDescriptorBuffer(
       layoutSize, alignment, *immediate_, nextSubmitHandle);
 
@@ -2398,6 +2935,8 @@ void VulkanContext::updateBindingsBuffersByDescriptorBuffer(
   auto alignment = vkPhysicalDeviceDescriptorBufferProperties_.descriptorBufferOffsetAlignment;
   auto layoutSize = dsl.layoutSize;
 
+  // the lock also covers the writes into the returned range of the descriptor buffer
+  const std::lock_guard<std::mutex> lock(pimpl_->descriptorArenasMutex);
   auto& descriptorBuffer = pimpl_->descriptorBuffersArena->getDescriptorBuffer(
       layoutSize, alignment, *immediate_, nextSubmitHandle);
 
@@ -2457,6 +2996,7 @@ void VulkanContext::deferredTask(std::packaged_task<void()>&& task, SubmitHandle
   if (handle.empty()) {
     handle = immediate_->getNextSubmitHandle();
   }
+  const std::lock_guard<std::mutex> lock(pimpl_->deferredTasksMutex);
   deferredTasks.emplace_back(std::move(task), handle);
   deferredTasks.back().frameId = this->getFrameNumber();
 }
@@ -2818,6 +3358,8 @@ BindGroupTextureHandle VulkanContext::createBindGroup(const BindGroupTextureDesc
         (uint64_t)metadata.pool,
         IGL_FORMAT("Descriptor Pool (COMBINED_IMAGE_SAMPLER): BindGroup = {}", desc.debugName)
             .c_str()));
+    metadata.poolSize = getEstimatedDescriptorPoolSize(1u, &poolSize);
+    addMemoryUsage(VulkanMemoryCategory::DescriptorPool, metadata.poolSize);
 
     VK_ASSERT(ivkAllocateDescriptorSet(&vf_, device, metadata.pool, dsl, &metadata.dset));
   }
@@ -2995,6 +3537,8 @@ BindGroupBufferHandle VulkanContext::createBindGroup(const BindGroupBufferDesc&
         VK_OBJECT_TYPE_DESCRIPTOR_POOL,
         (uint64_t)metadata.pool,
         IGL_FORMAT("Descriptor Pool (BUFFERS): BindGroup = {}", desc.debugName).c_str()));
+    metadata.poolSize = getEstimatedDescriptorPoolSize(numPoolSizes, poolSizes);
+    addMemoryUsage(VulkanMemoryCategory::DescriptorPool, metadata.poolSize);
 
     VK_ASSERT(ivkAllocateDescriptorSet(&vf_, device, metadata.pool, dsl, &metadata.dset));
   }
@@ -3053,6 +3597,8 @@ void VulkanContext::destroy(BindGroupTextureHandle handle) {
       [vf = &vf_, device = getVkDevice(), pool = pimpl_->bindGroupTexturesPool.get(handle)->pool] {
         vf->vkDestroyDescriptorPool(device, pool, nullptr);
       }));
+  removeMemoryUsage(VulkanMemoryCategory::DescriptorPool,
+                    pimpl_->bindGroupTexturesPool.get(handle)->poolSize);
 
   pimpl_->bindGroupTexturesPool.destroy(handle);
 }
@@ -3066,6 +3612,8 @@ void VulkanContext::destroy(BindGroupBufferHandle handle) {
       [vf = &vf_, device = getVkDevice(), pool = pimpl_->bindGroupBuffersPool.get(handle)->pool] {
         vf->vkDestroyDescriptorPool(device, pool, nullptr);
       }));
+  removeMemoryUsage(VulkanMemoryCategory::DescriptorPool,
+                    pimpl_->bindGroupBuffersPool.get(handle)->poolSize);
 
   pimpl_->bindGroupBuffersPool.destroy(handle);
 }
@@ -3122,6 +3670,10 @@ void VulkanContext::syncAcquireNext() noexcept {
 
   // Wait for the current buffer to become available
   immediate_->wait(syncSubmitHandles[syncCurrentIndex], config_.fenceTimeoutNanoseconds);
+
+  if (uniformRing_) {
+    uniformRing_->recycle(syncCurrentIndex);
+  }
 }
 
 void VulkanContext::syncMarkSubmitted(VulkanImmediateCommands::SubmitHandle handle) noexcept {
@@ -3139,6 +3691,27 @@ void VulkanContext::ensureCurrentContextThread() const {
       "`setCurrentContextThread()` to mark the current thread as the `owning` thread.");
 }
 
+void VulkanContext::ensureRecordingThread() const {
+  IGL_DEBUG_ASSERT(
+      pimpl_->contextThread == std::this_thread::get_id() ||
+          (tlsRecordingContext == this && tlsNumRecordingEncoders > 0),
+      "IGL/Vulkan commands can only be recorded on the context thread or in a secondary encoder "
+      "of a ParallelRenderCommandEncoder.");
+}
+
+void VulkanContext::beginRecordingThread() const {
+  IGL_DEBUG_ASSERT(tlsRecordingContext == nullptr || tlsRecordingContext == this);
+  tlsRecordingContext = this;
+  tlsNumRecordingEncoders++;
+}
+
+void VulkanContext::endRecordingThread() const {
+  IGL_DEBUG_ASSERT(tlsRecordingContext == this && tlsNumRecordingEncoders > 0);
+  if (--tlsNumRecordingEncoders == 0) {
+    tlsRecordingContext = nullptr;
+  }
+}
+
 void VulkanContext::setCurrentContextThread() {
   pimpl_->contextThread = std::this_thread::get_id();
 }
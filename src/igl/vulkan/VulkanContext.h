@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <future>
@@ -14,14 +15,19 @@
 #include <memory>
 #include <unordered_map>
 #include <igl/CommandEncoder.h>
+#include <igl/Device.h>
 #include <igl/HWDevice.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanFeatures.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanImmediateCommands.h>
+#include <igl/vulkan/VulkanMipmapGenerator.h>
 #include <igl/vulkan/VulkanQueuePool.h>
+#include <igl/vulkan/VulkanReadbackRing.h>
 #include <igl/vulkan/VulkanRenderPassBuilder.h>
 #include <igl/vulkan/VulkanStagingDevice.h>
+#include <igl/vulkan/VulkanThreadCommandPools.h>
+#include <igl/vulkan/VulkanUniformRing.h>
 
 #if defined(IGL_ANDROID_HWBUFFER_SUPPORTED)
 struct AHardwareBuffer;
@@ -35,7 +41,11 @@ struct AHardwareBuffer;
 
 namespace igl {
 class IRenderPipelineState;
-}
+class ThreadPool;
+namespace glslang {
+class SpirvCache;
+} // namespace glslang
+} // namespace igl
 
 namespace igl::vulkan {
 namespace util {
@@ -44,6 +54,7 @@ struct SpvModuleInfo;
 
 class CommandQueue;
 class ComputeCommandEncoder;
+class PipelineState;
 class RenderCommandEncoder;
 class VulkanBuffer;
 class VulkanDescriptorSetLayout;
@@ -55,6 +66,7 @@ class VulkanTexture;
 struct BindingsBuffers;
 struct BindingsTextures;
 struct BindingsStorageImages;
+struct VulkanPipelineCacheStats;
 struct VulkanContextImpl;
 struct VulkanImageCreateInfo;
 struct VulkanImageViewCreateInfo;
@@ -75,13 +87,44 @@ enum {
 };
 // NOLINTEND(readability-identifier-naming)
 
+/// @brief Counters of the descriptor set cache (see VulkanContextConfig::enableDescriptorSetCache)
+struct VulkanDescriptorSetCacheStats {
+  /// the number of descriptor sets reused without calling vkUpdateDescriptorSets()
+  uint64_t numHits = 0;
+  /// the number of descriptor sets which had to be written
+  uint64_t numMisses = 0;
+};
+
+/// @brief Counters of the uploads to ring buffers (BufferDesc::BufferAPIHintBits::Ring)
+struct VulkanRingBufferUploadStats {
+  /// the number of bytes passed to IBuffer::upload()
+  uint64_t numBytesRequested = 0;
+  /// the number of bytes written to the ring buffer slots, including the ranges which a slot
+  /// replays from the uploads to the other slots
+  uint64_t numBytesUploaded = 0;
+};
+
+/// @brief Categories of GPU memory reported by VulkanContext::getMemoryUsage()
+enum class VulkanMemoryCategory : uint8_t {
+  Texture = 0,
+  Buffer,
+  Staging,
+  DescriptorPool,
+  Count,
+};
+
 struct DeviceQueues {
   static constexpr uint32_t kInvalid = 0xFFFFFFFF;
   uint32_t graphicsQueueFamilyIndex = kInvalid;
   uint32_t computeQueueFamilyIndex = kInvalid;
+  // a transfer-only queue, used by VulkanStagingDevice if VulkanContextConfig::enableTransferQueue
+  uint32_t transferQueueFamilyIndex = kInvalid;
 
   VkQueue IGL_NULLABLE graphicsQueue = VK_NULL_HANDLE;
   VkQueue IGL_NULLABLE computeQueue = VK_NULL_HANDLE;
+  VkQueue IGL_NULLABLE transferQueue = VK_NULL_HANDLE;
+
+  VkExtent3D transferQueueImageGranularity = {};
 };
 
 struct DescriptorBuffer {
@@ -233,6 +276,44 @@ class VulkanContext final {
 
   std::vector<uint8_t> getPipelineCacheData() const;
 
+  /// @brief Flushes the pipeline cache to `VulkanContextConfig::pipelineCachePath` if it changed
+  void flushPipelineCache() const;
+  [[nodiscard]] VulkanPipelineCacheStats getPipelineCacheStats() const;
+  [[nodiscard]] VulkanDescriptorSetCacheStats getDescriptorSetCacheStats() const;
+  [[nodiscard]] VulkanRingBufferUploadStats getRingBufferUploadStats() const;
+  /// @brief Updates the counters reported by getRingBufferUploadStats()
+  void addRingBufferUploadStats(uint64_t numBytesRequested, uint64_t numBytesUploaded) const;
+
+  /// @brief Returns the memory used by images, buffers and descriptor pools created by this
+  /// context. With VMA, `total` and `budget` come from the VMA heap budgets.
+  [[nodiscard]] GPUMemoryUsage getMemoryUsage() const;
+  /// @brief Updates the memory usage reported by getMemoryUsage()
+  void addMemoryUsage(VulkanMemoryCategory category, VkDeviceSize size) const;
+  void removeMemoryUsage(VulkanMemoryCategory category, VkDeviceSize size) const;
+
+  /// @brief Returns the cache of compiled GLSL shaders, or nullptr if it is disabled
+  [[nodiscard]] glslang::SpirvCache* IGL_NULLABLE getSpirvCache() const;
+
+  /// @brief True if VkPipelineCreationFeedback can be requested when building pipelines
+  [[nodiscard]] bool hasPipelineCreationFeedback() const;
+
+  /// @brief True if render command encoders use vkCmdBeginRendering() and graphics pipelines are
+  /// created without a VkRenderPass (see `VulkanContextConfig::enableDynamicRendering`)
+  [[nodiscard]] bool useDynamicRendering() const {
+    return useDynamicRendering_;
+  }
+  /// @brief True if graphics pipelines are linked from pipeline libraries (see
+  /// `VulkanContextConfig::enableGraphicsPipelineLibrary`)
+  [[nodiscard]] bool useGraphicsPipelineLibrary() const {
+    return useGraphicsPipelineLibrary_;
+  }
+  /// @brief Accumulates pipeline cache hits and misses. Can be called from any thread.
+  void recordPipelineCreationFeedback(const VkPipelineCreationFeedback& feedback) const;
+
+  /// @brief Returns the worker threads used to build Vulkan pipelines off the render thread. The
+  /// pool is created on first use with `VulkanContextConfig::numPipelineCompilationThreads`.
+  ThreadPool& getPipelineCompilationThreadPool() const;
+
   uint64_t getFrameNumber() const;
 
   using SubmitHandle = VulkanImmediateCommands::SubmitHandle;
@@ -274,6 +355,9 @@ class VulkanContext final {
   }
 
   void ensureCurrentContextThread() const;
+  /// @brief Like ensureCurrentContextThread(), but also accepts worker threads while they record a
+  /// secondary encoder of a ParallelRenderCommandEncoder
+  void ensureRecordingThread() const;
   void setCurrentContextThread();
 
 #if defined(IGL_WITH_TRACY_GPU)
@@ -301,6 +385,9 @@ class VulkanContext final {
   void pruneTextures();
   void querySurfaceCapabilities();
   void processDeferredTasks() const;
+  // mark the calling thread as recording a secondary encoder (see ensureRecordingThread())
+  void beginRecordingThread() const;
+  void endRecordingThread() const;
   void growBindlessDescriptorPool(uint32_t newMaxTextures, uint32_t newMaxSamplers);
   BindGroupTextureHandle createBindGroup(const BindGroupTextureDesc& desc,
                                          const IRenderPipelineState* IGL_NULLABLE
@@ -323,6 +410,7 @@ class VulkanContext final {
   friend class VulkanSwapchain;
   friend class CommandQueue;
   friend class ComputeCommandEncoder;
+  friend class ParallelRenderCommandEncoder;
   friend class RenderCommandEncoder;
 
   // should be kept on the heap, otherwise global Vulkan functions can cause arbitrary crashes.
@@ -357,12 +445,19 @@ class VulkanContext final {
   std::unique_ptr<VulkanSwapchain> swapchain_;
   std::unique_ptr<VulkanSemaphore> timelineSemaphore_;
   std::unique_ptr<VulkanImmediateCommands> immediate_;
+  // secondary command buffers recorded by worker threads (see ParallelRenderCommandEncoder)
+  std::unique_ptr<VulkanThreadCommandPools> threadCommandPools_;
   std::unique_ptr<VulkanStagingDevice> stagingDevice_;
+  std::unique_ptr<VulkanReadbackRing> readbackRing_;
+  std::unique_ptr<VulkanUniformRing> uniformRing_;
+  std::unique_ptr<VulkanMipmapGenerator> mipmapGenerator_;
 
   std::unique_ptr<VulkanBuffer> dummyUniformBuffer_;
   std::unique_ptr<VulkanBuffer> dummyStorageBuffer_;
   // don't use staging on devices with device-local host-visible memory
   bool useStagingForBuffers_ = true;
+  bool useDynamicRendering_ = false;
+  bool useGraphicsPipelineLibrary_ = false;
 
   std::unique_ptr<VulkanContextImpl> pimpl_;
 
@@ -395,7 +490,12 @@ class VulkanContext final {
   mutable bool awaitingCreation_ = false;
 
   mutable std::atomic<size_t> drawCallCount_{0};
+  // bytes of memory per VulkanMemoryCategory
+  mutable std::array<std::atomic<uint64_t>, static_cast<size_t>(VulkanMemoryCategory::Count)>
+      memoryUsage_ = {};
   mutable std::atomic<size_t> shaderCompilationCount_{0};
+  mutable std::atomic<uint64_t> ringBufferBytesRequested_{0};
+  mutable std::atomic<uint64_t> ringBufferBytesUploaded_{0};
 
   // stores an index into renderPasses_
   mutable std::
@@ -420,7 +520,8 @@ class VulkanContext final {
                              VulkanImmediateCommands::SubmitHandle nextSubmitHandle,
                              BindingsBuffers& data,
                              const VulkanDescriptorSetLayout& dsl,
-                             const util::SpvModuleInfo& info) const;
+                             const util::SpvModuleInfo& info,
+                             uint32_t dynamicBufferMask = 0) const;
   void updateBindingsStorageImages(VkCommandBuffer IGL_NONNULL cmdBuf,
                                    VkPipelineLayout layout,
                                    VkPipelineBindPoint bindPoint,
@@ -452,6 +553,17 @@ class VulkanContext final {
       const BindingsStorageImages& data,
       const VulkanDescriptorSetLayout& dsl,
       const util::SpvModuleInfo& info) const;
+  // requires PipelineState::usePushDescriptors; no descriptor sets are allocated
+  void updateBindingsBuffersByPushDescriptors(VkCommandBuffer IGL_NONNULL cmdBuf,
+                                              VkPipelineLayout layout,
+                                              VkPipelineBindPoint bindPoint,
+                                              const BindingsBuffers& data,
+                                              const PipelineState& state) const;
+  void updateBindingsBuffersByPushDescriptors(VkCommandBuffer IGL_NONNULL cmdBuf,
+                                              VkPipelineLayout layout,
+                                              VkPipelineBindPoint bindPoint,
+                                              BindGroupBufferHandle handle,
+                                              const PipelineState& state) const;
 
   struct DeferredTask {
     DeferredTask(std::packaged_task<void()>&& task, SubmitHandle handle) :
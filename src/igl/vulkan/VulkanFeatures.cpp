@@ -151,6 +151,14 @@ VulkanFeatures::VulkanFeatures(VulkanContextConfig config) noexcept :
       .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_2_FEATURES_EXT,
       .extendedDynamicState2 = VK_TRUE,
   }),
+  featuresDynamicRendering({
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
+      .dynamicRendering = VK_TRUE,
+  }),
+  featuresGraphicsPipelineLibrary({
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_GRAPHICS_PIPELINE_LIBRARY_FEATURES_EXT,
+      .graphicsPipelineLibrary = VK_TRUE,
+  }),
   config(config) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
 
@@ -312,6 +320,8 @@ void VulkanFeatures::assembleFeatureChain(const VulkanContextConfig& contextConf
   featuresTextureCompressionAstcHdr.pNext = nullptr;
   featuresExtendedDynamicState.pNext = nullptr;
   featuresExtendedDynamicState2.pNext = nullptr;
+  featuresDynamicRendering.pNext = nullptr;
+  featuresGraphicsPipelineLibrary.pNext = nullptr;
 
   // Add the required and optional features to the VkPhysicalDeviceFetaures2_
   ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresSamplerYcbcrConversion);
@@ -376,6 +386,14 @@ void VulkanFeatures::assembleFeatureChain(const VulkanContextConfig& contextConf
   if (hasExtension(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME)) {
     ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresExtendedDynamicState2);
   }
+  if (hasExtension(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME)) {
+    ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresDynamicRendering);
+  }
+  if (contextConfig.enableGraphicsPipelineLibrary &&
+      hasExtension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME) &&
+      hasExtension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME)) {
+    ivkAddNext(&vkPhysicalDeviceFeatures2, &featuresGraphicsPipelineLibrary);
+  }
 }
 
 // NOLINTNEXTLINE(bugprone-exception-escape)
@@ -416,6 +434,8 @@ VulkanFeatures& VulkanFeatures::operator=(const VulkanFeatures& other) noexcept
   featuresTextureCompressionAstcHdr = other.featuresTextureCompressionAstcHdr;
   featuresExtendedDynamicState = other.featuresExtendedDynamicState;
   featuresExtendedDynamicState2 = other.featuresExtendedDynamicState2;
+  featuresDynamicRendering = other.featuresDynamicRendering;
+  featuresGraphicsPipelineLibrary = other.featuresGraphicsPipelineLibrary;
 
   extensions_ = other.extensions_;
   enabledExtensions_ = other.enabledExtensions_;
@@ -597,6 +617,11 @@ void VulkanFeatures::enableCommonDeviceExtensions(const VulkanContextConfig& con
   has_VK_EXT_descriptor_indexing =
       enable(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME, ExtensionType::Device);
 
+  if (contextConfig.enablePushDescriptors) {
+    has_VK_KHR_push_descriptor =
+        enable(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME, ExtensionType::Device);
+  }
+
   has_VK_EXT_fragment_density_map =
       enable(VK_EXT_FRAGMENT_DENSITY_MAP_EXTENSION_NAME, ExtensionType::Device);
 
@@ -609,6 +634,10 @@ void VulkanFeatures::enableCommonDeviceExtensions(const VulkanContextConfig& con
 
   has_VK_EXT_mesh_shader = enable(VK_EXT_MESH_SHADER_EXTENSION_NAME, ExtensionType::Device);
 
+  // used to count pipeline cache hits and misses
+  has_VK_EXT_pipeline_creation_feedback =
+      enable(VK_EXT_PIPELINE_CREATION_FEEDBACK_EXTENSION_NAME, ExtensionType::Device);
+
   // VK_EXT_extended_dynamic_state / _state2 (promoted to core in Vulkan 1.3).
   // Only meaningful when device apiVersion < 1.3; on >= 1.3 core entry points are used
   // directly. Enabling here as extensions also loads the *EXT-suffixed function pointers.
@@ -617,6 +646,20 @@ void VulkanFeatures::enableCommonDeviceExtensions(const VulkanContextConfig& con
   has_VK_EXT_extended_dynamic_state2 =
       enable(VK_EXT_EXTENDED_DYNAMIC_STATE_2_EXTENSION_NAME, ExtensionType::Device);
 
+  // VK_KHR_dynamic_rendering (promoted to core in Vulkan 1.3). Enabled whenever available so that
+  // its feature struct is always valid in the device creation chain; whether it is actually used
+  // is decided by VulkanContextConfig::enableDynamicRendering.
+  has_VK_KHR_dynamic_rendering =
+      enable(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, ExtensionType::Device);
+
+  // VK_EXT_graphics_pipeline_library depends on VK_KHR_pipeline_library
+  if (contextConfig.enableGraphicsPipelineLibrary &&
+      available(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, ExtensionType::Device)) {
+    has_VK_EXT_graphics_pipeline_library =
+        enable(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME, ExtensionType::Device) &&
+        enable(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME, ExtensionType::Device);
+  }
+
   // Enable fragment shading rate extension (required when primitiveFragmentShadingRateMeshShader is
   // used)
   enable(VK_KHR_FRAGMENT_SHADING_RATE_EXTENSION_NAME, ExtensionType::Device);
@@ -78,6 +78,10 @@ class VulkanFeatures final {
   VkPhysicalDeviceExtendedDynamicStateFeaturesEXT featuresExtendedDynamicState{};
   // VK_EXT_extended_dynamic_state2 (promoted to Vulkan 1.3)
   VkPhysicalDeviceExtendedDynamicState2FeaturesEXT featuresExtendedDynamicState2{};
+  // VK_KHR_dynamic_rendering (promoted to Vulkan 1.3)
+  VkPhysicalDeviceDynamicRenderingFeaturesKHR featuresDynamicRendering{};
+  // VK_EXT_graphics_pipeline_library
+  VkPhysicalDeviceGraphicsPipelineLibraryFeaturesEXT featuresGraphicsPipelineLibrary{};
 
   // We need to reassemble the feature chain because of the pNext pointers
   VulkanFeatures& operator=(const VulkanFeatures& other) noexcept;
@@ -121,15 +125,18 @@ class VulkanFeatures final {
   bool has_VK_EXT_descriptor_buffer = false;
   bool has_VK_EXT_descriptor_indexing = false; // promoted to Vulkan 1.2
   bool has_VK_EXT_fragment_density_map = false;
+  bool has_VK_EXT_graphics_pipeline_library = false;
   bool has_VK_EXT_headless_surface = false;
   bool has_VK_EXT_index_type_uint8 = false; // promoted to Vulkan 1.4
   bool has_VK_EXT_mesh_shader = false;
+  bool has_VK_EXT_pipeline_creation_feedback = false; // promoted to Vulkan 1.3
   bool has_VK_EXT_queue_family_foreign = false;
   bool has_VK_EXT_scalar_block_layout = false; // promoted to Vulkan 1.2
   bool has_VK_KHR_8bit_storage = false; // promoted to Vulkan 1.2
   bool has_VK_KHR_buffer_device_address = false; // promoted to Vulkan 1.2
   bool has_VK_KHR_get_surface_capabilities2 = false;
   bool has_VK_KHR_portability_enumeration = false;
+  bool has_VK_KHR_push_descriptor = false;
   bool has_VK_KHR_shader_non_semantic_info = false; // promoted to Vulkan 1.3
   bool has_VK_KHR_synchronization2 = false; // promoted to Vulkan 1.3
   bool has_VK_KHR_timeline_semaphore = false; // promoted to Vulkan 1.2
@@ -138,6 +145,7 @@ class VulkanFeatures final {
   bool has_VK_QCOM_multiview_per_view_viewports = false;
   bool has_VK_EXT_extended_dynamic_state = false; // promoted to Vulkan 1.3
   bool has_VK_EXT_extended_dynamic_state2 = false; // promoted to Vulkan 1.3
+  bool has_VK_KHR_dynamic_rendering = false; // promoted to Vulkan 1.3
   // NOLINTEND(readability-identifier-naming)
 
  private:
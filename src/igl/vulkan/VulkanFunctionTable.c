@@ -1072,6 +1072,10 @@ void loadVulkanDeviceFunctions(struct VulkanFunctionTable* table,
   table->vkCmdBeginRenderingKHR =
       (PFN_vkCmdBeginRenderingKHR)load(context, "vkCmdBeginRenderingKHR");
   table->vkCmdEndRenderingKHR = (PFN_vkCmdEndRenderingKHR)load(context, "vkCmdEndRenderingKHR");
+  if (vulkanAPIVersion < VK_API_VERSION_1_3) {
+    table->vkCmdBeginRendering = table->vkCmdBeginRenderingKHR;
+    table->vkCmdEndRendering = table->vkCmdEndRenderingKHR;
+  }
 #endif /* defined(VK_KHR_dynamic_rendering) */
 #if defined(VK_KHR_external_fence_fd)
   table->vkGetFenceFdKHR = (PFN_vkGetFenceFdKHR)load(context, "vkGetFenceFdKHR");
@@ -530,6 +530,7 @@ VkResult ivkCreateGraphicsPipeline(const struct VulkanFunctionTable* vt,
                                    VkDevice device,
                                    VkPipelineCache pipelineCache,
                                    VkPipelineCreateFlags flags,
+                                   const void* pNext,
                                    uint32_t numShaderStages,
                                    const VkPipelineShaderStageCreateInfo* shaderStages,
                                    const VkPipelineVertexInputStateCreateInfo* vertexInputState,
@@ -546,7 +547,7 @@ VkResult ivkCreateGraphicsPipeline(const struct VulkanFunctionTable* vt,
                                    VkPipeline* outPipeline) {
   const VkGraphicsPipelineCreateInfo ci = {
       .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-      .pNext = NULL,
+      .pNext = pNext,
       .flags = flags,
       .stageCount = numShaderStages,
       .pStages = shaderStages,
@@ -590,22 +591,13 @@ void ivkImageMemoryBarrier(const struct VulkanFunctionTable* vt,
   vt->vkCmdPipelineBarrier(buffer, srcStageMask, dstStageMask, 0, 0, NULL, 0, NULL, 1, &barrier);
 }
 
-void ivkBufferBarrier(const struct VulkanFunctionTable* vt,
-                      VkCommandBuffer cmdBuffer,
-                      VkBuffer buffer,
-                      VkBufferUsageFlags usageFlags,
-                      VkPipelineStageFlags srcStageMask,
-                      VkPipelineStageFlags dstStageMask) {
-  VkBufferMemoryBarrier barrier = {
-      .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
-      .srcAccessMask = 0,
-      .dstAccessMask = 0,
-      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-      .buffer = buffer,
-      .offset = 0,
-      .size = VK_WHOLE_SIZE,
-  };
+void ivkGetBufferBarrierAccessMasks(VkBufferUsageFlags usageFlags,
+                                    VkPipelineStageFlags srcStageMask,
+                                    VkPipelineStageFlags dstStageMask,
+                                    VkAccessFlags* outSrcAccessMask,
+                                    VkAccessFlags* outDstAccessMask) {
+  VkAccessFlags srcAccessMask = 0;
+  VkAccessFlags dstAccessMask = 0;
 
   // Each access bit must be supported by at least one stage in its
   // corresponding stage mask, otherwise validation flags
@@ -618,42 +610,66 @@ void ivkBufferBarrier(const struct VulkanFunctionTable* vt,
                                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
 
   if (srcStageMask & VK_PIPELINE_STAGE_ALL_COMMANDS_BIT) {
-    barrier.srcAccessMask |= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    srcAccessMask |= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
   }
   if (srcStageMask & VK_PIPELINE_STAGE_TRANSFER_BIT) {
-    barrier.srcAccessMask |= VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    srcAccessMask |= VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
   }
   if (srcStageMask & VK_PIPELINE_STAGE_HOST_BIT) {
-    barrier.srcAccessMask |= VK_ACCESS_HOST_WRITE_BIT;
+    srcAccessMask |= VK_ACCESS_HOST_WRITE_BIT;
   }
   if (srcStageMask & kShaderStages) {
-    barrier.srcAccessMask |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    srcAccessMask |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
   }
 
   if (dstStageMask & VK_PIPELINE_STAGE_TRANSFER_BIT) {
-    barrier.dstAccessMask |= VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+    dstAccessMask |= VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
   }
   if (dstStageMask & VK_PIPELINE_STAGE_ALL_COMMANDS_BIT) {
-    barrier.dstAccessMask |= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    dstAccessMask |= VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
   }
   if (dstStageMask & VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT) {
-    barrier.dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
   }
   if (dstStageMask & VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) {
     if (usageFlags & VK_BUFFER_USAGE_INDEX_BUFFER_BIT) {
-      barrier.dstAccessMask |= VK_ACCESS_INDEX_READ_BIT;
+      dstAccessMask |= VK_ACCESS_INDEX_READ_BIT;
     }
     if (usageFlags & VK_BUFFER_USAGE_VERTEX_BUFFER_BIT) {
-      barrier.dstAccessMask |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+      dstAccessMask |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
     }
   }
   if (dstStageMask & kShaderStages) {
-    barrier.dstAccessMask |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
     if (usageFlags & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
-      barrier.dstAccessMask |= VK_ACCESS_UNIFORM_READ_BIT;
+      dstAccessMask |= VK_ACCESS_UNIFORM_READ_BIT;
     }
   }
 
+  *outSrcAccessMask = srcAccessMask;
+  *outDstAccessMask = dstAccessMask;
+}
+
+void ivkBufferBarrier(const struct VulkanFunctionTable* vt,
+                      VkCommandBuffer cmdBuffer,
+                      VkBuffer buffer,
+                      VkBufferUsageFlags usageFlags,
+                      VkPipelineStageFlags srcStageMask,
+                      VkPipelineStageFlags dstStageMask) {
+  VkBufferMemoryBarrier barrier = {
+      .sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER,
+      .srcAccessMask = 0,
+      .dstAccessMask = 0,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .buffer = buffer,
+      .offset = 0,
+      .size = VK_WHOLE_SIZE,
+  };
+
+  ivkGetBufferBarrierAccessMasks(
+      usageFlags, srcStageMask, dstStageMask, &barrier.srcAccessMask, &barrier.dstAccessMask);
+
   vt->vkCmdPipelineBarrier(cmdBuffer, srcStageMask, dstStageMask, 0, 0, NULL, 1, &barrier, 0, NULL);
 }
 
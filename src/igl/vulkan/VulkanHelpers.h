@@ -132,6 +132,7 @@ VkResult ivkCreateGraphicsPipeline(const struct VulkanFunctionTable* vt,
                                    VkDevice device,
                                    VkPipelineCache pipelineCache,
                                    VkPipelineCreateFlags flags,
+                                   const void* pNext,
                                    uint32_t numShaderStages,
                                    const VkPipelineShaderStageCreateInfo* shaderStages,
                                    const VkPipelineVertexInputStateCreateInfo* vertexInputState,
@@ -192,6 +193,13 @@ void ivkImageMemoryBarrier(const struct VulkanFunctionTable* vt,
                            VkPipelineStageFlags dstStageMask,
                            VkImageSubresourceRange subresourceRange);
 
+/// @brief Deduces the access masks of a buffer barrier from its stage masks and the buffer usage
+void ivkGetBufferBarrierAccessMasks(VkBufferUsageFlags usageFlags,
+                                    VkPipelineStageFlags srcStageMask,
+                                    VkPipelineStageFlags dstStageMask,
+                                    VkAccessFlags* outSrcAccessMask,
+                                    VkAccessFlags* outDstAccessMask);
+
 void ivkBufferBarrier(const struct VulkanFunctionTable* vt,
                       VkCommandBuffer cmdBuffer,
                       VkBuffer buffer,
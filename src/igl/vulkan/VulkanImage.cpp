@@ -7,11 +7,13 @@
 
 #include "VulkanImage.h"
 
+#include <algorithm>
 #include <array>
 // NOLINTNEXTLINE(facebook-unused-include-check)
 #include <cinttypes>
 #include <type_traits>
 #include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanBarrierBatch.h>
 #include <igl/vulkan/VulkanContext.h>
 #include <igl/vulkan/VulkanImageView.h>
 
@@ -123,6 +125,108 @@ bool tryAllocateImageVma(const VulkanContext& ctx,
   return true;
 }
 
+void getImageBarrierAccessMasks(VkPipelineStageFlags srcStageMask,
+                                VkPipelineStageFlags dstStageMask,
+                                VkAccessFlags& srcAccessMask,
+                                VkAccessFlags& dstAccessMask) {
+  srcAccessMask = 0;
+  dstAccessMask = 0;
+
+  const VkPipelineStageFlags doNotRequireAccessMask =
+      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
+      VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+  VkPipelineStageFlags srcRemainingMask = srcStageMask & ~doNotRequireAccessMask;
+  VkPipelineStageFlags dstRemainingMask = dstStageMask & ~doNotRequireAccessMask;
+
+  if (srcStageMask & VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT) {
+    srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    srcRemainingMask &= ~VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+  }
+  if (srcStageMask & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) {
+    srcAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    srcRemainingMask &= ~VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  }
+  if (srcStageMask & VK_PIPELINE_STAGE_TRANSFER_BIT) {
+    srcAccessMask |= VK_ACCESS_TRANSFER_WRITE_BIT;
+    srcRemainingMask &= ~VK_PIPELINE_STAGE_TRANSFER_BIT;
+  }
+  if (srcStageMask & VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) {
+    srcAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+    srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+    srcRemainingMask &= ~VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+  }
+  if (srcStageMask & VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT) {
+    srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    srcRemainingMask &= ~VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+  }
+  if (srcStageMask & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) {
+    srcAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+    srcRemainingMask &= ~VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+  }
+
+  (void)srcRemainingMask;
+  IGL_DEBUG_ASSERT(
+      srcRemainingMask == 0,
+      "Automatic access mask deduction is not implemented (yet) for this srcStageMask = %u",
+      srcRemainingMask);
+
+  if (dstStageMask & VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) {
+    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+    dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT) {
+    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT) {
+    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) {
+    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_VERTEX_SHADER_BIT) {
+    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) {
+    dstAccessMask |= VK_ACCESS_INDEX_READ_BIT;
+    dstAccessMask |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT) {
+    dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) {
+    dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+    dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+  }
+  if (dstStageMask & VK_PIPELINE_STAGE_TRANSFER_BIT) {
+    dstAccessMask |= VK_ACCESS_TRANSFER_READ_BIT;
+    dstAccessMask |= VK_ACCESS_TRANSFER_WRITE_BIT;
+    dstRemainingMask &= ~VK_PIPELINE_STAGE_TRANSFER_BIT;
+  }
+
+  (void)dstRemainingMask;
+  IGL_DEBUG_ASSERT(
+      dstRemainingMask == 0,
+      "Automatic access mask deduction is not implemented (yet) for this dstStageMask = %u",
+      dstRemainingMask);
+}
+
+// VK_REMAINING_MIP_LEVELS and VK_REMAINING_ARRAY_LAYERS have the same value
+uint32_t getNumSubresources(uint32_t base, uint32_t count, uint32_t total) {
+  IGL_DEBUG_ASSERT(base < total);
+  return count == VK_REMAINING_MIP_LEVELS ? total - std::min(base, total)
+                                          : std::min(count, total - std::min(base, total));
+}
+
 } // namespace
 
 VulkanImage::VulkanImage(const VulkanContext& ctx,
@@ -394,6 +498,8 @@ VulkanImage::VulkanImage(const VulkanContext& ctx,
     }
   }
 
+  ctx_->addMemoryUsage(VulkanMemoryCategory::Texture, allocatedSize);
+
   VK_ASSERT(ivkSetDebugObjectName(
       &ctx_->vf_, device_, VK_OBJECT_TYPE_IMAGE, (uint64_t)vkImage_, debugName));
 
@@ -958,6 +1064,8 @@ VulkanImage::VulkanImage(const VulkanContext& ctx,
   }
   VK_ASSERT(ctx_->vf_.vkBindImageMemory2(device_, numPlanes, bindInfo.data()));
 
+  ctx_->addMemoryUsage(VulkanMemoryCategory::Texture, allocatedSize);
+
 #if IGL_PLATFORM_WINDOWS
   const VkMemoryGetWin32HandleInfoKHR getHandleInfo{
       .sType = VK_STRUCTURE_TYPE_MEMORY_GET_WIN32_HANDLE_INFO_KHR,
@@ -991,6 +1099,8 @@ void VulkanImage::destroy() {
   IGL_ENSURE_VULKAN_CONTEXT_THREAD(ctx_);
 
   if (!isExternallyManaged_) {
+    ctx_->removeMemoryUsage(VulkanMemoryCategory::Texture, allocatedSize);
+
     if (vkMemory_[1] == VK_NULL_HANDLE) {
       if (vmaAllocation_) {
         if (mappedPtr_) {
@@ -1071,124 +1181,124 @@ void VulkanImage::transitionLayout(VkCommandBuffer cmdBuf,
                                    VkPipelineStageFlags srcStageMask,
                                    VkPipelineStageFlags dstStageMask,
                                    const VkImageSubresourceRange& subresourceRange) const {
+  VulkanBarrierBatch batch(*ctx_, cmdBuf);
+  transitionLayout(batch, newImageLayout, srcStageMask, dstStageMask, subresourceRange);
+  batch.flush();
+}
+
+void VulkanImage::transitionLayout(VulkanBarrierBatch& batch,
+                                   VkImageLayout newImageLayout,
+                                   VkPipelineStageFlags srcStageMask,
+                                   VkPipelineStageFlags dstStageMask,
+                                   const VkImageSubresourceRange& subresourceRange) const {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_TRANSITION);
 
-  VkAccessFlags srcAccessMask = 0;
-  VkAccessFlags dstAccessMask = 0;
+  auto addBarrier = [&](VkImageLayout oldImageLayout, const VkImageSubresourceRange& range) {
+    // we do not need to wait for any previous operations if the contents are undefined
+    VkPipelineStageFlags srcStage = oldImageLayout == VK_IMAGE_LAYOUT_UNDEFINED
+                                        ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT
+                                        : srcStageMask;
+    VkPipelineStageFlags dstStage = dstStageMask;
+    VkAccessFlags srcAccessMask = 0;
+    VkAccessFlags dstAccessMask = 0;
+    getImageBarrierAccessMasks(srcStage, dstStage, srcAccessMask, dstAccessMask);
 
-  if (imageLayout_ == VK_IMAGE_LAYOUT_UNDEFINED) {
-    // we do not need to wait for any previous operations in this case
-    srcStageMask = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-  }
+#if IGL_DEBUG_ENFORCE_FULL_IMAGE_BARRIER
+    // full image barrier
+    srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+    dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
 
-  const VkPipelineStageFlags doNotRequireAccessMask =
-      VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT |
-      VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-  VkPipelineStageFlags srcRemainingMask = srcStageMask & ~doNotRequireAccessMask;
-  VkPipelineStageFlags dstRemainingMask = dstStageMask & ~doNotRequireAccessMask;
+    srcStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+    dstStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+#endif // IGL_DEBUG_ENFORCE_FULL_IMAGE_BARRIER
 
-  if (srcStageMask & VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT) {
-    srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    srcRemainingMask &= ~VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-  }
-  if (srcStageMask & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) {
-    srcAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    srcRemainingMask &= ~VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  }
-  if (srcStageMask & VK_PIPELINE_STAGE_TRANSFER_BIT) {
-    srcAccessMask |= VK_ACCESS_TRANSFER_WRITE_BIT;
-    srcRemainingMask &= ~VK_PIPELINE_STAGE_TRANSFER_BIT;
-  }
-  if (srcStageMask & VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) {
-    srcAccessMask |= VK_ACCESS_SHADER_READ_BIT;
-    srcAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
-    srcRemainingMask &= ~VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-  }
-  if (srcStageMask & VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT) {
-    srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-    srcAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    srcRemainingMask &= ~VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-  }
-  if (srcStageMask & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) {
-    srcAccessMask |= VK_ACCESS_SHADER_READ_BIT;
-    srcRemainingMask &= ~VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+    batch.imageBarrier(vkImage_,
+                       srcAccessMask,
+                       dstAccessMask,
+                       oldImageLayout,
+                       newImageLayout,
+                       srcStage,
+                       dstStage,
+                       range);
+  };
+
+  if (subresourceLayouts_.empty()) {
+    addBarrier(imageLayout_, subresourceRange);
+  } else {
+    const uint32_t baseMipLevel = subresourceRange.baseMipLevel;
+    const uint32_t baseLayer = subresourceRange.baseArrayLayer;
+    const uint32_t numMipLevels =
+        getNumSubresources(baseMipLevel, subresourceRange.levelCount, mipLevels_);
+    const uint32_t numLayers =
+        getNumSubresources(baseLayer, subresourceRange.layerCount, arrayLayers_);
+    // one barrier per range of consecutive layers sharing the same layout
+    for (uint32_t mipLevel = baseMipLevel; mipLevel != baseMipLevel + numMipLevels; mipLevel++) {
+      uint32_t firstLayer = baseLayer;
+      for (uint32_t layer = baseLayer + 1; layer <= baseLayer + numLayers; layer++) {
+        const VkImageLayout oldImageLayout = getLayout(mipLevel, firstLayer);
+        if (layer != baseLayer + numLayers && getLayout(mipLevel, layer) == oldImageLayout) {
+          continue;
+        }
+        addBarrier(oldImageLayout,
+                   VkImageSubresourceRange{
+                       .aspectMask = subresourceRange.aspectMask,
+                       .baseMipLevel = mipLevel,
+                       .levelCount = 1,
+                       .baseArrayLayer = firstLayer,
+                       .layerCount = layer - firstLayer,
+                   });
+        firstLayer = layer;
+      }
+    }
   }
 
-  (void)srcRemainingMask;
-  IGL_DEBUG_ASSERT(
-      srcRemainingMask == 0,
-      "Automatic access mask deduction is not implemented (yet) for this srcStageMask = %u",
-      srcRemainingMask);
+  setLayout(newImageLayout, subresourceRange);
+}
 
-  if (dstStageMask & VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) {
-    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
-    dstAccessMask |= VK_ACCESS_SHADER_WRITE_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT) {
-    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT) {
-    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-    dstAccessMask |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT) {
-    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_VERTEX_SHADER_BIT) {
-    dstAccessMask |= VK_ACCESS_SHADER_READ_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_VERTEX_SHADER_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) {
-    dstAccessMask |= VK_ACCESS_INDEX_READ_BIT;
-    dstAccessMask |= VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT) {
-    dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) {
-    dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-    dstAccessMask |= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-  }
-  if (dstStageMask & VK_PIPELINE_STAGE_TRANSFER_BIT) {
-    dstAccessMask |= VK_ACCESS_TRANSFER_READ_BIT;
-    dstAccessMask |= VK_ACCESS_TRANSFER_WRITE_BIT;
-    dstRemainingMask &= ~VK_PIPELINE_STAGE_TRANSFER_BIT;
+VkImageLayout VulkanImage::getLayout(uint32_t mipLevel, uint32_t arrayLayer) const {
+  if (subresourceLayouts_.empty()) {
+    return imageLayout_;
   }
 
-  (void)dstRemainingMask;
-  IGL_DEBUG_ASSERT(
-      dstRemainingMask == 0,
-      "Automatic access mask deduction is not implemented (yet) for this dstStageMask = %u",
-      dstRemainingMask);
+  IGL_DEBUG_ASSERT(mipLevel < mipLevels_ && arrayLayer < arrayLayers_);
 
-#if IGL_DEBUG_ENFORCE_FULL_IMAGE_BARRIER
-  // full image barrier
-  srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
-  dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+  return subresourceLayouts_[static_cast<size_t>(mipLevel) * arrayLayers_ + arrayLayer];
+}
 
-  srcStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-  dstStageMask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
-#endif // IGL_DEBUG_ENFORCE_FULL_IMAGE_BARRIER
+void VulkanImage::setLayout(VkImageLayout newImageLayout,
+                            const VkImageSubresourceRange& subresourceRange) const {
+  const uint32_t baseMipLevel = subresourceRange.baseMipLevel;
+  const uint32_t baseLayer = subresourceRange.baseArrayLayer;
+  const uint32_t numMipLevels =
+      getNumSubresources(baseMipLevel, subresourceRange.levelCount, mipLevels_);
+  const uint32_t numLayers =
+      getNumSubresources(baseLayer, subresourceRange.layerCount, arrayLayers_);
 
-  ivkImageMemoryBarrier(&ctx_->vf_,
-                        cmdBuf,
-                        vkImage_,
-                        srcAccessMask,
-                        dstAccessMask,
-                        imageLayout_,
-                        newImageLayout,
-                        srcStageMask,
-                        dstStageMask,
-                        subresourceRange);
+  const VkImageLayout oldImageLayout = imageLayout_;
 
   imageLayout_ = newImageLayout;
+
+  if (numMipLevels == mipLevels_ && numLayers == arrayLayers_) {
+    subresourceLayouts_.clear();
+    return;
+  }
+
+  if (subresourceLayouts_.empty()) {
+    subresourceLayouts_.assign(static_cast<size_t>(mipLevels_) * arrayLayers_, oldImageLayout);
+  }
+
+  for (uint32_t mipLevel = baseMipLevel; mipLevel != baseMipLevel + numMipLevels; mipLevel++) {
+    for (uint32_t layer = baseLayer; layer != baseLayer + numLayers; layer++) {
+      subresourceLayouts_[static_cast<size_t>(mipLevel) * arrayLayers_ + layer] = newImageLayout;
+    }
+  }
+
+  // go back to a single layout once all subresources have converged
+  if (std::all_of(subresourceLayouts_.begin(),
+                  subresourceLayouts_.end(),
+                  [newImageLayout](VkImageLayout layout) { return layout == newImageLayout; })) {
+    subresourceLayouts_.clear();
+  }
 }
 
 void VulkanImage::clearColorImage(VkCommandBuffer commandBuffer,
@@ -1198,7 +1308,10 @@ void VulkanImage::clearColorImage(VkCommandBuffer commandBuffer,
   IGL_DEBUG_ASSERT(samples_ == VK_SAMPLE_COUNT_1_BIT);
   IGL_DEBUG_ASSERT(!isDepthOrStencilFormat_);
 
-  const VkImageLayout oldLayout = imageLayout_;
+  const VkImageLayout oldLayout =
+      subresourceRange
+          ? getLayout(subresourceRange->baseMipLevel, subresourceRange->baseArrayLayer)
+          : imageLayout_;
 
   VkClearColorValue value{};
   value.float32[0] = rgba.r;
@@ -1260,6 +1373,11 @@ void VulkanImage::generateMipmap(VkCommandBuffer commandBuffer,
                                  const TextureRangeDesc& range) const {
   IGL_PROFILER_FUNCTION();
 
+  if (ctx_->mipmapGenerator_ && ctx_->mipmapGenerator_->shouldGenerate(*this)) {
+    ctx_->mipmapGenerator_->generateMipmap(commandBuffer, *this, range);
+    return;
+  }
+
   // Check if device supports downscaling for color or depth/stencil buffer based on image format
   {
     const uint32_t formatFeatureMask =
@@ -1271,9 +1389,10 @@ void VulkanImage::generateMipmap(VkCommandBuffer commandBuffer,
     if (!hardwareDownscalingSupported) {
       // Not all drivers can blit-downscale every format. In particular, KosmicKrisp (the Vulkan-to-
       // Metal driver) cannot blit into depth images, so depth formats such as VK_FORMAT_D16_UNORM
-      // report BLIT_SRC but not BLIT_DST. Mipmap generation is implemented via vkCmdBlitImage, so
-      // there is nothing we can do here other than skip it; aborting would take down any otherwise
-      // healthy application (e.g. one rendering a mipmapped depth shadow map). Warn once and no-op.
+      // report BLIT_SRC but not BLIT_DST. Color formats which can be storage images were handled by
+      // VulkanMipmapGenerator above; for everything else there is nothing we can do here other than
+      // skip it; aborting would take down any otherwise healthy application (e.g. one rendering a
+      // mipmapped depth shadow map). Warn once and no-op.
       IGL_LOG_ERROR_ONCE(
           "VulkanImage::generateMipmap: skipping; image format %u does not support hardware blit "
           "downscaling (optimalTilingFeatures missing BLIT_SRC/BLIT_DST)\n",
@@ -1306,7 +1425,7 @@ void VulkanImage::generateMipmap(VkCommandBuffer commandBuffer,
     ivkCmdEndDebugUtilsLabel(&ctx_->vf_, commandBuffer);
   };
 
-  const VkImageLayout originalImageLayout = imageLayout_;
+  const VkImageLayout originalImageLayout = getLayout(range.mipLevel, 0);
 
   IGL_DEBUG_ASSERT(originalImageLayout != VK_IMAGE_LAYOUT_UNDEFINED);
 
@@ -1427,7 +1546,12 @@ void VulkanImage::generateMipmap(VkCommandBuffer commandBuffer,
                                                 .baseArrayLayer = 0,
                                                 .layerCount = VK_REMAINING_ARRAY_LAYERS});
 
-  imageLayout_ = originalImageLayout;
+  setLayout(originalImageLayout,
+            VkImageSubresourceRange{.aspectMask = imageAspectFlags,
+                                    .baseMipLevel = range.mipLevel,
+                                    .levelCount = range.numMipLevels,
+                                    .baseArrayLayer = 0,
+                                    .layerCount = VK_REMAINING_ARRAY_LAYERS});
 }
 
 void VulkanImage::setName(std::string name) noexcept { // NOLINT(bugprone-exception-escape)
@@ -1475,6 +1599,7 @@ VulkanImage& VulkanImage::operator=(VulkanImage&& other) noexcept {
 #endif
   tiling_ = other.tiling_;
   isCoherentMemory_ = other.isCoherentMemory_;
+  subresourceLayouts_ = std::move(other.subresourceLayouts_);
   extendedFormat_ = other.extendedFormat_;
   samplerYcbcrConversionCreateInfo_ = other.samplerYcbcrConversionCreateInfo_;
   ycbcrConversion_ = other.ycbcrConversion_;
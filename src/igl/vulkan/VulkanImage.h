@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <vector>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanImageView.h>
@@ -17,6 +18,7 @@ struct AHardwareBuffer;
 
 namespace igl::vulkan {
 
+class VulkanBarrierBatch;
 class VulkanContext;
 
 struct VulkanImageCreateInfo {
@@ -268,6 +270,30 @@ class VulkanImage final {
                         VkPipelineStageFlags srcStageMask,
                         VkPipelineStageFlags dstStageMask,
                         const VkImageSubresourceRange& subresourceRange) const;
+  /**
+   * @brief Same as above, but the Image Memory Barriers are added to `batch` and recorded when the
+   * batch is flushed. Only the subresources in `subresourceRange` change their layouts. If they
+   * are currently in different layouts, one barrier is added per range of array layers sharing the
+   * same layout within a mip level.
+   */
+  void transitionLayout(VulkanBarrierBatch& batch,
+                        VkImageLayout newImageLayout,
+                        VkPipelineStageFlags srcStageMask,
+                        VkPipelineStageFlags dstStageMask,
+                        const VkImageSubresourceRange& subresourceRange) const;
+
+  /**
+   * @brief Returns the current layout of the subresource at `mipLevel` and `arrayLayer`.
+   */
+  [[nodiscard]] VkImageLayout getLayout(uint32_t mipLevel, uint32_t arrayLayer) const;
+
+  /**
+   * @brief Sets the layouts of the subresources in `subresourceRange` without recording any
+   * barriers. Use it when the layouts have been changed outside of `transitionLayout()`, e.g. by
+   * the final layout of a render pass. `imageLayout_` is updated to `newImageLayout`.
+   */
+  void setLayout(VkImageLayout newImageLayout,
+                 const VkImageSubresourceRange& subresourceRange = kAllSubresources) const;
   void clearColorImage(VkCommandBuffer commandBuffer,
                        const igl::Color& rgba,
                        const VkImageSubresourceRange* subresourceRange = nullptr) const;
@@ -311,7 +337,8 @@ class VulkanImage final {
   // NOLINTNEXTLINE(readability-identifier-naming)
   bool isDepthOrStencilFormat_ = false;
   VkDeviceSize allocatedSize = 0;
-  mutable VkImageLayout imageLayout_ = VK_IMAGE_LAYOUT_UNDEFINED; // current image layout
+  // current image layout; if the subresources are in different layouts, the most recently set one
+  mutable VkImageLayout imageLayout_ = VK_IMAGE_LAYOUT_UNDEFINED;
   bool isImported_ = false;
   bool isExported_ = false;
   bool isCubemap_ = false;
@@ -337,6 +364,9 @@ class VulkanImage final {
  private:
   VkImageTiling tiling_ = VK_IMAGE_TILING_OPTIMAL;
   bool isCoherentMemory_ = false;
+  // Per-subresource layouts indexed by `mipLevel * arrayLayers_ + arrayLayer`. Empty while all
+  // subresources are in `imageLayout_`.
+  mutable std::vector<VkImageLayout> subresourceLayouts_;
 
 #if IGL_PLATFORM_WINDOWS || IGL_PLATFORM_LINUX || IGL_PLATFORM_ANDROID
   /**
@@ -39,7 +39,7 @@ VulkanImageView::~VulkanImageView() {
 VulkanImageView::VulkanImageView(const VulkanContext& ctx,
                                  const VkImageViewCreateInfo& ci,
                                  const char* debugName) :
-  ctx(&ctx), aspectMask(ci.subresourceRange.aspectMask) {
+  ctx(&ctx), aspectMask(ci.subresourceRange.aspectMask), subresourceRange(ci.subresourceRange) {
   IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
 
   VkImageViewCreateInfo ciCopy(ci);
@@ -63,9 +63,11 @@ VulkanImageView& VulkanImageView::operator=(VulkanImageView&& other) noexcept {
   ctx = other.ctx;
   vkImageView = other.vkImageView;
   aspectMask = other.aspectMask;
+  subresourceRange = other.subresourceRange;
   other.ctx = nullptr;
   other.vkImageView = VK_NULL_HANDLE;
   other.aspectMask = 0;
+  other.subresourceRange = {};
   return *this;
 }
 
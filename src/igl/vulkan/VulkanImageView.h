@@ -79,11 +79,18 @@ class VulkanImageView final {
   [[nodiscard]] VkImageAspectFlags getVkImageAspectFlags() const {
     return aspectMask;
   }
+  /**
+   * @brief Returns the subresource range used to create the imageView
+   */
+  [[nodiscard]] const VkImageSubresourceRange& getVkImageSubresourceRange() const {
+    return subresourceRange;
+  }
 
  public:
   const VulkanContext* ctx = nullptr;
   VkImageView vkImageView = VK_NULL_HANDLE;
   VkImageAspectFlags aspectMask = 0;
+  VkImageSubresourceRange subresourceRange = {};
 
  private:
   void destroy();
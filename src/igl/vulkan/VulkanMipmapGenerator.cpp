@@ -0,0 +1,528 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanMipmapGenerator.h>
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <vector>
+#include <igl/glslang/GlslCompiler.h>
+#include <igl/glslang/GlslangHelpers.h>
+#include <igl/vulkan/VulkanContext.h>
+#include <igl/vulkan/VulkanImage.h>
+#include <igl/vulkan/VulkanImageView.h>
+#include <igl/vulkan/VulkanPipelineBuilder.h>
+
+namespace igl::vulkan {
+
+namespace {
+
+constexpr uint32_t kLocalSize = 16;
+// every workgroup reads a tile of kTileSize x kTileSize texels of the source level
+constexpr uint32_t kTileSize = 2 * kLocalSize;
+
+struct FormatInfo {
+  VkFormat format;
+  const char* qualifier;
+  // "" for float and normalized formats, "u" and "i" for unsigned and signed integer formats
+  const char* prefix;
+  // requires VkPhysicalDeviceFeatures::shaderStorageImageExtendedFormats
+  bool isExtended;
+};
+
+// sRGB formats are not listed: they cannot be storage images, and writing them through a UNORM
+// view would need VK_IMAGE_CREATE_MUTABLE_FORMAT_BIT | VK_IMAGE_CREATE_EXTENDED_USAGE_BIT on the
+// image plus a usage-restricted sRGB view for sampling. They always take the blit path.
+constexpr std::array<FormatInfo, 28> kFormats = {{
+    {VK_FORMAT_R8G8B8A8_UNORM, "rgba8", "", false},
+    {VK_FORMAT_R8G8B8A8_SNORM, "rgba8_snorm", "", false},
+    {VK_FORMAT_R16G16B16A16_SFLOAT, "rgba16f", "", false},
+    {VK_FORMAT_R32G32B32A32_SFLOAT, "rgba32f", "", false},
+    {VK_FORMAT_R32_SFLOAT, "r32f", "", false},
+    {VK_FORMAT_R8_UNORM, "r8", "", true},
+    {VK_FORMAT_R8G8_UNORM, "rg8", "", true},
+    {VK_FORMAT_R16_UNORM, "r16", "", true},
+    {VK_FORMAT_R16G16_UNORM, "rg16", "", true},
+    {VK_FORMAT_R16G16B16A16_UNORM, "rgba16", "", true},
+    {VK_FORMAT_R16_SFLOAT, "r16f", "", true},
+    {VK_FORMAT_R16G16_SFLOAT, "rg16f", "", true},
+    {VK_FORMAT_R32G32_SFLOAT, "rg32f", "", true},
+    {VK_FORMAT_B10G11R11_UFLOAT_PACK32, "r11f_g11f_b10f", "", true},
+    {VK_FORMAT_A2B10G10R10_UNORM_PACK32, "rgb10_a2", "", true},
+    {VK_FORMAT_R8G8B8A8_UINT, "rgba8ui", "u", false},
+    {VK_FORMAT_R16G16B16A16_UINT, "rgba16ui", "u", false},
+    {VK_FORMAT_R32G32B32A32_UINT, "rgba32ui", "u", false},
+    {VK_FORMAT_R32_UINT, "r32ui", "u", false},
+    {VK_FORMAT_R8_UINT, "r8ui", "u", true},
+    {VK_FORMAT_R16_UINT, "r16ui", "u", true},
+    {VK_FORMAT_R16G16_UINT, "rg16ui", "u", true},
+    {VK_FORMAT_R32G32_UINT, "rg32ui", "u", true},
+    {VK_FORMAT_R32G32B32A32_SINT, "rgba32i", "i", false},
+    {VK_FORMAT_R32_SINT, "r32i", "i", false},
+    {VK_FORMAT_R16_SINT, "r16i", "i", true},
+    {VK_FORMAT_R16G16_SINT, "rg16i", "i", true},
+    {VK_FORMAT_R32G32_SINT, "rg32i", "i", true},
+}};
+
+const FormatInfo* findFormat(VkFormat format) {
+  for (const FormatInfo& info : kFormats) {
+    if (info.format == format) {
+      return &info;
+    }
+  }
+  return nullptr;
+}
+
+// Mip level `m` of this dispatch (0-based) is reduced from level `m - 1`, or from the source level
+// for m == 0. Texels beyond the edges of the previous level are clamped, so odd sizes drop the last
+// row/column like a blit does.
+constexpr const char* kShaderBody = R"(
+layout (local_size_x = 16, local_size_y = 16) in;
+
+layout (set = 0, binding = 0, FORMAT) uniform readonly IMAGE uSrc;
+layout (set = 0, binding = 1, FORMAT) uniform writeonly IMAGE uDst0;
+layout (set = 0, binding = 2, FORMAT) uniform writeonly IMAGE uDst1;
+layout (set = 0, binding = 3, FORMAT) uniform writeonly IMAGE uDst2;
+layout (set = 0, binding = 4, FORMAT) uniform writeonly IMAGE uDst3;
+
+layout (push_constant) uniform Constants {
+  ivec2 srcSize;
+  uint numMips;
+  uint baseLayer;
+} pc;
+
+shared VEC4 sTile[16][16];
+
+VEC4 reduce(VEC4 a, VEC4 b, VEC4 c, VEC4 d) {
+#if BOX_FILTER
+  return (a + b + c + d) * 0.25;
+#else
+  return a;
+#endif
+}
+
+ivec2 mipSize(uint mip) {
+  return max(pc.srcSize >> int(mip + 1), ivec2(1));
+}
+
+void store(uint mip, ivec2 pos, VEC4 value) {
+  const ivec3 p = ivec3(pos, int(pc.baseLayer + gl_WorkGroupID.z));
+  if (mip == 0) {
+    imageStore(uDst0, p, value);
+  } else if (mip == 1) {
+    imageStore(uDst1, p, value);
+  } else if (mip == 2) {
+    imageStore(uDst2, p, value);
+  } else {
+    imageStore(uDst3, p, value);
+  }
+}
+
+void main() {
+  const ivec2 local = ivec2(gl_LocalInvocationID.xy);
+  const ivec2 wg = ivec2(gl_WorkGroupID.xy);
+  const int layer = int(pc.baseLayer + gl_WorkGroupID.z);
+
+  {
+    const ivec2 pos = wg * 16 + local;
+    const ivec2 src = pos * 2;
+    const ivec2 last = pc.srcSize - 1;
+    const VEC4 v = reduce(imageLoad(uSrc, ivec3(min(src, last), layer)),
+                          imageLoad(uSrc, ivec3(min(src + ivec2(1, 0), last), layer)),
+                          imageLoad(uSrc, ivec3(min(src + ivec2(0, 1), last), layer)),
+                          imageLoad(uSrc, ivec3(min(src + ivec2(1, 1), last), layer)));
+    if (all(lessThan(pos, mipSize(0)))) {
+      store(0, pos, v);
+    }
+    sTile[local.y][local.x] = v;
+  }
+
+  int tileSize = 16;
+
+  for (uint mip = 1; mip < pc.numMips; mip++) {
+    memoryBarrierShared();
+    barrier();
+    // the last texel of the previous level inside this tile
+    const ivec2 last = max(mipSize(mip - 1) - 1 - wg * tileSize, ivec2(0));
+    tileSize /= 2;
+    const bool active = all(lessThan(local, ivec2(tileSize)));
+    VEC4 v = VEC4(0);
+    if (active) {
+      const ivec2 t = local * 2;
+      const ivec2 t1 = min(t + 1, last);
+      v = reduce(sTile[min(t.y, last.y)][min(t.x, last.x)],
+                 sTile[min(t.y, last.y)][t1.x],
+                 sTile[t1.y][min(t.x, last.x)],
+                 sTile[t1.y][t1.x]);
+    }
+    memoryBarrierShared();
+    barrier();
+    if (active) {
+      sTile[local.y][local.x] = v;
+      const ivec2 pos = wg * tileSize + local;
+      if (all(lessThan(pos, mipSize(mip)))) {
+        store(mip, pos, v);
+      }
+    }
+  }
+}
+)";
+
+std::string getShaderSource(const FormatInfo& info) {
+  const std::string prefix = info.prefix;
+  std::string source = "#version 460\n";
+  source += "#define FORMAT " + std::string(info.qualifier) + "\n";
+  source += "#define IMAGE " + prefix + "image2DArray\n";
+  source += "#define VEC4 " + prefix + "vec4\n";
+  source += "#define BOX_FILTER " + std::string(prefix.empty() ? "1" : "0") + "\n";
+  source += kShaderBody;
+  return source;
+}
+
+} // namespace
+
+VulkanMipmapGenerator::VulkanMipmapGenerator(const VulkanContext& ctx) : ctx_(ctx) {}
+
+VulkanMipmapGenerator::~VulkanMipmapGenerator() {
+  const VkDevice device = ctx_.getVkDevice();
+
+  for (const auto& [format, pipeline] : pipelines_) {
+    ctx_.vf_.vkDestroyPipeline(device, pipeline, nullptr);
+  }
+  if (pipelineLayout_ != VK_NULL_HANDLE) {
+    ctx_.vf_.vkDestroyPipelineLayout(device, pipelineLayout_, nullptr);
+  }
+  if (dsl_ != VK_NULL_HANDLE) {
+    ctx_.vf_.vkDestroyDescriptorSetLayout(device, dsl_, nullptr);
+  }
+}
+
+bool VulkanMipmapGenerator::canBlit(VkFormat format) const {
+  VkFormatProperties properties = {};
+  ctx_.vf_.vkGetPhysicalDeviceFormatProperties(
+      ctx_.getVkPhysicalDevice(), format, &properties);
+
+  const VkFormatFeatureFlags mask = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT;
+
+  return (properties.optimalTilingFeatures & mask) == mask;
+}
+
+bool VulkanMipmapGenerator::isFormatSupported(VkFormat format) const {
+  const FormatInfo* info = findFormat(format);
+
+  if (!info) {
+    return false;
+  }
+
+  if (info->isExtended &&
+      !ctx_.features().vkPhysicalDeviceFeatures2.features.shaderStorageImageExtendedFormats) {
+    return false;
+  }
+
+  VkFormatProperties properties = {};
+  ctx_.vf_.vkGetPhysicalDeviceFormatProperties(
+      ctx_.getVkPhysicalDevice(), format, &properties);
+
+  return (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_STORAGE_IMAGE_BIT) != 0;
+}
+
+bool VulkanMipmapGenerator::needsStorageUsage(VkFormat format,
+                                              uint32_t width,
+                                              uint32_t height) const {
+  if (!isFormatSupported(format)) {
+    return false;
+  }
+
+  const uint32_t minSize = ctx_.config_.computeMipmapMinSize;
+
+  return !canBlit(format) || (minSize && std::max(width, height) >= minSize);
+}
+
+bool VulkanMipmapGenerator::shouldGenerate(const VulkanImage& image) const {
+  if (image.type_ == VK_IMAGE_TYPE_3D || image.samples_ != VK_SAMPLE_COUNT_1_BIT ||
+      image.isDepthOrStencilFormat_ || !image.isStorageImage()) {
+    return false;
+  }
+
+  if (!isFormatSupported(image.imageFormat_)) {
+    return false;
+  }
+
+  const uint32_t minSize = ctx_.config_.computeMipmapMinSize;
+
+  return !canBlit(image.imageFormat_) ||
+         (minSize && std::max(image.extent_.width, image.extent_.height) >= minSize);
+}
+
+void VulkanMipmapGenerator::createPipelineLayout() {
+  const VkDevice device = ctx_.getVkDevice();
+
+  std::array<VkDescriptorSetLayoutBinding, kMaxMipsPerDispatch + 1> bindings = {};
+  for (uint32_t i = 0; i != bindings.size(); i++) {
+    bindings[i] = VkDescriptorSetLayoutBinding{
+        .binding = i,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+        .descriptorCount = 1,
+        .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+    };
+  }
+  VK_ASSERT(ivkCreateDescriptorSetLayout(&ctx_.vf_,
+                                         device,
+                                         0,
+                                         static_cast<uint32_t>(bindings.size()),
+                                         bindings.data(),
+                                         nullptr,
+                                         &dsl_));
+  VK_ASSERT(ivkSetDebugObjectName(&ctx_.vf_,
+                                  device,
+                                  VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT,
+                                  reinterpret_cast<uint64_t>(dsl_),
+                                  "Descriptor Set Layout: VulkanMipmapGenerator"));
+
+  const VkPushConstantRange range = {
+      .stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+      .offset = 0,
+      .size = 4 * sizeof(uint32_t),
+  };
+  const VkPipelineLayoutCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+      .setLayoutCount = 1,
+      .pSetLayouts = &dsl_,
+      .pushConstantRangeCount = 1,
+      .pPushConstantRanges = &range,
+  };
+  VK_ASSERT(ctx_.vf_.vkCreatePipelineLayout(device, &ci, nullptr, &pipelineLayout_));
+  VK_ASSERT(ivkSetDebugObjectName(&ctx_.vf_,
+                                  device,
+                                  VK_OBJECT_TYPE_PIPELINE_LAYOUT,
+                                  reinterpret_cast<uint64_t>(pipelineLayout_),
+                                  "Pipeline Layout: VulkanMipmapGenerator"));
+}
+
+VkPipeline VulkanMipmapGenerator::getPipeline(VkFormat format) {
+  if (auto it = pipelines_.find(format); it != pipelines_.end()) {
+    return it->second;
+  }
+
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+
+  const FormatInfo* info = findFormat(format);
+  if (!IGL_DEBUG_VERIFY(info)) {
+    return VK_NULL_HANDLE;
+  }
+
+  if (pipelineLayout_ == VK_NULL_HANDLE) {
+    createPipelineLayout();
+  }
+
+  glslang_resource_t glslangResource = {};
+  glslangGetDefaultResource(&glslangResource);
+  ivkUpdateGlslangResource(&glslangResource,
+                           &ctx_.getVkPhysicalDeviceProperties(),
+                           &ctx_.getvkPhysicalDeviceMeshShaderPropertiesEXT());
+
+  std::vector<uint32_t> spirv;
+  const Result result = glslang::compileShader(
+      ShaderStage::Compute, getShaderSource(*info).c_str(), spirv, &glslangResource, {});
+  if (!IGL_DEBUG_VERIFY(result.isOk())) {
+    IGL_LOG_ERROR("VulkanMipmapGenerator: %s\n", result.message.c_str());
+    pipelines_[format] = VK_NULL_HANDLE;
+    return VK_NULL_HANDLE;
+  }
+
+  const VkDevice device = ctx_.getVkDevice();
+
+  VkShaderModule shaderModule = VK_NULL_HANDLE;
+  const VkShaderModuleCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+      .codeSize = spirv.size() * sizeof(uint32_t),
+      .pCode = spirv.data(),
+  };
+  VK_ASSERT(ctx_.vf_.vkCreateShaderModule(device, &ci, nullptr, &shaderModule));
+
+  const std::string debugName = IGL_FORMAT("Pipeline: VulkanMipmapGenerator ({})", info->qualifier);
+
+  VkPipeline pipeline = VK_NULL_HANDLE;
+  VK_ASSERT(VulkanComputePipelineBuilder()
+                .shaderStage(VkPipelineShaderStageCreateInfo{
+                    .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                    .stage = VK_SHADER_STAGE_COMPUTE_BIT,
+                    .module = shaderModule,
+                    .pName = "main",
+                })
+                .build(ctx_.vf_,
+                       device,
+                       0,
+                       ctx_.pipelineCache_,
+                       pipelineLayout_,
+                       &pipeline,
+                       debugName.c_str()));
+
+  // the module is not needed once the pipeline is created
+  ctx_.vf_.vkDestroyShaderModule(device, shaderModule, nullptr);
+
+  pipelines_[format] = pipeline;
+
+  return pipeline;
+}
+
+void VulkanMipmapGenerator::generateMipmap(VkCommandBuffer cmdBuf,
+                                           const VulkanImage& image,
+                                           const TextureRangeDesc& range) {
+  IGL_PROFILER_FUNCTION();
+
+  if (range.numMipLevels < 2) {
+    return;
+  }
+
+  const VkPipeline pipeline = getPipeline(image.imageFormat_);
+  if (pipeline == VK_NULL_HANDLE) {
+    return;
+  }
+
+  const VkDevice device = ctx_.getVkDevice();
+  const VulkanFunctionTable& vf = ctx_.vf_;
+
+  ivkCmdBeginDebugUtilsLabel(
+      &vf, cmdBuf, "Generate mipmaps (compute)", K_COLOR_GENERATE_MIPMAPS.toFloatPtr());
+
+  IGL_SCOPE_EXIT {
+    ivkCmdEndDebugUtilsLabel(&vf, cmdBuf);
+  };
+
+  const VkImageLayout originalImageLayout = image.getLayout(range.mipLevel, 0);
+
+  IGL_DEBUG_ASSERT(originalImageLayout != VK_IMAGE_LAYOUT_UNDEFINED);
+
+  IGL_DEBUG_ASSERT(!image.isCubemap_ || image.arrayLayers_ % 6u == 0,
+                   "Cubemaps must have a multiple of 6 array layers!");
+  const uint32_t multiplier = image.isCubemap_ ? image.arrayLayers_ / 6u : 1u;
+
+  const VkImageSubresourceRange subresourceRange = {
+      .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+      .baseMipLevel = range.mipLevel,
+      .levelCount = range.numMipLevels,
+      .baseArrayLayer = 0,
+      .layerCount = VK_REMAINING_ARRAY_LAYERS,
+  };
+
+  image.transitionLayout(cmdBuf,
+                         VK_IMAGE_LAYOUT_GENERAL,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         subresourceRange);
+
+  // one view per mip level, covering all array layers; destroyed once the command buffer completes
+  std::vector<VulkanImageView> views;
+  views.reserve(range.numMipLevels);
+  for (uint32_t i = 0; i != range.numMipLevels; i++) {
+    views.push_back(image.createImageView(VK_IMAGE_VIEW_TYPE_2D_ARRAY,
+                                          image.imageFormat_,
+                                          VK_IMAGE_ASPECT_COLOR_BIT,
+                                          range.mipLevel + i,
+                                          1,
+                                          0,
+                                          image.arrayLayers_,
+                                          "Image View: VulkanMipmapGenerator"));
+  }
+
+  const uint32_t numLevelsToGenerate = range.numMipLevels - 1;
+  const uint32_t numSteps = (numLevelsToGenerate + kMaxMipsPerDispatch - 1) / kMaxMipsPerDispatch;
+
+  VkDescriptorPool pool = VK_NULL_HANDLE;
+  const VkDescriptorPoolSize poolSize = {
+      .type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+      .descriptorCount = numSteps * (kMaxMipsPerDispatch + 1),
+  };
+  VK_ASSERT(ivkCreateDescriptorPool(&vf, device, 0, numSteps, 1, &poolSize, &pool));
+  ctx_.deferredTask(std::packaged_task<void()>([vf = &vf, device, pool]() {
+    vf->vkDestroyDescriptorPool(device, pool, nullptr);
+  }));
+
+  vf.vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+
+  for (uint32_t step = 0; step != numSteps; step++) {
+    // the level read by this step, relative to range.mipLevel
+    const uint32_t srcLevel = step * kMaxMipsPerDispatch;
+    const uint32_t numMips = std::min(kMaxMipsPerDispatch, numLevelsToGenerate - srcLevel);
+
+    if (step) {
+      // the levels written by the previous step are read by this one
+      const VkMemoryBarrier barrier = {
+          .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+          .srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+          .dstAccessMask = VK_ACCESS_SHADER_READ_BIT,
+      };
+      vf.vkCmdPipelineBarrier(cmdBuf,
+                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                              VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                              0,
+                              1,
+                              &barrier,
+                              0,
+                              nullptr,
+                              0,
+                              nullptr);
+    }
+
+    VkDescriptorSet dset = VK_NULL_HANDLE;
+    VK_ASSERT(ivkAllocateDescriptorSet(&vf, device, pool, dsl_, &dset));
+
+    std::array<VkDescriptorImageInfo, kMaxMipsPerDispatch + 1> infos = {};
+    for (uint32_t i = 0; i != infos.size(); i++) {
+      // unused destinations point to the last generated level and are never written
+      const uint32_t level = srcLevel + std::min(i, numMips);
+      infos[i] = VkDescriptorImageInfo{
+          .imageView = views[level].getVkImageView(),
+          .imageLayout = VK_IMAGE_LAYOUT_GENERAL,
+      };
+    }
+    const VkWriteDescriptorSet write =
+        ivkGetWriteDescriptorSetImageInfo(dset,
+                                          0,
+                                          VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,
+                                          static_cast<uint32_t>(infos.size()),
+                                          infos.data());
+    vf.vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+
+    vf.vkCmdBindDescriptorSets(
+        cmdBuf, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout_, 0, 1, &dset, 0, nullptr);
+
+    const uint32_t mipLevel = range.mipLevel + srcLevel;
+    const uint32_t srcWidth = std::max(image.extent_.width >> mipLevel, 1u);
+    const uint32_t srcHeight = std::max(image.extent_.height >> mipLevel, 1u);
+
+    for (uint32_t arrayLayer = range.layer; arrayLayer < (range.layer + range.numLayers);
+         ++arrayLayer) {
+      const std::array<uint32_t, 4> constants = {
+          srcWidth,
+          srcHeight,
+          numMips,
+          arrayLayer * multiplier + static_cast<uint32_t>(range.face),
+      };
+      vf.vkCmdPushConstants(cmdBuf,
+                            pipelineLayout_,
+                            VK_SHADER_STAGE_COMPUTE_BIT,
+                            0,
+                            sizeof(constants),
+                            constants.data());
+      vf.vkCmdDispatch(cmdBuf,
+                       (srcWidth + kTileSize - 1) / kTileSize,
+                       (srcHeight + kTileSize - 1) / kTileSize,
+                       static_cast<uint32_t>(range.numFaces));
+    }
+  }
+
+  image.transitionLayout(cmdBuf,
+                         originalImageLayout,
+                         VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                         subresourceRange);
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <unordered_map>
+#include <igl/Texture.h>
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+class VulkanContext;
+class VulkanImage;
+
+/**
+ * @brief Generates mipmaps with a compute shader, for formats which cannot be downscaled with
+ * vkCmdBlitImage() and for large textures when VulkanContextConfig::computeMipmapMinSize is set.
+ *
+ * Every workgroup reduces a 32x32 tile of the source level into up to kMaxMipsPerDispatch levels:
+ * the first level is read from the image, every further level is reduced from the previous one in
+ * shared memory and written through its own storage image view. Long mip chains take one dispatch
+ * per kMaxMipsPerDispatch levels. Float and normalized formats use a 2x2 box filter; integer formats
+ * take the top-left texel of every 2x2 quad, like a blit with VK_FILTER_NEAREST.
+ *
+ * The image has to be created with VK_IMAGE_USAGE_STORAGE_BIT; Texture::create() adds it to every
+ * texture for which needsStorageUsage() returns true. A compute pipeline is built per format on
+ * first use.
+ */
+class VulkanMipmapGenerator final {
+ public:
+  static constexpr uint32_t kMaxMipsPerDispatch = 4;
+
+  explicit VulkanMipmapGenerator(const VulkanContext& ctx);
+  ~VulkanMipmapGenerator();
+
+  VulkanMipmapGenerator(const VulkanMipmapGenerator&) = delete;
+  VulkanMipmapGenerator& operator=(const VulkanMipmapGenerator&) = delete;
+
+  /// @brief Returns true if the format can be written by the compute shader on this device
+  [[nodiscard]] bool isFormatSupported(VkFormat format) const;
+
+  /// @brief Returns true if the mipmaps of a sampled 2D, 2D array or cube texture with these
+  /// properties will be generated by this class, which requires VK_IMAGE_USAGE_STORAGE_BIT
+  [[nodiscard]] bool needsStorageUsage(VkFormat format, uint32_t width, uint32_t height) const;
+
+  /// @brief Returns true if generateMipmap() should be used instead of blits for `image`
+  [[nodiscard]] bool shouldGenerate(const VulkanImage& image) const;
+
+  /// @brief Records the dispatches which fill the mip levels `range.mipLevel + 1` to
+  /// `range.mipLevel + range.numMipLevels - 1` of `image` from `range.mipLevel`. The layouts of
+  /// all levels are restored afterwards.
+  void generateMipmap(VkCommandBuffer cmdBuf,
+                      const VulkanImage& image,
+                      const TextureRangeDesc& range);
+
+ private:
+  [[nodiscard]] bool canBlit(VkFormat format) const;
+  [[nodiscard]] VkPipeline getPipeline(VkFormat format);
+  void createPipelineLayout();
+
+ private:
+  const VulkanContext& ctx_;
+  VkDescriptorSetLayout dsl_ = VK_NULL_HANDLE;
+  VkPipelineLayout pipelineLayout_ = VK_NULL_HANDLE;
+  std::unordered_map<VkFormat, VkPipeline> pipelines_;
+};
+
+} // namespace igl::vulkan
@@ -9,8 +9,9 @@
 
 namespace igl::vulkan {
 
-uint32_t VulkanPipelineBuilder::numPipelinesCreated = 0;
-uint32_t VulkanComputePipelineBuilder::numPipelinesCreated = 0;
+std::atomic<uint32_t> VulkanPipelineBuilder::numPipelinesCreated = 0;
+std::atomic<uint32_t> VulkanPipelineBuilder::numPipelineLibrariesCreated = 0;
+std::atomic<uint32_t> VulkanComputePipelineBuilder::numPipelinesCreated = 0;
 
 VulkanPipelineBuilder::VulkanPipelineBuilder() :
   vertexInputState_({.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO}),
@@ -162,6 +163,25 @@ VulkanPipelineBuilder& VulkanPipelineBuilder::stencilStateOps(VkStencilFaceFlags
   return *this;
 }
 
+VulkanPipelineBuilder& VulkanPipelineBuilder::creationFeedback(
+    VkPipelineCreationFeedback* feedback) {
+  creationFeedback_ = feedback;
+  return *this;
+}
+
+VulkanPipelineBuilder& VulkanPipelineBuilder::renderingFormats(
+    const std::vector<VkFormat>& colorFormats,
+    VkFormat depthFormat,
+    VkFormat stencilFormat,
+    uint32_t viewMask) {
+  useDynamicRendering_ = true;
+  colorAttachmentFormats_ = colorFormats;
+  depthAttachmentFormat_ = depthFormat;
+  stencilAttachmentFormat_ = stencilFormat;
+  viewMask_ = viewMask;
+  return *this;
+}
+
 VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
                                       VkDevice device,
                                       VkPipelineCreateFlags flags,
@@ -170,6 +190,96 @@ VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
                                       VkRenderPass renderPass,
                                       VkPipeline* outPipeline,
                                       const char* debugName) noexcept {
+  return create(
+      vf, device, flags, pipelineCache, pipelineLayout, renderPass, 0, outPipeline, debugName);
+}
+
+VkResult VulkanPipelineBuilder::buildLibrary(const VulkanFunctionTable& vf,
+                                             VkDevice device,
+                                             VkPipelineCreateFlags flags,
+                                             VkPipelineCache pipelineCache,
+                                             VkPipelineLayout pipelineLayout,
+                                             VkRenderPass renderPass,
+                                             VkGraphicsPipelineLibraryFlagsEXT parts,
+                                             VkPipeline* outPipeline,
+                                             const char* debugName) noexcept {
+  IGL_DEBUG_ASSERT(parts != 0);
+
+  return create(vf,
+                device,
+                flags | VK_PIPELINE_CREATE_LIBRARY_BIT_KHR |
+                    VK_PIPELINE_CREATE_RETAIN_LINK_TIME_OPTIMIZATION_INFO_BIT_EXT,
+                pipelineCache,
+                pipelineLayout,
+                renderPass,
+                parts,
+                outPipeline,
+                debugName);
+}
+
+VkResult VulkanPipelineBuilder::link(const VulkanFunctionTable& vf,
+                                     VkDevice device,
+                                     VkPipelineCreateFlags flags,
+                                     VkPipelineCache pipelineCache,
+                                     VkPipelineLayout pipelineLayout,
+                                     const std::vector<VkPipeline>& libraries,
+                                     bool optimize,
+                                     VkPipelineCreationFeedback* feedback,
+                                     VkPipeline* outPipeline,
+                                     const char* debugName) noexcept {
+  const VkPipelineCreationFeedbackCreateInfo feedbackInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+      .pPipelineCreationFeedback = feedback,
+  };
+  const VkPipelineLibraryCreateInfoKHR libraryInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_LIBRARY_CREATE_INFO_KHR,
+      .pNext = feedback ? &feedbackInfo : nullptr,
+      .libraryCount = static_cast<uint32_t>(libraries.size()),
+      .pLibraries = libraries.data(),
+  };
+
+  // all state comes from the libraries
+  const auto result = ivkCreateGraphicsPipeline(
+      &vf,
+      device,
+      pipelineCache,
+      optimize ? flags | VK_PIPELINE_CREATE_LINK_TIME_OPTIMIZATION_BIT_EXT : flags,
+      &libraryInfo,
+      0,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      nullptr,
+      pipelineLayout,
+      VK_NULL_HANDLE,
+      outPipeline);
+
+  if (!IGL_DEBUG_VERIFY(result == VK_SUCCESS)) {
+    return result;
+  }
+
+  numPipelinesCreated++;
+
+  // set debug name
+  return ivkSetDebugObjectName(
+      &vf, device, VK_OBJECT_TYPE_PIPELINE, (uint64_t)*outPipeline, debugName);
+}
+
+VkResult VulkanPipelineBuilder::create(const VulkanFunctionTable& vf,
+                                       VkDevice device,
+                                       VkPipelineCreateFlags flags,
+                                       VkPipelineCache pipelineCache,
+                                       VkPipelineLayout pipelineLayout,
+                                       VkRenderPass renderPass,
+                                       VkGraphicsPipelineLibraryFlagsEXT libraryParts,
+                                       VkPipeline* outPipeline,
+                                       const char* debugName) noexcept {
   const VkPipelineDynamicStateCreateInfo dynamicState = {
       .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
       .dynamicStateCount = static_cast<uint32_t>(dynamicStates_.size()),
@@ -186,13 +296,57 @@ VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
       .attachmentCount = static_cast<uint32_t>(colorBlendAttachmentStates_.size()),
       .pAttachments = colorBlendAttachmentStates_.data(),
   };
+  const VkPipelineCreationFeedbackCreateInfo feedbackInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+      .pPipelineCreationFeedback = creationFeedback_,
+  };
+  const VkPipelineRenderingCreateInfo renderingInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO,
+      .pNext = creationFeedback_ ? &feedbackInfo : nullptr,
+      .viewMask = viewMask_,
+      .colorAttachmentCount = static_cast<uint32_t>(colorAttachmentFormats_.size()),
+      .pColorAttachmentFormats = colorAttachmentFormats_.data(),
+      .depthAttachmentFormat = depthAttachmentFormat_,
+      .stencilAttachmentFormat = stencilAttachmentFormat_,
+  };
+
+  IGL_DEBUG_ASSERT(!useDynamicRendering_ || renderPass == VK_NULL_HANDLE,
+                   "Pipelines for dynamic rendering cannot have a render pass");
+
+  const void* pNext = useDynamicRendering_ ? static_cast<const void*>(&renderingInfo)
+                      : creationFeedback_  ? static_cast<const void*>(&feedbackInfo)
+                                           : nullptr;
+
+  const VkGraphicsPipelineLibraryCreateInfoEXT libraryInfo = {
+      .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_LIBRARY_CREATE_INFO_EXT,
+      .pNext = pNext,
+      .flags = libraryParts,
+  };
+
+  // a library can only contain the shader stages of its own state subsets
+  std::vector<VkPipelineShaderStageCreateInfo> libraryStages;
+  if (libraryParts) {
+    pNext = &libraryInfo;
+    for (const VkPipelineShaderStageCreateInfo& stage : shaderStages_) {
+      const VkGraphicsPipelineLibraryFlagsEXT part =
+          stage.stage == VK_SHADER_STAGE_FRAGMENT_BIT
+              ? VK_GRAPHICS_PIPELINE_LIBRARY_FRAGMENT_SHADER_BIT_EXT
+              : VK_GRAPHICS_PIPELINE_LIBRARY_PRE_RASTERIZATION_SHADERS_BIT_EXT;
+      if (libraryParts & part) {
+        libraryStages.push_back(stage);
+      }
+    }
+  }
+  const std::vector<VkPipelineShaderStageCreateInfo>& stages =
+      libraryParts ? libraryStages : shaderStages_;
 
   const auto result = ivkCreateGraphicsPipeline(&vf,
                                                 device,
                                                 pipelineCache,
                                                 flags,
-                                                static_cast<uint32_t>(shaderStages_.size()),
-                                                shaderStages_.data(),
+                                                pNext,
+                                                static_cast<uint32_t>(stages.size()),
+                                                stages.data(),
                                                 &vertexInputState_,
                                                 &inputAssembly_,
                                                 nullptr,
@@ -210,7 +364,11 @@ VkResult VulkanPipelineBuilder::build(const VulkanFunctionTable& vf,
     return result;
   }
 
-  numPipelinesCreated++;
+  if (libraryParts) {
+    numPipelineLibrariesCreated++;
+  } else {
+    numPipelinesCreated++;
+  }
 
   // set debug name
   return ivkSetDebugObjectName(
@@ -223,6 +381,12 @@ VulkanComputePipelineBuilder& VulkanComputePipelineBuilder::shaderStage(
   return *this;
 }
 
+VulkanComputePipelineBuilder& VulkanComputePipelineBuilder::creationFeedback(
+    VkPipelineCreationFeedback* feedback) {
+  creationFeedback_ = feedback;
+  return *this;
+}
+
 VkResult VulkanComputePipelineBuilder::build(const VulkanFunctionTable& vf,
                                              VkDevice device,
                                              VkPipelineCreateFlags flags,
@@ -230,8 +394,13 @@ VkResult VulkanComputePipelineBuilder::build(const VulkanFunctionTable& vf,
                                              VkPipelineLayout pipelineLayout,
                                              VkPipeline* outPipeline,
                                              const char* debugName) noexcept {
+  const VkPipelineCreationFeedbackCreateInfo feedbackInfo = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+      .pPipelineCreationFeedback = creationFeedback_,
+  };
   const VkComputePipelineCreateInfo ci = {
       .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+      .pNext = creationFeedback_ ? &feedbackInfo : nullptr,
       .flags = flags,
       .stage = shaderStage_,
       .layout = pipelineLayout,
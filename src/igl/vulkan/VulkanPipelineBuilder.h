@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanHelpers.h>
@@ -39,6 +40,16 @@ class VulkanPipelineBuilder final {
   VulkanPipelineBuilder& vertexInputState(const VkPipelineVertexInputStateCreateInfo& state);
   VulkanPipelineBuilder& colorBlendAttachmentStates(
       std::vector<VkPipelineColorBlendAttachmentState>& states);
+  /// @brief If not null, `feedback` is filled by build(). Requires VK_EXT_pipeline_creation_feedback
+  /// or Vulkan 1.3.
+  VulkanPipelineBuilder& creationFeedback(VkPipelineCreationFeedback* feedback);
+  /// @brief Builds a pipeline for dynamic rendering with these attachment formats, described by
+  /// VkPipelineRenderingCreateInfo. Requires VK_KHR_dynamic_rendering or Vulkan 1.3. The
+  /// `renderPass` passed to build() must be VK_NULL_HANDLE.
+  VulkanPipelineBuilder& renderingFormats(const std::vector<VkFormat>& colorFormats,
+                                          VkFormat depthFormat,
+                                          VkFormat stencilFormat,
+                                          uint32_t viewMask);
 
   [[nodiscard]] VkResult build(const VulkanFunctionTable& vf,
                                VkDevice device,
@@ -49,11 +60,53 @@ class VulkanPipelineBuilder final {
                                VkPipeline* outPipeline,
                                const char* debugName = nullptr) noexcept;
 
+  /// @brief Builds a pipeline library (VK_EXT_graphics_pipeline_library) which contains only the
+  /// state subsets in `parts`. Shader stages outside of these subsets are skipped. The library
+  /// retains link-time optimization info, so it can be used with both kinds of link().
+  [[nodiscard]] VkResult buildLibrary(const VulkanFunctionTable& vf,
+                                      VkDevice device,
+                                      VkPipelineCreateFlags flags,
+                                      VkPipelineCache pipelineCache,
+                                      VkPipelineLayout pipelineLayout,
+                                      VkRenderPass renderPass,
+                                      VkGraphicsPipelineLibraryFlagsEXT parts,
+                                      VkPipeline* outPipeline,
+                                      const char* debugName = nullptr) noexcept;
+
+  /// @brief Links pipeline libraries into a complete graphics pipeline. A link without
+  /// `optimize` is fast enough to be done at draw time. A link with `optimize` applies link-time
+  /// optimizations and is about as slow as a monolithic build().
+  [[nodiscard]] static VkResult link(const VulkanFunctionTable& vf,
+                                     VkDevice device,
+                                     VkPipelineCreateFlags flags,
+                                     VkPipelineCache pipelineCache,
+                                     VkPipelineLayout pipelineLayout,
+                                     const std::vector<VkPipeline>& libraries,
+                                     bool optimize,
+                                     VkPipelineCreationFeedback* feedback,
+                                     VkPipeline* outPipeline,
+                                     const char* debugName = nullptr) noexcept;
+
   [[nodiscard]] static uint32_t getNumPipelinesCreated() {
     return numPipelinesCreated;
   }
 
+  [[nodiscard]] static uint32_t getNumPipelineLibrariesCreated() {
+    return numPipelineLibrariesCreated;
+  }
+
  private:
+  /// @brief Builds a monolithic pipeline if `libraryParts` is 0, or a pipeline library otherwise
+  [[nodiscard]] VkResult create(const VulkanFunctionTable& vf,
+                                VkDevice device,
+                                VkPipelineCreateFlags flags,
+                                VkPipelineCache pipelineCache,
+                                VkPipelineLayout pipelineLayout,
+                                VkRenderPass renderPass,
+                                VkGraphicsPipelineLibraryFlagsEXT libraryParts,
+                                VkPipeline* outPipeline,
+                                const char* debugName) noexcept;
+
   std::vector<VkDynamicState> dynamicStates_;
   std::vector<VkPipelineShaderStageCreateInfo> shaderStages_;
   VkPipelineVertexInputStateCreateInfo vertexInputState_;
@@ -62,7 +115,15 @@ class VulkanPipelineBuilder final {
   VkPipelineMultisampleStateCreateInfo multisampleState_;
   VkPipelineDepthStencilStateCreateInfo depthStencilState_;
   std::vector<VkPipelineColorBlendAttachmentState> colorBlendAttachmentStates_;
-  static uint32_t numPipelinesCreated;
+  VkPipelineCreationFeedback* creationFeedback_ = nullptr;
+  bool useDynamicRendering_ = false;
+  std::vector<VkFormat> colorAttachmentFormats_;
+  VkFormat depthAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  VkFormat stencilAttachmentFormat_ = VK_FORMAT_UNDEFINED;
+  uint32_t viewMask_ = 0;
+  // pipelines can be built on worker threads (see RenderPipelineState::precompile())
+  static std::atomic<uint32_t> numPipelinesCreated;
+  static std::atomic<uint32_t> numPipelineLibrariesCreated;
 };
 
 class VulkanComputePipelineBuilder final {
@@ -71,6 +132,9 @@ class VulkanComputePipelineBuilder final {
   ~VulkanComputePipelineBuilder() = default;
 
   VulkanComputePipelineBuilder& shaderStage(VkPipelineShaderStageCreateInfo stage);
+  /// @brief If not null, `feedback` is filled by build(). Requires VK_EXT_pipeline_creation_feedback
+  /// or Vulkan 1.3.
+  VulkanComputePipelineBuilder& creationFeedback(VkPipelineCreationFeedback* feedback);
 
   [[nodiscard]] VkResult build(const VulkanFunctionTable& vf,
                                VkDevice device,
@@ -86,7 +150,8 @@ class VulkanComputePipelineBuilder final {
 
  private:
   VkPipelineShaderStageCreateInfo shaderStage_;
-  static uint32_t numPipelinesCreated;
+  VkPipelineCreationFeedback* creationFeedback_ = nullptr;
+  static std::atomic<uint32_t> numPipelinesCreated;
 };
 
 } // namespace igl::vulkan
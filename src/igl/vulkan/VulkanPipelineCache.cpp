@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanPipelineCache.h>
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <igl/vulkan/VulkanHelpers.h>
+
+namespace igl::vulkan {
+
+namespace {
+
+// FNV-1a: the cache file only needs protection against truncated or corrupted writes
+uint32_t computeChecksum(const uint8_t* data, size_t size) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i != size; i++) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+std::vector<uint8_t> readFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file) {
+    return {};
+  }
+  const std::streamsize size = file.tellg();
+  if (size <= 0) {
+    return {};
+  }
+  std::vector<uint8_t> data(static_cast<size_t>(size));
+  file.seekg(0, std::ios::beg);
+  if (!file.read(reinterpret_cast<char*>(data.data()), size)) {
+    return {};
+  }
+  return data;
+}
+
+bool writeFileAtomically(const std::string& path, const std::vector<uint8_t>& data) {
+  const std::string tmpPath = path + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file) {
+      return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!file) {
+      return false;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+  if (ec) {
+    std::filesystem::remove(tmpPath, ec);
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+VulkanPipelineCache::VulkanPipelineCache(const VulkanFunctionTable& vf,
+                                         VkDevice device,
+                                         const VkPhysicalDeviceProperties& props,
+                                         const VulkanContextConfig& config) :
+  vf_(vf),
+  device_(device),
+  props_(props),
+  filePath_(config.pipelineCachePath ? config.pipelineCachePath : ""),
+  flushIntervalMs_(config.pipelineCacheFlushIntervalMs) {
+  IGL_PROFILER_FUNCTION();
+
+  const void* initialData = config.pipelineCacheData;
+  size_t initialDataSize = config.pipelineCacheDataSize;
+
+  // the application provided data takes precedence over the file
+  std::vector<uint8_t> blob;
+  if (!initialData && !filePath_.empty()) {
+    blob = readFile(filePath_);
+    if (!blob.empty()) {
+      initialData = deserialize(props_, blob, initialDataSize);
+      loadedFromFile_ = initialData != nullptr;
+      if (!loadedFromFile_) {
+        IGL_LOG_INFO("Discarding stale pipeline cache file %s\n", filePath_.c_str());
+      }
+    }
+  }
+
+  const VkPipelineCacheCreateInfo ci = {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      .flags = VkPipelineCacheCreateFlags(0),
+      .initialDataSize = initialData ? initialDataSize : 0,
+      .pInitialData = initialData,
+  };
+  VK_ASSERT(vf_.vkCreatePipelineCache(device_, &ci, nullptr, &vkPipelineCache_));
+  VK_ASSERT(ivkSetDebugObjectName(&vf_,
+                                  device_,
+                                  VK_OBJECT_TYPE_PIPELINE_CACHE,
+                                  (uint64_t)vkPipelineCache_,
+                                  "Pipeline Cache: VulkanContext::pipelineCache_"));
+
+  loadedBytes_ = ci.initialDataSize;
+  // do not rewrite the file until something new is added to the cache
+  lastFlushedSize_ = loadedFromFile_ ? loadedBytes_ : 0;
+
+  if (loadedFromFile_ && config.enableExtraLogs) {
+    IGL_LOG_INFO("Loaded %zu bytes of pipeline cache from %s\n", loadedBytes_, filePath_.c_str());
+  }
+
+  if (!filePath_.empty() && flushIntervalMs_) {
+    flushThread_ = std::thread([this]() { flushThreadLoop(); });
+  }
+}
+
+VulkanPipelineCache::~VulkanPipelineCache() {
+  IGL_PROFILER_FUNCTION();
+
+  if (flushThread_.joinable()) {
+    {
+      const std::lock_guard lock(threadMutex_);
+      stopThread_ = true;
+    }
+    threadCV_.notify_one();
+    flushThread_.join();
+  }
+
+  flush();
+
+  vf_.vkDestroyPipelineCache(device_, vkPipelineCache_, nullptr);
+}
+
+void VulkanPipelineCache::flushThreadLoop() {
+  IGL_PROFILER_THREAD("IGL Vulkan Pipeline Cache");
+
+  std::unique_lock lock(threadMutex_);
+
+  while (!threadCV_.wait_for(lock, std::chrono::milliseconds(flushIntervalMs_), [this]() {
+    return stopThread_;
+  })) {
+    lock.unlock();
+    flush();
+    lock.lock();
+  }
+}
+
+std::vector<uint8_t> VulkanPipelineCache::getData() const {
+  size_t size = 0;
+  vf_.vkGetPipelineCacheData(device_, vkPipelineCache_, &size, nullptr);
+
+  std::vector<uint8_t> data(size);
+
+  if (size) {
+    vf_.vkGetPipelineCacheData(device_, vkPipelineCache_, &size, data.data());
+    data.resize(size);
+  }
+
+  return data;
+}
+
+void VulkanPipelineCache::flush() {
+  if (filePath_.empty()) {
+    return;
+  }
+
+  IGL_PROFILER_FUNCTION();
+
+  const std::lock_guard lock(flushMutex_);
+
+  // the driver only appends to the cache, so an unchanged size means there is nothing new to save
+  size_t size = 0;
+  vf_.vkGetPipelineCacheData(device_, vkPipelineCache_, &size, nullptr);
+  if (!size || size == lastFlushedSize_) {
+    return;
+  }
+
+  const std::vector<uint8_t> data = getData();
+
+  if (!writeFileAtomically(filePath_, serialize(props_, data.data(), data.size()))) {
+    IGL_LOG_ERROR("Cannot write pipeline cache file %s\n", filePath_.c_str());
+    return;
+  }
+
+  lastFlushedSize_ = data.size();
+  numFlushes_++;
+}
+
+void VulkanPipelineCache::recordCreationFeedback(const VkPipelineCreationFeedback& feedback) {
+  if ((feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT) == 0) {
+    return;
+  }
+  if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT) {
+    numHits_++;
+  } else {
+    numMisses_++;
+  }
+}
+
+VulkanPipelineCacheStats VulkanPipelineCache::getStats() const {
+  const std::lock_guard lock(flushMutex_);
+
+  return {
+      .loadedFromFile = loadedFromFile_,
+      .loadedBytes = loadedBytes_,
+      .numHits = numHits_.load(),
+      .numMisses = numMisses_.load(),
+      .numFlushes = numFlushes_,
+      .flushedBytes = numFlushes_ ? lastFlushedSize_ : 0,
+  };
+}
+
+std::vector<uint8_t> VulkanPipelineCache::serialize(const VkPhysicalDeviceProperties& props,
+                                                    const uint8_t* data,
+                                                    size_t size) {
+  VulkanPipelineCacheFileHeader header = {
+      .magic = kMagic,
+      .headerSize = sizeof(VulkanPipelineCacheFileHeader),
+      .iglCacheVersion = kIGLCacheVersion,
+      .vendorID = props.vendorID,
+      .deviceID = props.deviceID,
+      .driverVersion = props.driverVersion,
+      .dataSize = size,
+      .dataChecksum = computeChecksum(data, size),
+  };
+  memcpy(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+
+  std::vector<uint8_t> blob(sizeof(header) + size);
+  memcpy(blob.data(), &header, sizeof(header));
+  if (size) {
+    memcpy(blob.data() + sizeof(header), data, size);
+  }
+  return blob;
+}
+
+const uint8_t* VulkanPipelineCache::deserialize(const VkPhysicalDeviceProperties& props,
+                                                const std::vector<uint8_t>& blob,
+                                                size_t& outSize) {
+  outSize = 0;
+
+  if (blob.size() < sizeof(VulkanPipelineCacheFileHeader)) {
+    return nullptr;
+  }
+
+  VulkanPipelineCacheFileHeader header;
+  memcpy(&header, blob.data(), sizeof(header));
+
+  const uint8_t* data = blob.data() + sizeof(header);
+
+  if (header.magic != kMagic || header.headerSize != sizeof(header) ||
+      header.iglCacheVersion != kIGLCacheVersion || header.vendorID != props.vendorID ||
+      header.deviceID != props.deviceID || header.driverVersion != props.driverVersion ||
+      memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+      header.dataSize != blob.size() - sizeof(header) ||
+      header.dataChecksum != computeChecksum(data, header.dataSize)) {
+    return nullptr;
+  }
+
+  outSize = header.dataSize;
+  return data;
+}
+
+} // namespace igl::vulkan
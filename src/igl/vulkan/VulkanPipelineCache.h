@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <igl/vulkan/Common.h>
+
+namespace igl::vulkan {
+
+/// @brief Counters reported by VulkanPipelineCache. Hits and misses are only counted when
+/// VK_EXT_pipeline_creation_feedback (or Vulkan 1.3) is available.
+struct VulkanPipelineCacheStats {
+  /// true if the cache was seeded from the file at VulkanContextConfig::pipelineCachePath
+  bool loadedFromFile = false;
+  /// the size of the pipeline cache data used to seed the VkPipelineCache
+  size_t loadedBytes = 0;
+  /// the number of pipelines found in the VkPipelineCache
+  uint32_t numHits = 0;
+  /// the number of pipelines which had to be compiled from scratch
+  uint32_t numMisses = 0;
+  /// the number of times the cache file was (re)written
+  uint32_t numFlushes = 0;
+  /// the size of the pipeline cache data in the last written file
+  size_t flushedBytes = 0;
+};
+
+/// @brief The header which precedes the VkPipelineCache data in a cache file. A file is only used
+/// if every field matches the current device and build, and the data checksum is valid.
+struct VulkanPipelineCacheFileHeader {
+  uint32_t magic = 0;
+  uint32_t headerSize = 0;
+  uint32_t iglCacheVersion = 0;
+  uint32_t vendorID = 0;
+  uint32_t deviceID = 0;
+  uint32_t driverVersion = 0;
+  uint8_t pipelineCacheUUID[VK_UUID_SIZE] = {};
+  uint64_t dataSize = 0;
+  uint32_t dataChecksum = 0;
+  uint32_t reserved = 0;
+};
+
+/**
+ * @brief Owns the VkPipelineCache of a VulkanContext. The cache can be seeded from application
+ * provided data (VulkanContextConfig::pipelineCacheData) or from a file on disk
+ * (VulkanContextConfig::pipelineCachePath). When a file path is provided, the cache contents
+ * are written back to the file from a background thread whenever they change, and once more on
+ * destruction. Files are written to a temporary file first and then renamed over the old one, so a
+ * crash never leaves a truncated cache behind.
+ */
+class VulkanPipelineCache final {
+ public:
+  static constexpr uint32_t kMagic = 0x43504749; // "IGPC"
+  /// Bump this whenever IGL changes in a way that makes previously cached pipelines unusable
+  static constexpr uint32_t kIGLCacheVersion = 1;
+
+  VulkanPipelineCache(const VulkanFunctionTable& vf,
+                      VkDevice device,
+                      const VkPhysicalDeviceProperties& props,
+                      const VulkanContextConfig& config);
+  ~VulkanPipelineCache();
+
+  VulkanPipelineCache(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache& operator=(const VulkanPipelineCache&) = delete;
+  VulkanPipelineCache(VulkanPipelineCache&&) = delete;
+  VulkanPipelineCache& operator=(VulkanPipelineCache&&) = delete;
+
+  [[nodiscard]] VkPipelineCache getVkPipelineCache() const {
+    return vkPipelineCache_;
+  }
+
+  [[nodiscard]] std::vector<uint8_t> getData() const;
+
+  /// @brief Writes the cache contents to the cache file if they changed since the last flush. Does
+  /// nothing if no file path was provided. Thread-safe.
+  void flush();
+
+  /// @brief Updates the hit/miss counters. Can be called from any thread.
+  void recordCreationFeedback(const VkPipelineCreationFeedback& feedback);
+
+  [[nodiscard]] VulkanPipelineCacheStats getStats() const;
+
+  /// @brief Prepends a VulkanPipelineCacheFileHeader for the device `props` to `data`
+  [[nodiscard]] static std::vector<uint8_t> serialize(const VkPhysicalDeviceProperties& props,
+                                                      const uint8_t* data,
+                                                      size_t size);
+  /// @brief Validates a blob created by serialize() against the device `props`. On success,
+  /// returns a pointer to the VkPipelineCache data inside `blob` and its size in `outSize`.
+  /// Returns nullptr if the blob is stale or corrupted.
+  [[nodiscard]] static const uint8_t* deserialize(const VkPhysicalDeviceProperties& props,
+                                                  const std::vector<uint8_t>& blob,
+                                                  size_t& outSize);
+
+ private:
+  void flushThreadLoop();
+
+ private:
+  const VulkanFunctionTable& vf_;
+  VkDevice device_ = VK_NULL_HANDLE;
+  VkPhysicalDeviceProperties props_ = {};
+  VkPipelineCache vkPipelineCache_ = VK_NULL_HANDLE;
+
+  std::string filePath_;
+  uint32_t flushIntervalMs_ = 0;
+
+  bool loadedFromFile_ = false;
+  size_t loadedBytes_ = 0;
+  std::atomic<uint32_t> numHits_ = 0;
+  std::atomic<uint32_t> numMisses_ = 0;
+
+  mutable std::mutex flushMutex_;
+  size_t lastFlushedSize_ = 0;
+  uint32_t numFlushes_ = 0;
+
+  std::mutex threadMutex_;
+  std::condition_variable threadCV_;
+  bool stopThread_ = false;
+  std::thread flushThread_;
+};
+
+} // namespace igl::vulkan
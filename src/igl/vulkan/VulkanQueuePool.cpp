@@ -106,6 +106,20 @@ VulkanQueueDescriptor VulkanQueuePool::findQueueDescriptor(VkQueueFlags flags) c
   return {};
 }
 
+VulkanQueueDescriptor VulkanQueuePool::findDedicatedQueueDescriptor(VkQueueFlags flags,
+                                                                   VkQueueFlags avoid) const {
+  IGL_PROFILER_FUNCTION();
+
+  for (const auto& queueDescriptor : availableDescriptors_) {
+    const VkQueueFlags queueFlags = queueDescriptor.queueFlags;
+    if ((queueFlags & flags) == flags && (queueFlags & avoid) == 0) {
+      return queueDescriptor;
+    }
+  }
+
+  return {};
+}
+
 void VulkanQueuePool::reserveQueue(const VulkanQueueDescriptor& queueDescriptor) {
   IGL_PROFILER_FUNCTION();
 
@@ -45,6 +45,12 @@ class VulkanQueuePool final {
   /* Find a queue descriptor that conforms to give queue flags. */
   [[nodiscard]] VulkanQueueDescriptor findQueueDescriptor(VkQueueFlags flags) const;
 
+  /* Find a queue descriptor that supports all of the given queue flags and none of the `avoid`
+   * flags. Returns an invalid descriptor if there is no such queue.
+   */
+  [[nodiscard]] VulkanQueueDescriptor findDedicatedQueueDescriptor(VkQueueFlags flags,
+                                                                   VkQueueFlags avoid) const;
+
   /* Reserve the given queue. Reserved queues will not be visible in future
    * find requests and they will participate in resulting queue creation infos.
    */
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanReadbackRing.h>
+
+#include <algorithm>
+#include <numeric>
+#include <igl/vulkan/Readback.h>
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::vulkan {
+
+namespace {
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+VulkanReadbackRing::VulkanReadbackRing(VulkanContext& ctx, VkDeviceSize size) :
+  ctx_(ctx), size_(size) {
+  alignment_ =
+      std::max(alignment_, ctx_.getVkPhysicalDeviceProperties().limits.nonCoherentAtomSize);
+}
+
+VulkanReadbackRing::~VulkanReadbackRing() {
+  // a readback which outlives the context would keep a dangling VulkanContext reference
+  size_t numAlive = 0;
+  for (const Region& region : regions_) {
+    numAlive += region.readback.expired() ? 0 : 1;
+  }
+  for (const std::weak_ptr<Readback>& readback : dedicated_) {
+    numAlive += readback.expired() ? 0 : 1;
+  }
+  if (numAlive) {
+    IGL_LOG_ERROR("Leaked %zu readbacks\n", numAlive);
+  }
+  IGL_DEBUG_ASSERT(numAlive == 0, "Readbacks must be released before the device is destroyed");
+}
+
+std::shared_ptr<Readback> VulkanReadbackRing::createReadback(
+    VulkanImmediateCommands::SubmitHandle handle,
+    VkDeviceSize size,
+    uint32_t bytesPerRow,
+    VkDeviceSize offsetAlignment,
+    Result* IGL_NULLABLE outResult) {
+  IGL_PROFILER_FUNCTION();
+
+  if (size == 0) {
+    Result::setResult(outResult, Result::Code::ArgumentInvalid, "Readback size cannot be 0");
+    return nullptr;
+  }
+
+  const VkDeviceSize alignment = std::lcm(alignment_, std::max<VkDeviceSize>(offsetAlignment, 1));
+
+  std::shared_ptr<Readback> readback;
+
+  VkDeviceSize offset = 0;
+  if (size_ && allocate(size, alignment, offset)) {
+    readback = std::make_shared<Readback>(
+        ctx_, handle, buffer_, offset, static_cast<size_t>(size), bytesPerRow);
+    regions_.push_back({
+        .offset = offset,
+        .handle = handle,
+        .readback = readback,
+    });
+  } else {
+    auto buffer = ctx_.createBuffer(size,
+                                    VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                    outResult,
+                                    "Buffer: readback");
+    if (!buffer || !buffer->isMapped()) {
+      Result::setResult(
+          outResult, Result::Code::RuntimeError, "Cannot allocate memory for the readback");
+      return nullptr;
+    }
+    readback = std::make_shared<Readback>(
+        ctx_, handle, std::move(buffer), 0, static_cast<size_t>(size), bytesPerRow);
+    std::erase_if(dedicated_, [](const auto& weakReadback) { return weakReadback.expired(); });
+    dedicated_.push_back(readback);
+  }
+
+  pending_.push_back(readback);
+
+  Result::setResult(outResult, Result::Code::Ok);
+  return readback;
+}
+
+bool VulkanReadbackRing::allocate(VkDeviceSize size,
+                                  VkDeviceSize alignment,
+                                  VkDeviceSize& outOffset) {
+  reclaim();
+
+  if (regions_.empty()) {
+    head_ = 0;
+  }
+
+  const VkDeviceSize tail = regions_.empty() ? 0 : regions_.front().offset;
+  const VkDeviceSize offset = alignUp(head_, alignment);
+
+  if (regions_.empty() || head_ > tail) {
+    // the free space is [head_, size_) followed by [0, tail)
+    if (offset + size <= size_) {
+      outOffset = offset;
+    } else if (size <= tail) {
+      outOffset = 0;
+    } else {
+      return false;
+    }
+  } else if (head_ < tail && offset + size <= tail) {
+    // the ring has wrapped around: the free space is [head_, tail)
+    outOffset = offset;
+  } else {
+    return false;
+  }
+
+  if (!buffer_) {
+    buffer_ = ctx_.createBuffer(size_,
+                                VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                nullptr,
+                                "Buffer: readback ring");
+    if (!buffer_ || !buffer_->isMapped()) {
+      buffer_ = nullptr;
+      return false;
+    }
+  }
+
+  head_ = outOffset + size;
+
+  return true;
+}
+
+void VulkanReadbackRing::reclaim() {
+  // regions are released in allocation order, so a region held by the application keeps all newer
+  // regions alive
+  while (!regions_.empty() && regions_.front().readback.expired() &&
+         ctx_.immediate_->isReady(regions_.front().handle)) {
+    regions_.pop_front();
+  }
+}
+
+void VulkanReadbackRing::processCompletedReadbacks() {
+  IGL_PROFILER_FUNCTION();
+
+  // handlers may create new readbacks, so iterate over a snapshot
+  std::vector<std::weak_ptr<Readback>> pending;
+  pending.swap(pending_);
+
+  for (const auto& weakReadback : pending) {
+    const std::shared_ptr<Readback> readback = weakReadback.lock();
+    if (readback && !readback->processCompletion()) {
+      pending_.push_back(readback);
+    }
+  }
+
+  reclaim();
+}
+
+} // namespace igl::vulkan
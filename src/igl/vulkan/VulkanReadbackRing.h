@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+class Readback;
+class VulkanBuffer;
+class VulkanContext;
+
+/**
+ * @brief Allocates CPU-visible memory for asynchronous GPU->CPU readbacks (see
+ * CommandBuffer::readBufferAsync() and CommandBuffer::readTextureAsync()).
+ *
+ * Readbacks are sub-allocated in FIFO order from one persistently mapped host-visible buffer,
+ * created on first use. A region is reclaimed once the Readback object which owns it has been
+ * released by the application and the GPU has finished writing to it. Readbacks which do not fit
+ * into the ring, e.g. because the application holds on to older readbacks, get a dedicated buffer.
+ * Every Readback shares ownership of its buffer. All readbacks have to be released before the ring
+ * is destroyed together with the context, as they keep a reference to the context.
+ */
+class VulkanReadbackRing final {
+ public:
+  VulkanReadbackRing(VulkanContext& ctx, VkDeviceSize size);
+  ~VulkanReadbackRing();
+
+  VulkanReadbackRing(const VulkanReadbackRing&) = delete;
+  VulkanReadbackRing& operator=(const VulkanReadbackRing&) = delete;
+
+  /** @brief Creates a Readback object with `size` bytes of CPU-visible memory which will be
+   * written by the command buffer identified by `handle`. The caller has to record the copy into
+   * Readback::getVkBuffer() at Readback::getOffset(), which is a multiple of `offsetAlignment`.
+   */
+  std::shared_ptr<Readback> createReadback(VulkanImmediateCommands::SubmitHandle handle,
+                                           VkDeviceSize size,
+                                           uint32_t bytesPerRow,
+                                           VkDeviceSize offsetAlignment,
+                                           Result* IGL_NULLABLE outResult);
+
+  /// @brief Invokes the completion handlers of all finished readbacks and reclaims the memory of
+  /// released ones. Called after every command buffer submission.
+  void processCompletedReadbacks();
+
+  [[nodiscard]] VkDeviceSize getSize() const {
+    return size_;
+  }
+
+ private:
+  /// @brief Returns true and the offset of a free region of `size` bytes in the ring, if any
+  [[nodiscard]] bool allocate(VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize& outOffset);
+  void reclaim();
+
+ private:
+  struct Region {
+    VkDeviceSize offset = 0;
+    VulkanImmediateCommands::SubmitHandle handle;
+    std::weak_ptr<Readback> readback;
+  };
+
+  VulkanContext& ctx_;
+  const VkDeviceSize size_;
+  // the minimal alignment of all regions; satisfies the nonCoherentAtomSize requirements
+  VkDeviceSize alignment_ = 16;
+  std::shared_ptr<VulkanBuffer> buffer_;
+  // the offset of the next allocation
+  VkDeviceSize head_ = 0;
+  // allocated regions of the ring in allocation order; the oldest region is at the front
+  std::deque<Region> regions_;
+  // all readbacks whose completion handlers have not been processed yet
+  std::vector<std::weak_ptr<Readback>> pending_;
+  // readbacks with a dedicated buffer, to check that all of them are released before the context
+  std::vector<std::weak_ptr<Readback>> dedicated_;
+};
+
+} // namespace igl::vulkan
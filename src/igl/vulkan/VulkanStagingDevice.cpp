@@ -7,6 +7,7 @@
 
 #include <igl/vulkan/VulkanStagingDevice.h>
 
+#include <algorithm>
 #include <igl/IGLSafeC.h>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanBuffer.h>
@@ -38,16 +39,211 @@ VulkanStagingDevice::VulkanStagingDevice(VulkanContext& ctx) : ctx_(ctx) {
       ctx_.features_.has_VK_KHR_timeline_semaphore && ctx_.features_.has_VK_KHR_synchronization2,
       "VulkanStagingDevice::immediate_");
   IGL_DEBUG_ASSERT(immediate.get());
+
+  // VulkanContext selects a transfer queue only if timeline semaphores and synchronization2 are
+  // available
+  if (ctx_.deviceQueues_.transferQueue) {
+    transferImmediate_ =
+        std::make_unique<VulkanImmediateCommands>(ctx_.vf_,
+                                                  ctx_.getVkDevice(),
+                                                  ctx_.deviceQueues_.transferQueueFamilyIndex,
+                                                  false,
+                                                  true,
+                                                  "VulkanStagingDevice::transferImmediate_");
+    transferSemaphore_ = std::make_unique<VulkanSemaphore>(
+        ctx_.vf_,
+        ctx_.getVkDevice(),
+        0,
+        false,
+        "Semaphore: VulkanStagingDevice::transferSemaphore_");
+  }
+}
+
+VulkanStagingDevice::~VulkanStagingDevice() {
+  IGL_DEBUG_ASSERT(batchDepth_ == 0, "Upload batch was not ended");
+  flushBatch();
+
+  if (transferImmediate_) {
+    // the graphics queue may still be waiting on the timeline semaphore
+    immediate->waitAll();
+  }
+}
+
+void VulkanStagingDevice::beginBatch() {
+  batchDepth_++;
+}
+
+VulkanSubmitHandle VulkanStagingDevice::endBatch() {
+  IGL_DEBUG_ASSERT(batchDepth_ > 0, "endBatch() without beginBatch()");
+
+  if (batchDepth_ == 0 || --batchDepth_ > 0) {
+    return lastBatchHandle_;
+  }
+
+  flushBatch();
+
+  return lastBatchHandle_;
+}
+
+void VulkanStagingDevice::flushBatch() {
+  // transfers recorded in the batch have to be acquired before the batch uses the resources
+  if (transferWrapper_) {
+    lastBatchHandle_ = flushTransfers();
+  }
+
+  if (!batchWrapper_) {
+    return;
+  }
+
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
+
+  lastBatchHandle_ = immediate->submit(*batchWrapper_);
+  batchWrapper_ = nullptr;
+}
+
+const VulkanImmediateCommands::CommandBufferWrapper& VulkanStagingDevice::acquireCommandBuffer(
+    std::initializer_list<BatchRange> ranges) {
+  if (!batchDepth_) {
+    return immediate->acquire();
+  }
+
+  if (!batchWrapper_) {
+    batchWrapper_ = &immediate->acquire();
+    batchRanges_.assign(ranges);
+    return *batchWrapper_;
+  }
+
+  syncBatchRanges(batchWrapper_->cmdBuf, batchRanges_, ranges);
+
+  return *batchWrapper_;
+}
+
+void VulkanStagingDevice::syncBatchRanges(VkCommandBuffer cmdBuf,
+                                          std::vector<BatchRange>& batchRanges,
+                                          std::initializer_list<BatchRange> ranges) {
+  const auto overlaps = [&batchRanges](const BatchRange& r) {
+    return std::any_of(batchRanges.begin(), batchRanges.end(), [&r](const BatchRange& b) {
+      return r.resource == b.resource && r.offset < b.offset + b.size &&
+             b.offset < r.offset + r.size;
+    });
+  };
+
+  // uploads in a batch share one command buffer: make sure the previous copies have landed before
+  // the next one reads from or writes to the same resources. Copies into disjoint ranges do not
+  // need to wait for each other
+  if (std::any_of(ranges.begin(), ranges.end(), overlaps)) {
+    const VkMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+    };
+    ctx_.vf_.vkCmdPipelineBarrier(cmdBuf,
+                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                  0,
+                                  1,
+                                  &barrier,
+                                  0,
+                                  nullptr,
+                                  0,
+                                  nullptr);
+    // everything recorded so far is synchronized with the following copies
+    batchRanges.clear();
+  }
+
+  for (const BatchRange& r : ranges) {
+    // consecutive chunks of one upload extend the same range, which keeps the list short
+    auto it = std::find_if(batchRanges.rbegin(), batchRanges.rend(), [&r](const BatchRange& b) {
+      return b.resource == r.resource;
+    });
+    if (it != batchRanges.rend() && it->offset + it->size == r.offset) {
+      it->size += r.size;
+    } else {
+      batchRanges.push_back(r);
+    }
+  }
+}
+
+VulkanSubmitHandle VulkanStagingDevice::submitCommandBuffer(
+    const VulkanImmediateCommands::CommandBufferWrapper& wrapper) {
+  if (&wrapper == batchWrapper_) {
+    // becomes valid when the batch is flushed
+    return wrapper.handle;
+  }
+  return immediate->submit(wrapper);
+}
+
+const VulkanImmediateCommands::CommandBufferWrapper&
+VulkanStagingDevice::acquireTransferCommandBuffer(std::initializer_list<BatchRange> ranges) {
+  IGL_DEBUG_ASSERT(transferImmediate_);
+
+  if (!transferWrapper_) {
+    transferWrapper_ = &transferImmediate_->acquire();
+    transferRanges_.assign(ranges);
+    return *transferWrapper_;
+  }
+
+  syncBatchRanges(transferWrapper_->cmdBuf, transferRanges_, ranges);
+
+  return *transferWrapper_;
+}
+
+VulkanSubmitHandle VulkanStagingDevice::submitTransfer() {
+  if (!batchDepth_) {
+    return flushTransfers();
+  }
+
+  // the batch command buffer is submitted after the ownership acquire command buffer (see
+  // flushBatch()), so its fence also covers the transfer
+  return submitCommandBuffer(acquireCommandBuffer());
+}
+
+VulkanSubmitHandle VulkanStagingDevice::flushTransfers() {
+  IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_SUBMIT);
+
+  if (!transferWrapper_) {
+    return {};
+  }
+
+  const uint64_t signalValue = ++transferTimelineValue_;
+
+  // 1. Release the ownership of the uploaded resources on the transfer queue
+  const bool signaled = IGL_DEBUG_VERIFY(
+      transferImmediate_->signalSemaphore(transferSemaphore_->getVkSemaphore(), signalValue));
+  const VulkanSubmitHandle transferHandle = transferImmediate_->submit(*transferWrapper_);
+  transferWrapper_ = nullptr;
+
+  // 2. Acquire the ownership on the graphics queue once the transfer queue is done
+  const auto& wrapper = immediate->acquire();
+  if (!signaled || !IGL_DEBUG_VERIFY(immediate->waitSemaphore(
+                       transferSemaphore_->getVkSemaphore(), signalValue))) {
+    // cannot hand over via the semaphore: wait on the CPU instead
+    transferImmediate_->wait(transferHandle, ctx_.config_.fenceTimeoutNanoseconds);
+  }
+  ctx_.vf_.vkCmdPipelineBarrier(wrapper.cmdBuf,
+                                VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                                pendingAcquireStageMask_,
+                                0,
+                                0,
+                                nullptr,
+                                0,
+                                nullptr,
+                                static_cast<uint32_t>(pendingAcquireBarriers_.size()),
+                                pendingAcquireBarriers_.data());
+  pendingAcquireBarriers_.clear();
+  pendingAcquireStageMask_ = 0;
+
+  return immediate->submit(wrapper);
 }
 
-void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
-                                        size_t dstOffset,
-                                        size_t size,
-                                        const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
+                                                      size_t dstOffset,
+                                                      size_t size,
+                                                      const void* data) {
   IGL_PROFILER_FUNCTION();
   if (buffer.isMapped()) {
     buffer.bufferSubData(dstOffset, size, data);
-    return;
+    return {};
   }
 
   // Use vkCmdUpdateBuffer() for small buffers (up to 64KB) when alignment requirements are met.
@@ -56,16 +252,21 @@ void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
   constexpr size_t kMaxUpdateBufferSize = 65536;
   if (data && size <= kMaxUpdateBufferSize && (dstOffset % 4 == 0) && (size % 4 == 0)) {
     IGL_DEBUG_ASSERT(buffer.getBufferUsageFlags() & VK_BUFFER_USAGE_TRANSFER_DST_BIT);
-    const auto& wrapper = immediate->acquire();
+    const auto& wrapper = acquireCommandBuffer({{
+        .resource = (uint64_t)buffer.getVkBuffer(),
+        .offset = static_cast<VkDeviceSize>(dstOffset),
+        .size = static_cast<VkDeviceSize>(size),
+    }});
     ctx_.vf_.vkCmdUpdateBuffer(wrapper.cmdBuf,
                                buffer.getVkBuffer(),
                                static_cast<VkDeviceSize>(dstOffset),
                                static_cast<VkDeviceSize>(size),
                                data);
-    immediate->submit(wrapper);
-    return;
+    return submitCommandBuffer(wrapper);
   }
 
+  VulkanSubmitHandle handle;
+
   VkDeviceSize chunkDstOffset = dstOffset;
   void* copyData = const_cast<void*>(data);
 
@@ -94,16 +295,22 @@ void VulkanStagingDevice::bufferSubData(VulkanBuffer& buffer,
         .size = copySize,
     };
 
-    const auto& wrapper = immediate->acquire();
+    const auto& wrapper = acquireCommandBuffer({
+        {(uint64_t)stagingBuffer->getVkBuffer(), memoryChunk.offset, copySize},
+        {(uint64_t)buffer.getVkBuffer(), chunkDstOffset, copySize},
+    });
     ctx_.vf_.vkCmdCopyBuffer(
         wrapper.cmdBuf, stagingBuffer->getVkBuffer(), buffer.getVkBuffer(), 1, &copy);
-    memoryChunk.handle = immediate->submit(wrapper); // store the submit handle with the allocation
+    handle = submitCommandBuffer(wrapper);
+    memoryChunk.handle = handle; // store the submit handle with the allocation
     regions_.push_back(memoryChunk);
 
     size -= copySize;
     copyData = static_cast<uint8_t*>(copyData) + copySize;
     chunkDstOffset += copySize;
   }
+
+  return handle;
 }
 
 void VulkanStagingDevice::mergeRegionsAndFreeBuffers() {
@@ -242,7 +449,9 @@ VulkanStagingDevice::MemoryRegion VulkanStagingDevice::nextFreeBlock(VkDeviceSiz
       "available\n");
 #endif
 
-  // Nothing was available. Let's wait for the entire staging buffer to become free
+  // Nothing was available. Let's wait for the entire staging buffer to become free. Regions used
+  // by the current batch cannot be waited on before the batch is submitted
+  flushBatch();
   waitAndReset();
 
   // try to allocate a new staging buffer
@@ -270,6 +479,9 @@ void VulkanStagingDevice::getBufferSubData(const VulkanBuffer& buffer,
     return;
   }
 
+  // the readback must observe all uploads recorded so far
+  flushBatch();
+
 #if IGL_VULKAN_DEBUG_STAGING_DEVICE
   IGL_LOG_INFO("Download requested for data with %u bytes\n", size);
 #endif
@@ -315,13 +527,13 @@ void VulkanStagingDevice::getBufferSubData(const VulkanBuffer& buffer,
   }
 }
 
-void VulkanStagingDevice::imageData(const VulkanImage& image,
-                                    TextureType type,
-                                    const TextureRangeDesc& range,
-                                    const TextureFormatProperties& properties,
-                                    uint32_t bytesPerRow,
-                                    VkImageAspectFlags aspectFlags,
-                                    const void* data) {
+VulkanSubmitHandle VulkanStagingDevice::imageData(const VulkanImage& image,
+                                                  TextureType type,
+                                                  const TextureRangeDesc& range,
+                                                  const TextureFormatProperties& properties,
+                                                  uint32_t bytesPerRow,
+                                                  VkImageAspectFlags aspectFlags,
+                                                  const void* data) {
   IGL_PROFILER_FUNCTION();
 
   const bool is420 = (image.imageFormat_ == VK_FORMAT_G8_B8R8_2PLANE_420_UNORM) ||
@@ -351,7 +563,6 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
   // 1. Copy the pixel data into the host visible staging buffer
   stagingBuffer->bufferSubData(memoryChunk.offset, storageSize, data);
 
-  const auto& wrapper = immediate->acquire();
   const uint32_t initialLayer = getVkLayer(type, range.face, range.layer);
   const uint32_t numLayers = getVkLayer(type, range.numFaces, range.numLayers);
 
@@ -365,6 +576,10 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
     IGL_DEBUG_ASSERT(range.x == 0 && range.y == 0 && range.z == 0);
     IGL_DEBUG_ASSERT(image.type_ == VK_IMAGE_TYPE_2D);
     IGL_DEBUG_ASSERT(image.extent_.width == range.width && image.extent_.height == range.height);
+    const auto& wrapper = acquireCommandBuffer({
+        {(uint64_t)stagingBuffer->getVkBuffer(), memoryChunk.offset, storageSize},
+        {.resource = (uint64_t)image.getVkImage()},
+    });
     const uint32_t w = image.extent_.width;
     const uint32_t h = image.extent_.height;
     ivkCmdBeginDebugUtilsLabel(&ctx_.vf_,
@@ -432,7 +647,7 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
 
     } else {
       IGL_DEBUG_ABORT("Unimplemented multiplanar image format");
-      return;
+      return {};
     }
 
     const VkImageSubresourceRange subresourceRange = {
@@ -481,15 +696,15 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
                               VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
                           subresourceRange);
 
-    image.imageLayout_ = targetLayout;
+    image.setLayout(targetLayout, subresourceRange);
 
     ivkCmdEndDebugUtilsLabel(&ctx_.vf_, wrapper.cmdBuf);
 
     // Store the allocated block with the SubmitHandle at the end of the deque
-    memoryChunk.handle = immediate->submit(wrapper);
+    memoryChunk.handle = submitCommandBuffer(wrapper);
     regions_.push_back(memoryChunk);
 
-    return;
+    return memoryChunk.handle;
 
     // end of VK_FORMAT_G8_B8R8_2PLANE_420_UNORM code path
   }
@@ -500,11 +715,6 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
       image.isDepthFormat_ ? VK_IMAGE_ASPECT_DEPTH_BIT
                            : (image.isStencilFormat_ ? VK_IMAGE_ASPECT_STENCIL_BIT : aspectFlags);
 
-  ivkCmdBeginDebugUtilsLabel(&ctx_.vf_,
-                             wrapper.cmdBuf,
-                             "VulkanStagingDevice::imageData (upload image data)",
-                             K_COLOR_UPLOAD_IMAGE.toFloatPtr());
-
   for (uint32_t mipLevel = range.mipLevel; mipLevel < range.mipLevel + range.numMipLevels;
        ++mipLevel) {
     const auto mipRange = range.atMipLevel(mipLevel);
@@ -551,6 +761,32 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
     }
   }
 
+  // The initial upload into an image can go to the transfer queue: the image has never been used by
+  // the graphics queue, so there is nothing to synchronize with except the ownership transfer. The
+  // copies have to satisfy the stricter requirements of transfer-only queues
+  const VkExtent3D& granularity = ctx_.deviceQueues_.transferQueueImageGranularity;
+  const bool useTransferQueue =
+      transferImmediate_ && image.imageLayout_ == VK_IMAGE_LAYOUT_UNDEFINED &&
+      !image.isDepthFormat_ && !image.isStencilFormat_ && granularity.width == 1 &&
+      granularity.height == 1 && granularity.depth == 1 &&
+      std::all_of(copyRegions.begin(), copyRegions.end(), [](const VkBufferImageCopy& region) {
+        return region.bufferOffset % 4 == 0;
+      });
+
+  // the layout transitions below do not wait for earlier writes, so any earlier upload into the
+  // same image counts as an overlap
+  const std::initializer_list<BatchRange> ranges = {
+      {(uint64_t)stagingBuffer->getVkBuffer(), memoryChunk.offset, storageSize},
+      {.resource = (uint64_t)image.getVkImage()},
+  };
+  const auto& wrapper =
+      useTransferQueue ? acquireTransferCommandBuffer(ranges) : acquireCommandBuffer(ranges);
+
+  ivkCmdBeginDebugUtilsLabel(&ctx_.vf_,
+                             wrapper.cmdBuf,
+                             "VulkanStagingDevice::imageData (upload image data)",
+                             K_COLOR_UPLOAD_IMAGE.toFloatPtr());
+
   // image memory barriers should have combined image aspect flags (depth/stencil)
   const VkImageSubresourceRange subresourceRange = {
       .aspectMask = aspectFlags,
@@ -626,25 +862,58 @@ void VulkanStagingDevice::imageData(const VulkanImage& image,
                                                           VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT
                                                     : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT)));
 
-  // 3. Transition TRANSFER_DST_OPTIMAL into `targetLayout`
-  ivkImageMemoryBarrier(&ctx_.vf_,
-                        wrapper.cmdBuf,
-                        image.getVkImage(),
-                        VK_ACCESS_TRANSFER_WRITE_BIT,
-                        dstAccessMask,
-                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                        targetLayout,
-                        VK_PIPELINE_STAGE_TRANSFER_BIT,
-                        dstStageMask,
-                        subresourceRange);
+  if (useTransferQueue) {
+    // 3. Release the image to the graphics queue, transitioning TRANSFER_DST_OPTIMAL into
+    // `targetLayout`. The graphics queue acquires it with a matching barrier (see flushTransfers())
+    VkImageMemoryBarrier barrier = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+        .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+        .dstAccessMask = 0,
+        .oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+        .newLayout = targetLayout,
+        .srcQueueFamilyIndex = ctx_.deviceQueues_.transferQueueFamilyIndex,
+        .dstQueueFamilyIndex = ctx_.deviceQueues_.graphicsQueueFamilyIndex,
+        .image = image.getVkImage(),
+        .subresourceRange = subresourceRange,
+    };
+    ctx_.vf_.vkCmdPipelineBarrier(wrapper.cmdBuf,
+                                  VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                  VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                                  0,
+                                  0,
+                                  nullptr,
+                                  0,
+                                  nullptr,
+                                  1,
+                                  &barrier);
 
-  image.imageLayout_ = targetLayout;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = dstAccessMask;
+    pendingAcquireBarriers_.push_back(barrier);
+    pendingAcquireStageMask_ |= dstStageMask;
+  } else {
+    // 3. Transition TRANSFER_DST_OPTIMAL into `targetLayout`
+    ivkImageMemoryBarrier(&ctx_.vf_,
+                          wrapper.cmdBuf,
+                          image.getVkImage(),
+                          VK_ACCESS_TRANSFER_WRITE_BIT,
+                          dstAccessMask,
+                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                          targetLayout,
+                          VK_PIPELINE_STAGE_TRANSFER_BIT,
+                          dstStageMask,
+                          subresourceRange);
+  }
+
+  image.setLayout(targetLayout, subresourceRange);
 
   ivkCmdEndDebugUtilsLabel(&ctx_.vf_, wrapper.cmdBuf);
 
   // Store the allocated block with the SubmitHandle at the end of the deque
-  memoryChunk.handle = immediate->submit(wrapper);
+  memoryChunk.handle = useTransferQueue ? submitTransfer() : submitCommandBuffer(wrapper);
   regions_.push_back(memoryChunk);
+
+  return memoryChunk.handle;
 }
 
 void VulkanStagingDevice::getImageData2D(VkImage srcImage,
@@ -661,6 +930,9 @@ void VulkanStagingDevice::getImageData2D(VkImage srcImage,
   IGL_PROFILER_FUNCTION();
   IGL_DEBUG_ASSERT(layout != VK_IMAGE_LAYOUT_UNDEFINED);
 
+  // the readback must observe all uploads recorded so far
+  flushBatch();
+
   const bool mustRepack = bytesPerRow != 0 && bytesPerRow % properties.bytesPerBlock != 0;
 
   const auto range =
@@ -8,11 +8,13 @@
 #pragma once
 
 #include <deque>
+#include <initializer_list>
 #include <memory>
 #include <vector>
 #include <igl/vulkan/Common.h>
 #include <igl/vulkan/VulkanHelpers.h>
 #include <igl/vulkan/VulkanImmediateCommands.h>
+#include <igl/vulkan/VulkanSemaphore.h>
 
 namespace igl::vulkan {
 
@@ -29,23 +31,58 @@ class VulkanImage;
  * determined at runtime and is the minimum between VkPhysicalDeviceLimits::VkPhysicalDeviceLimits
  * and 256 MB. Some architectures limit the size of staging buffers to 256MB (buffers that are both
  * host and device visible).
+ *
+ * If VulkanContextConfig::enableTransferQueue is set and the device exposes a dedicated transfer
+ * queue family, the initial uploads into images are recorded on that queue, so that streaming
+ * overlaps with rendering. The ownership of these images is released by the transfer queue and
+ * acquired by the graphics queue, which waits on a timeline semaphore signaled by the transfer
+ * submission. All other transfers are done on the graphics queue.
  */
 // NOLINTNEXTLINE(cppcoreguidelines-special-member-functions)
 class VulkanStagingDevice final {
  public:
   explicit VulkanStagingDevice(VulkanContext& ctx);
-  ~VulkanStagingDevice() = default;
+  ~VulkanStagingDevice();
 
   VulkanStagingDevice(const VulkanStagingDevice&) = delete;
   VulkanStagingDevice& operator=(const VulkanStagingDevice&) = delete;
 
   std::unique_ptr<VulkanImmediateCommands> immediate;
 
+  /** @brief Starts an upload batch. Until the matching endBatch(), all uploads done via
+   * bufferSubData() and imageData() are recorded into a single command buffer which is submitted
+   * once by endBatch(), instead of one submission per upload. Batches can be nested; only the
+   * outermost endBatch() submits. Readbacks and command buffer submissions flush the batch
+   * recorded so far to preserve the ordering of GPU operations.
+   */
+  void beginBatch();
+
+  /// @brief Ends an upload batch started with beginBatch(). Returns the submit handle of the last
+  /// command buffer submitted for the batch, which can be used to wait for all its uploads.
+  VulkanImmediateCommands::SubmitHandle endBatch();
+
+  /// @brief Submits the uploads recorded so far in the current batch without ending the batch
+  void flushBatch();
+
+  [[nodiscard]] bool isBatching() const noexcept {
+    return batchDepth_ > 0;
+  }
+
+  /// @brief Returns true if uploads can be done on a dedicated transfer queue
+  [[nodiscard]] bool hasTransferQueue() const noexcept {
+    return transferImmediate_ != nullptr;
+  }
+
   /** @brief Uploads the data at location `data` with the provided size (in bytes) to the
    * VulkanBuffer object on the device at offset `dstOffset`. The upload operation is asynchronous
-   * and the data may or may not be available to the GPU when the function returns
+   * and the data may or may not be available to the GPU when the function returns. Returns the
+   * submit handle which can be used to wait for the upload. Inside a batch, the handle becomes
+   * valid once the batch is flushed.
    */
-  void bufferSubData(VulkanBuffer& buffer, size_t dstOffset, size_t size, const void* data);
+  VulkanImmediateCommands::SubmitHandle bufferSubData(VulkanBuffer& buffer,
+                                                      size_t dstOffset,
+                                                      size_t size,
+                                                      const void* data);
 
   /** @brief Downloads the data with the provided size (in bytes) from the VulkanBuffer object on
    * the device, and at the offset provided, to the location referenced by the pointer `data`. The
@@ -56,14 +93,15 @@ class VulkanStagingDevice final {
 
   /// @brief Uploads the texture data pointed by `data` to the VulkanImage object on the device. The
   /// data may span the entire texture or just part of it. The upload operation is asynchronous and
-  /// the data may or may not be available to the GPU when the function returns
-  void imageData(const VulkanImage& image,
-                 TextureType type,
-                 const TextureRangeDesc& range,
-                 const TextureFormatProperties& properties,
-                 uint32_t bytesPerRow,
-                 VkImageAspectFlags aspectFlags,
-                 const void* data);
+  /// the data may or may not be available to the GPU when the function returns. Returns the submit
+  /// handle of the upload (see bufferSubData())
+  VulkanImmediateCommands::SubmitHandle imageData(const VulkanImage& image,
+                                                  TextureType type,
+                                                  const TextureRangeDesc& range,
+                                                  const TextureFormatProperties& properties,
+                                                  uint32_t bytesPerRow,
+                                                  VkImageAspectFlags aspectFlags,
+                                                  const void* data);
 
   /** @brief Downloads the texture data from the VulkanImage object on the device to the location
    * pointed by `data`. The data requested may span the entire texture or just part of it. The
@@ -120,6 +158,38 @@ class VulkanStagingDevice final {
 
   [[nodiscard]] VkDeviceSize getAlignedSize(VkDeviceSize size) const;
 
+  /// @brief A range of a buffer, or a whole image, accessed by a copy recorded into a batch
+  struct BatchRange {
+    uint64_t resource = 0; // VkBuffer or VkImage
+    VkDeviceSize offset = 0;
+    VkDeviceSize size = VK_WHOLE_SIZE;
+  };
+
+  /// @brief Returns the command buffer of the current batch, or a new command buffer if there is no
+  /// batch in progress. `ranges` are the staging and destination ranges accessed by the next copy
+  [[nodiscard]] const VulkanImmediateCommands::CommandBufferWrapper& acquireCommandBuffer(
+      std::initializer_list<BatchRange> ranges = {});
+  /// @brief Submits `wrapper` unless it belongs to the current batch, in which case it is submitted
+  /// when the batch is flushed
+  VulkanImmediateCommands::SubmitHandle submitCommandBuffer(
+      const VulkanImmediateCommands::CommandBufferWrapper& wrapper);
+
+  /// @brief Returns the transfer queue command buffer collecting the pending transfers. See
+  /// acquireCommandBuffer() for `ranges`
+  [[nodiscard]] const VulkanImmediateCommands::CommandBufferWrapper& acquireTransferCommandBuffer(
+      std::initializer_list<BatchRange> ranges);
+  /// @brief Records a transfer barrier into `cmdBuf` if any of `ranges` overlaps one of
+  /// `batchRanges`, which holds the ranges accessed by the copies already recorded into `cmdBuf`
+  void syncBatchRanges(VkCommandBuffer cmdBuf,
+                       std::vector<BatchRange>& batchRanges,
+                       std::initializer_list<BatchRange> ranges);
+  /// @brief Returns the submit handle of a transfer recorded into the transfer queue command
+  /// buffer. Outside of a batch, the transfers are submitted right away
+  VulkanImmediateCommands::SubmitHandle submitTransfer();
+  /// @brief Submits the pending transfers and the graphics queue command buffer acquiring the
+  /// ownership of the uploaded resources. Returns the handle of the latter
+  VulkanImmediateCommands::SubmitHandle flushTransfers();
+
   /// @brief Waits for all memory blocks to become available and resets the staging device's
   /// internal state
   void waitAndReset();
@@ -161,6 +231,25 @@ class VulkanStagingDevice final {
    * the associated command buffer to finish)
    */
   std::deque<MemoryRegion> regions_;
+
+  uint32_t batchDepth_ = 0;
+  /// @brief The command buffer recording the current batch. Acquired lazily by the first upload
+  const VulkanImmediateCommands::CommandBufferWrapper* batchWrapper_ = nullptr;
+  /// @brief Ranges accessed by the copies recorded into the batch since its last barrier
+  std::vector<BatchRange> batchRanges_;
+  VulkanImmediateCommands::SubmitHandle lastBatchHandle_;
+
+  /// @brief Dedicated transfer queue; nullptr if uploads are done on the graphics queue
+  std::unique_ptr<VulkanImmediateCommands> transferImmediate_;
+  /// @brief Timeline semaphore signaled by the transfer queue and waited on by the graphics queue
+  std::unique_ptr<VulkanSemaphore> transferSemaphore_;
+  uint64_t transferTimelineValue_ = 0;
+  /// @brief The transfer queue command buffer recording the pending transfers. Acquired lazily
+  const VulkanImmediateCommands::CommandBufferWrapper* transferWrapper_ = nullptr;
+  std::vector<BatchRange> transferRanges_;
+  /// @brief Queue family ownership acquire barriers matching the pending transfers
+  std::vector<VkImageMemoryBarrier> pendingAcquireBarriers_;
+  VkPipelineStageFlags pendingAcquireStageMask_ = 0;
 };
 
 } // namespace igl::vulkan
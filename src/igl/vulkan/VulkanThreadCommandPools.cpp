@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanThreadCommandPools.h>
+
+#include <algorithm>
+
+namespace igl::vulkan {
+
+struct VulkanThreadCommandPools::ThreadExitObserver {
+  ~ThreadExitObserver() {
+    for (const std::weak_ptr<ThreadPool>& weakPool : pools) {
+      // expired if the context was destroyed before this thread exited
+      if (const std::shared_ptr<ThreadPool> threadPool = weakPool.lock()) {
+        const std::lock_guard<std::mutex> lock(threadPool->mutex);
+        threadPool->isOrphaned = true;
+      }
+    }
+  }
+
+  // one pool per context used by this thread
+  std::vector<std::weak_ptr<ThreadPool>> pools;
+};
+
+VulkanThreadCommandPools::VulkanThreadCommandPools(const VulkanFunctionTable& vf,
+                                                   VkDevice device,
+                                                   uint32_t queueFamilyIndex) :
+  vf_(vf), device_(device), queueFamilyIndex_(queueFamilyIndex) {}
+
+VulkanThreadCommandPools::~VulkanThreadCommandPools() {
+  // the context waits for the device to be idle before destroying this object
+  for (const auto& [threadId, threadPool] : pools_) {
+    vf_.vkDestroyCommandPool(device_, threadPool->pool, nullptr);
+  }
+  for (const std::shared_ptr<ThreadPool>& threadPool : orphanedPools_) {
+    vf_.vkDestroyCommandPool(device_, threadPool->pool, nullptr);
+  }
+}
+
+VulkanThreadCommandPools::ThreadPool& VulkanThreadCommandPools::getThreadPool() {
+  const std::lock_guard<std::mutex> lock(poolsMutex_);
+
+  std::shared_ptr<ThreadPool>& threadPool = pools_[std::this_thread::get_id()];
+
+  if (threadPool) {
+    const std::lock_guard<std::mutex> poolLock(threadPool->mutex);
+    if (threadPool->isOrphaned) {
+      // the id of an exited thread was reused before recycle() could retire its pool
+      orphanedPools_.push_back(std::move(threadPool));
+    }
+  }
+
+  if (!threadPool) {
+    IGL_PROFILER_FUNCTION_COLOR(IGL_PROFILER_COLOR_CREATE);
+    threadPool = std::make_shared<ThreadPool>();
+    VK_ASSERT(ivkCreateCommandPool(&vf_,
+                                   device_,
+                                   VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT |
+                                       VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,
+                                   queueFamilyIndex_,
+                                   &threadPool->pool));
+    ivkSetDebugObjectName(
+        &vf_,
+        device_,
+        VK_OBJECT_TYPE_COMMAND_POOL,
+        (uint64_t)threadPool->pool,
+        IGL_FORMAT("Command Pool: secondary #{}", static_cast<uint32_t>(pools_.size())).c_str());
+
+    thread_local ThreadExitObserver observer;
+    std::erase_if(observer.pools,
+                  [](const std::weak_ptr<ThreadPool>& weakPool) { return weakPool.expired(); });
+    observer.pools.push_back(threadPool);
+  }
+
+  return *threadPool;
+}
+
+VkCommandBuffer VulkanThreadCommandPools::acquireSecondary(
+    VulkanImmediateCommands::SubmitHandle handle) {
+  IGL_PROFILER_FUNCTION();
+  IGL_DEBUG_ASSERT(!handle.empty());
+
+  ThreadPool& threadPool = getThreadPool();
+
+  const std::lock_guard<std::mutex> lock(threadPool.mutex);
+
+  for (SecondaryCommandBuffer& buf : threadPool.buffers) {
+    if (buf.isFree) {
+      buf.isFree = false;
+      buf.handle = handle;
+      // implicitly reset by vkBeginCommandBuffer()
+      return buf.cmdBuf;
+    }
+  }
+
+  const VkCommandBufferAllocateInfo ai = {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
+      .commandPool = threadPool.pool,
+      .level = VK_COMMAND_BUFFER_LEVEL_SECONDARY,
+      .commandBufferCount = 1,
+  };
+  VkCommandBuffer cmdBuf = VK_NULL_HANDLE;
+  VK_ASSERT(vf_.vkAllocateCommandBuffers(device_, &ai, &cmdBuf));
+
+  threadPool.buffers.push_back({.cmdBuf = cmdBuf, .handle = handle, .isFree = false});
+
+  return cmdBuf;
+}
+
+bool VulkanThreadCommandPools::recycleBuffers(ThreadPool& threadPool,
+                                              const VulkanImmediateCommands& immediate) {
+  bool isIdle = true;
+  for (SecondaryCommandBuffer& buf : threadPool.buffers) {
+    if (!buf.isFree && immediate.isReady(buf.handle)) {
+      buf.isFree = true;
+      buf.handle = {};
+    }
+    isIdle = isIdle && buf.isFree;
+  }
+  return isIdle;
+}
+
+void VulkanThreadCommandPools::recycle(const VulkanImmediateCommands& immediate) {
+  IGL_PROFILER_FUNCTION();
+
+  const std::lock_guard<std::mutex> lock(poolsMutex_);
+
+  for (auto it = pools_.begin(); it != pools_.end();) {
+    ThreadPool& threadPool = *it->second;
+    const std::lock_guard<std::mutex> poolLock(threadPool.mutex);
+    recycleBuffers(threadPool, immediate);
+    if (threadPool.isOrphaned) {
+      orphanedPools_.push_back(std::move(it->second));
+      it = pools_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  // no thread records into these pools anymore, so they can be destroyed on this thread
+  std::erase_if(orphanedPools_, [this, &immediate](const std::shared_ptr<ThreadPool>& threadPool) {
+    const std::lock_guard<std::mutex> poolLock(threadPool->mutex);
+    if (!recycleBuffers(*threadPool, immediate)) {
+      return false;
+    }
+    vf_.vkDestroyCommandPool(device_, threadPool->pool, nullptr);
+    return true;
+  });
+}
+
+size_t VulkanThreadCommandPools::getNumPools() const {
+  const std::lock_guard<std::mutex> lock(poolsMutex_);
+  return pools_.size() + orphanedPools_.size();
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+/**
+ * @brief Secondary command buffers for recording on worker threads.
+ *
+ * Vulkan requires command pools to be externally synchronized, so every thread which records
+ * secondary command buffers gets its own VkCommandPool, created on its first acquireSecondary()
+ * call. Each secondary command buffer is tagged with the SubmitHandle of the primary command buffer
+ * which executes it and is reused once recycle() sees that primary retired. When a thread exits,
+ * its pool is destroyed by recycle() as soon as all of its command buffers have retired.
+ */
+class VulkanThreadCommandPools final {
+ public:
+  VulkanThreadCommandPools(const VulkanFunctionTable& vf,
+                           VkDevice device,
+                           uint32_t queueFamilyIndex);
+  ~VulkanThreadCommandPools();
+
+  VulkanThreadCommandPools(const VulkanThreadCommandPools&) = delete;
+  VulkanThreadCommandPools& operator=(const VulkanThreadCommandPools&) = delete;
+  VulkanThreadCommandPools(VulkanThreadCommandPools&&) = delete;
+  VulkanThreadCommandPools& operator=(VulkanThreadCommandPools&&) = delete;
+
+  /// @brief Returns a secondary command buffer from the pool of the calling thread, which will be
+  /// executed by the primary command buffer identified by `handle`. Can be called from any thread.
+  /// The command buffer has to be recorded on the calling thread.
+  [[nodiscard]] VkCommandBuffer acquireSecondary(VulkanImmediateCommands::SubmitHandle handle);
+
+  /// @brief Makes the secondary command buffers of all retired primary command buffers available
+  /// again. Called on the context thread after every submit.
+  void recycle(const VulkanImmediateCommands& immediate);
+
+  /// @brief The number of command pools which have not been destroyed yet, including the pools of
+  /// exited threads whose command buffers are still pending
+  [[nodiscard]] size_t getNumPools() const;
+
+ private:
+  struct SecondaryCommandBuffer {
+    VkCommandBuffer cmdBuf = VK_NULL_HANDLE;
+    VulkanImmediateCommands::SubmitHandle handle = {};
+    bool isFree = false;
+  };
+  struct ThreadPool {
+    // guards `buffers` and `isOrphaned`; the VkCommandPool itself is only used by its own thread
+    std::mutex mutex;
+    VkCommandPool pool = VK_NULL_HANDLE;
+    std::vector<SecondaryCommandBuffer> buffers;
+    // set when the owning thread exits
+    bool isOrphaned = false;
+  };
+  // a thread_local which marks the pools of its thread as orphaned when the thread exits
+  struct ThreadExitObserver;
+
+  [[nodiscard]] ThreadPool& getThreadPool();
+  // returns true if none of the command buffers of `threadPool` is pending
+  [[nodiscard]] static bool recycleBuffers(ThreadPool& threadPool,
+                                           const VulkanImmediateCommands& immediate);
+
+  const VulkanFunctionTable& vf_;
+  VkDevice device_ = VK_NULL_HANDLE;
+  uint32_t queueFamilyIndex_ = 0;
+
+  mutable std::mutex poolsMutex_;
+  std::unordered_map<std::thread::id, std::shared_ptr<ThreadPool>> pools_;
+  // pools of exited threads, destroyed once all of their command buffers have retired
+  std::vector<std::shared_ptr<ThreadPool>> orphanedPools_;
+};
+
+} // namespace igl::vulkan
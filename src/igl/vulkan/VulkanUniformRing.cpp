@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <igl/vulkan/VulkanUniformRing.h>
+
+#include <algorithm>
+#include <igl/vulkan/VulkanBuffer.h>
+#include <igl/vulkan/VulkanContext.h>
+
+namespace igl::vulkan {
+
+namespace {
+
+VkDeviceSize alignUp(VkDeviceSize value, VkDeviceSize alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+VulkanUniformRing::VulkanUniformRing(VulkanContext& ctx, VkDeviceSize size) :
+  ctx_(ctx), size_(size), frames_(ctx.config_.maxResourceCount) {
+  alignment_ = std::max(
+      alignment_, ctx_.getVkPhysicalDeviceProperties().limits.minUniformBufferOffsetAlignment);
+}
+
+VulkanUniformRing::~VulkanUniformRing() = default;
+
+VulkanUniformRing::Allocation VulkanUniformRing::allocate(
+    const void* IGL_NONNULL data,
+    size_t length,
+    VulkanImmediateCommands::SubmitHandle handle) {
+  IGL_PROFILER_FUNCTION();
+
+  IGL_DEBUG_ASSERT(data);
+  IGL_DEBUG_ASSERT(length);
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+
+  Frame& frame = frames_[ctx_.currentSyncIndex()];
+
+  VkDeviceSize offset = alignUp(frame.head, alignment_);
+
+  if (frame.buffers.empty() || offset + length > frame.buffers.back()->getSize()) {
+    const VkDeviceSize prevSize = frame.buffers.empty() ? 0 : frame.buffers.back()->getSize();
+    const VkDeviceSize bufferSize =
+        std::max({size_, 2 * prevSize, alignUp(static_cast<VkDeviceSize>(length), alignment_)});
+    const VkBufferUsageFlags optionalBDA = ctx_.features().has_VK_KHR_buffer_device_address
+                                               ? VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT_KHR
+                                               : 0;
+    auto buffer = ctx_.createBuffer(bufferSize,
+                                    VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | optionalBDA,
+                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT,
+                                    nullptr,
+                                    "Buffer: uniform ring");
+    if (!buffer || !buffer->isMapped()) {
+      IGL_LOG_ERROR("Cannot allocate %llu bytes for bindBytes()\n",
+                    static_cast<unsigned long long>(bufferSize));
+      return {};
+    }
+    frame.buffers.push_back(std::move(buffer));
+    frame.head = 0;
+    offset = 0;
+  }
+
+  VulkanBuffer& buffer = *frame.buffers.back();
+  buffer.bufferSubData(offset, length, data);
+
+  frame.numBytesUsed += offset + length - frame.head;
+  frame.head = offset + length;
+  if (frame.handles.empty() || frame.handles.back() != handle) {
+    frame.handles.push_back(handle);
+  }
+
+  numAllocations_++;
+  highWaterMark_ = std::max(highWaterMark_, frame.numBytesUsed);
+
+  return {
+      .buffer = &buffer,
+      .offset = offset,
+  };
+}
+
+void VulkanUniformRing::recycle(uint32_t syncIndex) {
+  IGL_PROFILER_FUNCTION();
+
+  IGL_DEBUG_ASSERT(syncIndex < frames_.size());
+
+  const std::lock_guard<std::mutex> lock(mutex_);
+
+  Frame& frame = frames_[syncIndex];
+
+  // a command buffer recorded concurrently with other submissions can still be pending; keep
+  // appending to the frame until it completes
+  for (const auto& handle : frame.handles) {
+    if (!ctx_.immediate_->isReady(handle)) {
+      return;
+    }
+  }
+
+  frame.handles.clear();
+  frame.head = 0;
+  frame.numBytesUsed = 0;
+
+  if (frame.buffers.size() > 1) {
+    // the last buffer is the largest one
+    frame.buffers.erase(frame.buffers.begin(), frame.buffers.end() - 1);
+  }
+}
+
+VulkanUniformRingStats VulkanUniformRing::getStats() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  VulkanUniformRingStats stats = {
+      .numAllocations = numAllocations_,
+      .numBytesUsed = frames_[ctx_.currentSyncIndex()].numBytesUsed,
+      .highWaterMark = highWaterMark_,
+  };
+  for (const Frame& frame : frames_) {
+    for (const auto& buffer : frame.buffers) {
+      stats.capacity += buffer->getSize();
+    }
+  }
+  return stats;
+}
+
+} // namespace igl::vulkan
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <igl/vulkan/Common.h>
+#include <igl/vulkan/VulkanImmediateCommands.h>
+
+namespace igl::vulkan {
+
+class VulkanBuffer;
+class VulkanContext;
+
+/// @brief Counters of the transient uniform memory used by bindBytes()
+struct VulkanUniformRingStats {
+  /// the total number of bindBytes() allocations
+  uint64_t numAllocations = 0;
+  /// the number of bytes allocated in the current frame, including alignment padding
+  VkDeviceSize numBytesUsed = 0;
+  /// the largest number of bytes allocated in any frame so far
+  VkDeviceSize highWaterMark = 0;
+  /// the total size of the buffers of all frames
+  VkDeviceSize capacity = 0;
+};
+
+/**
+ * @brief Allocates transient uniform data for RenderCommandEncoder::bindBytes() and
+ * ComputeCommandEncoder::bindBytes().
+ *
+ * Every frame, indexed by VulkanContext::currentSyncIndex(), owns persistently mapped host-visible
+ * uniform buffers which are sub-allocated linearly and created on first use. A frame's memory is
+ * recycled by VulkanContext::syncAcquireNext() once all command buffers which used it have
+ * completed. When a frame runs out of memory, it continues in a new buffer twice as large; only
+ * the largest buffer is kept when the frame is recycled.
+ *
+ * allocate() can be called from multiple threads recording secondary command buffers.
+ */
+class VulkanUniformRing final {
+ public:
+  struct Allocation {
+    const VulkanBuffer* IGL_NULLABLE buffer = nullptr;
+    VkDeviceSize offset = 0;
+  };
+
+  VulkanUniformRing(VulkanContext& ctx, VkDeviceSize size);
+  ~VulkanUniformRing();
+
+  VulkanUniformRing(const VulkanUniformRing&) = delete;
+  VulkanUniformRing& operator=(const VulkanUniformRing&) = delete;
+
+  /** @brief Copies `length` bytes from `data` into the memory of the current frame which will be
+   * read by the command buffer identified by `handle`. The offset of the returned allocation is a
+   * multiple of `VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment`. Returns an empty
+   * allocation if no memory could be allocated.
+   */
+  [[nodiscard]] Allocation allocate(const void* IGL_NONNULL data,
+                                    size_t length,
+                                    VulkanImmediateCommands::SubmitHandle handle);
+
+  /// @brief Makes the memory of the frame `syncIndex` available again if the GPU is done with it
+  void recycle(uint32_t syncIndex);
+
+  [[nodiscard]] VulkanUniformRingStats getStats() const;
+
+ private:
+  struct Frame {
+    // the last buffer is the one being sub-allocated
+    std::vector<std::unique_ptr<VulkanBuffer>> buffers;
+    // the offset of the next allocation in buffers.back()
+    VkDeviceSize head = 0;
+    VkDeviceSize numBytesUsed = 0;
+    // all command buffers which read from this frame's memory
+    std::vector<VulkanImmediateCommands::SubmitHandle> handles;
+  };
+
+  VulkanContext& ctx_;
+  mutable std::mutex mutex_;
+  const VkDeviceSize size_;
+  VkDeviceSize alignment_ = 16;
+  std::vector<Frame> frames_;
+  uint64_t numAllocations_ = 0;
+  VkDeviceSize highWaterMark_ = 0;
+};
+
+} // namespace igl::vulkan